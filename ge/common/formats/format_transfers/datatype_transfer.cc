@@ -16,13 +16,23 @@
 
 #include "common/formats/format_transfers/datatype_transfer.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <map>
 #include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #include "common/formats/utils/formats_trans_utils.h"
 #include "common/fp16_t.h"
 #include "common/ge/ge_util.h"
+#include "common/task_scheduler.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/utils/type_utils.h"
 #include "securec.h"
@@ -68,52 +78,613 @@ std::map<std::pair<DataType, DataType>, DataTypeTransMode> trans_mode_map{
   {std::pair<DataType, DataType>(DT_DOUBLE, DT_INT32), kTransferWithDatatypeDoubleToInt32},
 };
 
+using CastFunc = void (*)(const uint8_t *src, uint8_t *dst, size_t num);
+
+struct CastKernel {
+  size_t src_size;  // bytes of a source element
+  size_t dst_size;
+  CastFunc scalar_func;
+  CastFunc vector_func;  // nullptr if there is no vector kernel for the mode on this platform
+};
+
+// buffers below this number of elements per task are converted on the calling thread
+const size_t kParallelMinElemNum = 1024 * 1024;
+const size_t kMaxCastTaskNum = 8;
+// chunks handed to the tasks are multiples of it, so that only the last one has a scalar tail
+const size_t kCastChunkAlign = 64;
+
 template <typename SrcT, typename DstT>
-Status TransDataSrc2Dst(const CastArgs &args, uint8_t *dst, const size_t data_size) {
+void TransDataSrc2Dst(const uint8_t *src, uint8_t *dst, size_t num) {
   SrcT src_data;
-  for (size_t idx = 0; idx != data_size; idx++) {
-    src_data = reinterpret_cast<const SrcT *>(args.data)[idx];
+  for (size_t idx = 0; idx != num; idx++) {
+    src_data = reinterpret_cast<const SrcT *>(src)[idx];
     reinterpret_cast<DstT *>(dst)[idx] = static_cast<DstT>(src_data);
   }
-  return SUCCESS;
 }
 
 template <typename SrcT>
-Status TransDataSrc2Fp16(const CastArgs &args, uint8_t *dst, const size_t data_size) {
+void TransDataSrc2Fp16(const uint8_t *src, uint8_t *dst, size_t num) {
   fp16_t src_data;
-  for (size_t idx = 0; idx != data_size; idx++) {
-    src_data = reinterpret_cast<const SrcT *>(args.data)[idx];
+  for (size_t idx = 0; idx != num; idx++) {
+    src_data = reinterpret_cast<const SrcT *>(src)[idx];
     reinterpret_cast<uint16_t *>(dst)[idx] = src_data.val;
   }
-  return SUCCESS;
 }
 
-Status CastKernel(const CastArgs &args, uint8_t *dst, const size_t data_size, const DataTypeTransMode trans_mode) {
-  static std::map<DataTypeTransMode, std::function<Status(const CastArgs &, uint8_t *, const size_t)>> transfer_handle =
-    {
-      {kTransferWithDatatypeFloatToFloat16, TransDataSrc2Fp16<float>},
-      {kTransferWithDatatypeFloatToInt32, TransDataSrc2Dst<float, int32_t>},
-      {kTransferWithDatatypeFloat16ToFloat, TransDataSrc2Dst<fp16_t, float>},
-      {kTransferWithDatatypeFloat16ToInt32, TransDataSrc2Dst<fp16_t, int32_t>},
-      {kTransferWithDatatypeInt32ToFloat, TransDataSrc2Dst<int32_t, float>},
-      {kTransferWithDatatypeInt32ToFloat16, TransDataSrc2Fp16<int32_t>},
-      {kTransferWithDatatypeInt32ToUint8, TransDataSrc2Dst<int32_t, uint8_t>},
-      {kTransferWithDatatypeInt32ToInt8, TransDataSrc2Dst<int32_t, int8_t>},
-      {kTransferWithDatatypeUint8ToFloat, TransDataSrc2Dst<uint8_t, float>},
-      {kTransferWithDatatypeUint8ToInt32, TransDataSrc2Dst<uint8_t, int32_t>},
-      {kTransferWithDatatypeInt8ToFloat, TransDataSrc2Dst<int8_t, float>},
-      {kTransferWithDatatypeInt8ToInt32, TransDataSrc2Dst<int8_t, int32_t>},
-      {kTransferWithDatatypeInt64ToInt32, TransDataSrc2Dst<int64_t, int32_t>},
-      {kTransferWithDatatypeInt32ToInt64, TransDataSrc2Dst<int32_t, int64_t>},
-      {kTransferWithDatatypeInt32ToDouble, TransDataSrc2Dst<int32_t, double>},
-      {kTransferWithDatatypeDoubleToInt32, TransDataSrc2Dst<double, int32_t>},
-    };
-  auto it = transfer_handle.find(trans_mode);
-  if (it == transfer_handle.end()) {
+// The vector kernels leave the tail to the scalar kernels. The fp16 conversions of the CPUs round to nearest even like
+// fp16_t, but fp16_t saturates where IEEE overflows to inf, and keeps inf/NaN of fp16 as large finite values. The lanes
+// holding these values are patched with the results of fp16_t, so the kernels are bit exact.
+// float bits of 65520, the smallest value rounded beyond the max fp16 value, fp16_t saturates it to 0x7FFF
+const int32_t kFp32Fp16OverflowBits = 0x477FF000;
+// float bits of 131072, fp16_t saturates the values from it on, inf and nan too, to the max fp16 value 0x7BFF
+const int32_t kFp32Fp16ExpOverflowBits = 0x48000000;
+// int32 values with a magnitude beyond it saturate to the max fp16 value in fp16_t
+const int32_t kInt32Fp16MaxExact = 65519;
+const int32_t kFp16SignBit = 0x8000;
+const int32_t kFp16ExpBits = 0x7C00;
+const int32_t kFp16ManBits = 0x03FF;
+const int32_t kFp16MaxBits = 0x7BFF;
+// fp16_t turns inf/nan of fp16 into 65536 * (1 + man / 1024)
+const int32_t kFp16InvalidFp32ExpBits = 0x47800000;
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GE_VECTOR_CAST_KERNEL(avx2_func, neon_func) avx2_func
+#define GE_AVX2_TARGET __attribute__((target("avx2,f16c")))
+
+// the AVX2 kernels convert 8 elements per step
+const int kF16cRoundToNearest = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+GE_AVX2_TARGET inline __m128i PackInt32ToUint16(__m256i data) {
+  return _mm_packus_epi32(_mm256_castsi256_si128(data), _mm256_extracti128_si256(data, 1));
+}
+
+GE_AVX2_TARGET inline __m256i IsFp16Invalid(__m256i data) {
+  const __m256i exp_bits = _mm256_set1_epi32(kFp16ExpBits);
+  return _mm256_cmpeq_epi32(_mm256_and_si256(data, exp_bits), exp_bits);
+}
+
+GE_AVX2_TARGET void TransFloatToFp16Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const float *>(src);
+  auto dst_data = reinterpret_cast<__m128i *>(dst);
+  const __m256i abs_mask = _mm256_set1_epi32(0x7FFFFFFF);
+  const __m256i overflow_bits = _mm256_set1_epi32(kFp32Fp16OverflowBits - 1);
+  const __m256i exp_overflow_bits = _mm256_set1_epi32(kFp32Fp16ExpOverflowBits - 1);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    __m256 data = _mm256_loadu_ps(src_data + idx);
+    __m128i result = _mm256_cvtps_ph(data, kF16cRoundToNearest);
+    __m256i bits = _mm256_castps_si256(data);
+    __m256i abs_bits = _mm256_and_si256(bits, abs_mask);
+    __m256i overflow = _mm256_cmpgt_epi32(abs_bits, overflow_bits);
+    if (_mm256_testz_si256(overflow, overflow) == 0) {
+      __m256i exp_overflow = _mm256_cmpgt_epi32(abs_bits, exp_overflow_bits);
+      __m256i saturated = _mm256_blendv_epi8(_mm256_set1_epi32(kFp16ExpBits | kFp16ManBits),
+                                             _mm256_set1_epi32(kFp16MaxBits), exp_overflow);
+      __m256i sign = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(kFp16SignBit));
+      saturated = _mm256_or_si256(saturated, sign);
+      result = PackInt32ToUint16(_mm256_blendv_epi8(_mm256_cvtepu16_epi32(result), saturated, overflow));
+    }
+    _mm_storeu_si128(dst_data + idx / 8, result);
+  }
+  TransDataSrc2Fp16<float>(src + idx * sizeof(float), dst + idx * sizeof(uint16_t), num - idx);
+}
+
+GE_AVX2_TARGET void TransFp16ToFloatAvx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const __m128i *>(src);
+  auto dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    __m128i data = _mm_loadu_si128(src_data + idx / 8);
+    __m256 result = _mm256_cvtph_ps(data);
+    __m256i data_int32 = _mm256_cvtepu16_epi32(data);
+    __m256i invalid = IsFp16Invalid(data_int32);
+    if (_mm256_testz_si256(invalid, invalid) == 0) {
+      __m256i sign = _mm256_slli_epi32(_mm256_and_si256(data_int32, _mm256_set1_epi32(kFp16SignBit)), 16);
+      __m256i man = _mm256_slli_epi32(_mm256_and_si256(data_int32, _mm256_set1_epi32(kFp16ManBits)), 13);
+      __m256i value = _mm256_or_si256(_mm256_or_si256(sign, man), _mm256_set1_epi32(kFp16InvalidFp32ExpBits));
+      result = _mm256_blendv_ps(result, _mm256_castsi256_ps(value), _mm256_castsi256_ps(invalid));
+    }
+    _mm256_storeu_ps(dst_data + idx, result);
+  }
+  TransDataSrc2Dst<fp16_t, float>(src + idx * sizeof(uint16_t), dst + idx * sizeof(float), num - idx);
+}
+
+GE_AVX2_TARGET void TransFp16ToInt32Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const __m128i *>(src);
+  auto dst_data = reinterpret_cast<__m256i *>(dst);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    __m128i data = _mm_loadu_si128(src_data + idx / 8);
+    // fp16 values are exact in float, so rounding the float rounds the fp16 value
+    __m256 rounded = _mm256_round_ps(_mm256_cvtph_ps(data), kF16cRoundToNearest);
+    __m256i result = _mm256_cvttps_epi32(rounded);
+    __m256i data_int32 = _mm256_cvtepu16_epi32(data);
+    __m256i invalid = IsFp16Invalid(data_int32);
+    if (_mm256_testz_si256(invalid, invalid) == 0) {
+      // INT32_MAX plus the sign bit
+      __m256i value = _mm256_add_epi32(_mm256_set1_epi32(INT32_MAX), _mm256_srli_epi32(data_int32, 15));
+      result = _mm256_blendv_epi8(result, value, invalid);
+    }
+    _mm256_storeu_si256(dst_data + idx / 8, result);
+  }
+  TransDataSrc2Dst<fp16_t, int32_t>(src + idx * sizeof(uint16_t), dst + idx * sizeof(int32_t), num - idx);
+}
+
+GE_AVX2_TARGET void TransInt32ToFp16Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const __m256i *>(src);
+  auto dst_data = reinterpret_cast<__m128i *>(dst);
+  const __m256i max_exact = _mm256_set1_epi32(kInt32Fp16MaxExact);
+  const __m256i min_exact = _mm256_set1_epi32(-kInt32Fp16MaxExact);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    __m256i data = _mm256_loadu_si256(src_data + idx / 8);
+    // values in the range are exact in float, so there is only one rounding, to fp16
+    __m128i result = _mm256_cvtps_ph(_mm256_cvtepi32_ps(data), kF16cRoundToNearest);
+    __m256i saturated = _mm256_or_si256(_mm256_cmpgt_epi32(data, max_exact), _mm256_cmpgt_epi32(min_exact, data));
+    if (_mm256_testz_si256(saturated, saturated) == 0) {
+      __m256i sign = _mm256_and_si256(_mm256_srli_epi32(data, 16), _mm256_set1_epi32(kFp16SignBit));
+      __m256i value = _mm256_or_si256(sign, _mm256_set1_epi32(kFp16MaxBits));
+      result = PackInt32ToUint16(_mm256_blendv_epi8(_mm256_cvtepu16_epi32(result), value, saturated));
+    }
+    _mm_storeu_si128(dst_data + idx / 8, result);
+  }
+  TransDataSrc2Fp16<int32_t>(src + idx * sizeof(int32_t), dst + idx * sizeof(uint16_t), num - idx);
+}
+
+GE_AVX2_TARGET void TransFloatToInt32Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const float *>(src);
+  auto dst_data = reinterpret_cast<int32_t *>(dst);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    __m256i result = _mm256_cvttps_epi32(_mm256_loadu_ps(src_data + idx));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst_data + idx), result);
+  }
+  TransDataSrc2Dst<float, int32_t>(src + idx * sizeof(float), dst + idx * sizeof(int32_t), num - idx);
+}
+
+GE_AVX2_TARGET void TransInt32ToFloatAvx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const int32_t *>(src);
+  auto dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src_data + idx));
+    _mm256_storeu_ps(dst_data + idx, _mm256_cvtepi32_ps(data));
+  }
+  TransDataSrc2Dst<int32_t, float>(src + idx * sizeof(int32_t), dst + idx * sizeof(float), num - idx);
+}
+
+// int32 to int8 and uint8 both keep the low byte
+template <typename DstT>
+GE_AVX2_TARGET void TransInt32ToByteAvx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const __m128i *>(src);
+  const __m128i byte_mask = _mm_set1_epi32(0xFF);
+  size_t idx = 0;
+  for (; idx + 16 <= num; idx += 16, src_data += 4) {
+    __m128i data0 = _mm_and_si128(_mm_loadu_si128(src_data), byte_mask);
+    __m128i data1 = _mm_and_si128(_mm_loadu_si128(src_data + 1), byte_mask);
+    __m128i data2 = _mm_and_si128(_mm_loadu_si128(src_data + 2), byte_mask);
+    __m128i data3 = _mm_and_si128(_mm_loadu_si128(src_data + 3), byte_mask);
+    __m128i result = _mm_packus_epi16(_mm_packus_epi32(data0, data1), _mm_packus_epi32(data2, data3));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + idx), result);
+  }
+  TransDataSrc2Dst<int32_t, DstT>(src + idx * sizeof(int32_t), dst + idx, num - idx);
+}
+
+template <typename SrcT>
+GE_AVX2_TARGET __m256i LoadBytesAsInt32(const uint8_t *src);
+
+template <>
+GE_AVX2_TARGET __m256i LoadBytesAsInt32<uint8_t>(const uint8_t *src) {
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+}
+
+template <>
+GE_AVX2_TARGET __m256i LoadBytesAsInt32<int8_t>(const uint8_t *src) {
+  return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src)));
+}
+
+template <typename SrcT>
+GE_AVX2_TARGET void TransByteToFloatAvx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    _mm256_storeu_ps(dst_data + idx, _mm256_cvtepi32_ps(LoadBytesAsInt32<SrcT>(src + idx)));
+  }
+  TransDataSrc2Dst<SrcT, float>(src + idx, dst + idx * sizeof(float), num - idx);
+}
+
+template <typename SrcT>
+GE_AVX2_TARGET void TransByteToInt32Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto dst_data = reinterpret_cast<__m256i *>(dst);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    _mm256_storeu_si256(dst_data + idx / 8, LoadBytesAsInt32<SrcT>(src + idx));
+  }
+  TransDataSrc2Dst<SrcT, int32_t>(src + idx, dst + idx * sizeof(int32_t), num - idx);
+}
+
+GE_AVX2_TARGET void TransInt64ToInt32Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const __m256i *>(src);
+  auto dst_data = reinterpret_cast<__m256i *>(dst);
+  // the low words of the 4 elements to the lower half
+  const __m256i low_words = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8, src_data += 2) {
+    __m256i data0 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(src_data), low_words);
+    __m256i data1 = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(src_data + 1), low_words);
+    _mm256_storeu_si256(dst_data + idx / 8, _mm256_permute2x128_si256(data0, data1, 0x20));
+  }
+  TransDataSrc2Dst<int64_t, int32_t>(src + idx * sizeof(int64_t), dst + idx * sizeof(int32_t), num - idx);
+}
+
+GE_AVX2_TARGET void TransInt32ToInt64Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const __m128i *>(src);
+  auto dst_data = reinterpret_cast<__m256i *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    _mm256_storeu_si256(dst_data + idx / 4, _mm256_cvtepi32_epi64(_mm_loadu_si128(src_data + idx / 4)));
+  }
+  TransDataSrc2Dst<int32_t, int64_t>(src + idx * sizeof(int32_t), dst + idx * sizeof(int64_t), num - idx);
+}
+
+GE_AVX2_TARGET void TransInt32ToDoubleAvx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const __m128i *>(src);
+  auto dst_data = reinterpret_cast<double *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    _mm256_storeu_pd(dst_data + idx, _mm256_cvtepi32_pd(_mm_loadu_si128(src_data + idx / 4)));
+  }
+  TransDataSrc2Dst<int32_t, double>(src + idx * sizeof(int32_t), dst + idx * sizeof(double), num - idx);
+}
+
+GE_AVX2_TARGET void TransDoubleToInt32Avx2(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const double *>(src);
+  auto dst_data = reinterpret_cast<__m128i *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    _mm_storeu_si128(dst_data + idx / 4, _mm256_cvttpd_epi32(_mm256_loadu_pd(src_data + idx)));
+  }
+  TransDataSrc2Dst<double, int32_t>(src + idx * sizeof(double), dst + idx * sizeof(int32_t), num - idx);
+}
+
+bool SupportVectorKernels() {
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+  // the avx2 check covers the os support of the ymm registers
+  return ((ecx & bit_F16C) != 0) && __builtin_cpu_supports("avx2");
+}
+#elif defined(__aarch64__)
+#define GE_VECTOR_CAST_KERNEL(avx2_func, neon_func) neon_func
+
+// the NEON kernels convert 4 elements per step, 16 for bytes
+inline uint32x4_t IsFp16Invalid(uint32x4_t data) {
+  const uint32x4_t exp_bits = vdupq_n_u32(kFp16ExpBits);
+  return vceqq_u32(vandq_u32(data, exp_bits), exp_bits);
+}
+
+inline bool AnyLane(uint32x4_t mask) { return vmaxvq_u32(mask) != 0; }
+
+void TransFloatToFp16Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const float *>(src);
+  auto dst_data = reinterpret_cast<uint16_t *>(dst);
+  const uint32x4_t abs_mask = vdupq_n_u32(0x7FFFFFFF);
+  const uint32x4_t overflow_bits = vdupq_n_u32(kFp32Fp16OverflowBits);
+  const uint32x4_t exp_overflow_bits = vdupq_n_u32(kFp32Fp16ExpOverflowBits);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    float32x4_t data = vld1q_f32(src_data + idx);
+    uint16x4_t result = vreinterpret_u16_f16(vcvt_f16_f32(data));
+    uint32x4_t bits = vreinterpretq_u32_f32(data);
+    uint32x4_t abs_bits = vandq_u32(bits, abs_mask);
+    uint32x4_t overflow = vcgeq_u32(abs_bits, overflow_bits);
+    if (AnyLane(overflow)) {
+      uint32x4_t exp_overflow = vcgeq_u32(abs_bits, exp_overflow_bits);
+      uint32x4_t saturated =
+          vbslq_u32(exp_overflow, vdupq_n_u32(kFp16MaxBits), vdupq_n_u32(kFp16ExpBits | kFp16ManBits));
+      uint32x4_t sign = vandq_u32(vshrq_n_u32(bits, 16), vdupq_n_u32(kFp16SignBit));
+      saturated = vorrq_u32(saturated, sign);
+      result = vbsl_u16(vmovn_u32(overflow), vmovn_u32(saturated), result);
+    }
+    vst1_u16(dst_data + idx, result);
+  }
+  TransDataSrc2Fp16<float>(src + idx * sizeof(float), dst + idx * sizeof(uint16_t), num - idx);
+}
+
+void TransFp16ToFloatNeon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const uint16_t *>(src);
+  auto dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    uint16x4_t data = vld1_u16(src_data + idx);
+    float32x4_t result = vcvt_f32_f16(vreinterpret_f16_u16(data));
+    uint32x4_t data_uint32 = vmovl_u16(data);
+    uint32x4_t invalid = IsFp16Invalid(data_uint32);
+    if (AnyLane(invalid)) {
+      uint32x4_t sign = vshlq_n_u32(vandq_u32(data_uint32, vdupq_n_u32(kFp16SignBit)), 16);
+      uint32x4_t man = vshlq_n_u32(vandq_u32(data_uint32, vdupq_n_u32(kFp16ManBits)), 13);
+      uint32x4_t value = vorrq_u32(vorrq_u32(sign, man), vdupq_n_u32(kFp16InvalidFp32ExpBits));
+      result = vbslq_f32(invalid, vreinterpretq_f32_u32(value), result);
+    }
+    vst1q_f32(dst_data + idx, result);
+  }
+  TransDataSrc2Dst<fp16_t, float>(src + idx * sizeof(uint16_t), dst + idx * sizeof(float), num - idx);
+}
+
+void TransFp16ToInt32Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const uint16_t *>(src);
+  auto dst_data = reinterpret_cast<int32_t *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    uint16x4_t data = vld1_u16(src_data + idx);
+    // fp16 values are exact in float, the conversion rounds to nearest even
+    int32x4_t result = vcvtnq_s32_f32(vcvt_f32_f16(vreinterpret_f16_u16(data)));
+    uint32x4_t data_uint32 = vmovl_u16(data);
+    uint32x4_t invalid = IsFp16Invalid(data_uint32);
+    if (AnyLane(invalid)) {
+      // INT32_MAX plus the sign bit
+      uint32x4_t value = vaddq_u32(vdupq_n_u32(INT32_MAX), vshrq_n_u32(data_uint32, 15));
+      result = vbslq_s32(invalid, vreinterpretq_s32_u32(value), result);
+    }
+    vst1q_s32(dst_data + idx, result);
+  }
+  TransDataSrc2Dst<fp16_t, int32_t>(src + idx * sizeof(uint16_t), dst + idx * sizeof(int32_t), num - idx);
+}
+
+void TransInt32ToFp16Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const int32_t *>(src);
+  auto dst_data = reinterpret_cast<uint16_t *>(dst);
+  const int32x4_t max_exact = vdupq_n_s32(kInt32Fp16MaxExact);
+  const int32x4_t min_exact = vdupq_n_s32(-kInt32Fp16MaxExact);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    int32x4_t data = vld1q_s32(src_data + idx);
+    // values in the range are exact in float, so there is only one rounding, to fp16
+    uint16x4_t result = vreinterpret_u16_f16(vcvt_f16_f32(vcvtq_f32_s32(data)));
+    uint32x4_t saturated = vorrq_u32(vcgtq_s32(data, max_exact), vcltq_s32(data, min_exact));
+    if (AnyLane(saturated)) {
+      uint32x4_t sign = vandq_u32(vshrq_n_u32(vreinterpretq_u32_s32(data), 16), vdupq_n_u32(kFp16SignBit));
+      uint32x4_t value = vorrq_u32(sign, vdupq_n_u32(kFp16MaxBits));
+      result = vbsl_u16(vmovn_u32(saturated), vmovn_u32(value), result);
+    }
+    vst1_u16(dst_data + idx, result);
+  }
+  TransDataSrc2Fp16<int32_t>(src + idx * sizeof(int32_t), dst + idx * sizeof(uint16_t), num - idx);
+}
+
+// float to int32 truncates and saturates like the scalar conversion of aarch64
+void TransFloatToInt32Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const float *>(src);
+  auto dst_data = reinterpret_cast<int32_t *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    vst1q_s32(dst_data + idx, vcvtq_s32_f32(vld1q_f32(src_data + idx)));
+  }
+  TransDataSrc2Dst<float, int32_t>(src + idx * sizeof(float), dst + idx * sizeof(int32_t), num - idx);
+}
+
+void TransInt32ToFloatNeon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const int32_t *>(src);
+  auto dst_data = reinterpret_cast<float *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    vst1q_f32(dst_data + idx, vcvtq_f32_s32(vld1q_s32(src_data + idx)));
+  }
+  TransDataSrc2Dst<int32_t, float>(src + idx * sizeof(int32_t), dst + idx * sizeof(float), num - idx);
+}
+
+// int32 to int8 and uint8 both keep the low byte
+template <typename DstT>
+void TransInt32ToByteNeon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const uint32_t *>(src);
+  size_t idx = 0;
+  for (; idx + 16 <= num; idx += 16) {
+    uint16x8_t low = vcombine_u16(vmovn_u32(vld1q_u32(src_data + idx)), vmovn_u32(vld1q_u32(src_data + idx + 4)));
+    uint16x8_t high =
+        vcombine_u16(vmovn_u32(vld1q_u32(src_data + idx + 8)), vmovn_u32(vld1q_u32(src_data + idx + 12)));
+    vst1q_u8(dst + idx, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+  }
+  TransDataSrc2Dst<int32_t, DstT>(src + idx * sizeof(int32_t), dst + idx, num - idx);
+}
+
+// 8 bytes widened to int32, the first 4 to low
+template <typename SrcT>
+void LoadBytesAsInt32(const uint8_t *src, int32x4_t &low, int32x4_t &high);
+
+template <>
+void LoadBytesAsInt32<uint8_t>(const uint8_t *src, int32x4_t &low, int32x4_t &high) {
+  uint16x8_t data = vmovl_u8(vld1_u8(src));
+  low = vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(data)));
+  high = vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(data)));
+}
+
+template <>
+void LoadBytesAsInt32<int8_t>(const uint8_t *src, int32x4_t &low, int32x4_t &high) {
+  int16x8_t data = vmovl_s8(vld1_s8(reinterpret_cast<const int8_t *>(src)));
+  low = vmovl_s16(vget_low_s16(data));
+  high = vmovl_s16(vget_high_s16(data));
+}
+
+template <typename SrcT>
+void TransByteToFloatNeon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto dst_data = reinterpret_cast<float *>(dst);
+  int32x4_t low;
+  int32x4_t high;
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    LoadBytesAsInt32<SrcT>(src + idx, low, high);
+    vst1q_f32(dst_data + idx, vcvtq_f32_s32(low));
+    vst1q_f32(dst_data + idx + 4, vcvtq_f32_s32(high));
+  }
+  TransDataSrc2Dst<SrcT, float>(src + idx, dst + idx * sizeof(float), num - idx);
+}
+
+template <typename SrcT>
+void TransByteToInt32Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto dst_data = reinterpret_cast<int32_t *>(dst);
+  int32x4_t low;
+  int32x4_t high;
+  size_t idx = 0;
+  for (; idx + 8 <= num; idx += 8) {
+    LoadBytesAsInt32<SrcT>(src + idx, low, high);
+    vst1q_s32(dst_data + idx, low);
+    vst1q_s32(dst_data + idx + 4, high);
+  }
+  TransDataSrc2Dst<SrcT, int32_t>(src + idx, dst + idx * sizeof(int32_t), num - idx);
+}
+
+void TransInt64ToInt32Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const int64_t *>(src);
+  auto dst_data = reinterpret_cast<int32_t *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    int32x4_t result = vcombine_s32(vmovn_s64(vld1q_s64(src_data + idx)), vmovn_s64(vld1q_s64(src_data + idx + 2)));
+    vst1q_s32(dst_data + idx, result);
+  }
+  TransDataSrc2Dst<int64_t, int32_t>(src + idx * sizeof(int64_t), dst + idx * sizeof(int32_t), num - idx);
+}
+
+void TransInt32ToInt64Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const int32_t *>(src);
+  auto dst_data = reinterpret_cast<int64_t *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    int32x4_t data = vld1q_s32(src_data + idx);
+    vst1q_s64(dst_data + idx, vmovl_s32(vget_low_s32(data)));
+    vst1q_s64(dst_data + idx + 2, vmovl_s32(vget_high_s32(data)));
+  }
+  TransDataSrc2Dst<int32_t, int64_t>(src + idx * sizeof(int32_t), dst + idx * sizeof(int64_t), num - idx);
+}
+
+void TransInt32ToDoubleNeon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const int32_t *>(src);
+  auto dst_data = reinterpret_cast<double *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    int32x4_t data = vld1q_s32(src_data + idx);
+    vst1q_f64(dst_data + idx, vcvtq_f64_s64(vmovl_s32(vget_low_s32(data))));
+    vst1q_f64(dst_data + idx + 2, vcvtq_f64_s64(vmovl_s32(vget_high_s32(data))));
+  }
+  TransDataSrc2Dst<int32_t, double>(src + idx * sizeof(int32_t), dst + idx * sizeof(double), num - idx);
+}
+
+// double to int32 truncates and saturates like the scalar conversion of aarch64, in int64 and then to int32
+void TransDoubleToInt32Neon(const uint8_t *src, uint8_t *dst, size_t num) {
+  auto src_data = reinterpret_cast<const double *>(src);
+  auto dst_data = reinterpret_cast<int32_t *>(dst);
+  size_t idx = 0;
+  for (; idx + 4 <= num; idx += 4) {
+    int32x2_t low = vqmovn_s64(vcvtq_s64_f64(vld1q_f64(src_data + idx)));
+    int32x2_t high = vqmovn_s64(vcvtq_s64_f64(vld1q_f64(src_data + idx + 2)));
+    vst1q_s32(dst_data + idx, vcombine_s32(low, high));
+  }
+  TransDataSrc2Dst<double, int32_t>(src + idx * sizeof(double), dst + idx * sizeof(int32_t), num - idx);
+}
+
+// NEON is a mandatory part of armv8-a
+bool SupportVectorKernels() { return true; }
+#else
+#define GE_VECTOR_CAST_KERNEL(avx2_func, neon_func) nullptr
+
+bool SupportVectorKernels() { return false; }
+#endif
+
+const std::map<DataTypeTransMode, CastKernel> &GetCastKernels() {
+  static const std::map<DataTypeTransMode, CastKernel> cast_kernels = {
+    {kTransferWithDatatypeFloatToFloat16,
+     {sizeof(float), sizeof(uint16_t), TransDataSrc2Fp16<float>,
+      GE_VECTOR_CAST_KERNEL(TransFloatToFp16Avx2, TransFloatToFp16Neon)}},
+    {kTransferWithDatatypeFloatToInt32,
+     {sizeof(float), sizeof(int32_t), TransDataSrc2Dst<float, int32_t>,
+      GE_VECTOR_CAST_KERNEL(TransFloatToInt32Avx2, TransFloatToInt32Neon)}},
+    {kTransferWithDatatypeFloat16ToFloat,
+     {sizeof(uint16_t), sizeof(float), TransDataSrc2Dst<fp16_t, float>,
+      GE_VECTOR_CAST_KERNEL(TransFp16ToFloatAvx2, TransFp16ToFloatNeon)}},
+    {kTransferWithDatatypeFloat16ToInt32,
+     {sizeof(uint16_t), sizeof(int32_t), TransDataSrc2Dst<fp16_t, int32_t>,
+      GE_VECTOR_CAST_KERNEL(TransFp16ToInt32Avx2, TransFp16ToInt32Neon)}},
+    {kTransferWithDatatypeInt32ToFloat,
+     {sizeof(int32_t), sizeof(float), TransDataSrc2Dst<int32_t, float>,
+      GE_VECTOR_CAST_KERNEL(TransInt32ToFloatAvx2, TransInt32ToFloatNeon)}},
+    {kTransferWithDatatypeInt32ToFloat16,
+     {sizeof(int32_t), sizeof(uint16_t), TransDataSrc2Fp16<int32_t>,
+      GE_VECTOR_CAST_KERNEL(TransInt32ToFp16Avx2, TransInt32ToFp16Neon)}},
+    {kTransferWithDatatypeInt32ToUint8,
+     {sizeof(int32_t), sizeof(uint8_t), TransDataSrc2Dst<int32_t, uint8_t>,
+      GE_VECTOR_CAST_KERNEL(TransInt32ToByteAvx2<uint8_t>, TransInt32ToByteNeon<uint8_t>)}},
+    {kTransferWithDatatypeInt32ToInt8,
+     {sizeof(int32_t), sizeof(int8_t), TransDataSrc2Dst<int32_t, int8_t>,
+      GE_VECTOR_CAST_KERNEL(TransInt32ToByteAvx2<int8_t>, TransInt32ToByteNeon<int8_t>)}},
+    {kTransferWithDatatypeUint8ToFloat,
+     {sizeof(uint8_t), sizeof(float), TransDataSrc2Dst<uint8_t, float>,
+      GE_VECTOR_CAST_KERNEL(TransByteToFloatAvx2<uint8_t>, TransByteToFloatNeon<uint8_t>)}},
+    {kTransferWithDatatypeUint8ToInt32,
+     {sizeof(uint8_t), sizeof(int32_t), TransDataSrc2Dst<uint8_t, int32_t>,
+      GE_VECTOR_CAST_KERNEL(TransByteToInt32Avx2<uint8_t>, TransByteToInt32Neon<uint8_t>)}},
+    {kTransferWithDatatypeInt8ToFloat,
+     {sizeof(int8_t), sizeof(float), TransDataSrc2Dst<int8_t, float>,
+      GE_VECTOR_CAST_KERNEL(TransByteToFloatAvx2<int8_t>, TransByteToFloatNeon<int8_t>)}},
+    {kTransferWithDatatypeInt8ToInt32,
+     {sizeof(int8_t), sizeof(int32_t), TransDataSrc2Dst<int8_t, int32_t>,
+      GE_VECTOR_CAST_KERNEL(TransByteToInt32Avx2<int8_t>, TransByteToInt32Neon<int8_t>)}},
+    {kTransferWithDatatypeInt64ToInt32,
+     {sizeof(int64_t), sizeof(int32_t), TransDataSrc2Dst<int64_t, int32_t>,
+      GE_VECTOR_CAST_KERNEL(TransInt64ToInt32Avx2, TransInt64ToInt32Neon)}},
+    {kTransferWithDatatypeInt32ToInt64,
+     {sizeof(int32_t), sizeof(int64_t), TransDataSrc2Dst<int32_t, int64_t>,
+      GE_VECTOR_CAST_KERNEL(TransInt32ToInt64Avx2, TransInt32ToInt64Neon)}},
+    {kTransferWithDatatypeInt32ToDouble,
+     {sizeof(int32_t), sizeof(double), TransDataSrc2Dst<int32_t, double>,
+      GE_VECTOR_CAST_KERNEL(TransInt32ToDoubleAvx2, TransInt32ToDoubleNeon)}},
+    {kTransferWithDatatypeDoubleToInt32,
+     {sizeof(double), sizeof(int32_t), TransDataSrc2Dst<double, int32_t>,
+      GE_VECTOR_CAST_KERNEL(TransDoubleToInt32Avx2, TransDoubleToInt32Neon)}},
+  };
+  return cast_kernels;
+}
+
+// Splits large buffers into chunks converted by tasks of the scheduler, the last chunk on the calling thread.
+void RunCastFunc(const CastKernel &kernel, CastFunc func, const uint8_t *src, uint8_t *dst, size_t data_size) {
+  auto &scheduler = TaskScheduler::GetInstance();
+  size_t task_num = std::min(static_cast<size_t>(scheduler.GetWorkerNum()) + 1, kMaxCastTaskNum);
+  task_num = std::min(task_num, data_size / kParallelMinElemNum);
+  if (task_num <= 1) {
+    func(src, dst, data_size);
+    return;
+  }
+
+  size_t chunk_size = (data_size + task_num - 1) / task_num;
+  chunk_size = (chunk_size + kCastChunkAlign - 1) / kCastChunkAlign * kCastChunkAlign;
+  TaskGroup group(TaskPriority::kNormal, scheduler);
+  size_t begin = 0;
+  for (; begin + chunk_size < data_size; begin += chunk_size) {
+    const uint8_t *chunk_src = src + begin * kernel.src_size;
+    uint8_t *chunk_dst = dst + begin * kernel.dst_size;
+    auto future = group.Commit(func, chunk_src, chunk_dst, chunk_size);
+    if (!future.valid()) {
+      GELOGW("Failed to commit a task to cast data, cast on the current thread.");
+      func(chunk_src, chunk_dst, chunk_size);
+    }
+  }
+  func(src + begin * kernel.src_size, dst + begin * kernel.dst_size, data_size - begin);
+  group.Wait();
+}
+
+Status CastData(const CastArgs &args, uint8_t *dst, const size_t data_size, const DataTypeTransMode trans_mode) {
+  static const bool use_vector = SupportVectorKernels();
+  const auto &cast_kernels = GetCastKernels();
+  auto it = cast_kernels.find(trans_mode);
+  if (it == cast_kernels.end()) {
     return UNSUPPORTED;
-  } else {
-    return (it->second)(args, dst, data_size);
   }
+  const auto &kernel = it->second;
+  CastFunc func = (use_vector && kernel.vector_func != nullptr) ? kernel.vector_func : kernel.scalar_func;
+  RunCastFunc(kernel, func, args.data, dst, data_size);
+  return SUCCESS;
 }
 }  // namespace
 
@@ -153,7 +724,7 @@ Status DataTypeTransfer::TransDataType(const CastArgs &args, TransResult &result
     return OUT_OF_MEMORY;
   }
 
-  if (CastKernel(args, dst.get(), args.src_data_size, trans_mode) != SUCCESS) {
+  if (CastData(args, dst.get(), args.src_data_size, trans_mode) != SUCCESS) {
     GELOGE(INTERNAL_ERROR, "Failed to cast data from %s to %s, data size %zu",
            TypeUtils::DataTypeToSerialString(args.src_data_type).c_str(),
            TypeUtils::DataTypeToSerialString(args.dst_data_type).c_str(), args.src_data_size);
@@ -43,6 +43,7 @@ GE_COMMON_LOCAL_SRC_FILES := \
     op/attr_value_util.cc \
     op/ge_op_utils.cc \
     thread_pool.cc \
+    task_scheduler.cc \
     ge/tbe_plugin_manager.cc \
 
 GE_COMMON_LOCAL_C_INCLUDES := \
@@ -16,6 +16,10 @@
 
 #include "framework/common/helper/model_helper.h"
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+
 #include "common/ge/ge_util.h"
 #include "common/util/error_manager/error_manager.h"
 #include "framework/common/debug/log.h"
@@ -416,8 +420,14 @@ Status ModelHelper::LoadWeights(OmFileLoadHelper &om_load_helper) {
     GELOGE(FAILED, "Get weight model partition failed.");
     return FAILED;
   }
-  ge::Buffer weight = ge::Buffer::CopyFrom(partition.data, partition.size);
-  model_->SetWeight(weight);
+  std::shared_ptr<void> holder = ModelParserBase::GetMappedModelHolder(partition.data);
+  if (holder != nullptr) {
+    // the weights are uploaded to device straight from the mapped pages
+    model_->SetWeightData(holder, partition.data, partition.size);
+  } else {
+    ge::Buffer weight = ge::Buffer::CopyFrom(partition.data, partition.size);
+    model_->SetWeight(weight);
+  }
 
   GELOGI("GetWeight size:%u", partition.size);
   return SUCCESS;
@@ -429,6 +439,21 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadTask(Om
     GELOGE(FAILED, "Get task model partition failed.");
     return FAILED;
   }
+  GE_CHK_STATUS_RET(LoadTaskPartition(task_partition, *model_), "Load task partition failed.");
+  GELOGI("TASK_INFO partition size:%u", task_partition.size);
+  return SUCCESS;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status
+ModelHelper::LoadTaskPartition(const ModelPartition &task_partition, GeModel &ge_model) {
+  std::shared_ptr<void> holder = ModelParserBase::GetMappedModelHolder(task_partition.data);
+  if (holder != nullptr) {
+    // the mapped pages are shared, the tasks are decoded by the first GeModel::GetModelTaskDefPtr
+    ge_model.SetModelTaskData(holder, task_partition.data, task_partition.size);
+    return SUCCESS;
+  }
+
+  // the buffer of the caller may be freed after the load, decode it now instead of keeping a copy
   std::shared_ptr<ModelTaskDef> task = ge::MakeShared<ModelTaskDef>();
   GE_CHECK_NOTNULL(task);
   if (task_partition.size != 0) {
@@ -438,16 +463,54 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadTask(Om
     }
     GELOGI("TASK_INFO op_size:%zu, stream_num:%u", task->op().size(), task->stream_num());
   }
-  model_->SetModelTaskDef(task);
+  ge_model.SetModelTaskDef(task);
+  return SUCCESS;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelHelper::LoadTaskMeta(const ModelPartition &task_partition,
+                                                                                   ModelTaskDef &task_meta) {
+  task_meta.Clear();
+  if (task_partition.size == 0) {
+    return SUCCESS;
+  }
+  GE_CHECK_NOTNULL(task_partition.data);
+
+  using google::protobuf::internal::WireFormatLite;
+  google::protobuf::io::CodedInputStream input(task_partition.data, static_cast<int>(task_partition.size));
+  input.SetTotalBytesLimit(INT_MAX, INT_MAX);
+  std::string meta;
+  {
+    google::protobuf::io::StringOutputStream meta_stream(&meta);
+    google::protobuf::io::CodedOutputStream output(&meta_stream);
+    for (uint32_t tag = input.ReadTag(); tag != 0; tag = input.ReadTag()) {
+      int field_number = WireFormatLite::GetTagFieldNumber(tag);
+      bool is_skipped =
+        (field_number == ModelTaskDef::kTaskFieldNumber) || (field_number == ModelTaskDef::kOpFieldNumber);
+      bool ret = is_skipped ? WireFormatLite::SkipField(&input, tag) : WireFormatLite::SkipField(&input, tag, &output);
+      if (!ret) {
+        GELOGE(INTERNAL_ERROR, "Parse field %d of task partition failed.", field_number);
+        return INTERNAL_ERROR;
+      }
+    }
+  }
+  if (!task_meta.ParseFromString(meta)) {
+    GELOGE(INTERNAL_ERROR, "Parse meta of task partition failed.");
+    return INTERNAL_ERROR;
+  }
   return SUCCESS;
 }
 
 Status ModelHelper::LoadTBEKernelStore(OmFileLoadHelper &om_load_helper) {
-  // Load tbe kernels
+  // tbe kernels of mapped files are loaded by the first GeModel::GetTBEKernelStore
   ModelPartition partition_kernel_def;
   TBEKernelStore kernel_store;
   if (om_load_helper.GetModelPartition(ModelPartitionType::TBE_KERNELS, partition_kernel_def) == SUCCESS) {
     GELOGI("Kernels partition size:%u", partition_kernel_def.size);
+    std::shared_ptr<void> holder = ModelParserBase::GetMappedModelHolder(partition_kernel_def.data);
+    if (holder != nullptr) {
+      model_->SetTBEKernelData(holder, partition_kernel_def.data, partition_kernel_def.size);
+      return SUCCESS;
+    }
     if (kernel_store.Load(partition_kernel_def.data, partition_kernel_def.size)) {
       GELOGI("Load tbe kernels success");
     } else {
@@ -459,11 +522,16 @@ Status ModelHelper::LoadTBEKernelStore(OmFileLoadHelper &om_load_helper) {
 }
 
 Status ModelHelper::LoadCustAICPUKernelStore(OmFileLoadHelper &om_load_helper) {
-  // Load cust aicpu kernels
+  // cust aicpu kernels of mapped files are loaded by the first GeModel::GetCustAICPUKernelStore
   ModelPartition partition_kernel_def;
   CustAICPUKernelStore kernel_store;
   if (om_load_helper.GetModelPartition(ModelPartitionType::CUST_AICPU_KERNELS, partition_kernel_def) == SUCCESS) {
     GELOGI("Kernels partition size:%u", partition_kernel_def.size);
+    std::shared_ptr<void> holder = ModelParserBase::GetMappedModelHolder(partition_kernel_def.data);
+    if (holder != nullptr) {
+      model_->SetCustAICPUKernelData(holder, partition_kernel_def.data, partition_kernel_def.size);
+      return SUCCESS;
+    }
     if (kernel_store.Load(partition_kernel_def.data, partition_kernel_def.size)) {
       GELOGI("Load cust aicpu kernels success");
     } else {
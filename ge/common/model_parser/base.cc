@@ -16,10 +16,19 @@
 
 #include "common/model_parser/base.h"
 #include "common/helper/model_helper.h"
+#include <fcntl.h>
 #include <securec.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/sysinfo.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "framework/common/debug/ge_log.h"
@@ -27,6 +36,12 @@
 #include "framework/common/util.h"
 
 namespace ge {
+namespace {
+// mapped model files by start address, the holders unmap the file when the last owner is released
+std::mutex mapped_models_mutex;
+std::map<const uint8_t *, std::pair<size_t, std::shared_ptr<void>>> mapped_models;
+}  // namespace
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelParserBase::ModelParserBase() {}
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelParserBase::~ModelParserBase() {}
 
@@ -73,6 +88,89 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::LoadFro
   return SUCCESS;
 }
 
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::MapFromFile(const char *model_path,
+                                                                                     const char *key, int32_t priority,
+                                                                                     ge::ModelData &model_data) {
+  std::string real_path = RealPath(model_path);
+  if (real_path.empty()) {
+    GELOGE(GE_EXEC_MODEL_PATH_INVALID, "Model file path '%s' is invalid", model_path);
+    return GE_EXEC_MODEL_PATH_INVALID;
+  }
+
+  int fd = open(real_path.c_str(), O_RDONLY);
+  GE_CHK_BOOL_RET_STATUS(fd >= 0, GE_EXEC_READ_MODEL_FILE_FAILED, "Open file failed! path:%s, %s", model_path,
+                         strerror(errno));
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0 || file_stat.st_size > UINT32_MAX) {
+    GELOGE(GE_EXEC_READ_MODEL_FILE_FAILED, "File size not valid, path:%s", model_path);
+    (void)close(fd);
+    return GE_EXEC_READ_MODEL_FILE_FAILED;
+  }
+  size_t len = static_cast<size_t>(file_stat.st_size);
+
+  // private writable mapping, the pages stay shared with the page cache unless somebody writes to them
+  void *data = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (data == MAP_FAILED) {
+    GELOGE(GE_EXEC_READ_MODEL_FILE_FAILED, "Map file failed! path:%s, size:%zu, %s", model_path, len,
+           strerror(errno));
+    return GE_EXEC_READ_MODEL_FILE_FAILED;
+  }
+  // the partitions are read once from the beginning to the end, ask the kernel to read ahead aggressively
+  (void)madvise(data, len, MADV_SEQUENTIAL);
+  (void)madvise(data, len, MADV_WILLNEED);
+
+  std::shared_ptr<void> holder(data, [len](void *addr) { (void)munmap(addr, len); });
+  {
+    std::lock_guard<std::mutex> lock(mapped_models_mutex);
+    mapped_models[static_cast<const uint8_t *>(data)] = std::make_pair(len, holder);
+  }
+
+  ModelHelper model_helper;
+  model_helper.GetBaseNameFromFileName(model_path, model_data.om_name);
+  model_data.model_data = data;
+  model_data.model_len = static_cast<uint32_t>(len);
+  model_data.priority = priority;
+  model_data.key = (key == nullptr) ? "" : key;
+  GELOGI("Model file %s mapped, size = %zu", model_path, len);
+  return SUCCESS;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY std::shared_ptr<void> ModelParserBase::GetMappedModelHolder(
+  const void *addr) {
+  auto data = static_cast<const uint8_t *>(addr);
+  std::lock_guard<std::mutex> lock(mapped_models_mutex);
+  auto it = mapped_models.upper_bound(data);
+  if (it == mapped_models.begin()) {
+    return nullptr;
+  }
+  --it;
+  if (data >= it->first + it->second.first) {
+    return nullptr;
+  }
+  return it->second.second;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void ModelParserBase::ReleaseModelData(ge::ModelData &model_data) {
+  if (model_data.model_data == nullptr) {
+    return;
+  }
+  std::shared_ptr<void> holder;
+  {
+    std::lock_guard<std::mutex> lock(mapped_models_mutex);
+    auto it = mapped_models.find(static_cast<const uint8_t *>(model_data.model_data));
+    if (it != mapped_models.end()) {
+      // the file is unmapped when the models sharing the mapped weights are released as well
+      holder = it->second.second;
+      (void)mapped_models.erase(it);
+    }
+  }
+  if (holder == nullptr) {
+    delete[] static_cast<char *>(model_data.model_data);
+  }
+  model_data.model_data = nullptr;
+}
+
 FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status ModelParserBase::ParseModelContent(const ge::ModelData &model,
                                                                                            uint8_t *&model_data,
                                                                                            uint32_t &model_len) {
@@ -63,6 +63,34 @@ class ModelParserBase {
    * @author
    */
   static Status ParseModelContent(const ge::ModelData &model, uint8_t *&model_data, uint32_t &model_len);
+
+  /**
+   * @ingroup domi_ome
+   * @brief Map a model file into memory instead of reading it into a heap buffer.
+   * The pages are shared with the page cache and the other processes mapping the same file.
+   * @param [in] model_file  model path
+   * @param [in] model_key   model secret key
+   * @param [in] priority    modle priority
+   * @param [out] model_data model data, must be released by ReleaseModelData
+   * @return Status  result
+   */
+  static Status MapFromFile(const char *model_file, const char *model_key, int32_t priority,
+                            ge::ModelData &model_data);
+
+  /**
+   * @ingroup domi_ome
+   * @brief Get an owner of the mapping which contains the address
+   * @param [in] addr  address in the model data
+   * @return nullptr if the address is not in a mapped model
+   */
+  static std::shared_ptr<void> GetMappedModelHolder(const void *addr);
+
+  /**
+   * @ingroup domi_ome
+   * @brief Release the model data loaded by LoadFromFile or MapFromFile
+   * @param [in|out] model_data model data
+   */
+  static void ReleaseModelData(ge::ModelData &model_data);
 };
 }  //  namespace ge
 #endif  // GE_COMMON_MODEL_PARSER_BASE_H_
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_MPSC_QUEUE_H_
+#define GE_COMMON_MPSC_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace ge {
+///
+/// Unbounded queue with many producers and a single consumer.
+/// Push and Pop do not take a lock, the consumer only sleeps on the condition variable when the queue stays empty
+/// for a while, and producers only notify it if it is sleeping.
+///
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_), is_stopped_(false), is_sleeping_(false) {}
+
+  ~MpscQueue() {
+    T item;
+    while (TryPop(item)) {
+    }
+  }
+
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  bool Push(T item) {
+    if (is_stopped_.load()) {
+      return false;
+    }
+    auto node = new (std::nothrow) Node(std::move(item));
+    if (node == nullptr) {
+      return false;
+    }
+    PushNode(node);
+    if (is_sleeping_.load()) {
+      std::lock_guard<std::mutex> lk(mu_);
+      cv_.notify_one();
+    }
+    return true;
+  }
+
+  ///
+  /// Blocking pop, called by the consumer thread only
+  /// @return false if the queue was stopped
+  ///
+  bool Pop(T &item) {
+    uint32_t spin_count = 0;
+    while (!is_stopped_.load()) {
+      if (TryPop(item)) {
+        return true;
+      }
+      if (++spin_count < kSpinCount) {
+        std::this_thread::yield();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lk(mu_);
+      is_sleeping_.store(true);
+      cv_.wait(lk, [this]() { return is_stopped_.load() || !IsEmpty(); });
+      is_sleeping_.store(false);
+      spin_count = 0;
+    }
+    return false;
+  }
+
+  void Stop() {
+    is_stopped_.store(true);
+    std::lock_guard<std::mutex> lk(mu_);
+    cv_.notify_all();
+  }
+
+ private:
+  struct Node {
+    Node() : next(nullptr) {}
+    explicit Node(T &&value) : item(std::move(value)), next(nullptr) {}
+    T item;
+    std::atomic<Node *> next;
+  };
+
+  static const uint32_t kSpinCount = 64;
+
+  void PushNode(Node *node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node *prev = head_.exchange(node);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  bool IsEmpty() const { return tail_->next.load(std::memory_order_acquire) == nullptr && head_.load() == tail_; }
+
+  bool TryPop(T &item) {
+    Node *tail = tail_;
+    Node *next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) {
+        return false;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      item = std::move(tail->item);
+      delete tail;
+      return true;
+    }
+    if (tail != head_.load()) {
+      // a producer is between the exchange and the link, retry later
+      return false;
+    }
+    PushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      item = std::move(tail->item);
+      delete tail;
+      return true;
+    }
+    return false;
+  }
+
+  Node stub_;
+  std::atomic<Node *> head_;
+  Node *tail_;
+  std::atomic<bool> is_stopped_;
+  std::atomic<bool> is_sleeping_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_MPSC_QUEUE_H_
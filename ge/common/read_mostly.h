@@ -0,0 +1,120 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_READ_MOSTLY_H_
+#define GE_COMMON_READ_MOSTLY_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace ge {
+///
+/// Value which is read by many threads and rarely replaced.
+/// Readers neither take a lock nor touch a shared reference count, they only increase and decrease a counter of
+/// their own shard. Update publishes the new value, then waits until the readers of the old value have left
+/// before deleting it, the same way as a sleepable RCU. Updates must be serialized by the caller.
+///
+template <typename T>
+class ReadMostly {
+ public:
+  ReadMostly() : value_(new (std::nothrow) T()), epoch_(0) {
+    for (auto &shard : shards_) {
+      shard.readers[0].store(0);
+      shard.readers[1].store(0);
+    }
+  }
+
+  ~ReadMostly() { delete value_.load(); }
+
+  ReadMostly(const ReadMostly &) = delete;
+  ReadMostly &operator=(const ReadMostly &) = delete;
+
+  ///
+  /// Call `func` with the current value. `func` must be short and must not call Update
+  /// @return false if there is no value
+  ///
+  template <typename Func>
+  bool Read(Func &&func) const {
+    ReadGuard guard(*this);
+    const T *value = value_.load();
+    if (value == nullptr) {
+      return false;
+    }
+    func(*value);
+    return true;
+  }
+
+  ///
+  /// Replace the value, the old one is deleted when no reader can see it any more
+  ///
+  void Update(std::unique_ptr<T> value) {
+    T *old_value = value_.exchange(value.release());
+    // a reader may pick the shard counter of the current epoch just before it is flipped, wait for both
+    WaitForReaders();
+    WaitForReaders();
+    delete old_value;
+  }
+
+ private:
+  static const size_t kShardNum = 32;
+  static const size_t kCacheLineSize = 64;
+
+  // one shard per cache line, readers of different shards never write the same line
+  struct alignas(kCacheLineSize) ReaderShard {
+    std::atomic<int64_t> readers[2];
+  };
+
+  class ReadGuard {
+   public:
+    explicit ReadGuard(const ReadMostly &owner)
+        : shard_(owner.shards_[GetShardIndex()]), parity_(owner.epoch_.load() & 1U) {
+      shard_.readers[parity_].fetch_add(1);
+    }
+    ~ReadGuard() { shard_.readers[parity_].fetch_sub(1); }
+
+   private:
+    ReaderShard &shard_;
+    size_t parity_;
+  };
+
+  static size_t GetShardIndex() {
+    static std::atomic<size_t> next_index(0);
+    thread_local size_t index = next_index.fetch_add(1) % kShardNum;
+    return index;
+  }
+
+  void WaitForReaders() {
+    // new readers use the other counter from now on, so the counters of the old epoch only decrease
+    size_t parity = epoch_.fetch_add(1) & 1U;
+    for (auto &shard : shards_) {
+      while (shard.readers[parity].load() != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  std::atomic<T *> value_;
+  std::atomic<uint64_t> epoch_;
+  mutable ReaderShard shards_[kShardNum];
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_READ_MOSTLY_H_
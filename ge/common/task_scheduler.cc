@@ -0,0 +1,227 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/task_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "register/register_types.h"
+
+namespace ge {
+namespace {
+// graph compile tasks may block inside engines, keep at least as many workers as the old per-call pool
+const uint32_t kMinWorkerNum = 16;
+const uint32_t kPriorityNum = static_cast<uint32_t>(TaskPriority::kPriorityNum);
+const int64_t kHelpWaitIntervalUs = 100;
+
+thread_local TaskScheduler *current_scheduler = nullptr;
+thread_local uint32_t current_worker_id = 0;
+}  // namespace
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TaskScheduler &TaskScheduler::GetInstance() {
+  static TaskScheduler instance(std::max(std::thread::hardware_concurrency(), kMinWorkerNum));
+  return instance;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TaskScheduler::TaskScheduler(uint32_t worker_num)
+    : queues_(worker_num < 1 ? 1 : worker_num), is_stopped_(false), next_queue_(0), pending_num_(0), sleeping_num_(0) {
+  worker_num = static_cast<uint32_t>(queues_.size());
+  for (uint32_t i = 0; i < worker_num; ++i) {
+    workers_.emplace_back(&TaskScheduler::WorkerFunc, this, i);
+  }
+  GELOGI("Task scheduler started with %u workers.", worker_num);
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TaskScheduler::~TaskScheduler() {
+  is_stopped_.store(true);
+  // a Push holding a queue lock has checked the flag before it was set, wait until it has counted its task, so that
+  // the workers see it before they leave. Pushes taking the lock after this see the flag and fail
+  for (auto &queue : queues_) {
+    std::lock_guard<std::mutex> lock(queue.mu);
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mu_);
+    sleep_cv_.notify_all();
+  }
+
+  for (std::thread &thd : workers_) {
+    if (thd.joinable()) {
+      try {
+        thd.join();
+      } catch (const std::system_error &) {
+        GELOGW("system_error");
+      } catch (...) {
+        GELOGW("exception");
+      }
+    }
+  }
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY bool TaskScheduler::Push(TaskPriority priority, ThreadTask task,
+                                                                         const void *owner) {
+  uint32_t prio = std::min(static_cast<uint32_t>(priority), kPriorityNum - 1);
+  // keep tasks spawned by a worker local to it, spread the others round robin
+  uint32_t queue_id = (current_scheduler == this) ? current_worker_id
+                                                    : next_queue_.fetch_add(1) % static_cast<uint32_t>(queues_.size());
+  WorkQueue &queue = queues_[queue_id];
+  {
+    // checked and counted under the queue lock, the destructor waits on it before the workers may leave
+    std::lock_guard<std::mutex> lock(queue.mu);
+    if (is_stopped_.load()) {
+      GELOGE(FAILED, "task scheduler has been stopped.");
+      return false;
+    }
+    queue.tasks[prio].emplace_back(QueuedTask{std::move(task), owner});
+    pending_num_.fetch_add(1);
+  }
+  if (sleeping_num_.load() > 0) {
+    { std::lock_guard<std::mutex> lock(sleep_mu_); }
+    sleep_cv_.notify_one();
+  }
+  return true;
+}
+
+bool TaskScheduler::TryPopFrom(WorkQueue &queue, uint32_t priority, const void *owner, ThreadTask &task) {
+  std::lock_guard<std::mutex> lock(queue.mu);
+  auto &tasks = queue.tasks[priority];
+  auto it = tasks.begin();
+  if (owner != nullptr) {
+    it = std::find_if(tasks.begin(), tasks.end(), [owner](const QueuedTask &queued) { return queued.owner == owner; });
+  }
+  if (it == tasks.end()) {
+    return false;
+  }
+  task = std::move(it->task);
+  tasks.erase(it);
+  return true;
+}
+
+bool TaskScheduler::TryPop(uint32_t worker_id, const void *owner, ThreadTask &task) {
+  if (pending_num_.load() <= 0) {
+    return false;
+  }
+  uint32_t queue_num = static_cast<uint32_t>(queues_.size());
+  for (uint32_t prio = 0; prio < kPriorityNum; ++prio) {
+    // own queue first, then steal from siblings
+    for (uint32_t i = 0; i < queue_num; ++i) {
+      if (TryPopFrom(queues_[(worker_id + i) % queue_num], prio, owner, task)) {
+        pending_num_.fetch_sub(1);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY bool TaskScheduler::RunPendingTask(const void *owner) {
+  if (owner == nullptr) {
+    return false;
+  }
+  ThreadTask task;
+  uint32_t worker_id = (current_scheduler == this) ? current_worker_id : 0;
+  if (!TryPop(worker_id, owner, task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY bool TaskScheduler::IsWorkerThread() const {
+  return current_scheduler == this;
+}
+
+void TaskScheduler::WorkerFunc(uint32_t worker_id) {
+  current_scheduler = this;
+  current_worker_id = worker_id;
+  while (true) {
+    ThreadTask task;
+    if (TryPop(worker_id, nullptr, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mu_);
+    sleeping_num_.fetch_add(1);
+    sleep_cv_.wait(lock, [this] { return is_stopped_.load() || pending_num_.load() > 0; });
+    sleeping_num_.fetch_sub(1);
+    if (is_stopped_.load() && pending_num_.load() <= 0) {
+      return;
+    }
+  }
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TaskGroup::TaskGroup(TaskPriority priority, TaskScheduler &scheduler)
+    : priority_(priority), scheduler_(scheduler), state_(ge::MakeShared<State>(scheduler, priority)) {}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY TaskGroup::~TaskGroup() { Wait(); }
+
+void TaskGroup::OnTaskCommitted() {
+  std::lock_guard<std::mutex> lock(state_->mu);
+  ++state_->pending_num;
+}
+
+void TaskGroup::OnTaskDone(const std::shared_ptr<State> &state) {
+  std::vector<ThreadTask> continuations;
+  {
+    std::lock_guard<std::mutex> lock(state->mu);
+    if (--state->pending_num == 0) {
+      continuations.swap(state->continuations);
+    }
+    state->cv.notify_all();
+  }
+  for (auto &continuation : continuations) {
+    if (!state->scheduler.Push(state->priority, std::move(continuation))) {
+      GELOGE(FAILED, "Failed to schedule continuation.");
+    }
+  }
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void TaskGroup::Then(ThreadTask continuation) {
+  {
+    std::lock_guard<std::mutex> lock(state_->mu);
+    if (state_->pending_num > 0) {
+      state_->continuations.emplace_back(std::move(continuation));
+      return;
+    }
+  }
+  if (!scheduler_.Push(priority_, std::move(continuation))) {
+    GELOGE(FAILED, "Failed to schedule continuation.");
+  }
+}
+
+FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY void TaskGroup::Wait() {
+  if (state_ == nullptr) {
+    return;
+  }
+  bool help = scheduler_.IsWorkerThread();
+  std::unique_lock<std::mutex> lock(state_->mu);
+  while (state_->pending_num > 0) {
+    if (!help) {
+      state_->cv.wait(lock);
+      continue;
+    }
+    // a blocked worker would shrink the pool, run the queued tasks of this group instead. Tasks of other groups
+    // are not run here: they would see the thread local contexts of the task that is waiting
+    lock.unlock();
+    bool executed = scheduler_.RunPendingTask(state_.get());
+    lock.lock();
+    if (!executed && state_->pending_num > 0) {
+      state_->cv.wait_for(lock, std::chrono::microseconds(kHelpWaitIntervalUs));
+    }
+  }
+}
+}  // namespace ge
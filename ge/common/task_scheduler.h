@@ -0,0 +1,211 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_COMMON_TASK_SCHEDULER_H_
+#define GE_COMMON_TASK_SCHEDULER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/ge_inner_error_codes.h"
+#include "external/ge/ge_api_error_codes.h"
+#include "graph/types.h"
+#include "common/ge/ge_util.h"
+
+namespace ge {
+using ThreadTask = std::function<void()>;
+
+enum class TaskPriority : uint32_t {
+  kHigh = 0,
+  kNormal,
+  kLow,
+  kPriorityNum
+};
+
+///
+/// Process wide work-stealing executor.
+/// Every worker owns one deque per priority, so submitters and workers only contend on the
+/// queue they touch instead of one global lock. Idle workers steal from their siblings.
+/// Tasks keep FIFO order inside a queue, callers waiting on earlier tasks can not be starved by later ones.
+///
+class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY TaskScheduler {
+ public:
+  static TaskScheduler &GetInstance();
+
+  explicit TaskScheduler(uint32_t worker_num);
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler &) = delete;
+  TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+  template <class Func, class... Args>
+  auto Commit(TaskPriority priority, Func &&func, Args &&... args) -> std::future<decltype(func(args...))> {
+    using RetType = decltype(func(args...));
+    std::future<RetType> fail_future;
+    if (is_stopped_.load()) {
+      GELOGE(ge::FAILED, "task scheduler has been stopped.");
+      return fail_future;
+    }
+
+    auto bind_func = std::bind(std::forward<Func>(func), std::forward<Args>(args)...);
+    auto task = ge::MakeShared<std::packaged_task<RetType()>>(bind_func);
+    if (task == nullptr) {
+      GELOGE(ge::FAILED, "Make shared failed.");
+      return fail_future;
+    }
+    std::future<RetType> future = task->get_future();
+    if (!Push(priority, [task]() { (*task)(); })) {
+      return fail_future;
+    }
+    return future;
+  }
+
+  template <class Func, class... Args>
+  auto Commit(Func &&func, Args &&... args) -> std::future<decltype(func(args...))> {
+    return Commit(TaskPriority::kNormal, std::forward<Func>(func), std::forward<Args>(args)...);
+  }
+
+  ///
+  /// @ingroup ge
+  /// @brief enqueue a raw task, tasks submitted from a worker go to the worker's own queue
+  /// @param [in] priority: priority of task
+  /// @param [in] task: task to run
+  /// @param [in] owner: tag of the task, only waiters of the same owner run it on their thread
+  /// @return bool: false if scheduler has been stopped
+  ///
+  bool Push(TaskPriority priority, ThreadTask task, const void *owner = nullptr);
+
+  ///
+  /// @ingroup ge
+  /// @brief run one pending task of owner on the calling thread, used by waiters to help instead of blocking.
+  /// Tasks of other owners are left to the workers, they may depend on thread local state the waiter has set.
+  /// @param [in] owner: tag the tasks were pushed with
+  /// @return bool: true if a task was executed
+  ///
+  bool RunPendingTask(const void *owner);
+
+  bool IsWorkerThread() const;
+
+  uint32_t GetWorkerNum() const { return static_cast<uint32_t>(workers_.size()); }
+
+ private:
+  struct QueuedTask {
+    ThreadTask task;
+    const void *owner;
+  };
+
+  struct WorkQueue {
+    std::mutex mu;
+    std::deque<QueuedTask> tasks[static_cast<uint32_t>(TaskPriority::kPriorityNum)];
+  };
+
+  void WorkerFunc(uint32_t worker_id);
+  // owner nullptr pops any task
+  bool TryPop(uint32_t worker_id, const void *owner, ThreadTask &task);
+  static bool TryPopFrom(WorkQueue &queue, uint32_t priority, const void *owner, ThreadTask &task);
+
+  std::vector<WorkQueue> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<bool> is_stopped_;
+  std::atomic<uint32_t> next_queue_;
+  std::atomic<int64_t> pending_num_;
+  std::atomic<uint32_t> sleeping_num_;
+  std::mutex sleep_mu_;
+  std::condition_variable sleep_cv_;
+};
+
+///
+/// Set of tasks tracked together on a TaskScheduler.
+/// Then() is the when_all continuation: it is scheduled once every task committed before it has finished.
+/// A group can be reused after Wait() returns.
+///
+class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY TaskGroup {
+ public:
+  explicit TaskGroup(TaskPriority priority = TaskPriority::kNormal,
+                     TaskScheduler &scheduler = TaskScheduler::GetInstance());
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  template <class Func, class... Args>
+  auto Commit(Func &&func, Args &&... args) -> std::future<decltype(func(args...))> {
+    using RetType = decltype(func(args...));
+    std::future<RetType> fail_future;
+    auto bind_func = std::bind(std::forward<Func>(func), std::forward<Args>(args)...);
+    auto task = ge::MakeShared<std::packaged_task<RetType()>>(bind_func);
+    if (task == nullptr) {
+      GELOGE(ge::FAILED, "Make shared failed.");
+      return fail_future;
+    }
+    std::future<RetType> future = task->get_future();
+    auto state = state_;
+    OnTaskCommitted();
+    if (!scheduler_.Push(priority_,
+                         [task, state]() {
+                           (*task)();
+                           OnTaskDone(state);
+                         },
+                         state.get())) {
+      OnTaskDone(state);
+      return fail_future;
+    }
+    return future;
+  }
+
+  ///
+  /// @ingroup ge
+  /// @brief schedule continuation after all tasks committed so far are done
+  /// @param [in] continuation: task to run
+  ///
+  void Then(ThreadTask continuation);
+
+  ///
+  /// @ingroup ge
+  /// @brief wait for all committed tasks, workers of the scheduler keep running other tasks while waiting
+  ///
+  void Wait();
+
+ private:
+  struct State {
+    explicit State(TaskScheduler &sched, TaskPriority prio) : scheduler(sched), priority(prio) {}
+    TaskScheduler &scheduler;
+    TaskPriority priority;
+    std::mutex mu;
+    std::condition_variable cv;
+    uint64_t pending_num = 0;
+    std::vector<ThreadTask> continuations;
+  };
+
+  void OnTaskCommitted();
+  static void OnTaskDone(const std::shared_ptr<State> &state);
+
+  TaskPriority priority_;
+  TaskScheduler &scheduler_;
+  std::shared_ptr<State> state_;
+};
+}  // namespace ge
+
+#endif  // GE_COMMON_TASK_SCHEDULER_H_
@@ -969,7 +969,7 @@ Status GeExecutor::GetMemAndWeightSize(const std::string &path, size_t &mem_size
 
   ModelData model;
   std::string key;
-  Status ret = ge::GraphLoader::LoadDataFromFile(path, key, 0, model);
+  Status ret = ge::GraphLoader::LoadDataFromFile(path, key, 0, model, true);
   if ((ret != SUCCESS) || (model.model_data == nullptr)) {
     GELOGE(ret, "Load data from file failed. ret = %d", ret);
     return ret;
@@ -977,8 +977,7 @@ Status GeExecutor::GetMemAndWeightSize(const std::string &path, size_t &mem_size
 
   ret = ge::ModelManager::GetModelMemAndWeightSize(model, mem_size, weight_size);
 
-  delete[] static_cast<char *>(model.model_data);
-  model.model_data = nullptr;
+  DavinciModelParser::ReleaseModelData(model);
 
   return ret;
 }
@@ -1039,6 +1038,40 @@ ge::Status GeExecutor::ExecuteAsync(DynamicSingleOp *executor, const vector<GeTe
   return executor->ExecuteAsync(input_desc, inputs, output_desc, outputs);
 }
 
+Status GeExecutor::GetTilingCacheStats(DynamicSingleOp *executor, uint64_t &hit_count, uint64_t &miss_count) {
+  GE_CHECK_NOTNULL(executor);
+  return executor->GetTilingCacheStats(hit_count, miss_count);
+}
+
+Status GeExecutor::BeginSingleOpCapture(void *stream) { return SingleOpManager::GetInstance().BeginCapture(stream); }
+
+Status GeExecutor::EndSingleOpCapture(void *stream, const std::vector<DataBuffer> &inputs,
+                                      const std::vector<DataBuffer> &outputs, SingleOpSequence **sequence) {
+  return SingleOpManager::GetInstance().EndCapture(stream, inputs, outputs, sequence);
+}
+
+Status GeExecutor::ExecuteAsync(SingleOpSequence *executor, const std::vector<DataBuffer> &inputs,
+                                std::vector<DataBuffer> &outputs) {
+  GE_CHECK_NOTNULL(executor);
+  return executor->ExecuteAsync(inputs, outputs);
+}
+
+Status GeExecutor::DestroySingleOpSequence(void *stream, SingleOpSequence *sequence) {
+  return SingleOpManager::GetInstance().DestroySequence(stream, sequence);
+}
+
+Status GeExecutor::TrimSingleOpMemory(void *stream, size_t high_water_mark) {
+  return SingleOpManager::GetInstance().TrimMemory(stream, high_water_mark);
+}
+
+Status GeExecutor::GetSingleOpMemoryStats(void *stream, size_t &cached_size, size_t &in_use_peak_size) {
+  StreamMemoryPoolStats stats;
+  GE_CHK_STATUS_RET_NOLOG(SingleOpManager::GetInstance().GetMemoryStats(stream, stats));
+  cached_size = stats.cached_size;
+  in_use_peak_size = stats.in_use_peak_size;
+  return SUCCESS;
+}
+
 Status GeExecutor::ReleaseSingleOpResource(void *stream) {
   return SingleOpManager::GetInstance().ReleaseResource(stream);
 }
@@ -51,6 +51,9 @@ local_ge_executor_src_files :=  \
     ../graph/load/new_model_manager/task_info/super_kernel/super_kernel_factory.cc   \
     ../graph/load/new_model_manager/task_info/super_kernel/super_kernel.cc  \
     ../single_op/single_op_manager.cc \
+    ../single_op/single_op_sequence.cc \
+    ../single_op/stream_memory_pool.cc \
+    ../single_op/weight_store.cc \
     ../single_op/single_op_model.cc \
     ../single_op/single_op.cc \
     ../single_op/stream_resource.cc \
@@ -254,6 +254,9 @@ OME_HOST_SRC_FILES := \
     single_op/single_op_model.cc                                         \
     single_op/stream_resource.cc                                         \
     single_op/single_op_manager.cc                                       \
+    single_op/single_op_sequence.cc                                      \
+    single_op/stream_memory_pool.cc                                      \
+    single_op/weight_store.cc                                            \
     hybrid/hybrid_davinci_model_stub.cc                                  \
     hybrid/node_executor/aicpu/aicpu_ext_info.cc                         \
     # graph/load/new_model_manager/task_info/hccl_task_info.cc
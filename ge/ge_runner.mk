@@ -244,6 +244,9 @@ LIBGE_LOCAL_SRC_FILES := \
     session/session_manager.cc \
     single_op/single_op.cc \
     single_op/single_op_manager.cc \
+    single_op/single_op_sequence.cc \
+    single_op/stream_memory_pool.cc \
+    single_op/weight_store.cc \
     single_op/single_op_model.cc \
     single_op/stream_resource.cc \
     single_op/task/build_task_utils.cc \
@@ -252,6 +255,7 @@ LIBGE_LOCAL_SRC_FILES := \
     single_op/task/aicpu_task_builder.cc \
     single_op/task/aicpu_kernel_task_builder.cc \
     hybrid/common/tensor_value.cc                                        \
+    hybrid/common/tensor_arena.cc                                        \
     hybrid/common/npu_memory_allocator.cc                                \
     hybrid/executor/rt_callback_manager.cc                               \
     hybrid/executor/node_state.cc                                        \
@@ -420,6 +420,7 @@ BlockMemAssigner::~BlockMemAssigner() {
 }
 
 void BlockMemAssigner::GetOutAndWorkSpaceMem(vector<int64_t> &all_memory_size) {
+  InitSymbolIds();
   vector<int64_t> temp;
   for (const NodePtr &n : compute_graph_->GetAllNodes()) {
     auto node_op_desc = n->GetOpDesc();
@@ -441,17 +442,11 @@ void BlockMemAssigner::GetOutAndWorkSpaceMem(vector<int64_t> &all_memory_size) {
         if (anchor_to_symbol_.empty()) {
           all_memory_size.emplace_back(size);
         } else {
-          auto iter1 = anchor_to_symbol_.find(NodeIndexIO(n, out_anchor->GetIdx(), kOut).ToString());
-          if (iter1 == anchor_to_symbol_.end()) {
+          int64_t symbol_id = GetSymbolId(n, static_cast<uint32_t>(out_anchor->GetIdx()));
+          if (symbol_id == kInvalidSymbolId) {
             continue;
           }
-          const std::string &symbol = iter1->second;
-          auto iter2 = symbol_size_.find(symbol);
-          if (iter2 == symbol_size_.end()) {
-            symbol_size_[symbol] = size;
-          } else if (size > static_cast<int64_t>(iter2->second)) {
-            iter2->second = size;
-          }
+          symbol_size_[symbol_id] = std::max(symbol_size_[symbol_id], size);
         }
       }
     }
@@ -460,8 +455,10 @@ void BlockMemAssigner::GetOutAndWorkSpaceMem(vector<int64_t> &all_memory_size) {
     all_memory_size.insert(all_memory_size.end(), temp.begin(), temp.end());
   }
   GELOGI("The last atomic_addr_clean node id: %ld", atomic_addr_clean_id_);
-  for (const auto &pair : symbol_size_) {
-    all_memory_size.emplace_back(pair.second);
+  for (auto size : symbol_size_) {
+    if (size >= 0) {
+      all_memory_size.emplace_back(size);
+    }
   }
   sort(all_memory_size.begin(), all_memory_size.end());
   GELOGI("All memory size: %s", ToString(all_memory_size).c_str());
@@ -505,45 +502,6 @@ bool IsDirectOutputNode(const NodePtr &node, int idx) {
   return false;
 }
 
-void AddReusableBlockCount(const MemoryBlock &mem_block, map<string, uint64_t> &reusable_block_counts) {
-  string key = std::to_string(mem_block.Size());
-  key += "_" + std::to_string(mem_block.stream_id_);
-  auto it = reusable_block_counts.find(key);
-  if (it != reusable_block_counts.end()) {
-    it->second++;
-  } else {
-    reusable_block_counts[key] = 1;
-  }
-}
-
-void ReduceReusableBlockCount(const MemoryBlock &mem_block, map<string, uint64_t> &reusable_block_counts) {
-  string key = std::to_string(mem_block.Size());
-  key += "_" + std::to_string(mem_block.stream_id_);
-  auto it = reusable_block_counts.find(key);
-  if (it != reusable_block_counts.end()) {
-    if (it->second > 0) {
-      it->second--;
-    }
-  }
-}
-
-bool CanReuseBySize(const map<string, uint64_t> &reusable_block_counts, const MemoryBlock &reusable_block,
-                    size_t block_size, size_t real_size, bool continuous) {
-  bool can_reuse = false;
-  if (reusable_block.Size() == block_size) {
-    can_reuse = true;
-  } else {
-    string key = std::to_string(reusable_block.Size());
-    key += "_" + std::to_string(reusable_block.stream_id_);
-    auto it = reusable_block_counts.find(key);
-    GE_IF_BOOL_EXEC(
-      (it != reusable_block_counts.end() && (it->second > kReuseMaxCount)) && (reusable_block.Size() > block_size),
-      can_reuse = true;
-      GELOGD("Less size mem reuse, reuse block size:%zu, current block size:%zu", reusable_block.Size(), block_size););
-  }
-  return can_reuse;
-}
-
 bool BlockMemAssigner::IsOutNodeSetContinuousInput(const NodePtr &n, uint32_t out_index, std::string &peer_name,
                                                    uint32_t &peer_input_index, bool &no_need_assign_memory) {
   if (n == nullptr || n->GetAllOutDataAnchors().size() <= 0) {
@@ -609,8 +567,8 @@ void BlockMemAssigner::InitReuseFlag() {
                                                        ge::CONSTANT,  ge::CONSTANTOP};
   static const std::set<std::string> kPostReuseTypes = {ge::DATA_TYPE, ge::AIPP_DATA_TYPE, ge::ENTER,
                                                         ge::REFENTER,  ge::NEXTITERATION,  ge::REFNEXTITERATION};
+  int64_t symbol_id = 0;
   for (const auto &pair : symbol_to_anchors_) {
-    std::string symbol = pair.first;
     bool pre_reuse_flag = true;
     bool post_reuse_flag = true;
     for (const auto &node_index_io : pair.second) {
@@ -640,8 +598,9 @@ void BlockMemAssigner::InitReuseFlag() {
         break;
       }
     }
-    pre_reuse_flag_[symbol] = pre_reuse_flag;
-    post_reuse_flag_[symbol] = post_reuse_flag;
+    pre_reuse_flag_[symbol_id] = pre_reuse_flag;
+    post_reuse_flag_[symbol_id] = post_reuse_flag;
+    ++symbol_id;
   }
 }
 
@@ -653,25 +612,11 @@ void BlockMemAssigner::InitReuseFlag() {
 /// @return bool
 ///
 bool BlockMemAssigner::IsPreReuse(const NodePtr &node, uint32_t out_index) const {
-  OutDataAnchorPtr out_data_anchor = nullptr;
-  if (static_cast<size_t>(out_index) < node->GetAllOutDataAnchors().size()) {
-    out_data_anchor = node->GetOutDataAnchor(out_index);
-  }
-  if (out_data_anchor == nullptr) {
+  int64_t symbol_id = GetSymbolId(node, out_index);
+  if (symbol_id == kInvalidSymbolId) {
     return false;
   }
-  NodeIndexIO cur_node_index_io(out_data_anchor->GetOwnerNode(), out_data_anchor->GetIdx(), kOut);
-  auto iter1 = anchor_to_symbol_.find(cur_node_index_io.ToString());
-  if (iter1 == anchor_to_symbol_.end()) {
-    return false;
-  }
-
-  const std::string &symbol = iter1->second;
-  auto iter2 = pre_reuse_flag_.find(symbol);
-  if (iter2 == pre_reuse_flag_.end()) {
-    return false;
-  }
-  return iter2->second;
+  return pre_reuse_flag_[symbol_id];
 }
 
 ///
@@ -684,12 +629,8 @@ bool BlockMemAssigner::IsPostReuse(const MemoryBlock *mem_block) const {
   if (mem_block == nullptr) {
     return false;
   }
-  for (const auto &symbol : mem_block->SymbolList()) {
-    auto iter = post_reuse_flag_.find(symbol);
-    if (iter == post_reuse_flag_.end()) {
-      continue;
-    }
-    if (!iter->second) {
+  for (auto symbol_id : mem_block->SymbolList()) {
+    if (static_cast<size_t>(symbol_id) < post_reuse_flag_.size() && !post_reuse_flag_[symbol_id]) {
       return false;
     }
   }
@@ -698,19 +639,47 @@ bool BlockMemAssigner::IsPostReuse(const MemoryBlock *mem_block) const {
 
 ///
 /// @ingroup GE
-/// @brief check if symbol of cur node_index_io has block
-/// @param [in] node_index_io
-/// @param [out] symbol
-/// @return bool
+/// @brief number the symbols by their order in symbol_to_anchors_ and map every output tensor to its symbol id
+/// @return void
 ///
-bool BlockMemAssigner::IsSymbolExist(const NodeIndexIO &node_index_io, string &symbol) {
-  auto iter = anchor_to_symbol_.find(node_index_io.ToString());
-  if (iter == anchor_to_symbol_.end()) {
-    return false;
+void BlockMemAssigner::InitSymbolIds() {
+  out_symbol_ids_.clear();
+  int64_t symbol_id = 0;
+  for (const auto &pair : symbol_to_anchors_) {
+    for (const auto &node_index_io : pair.second) {
+      if ((node_index_io.io_type_ != kOut) || (node_index_io.node_ == nullptr)) {
+        continue;
+      }
+      auto &symbol_ids = out_symbol_ids_[node_index_io.node_.get()];
+      auto index = static_cast<size_t>(node_index_io.index_);
+      if (index >= symbol_ids.size()) {
+        symbol_ids.resize(index + 1, kInvalidSymbolId);
+      }
+      symbol_ids[index] = symbol_id;
+    }
+    ++symbol_id;
   }
 
-  symbol = iter->second;
-  return symbol_blocks_.find(iter->second) != symbol_blocks_.end();
+  size_t symbol_num = symbol_to_anchors_.size();
+  pre_reuse_flag_.assign(symbol_num, false);
+  post_reuse_flag_.assign(symbol_num, true);
+  symbol_size_.assign(symbol_num, -1);
+  symbol_blocks_.assign(symbol_num, nullptr);
+}
+
+///
+/// @ingroup GE
+/// @brief get symbol id of an output tensor
+/// @param [in] node
+/// @param [in] out_index
+/// @return kInvalidSymbolId if the tensor has no symbol
+///
+int64_t BlockMemAssigner::GetSymbolId(const NodePtr &node, uint32_t out_index) const {
+  auto iter = out_symbol_ids_.find(node.get());
+  if ((iter == out_symbol_ids_.end()) || (static_cast<size_t>(out_index) >= iter->second.size())) {
+    return kInvalidSymbolId;
+  }
+  return iter->second[out_index];
 }
 
 ///
@@ -719,12 +688,15 @@ bool BlockMemAssigner::IsSymbolExist(const NodeIndexIO &node_index_io, string &s
 /// @return void
 ///
 void BlockMemAssigner::PrintSymbolMap() {
+  int64_t symbol_id = 0;
   for (const auto &pair : symbol_to_anchors_) {
-    GELOGD("symbol=%s, max_size=%zu, pre_reuse=%s, post_reuse=%s", pair.first.c_str(), symbol_size_[pair.first],
-           pre_reuse_flag_[pair.first] ? "true" : "false", post_reuse_flag_[pair.first] ? "true" : "false");
+    GELOGD("symbol=%s, id=%ld, max_size=%ld, pre_reuse=%s, post_reuse=%s", pair.first.c_str(), symbol_id,
+           symbol_size_[symbol_id], pre_reuse_flag_[symbol_id] ? "true" : "false",
+           post_reuse_flag_[symbol_id] ? "true" : "false");
     for (const auto &node_index_io : pair.second) {
       GELOGD("anchor:%s", node_index_io.ToString().c_str());
     }
+    ++symbol_id;
   }
 }
 
@@ -782,37 +754,23 @@ MemoryBlock *BlockMemAssigner::ApplyMemory(size_t block_size, size_t real_size,
   GE_IF_BOOL_EXEC(node_op_desc == nullptr, return nullptr);
 
   bool is_reuse_memory = false;
-  string ge_disable_reuse_mem_env = "0";
-  (void)ge::GetContext().GetOption(OPTION_EXEC_DISABLE_REUSED_MEMORY, ge_disable_reuse_mem_env);
-  if (ge_disable_reuse_mem_env != "1") {
+  int64_t symbol_id = (mem_type == kOutput) ? GetSymbolId(n, out_index) : kInvalidSymbolId;
+  if (ge_disable_reuse_mem_env_ != "1") {
     bool reuse_mem_flag = !((workspace_reuse_flag.size() > out_index) && !workspace_reuse_flag[out_index]);
     is_reuse_memory = !node_op_desc->HasAttr(kL2FusionDynamicConvergeOp) && !node_op_desc->HasAttr(kOpNoReuseMem) &&
                       reuse_mem_flag && is_op_reuse_mem && (IsPreReuse(n, out_index));
     auto stream_id = node_op_desc->GetStreamId();
     if (is_reuse_memory && !continuous) {
-      for (auto it = reusable_blocks_[stream_id].begin(); it != reusable_blocks_[stream_id].end(); ++it) {
-        MemoryBlock *reusable_block = *it;
-        if (!IsPostReuse(reusable_block)) {
-          reusable_block->reuse_mem_ = false;
-          GELOGI("Unreusable block.");
-          continue;
-        }
-
-        // A node can reuse blocks of the same stream and preorder streams
-        if (CanReuseBySize(reusable_block_counts_, *reusable_block, block_size, real_size, continuous)) {
-          reusable_block->AddNodeTypeIndex({n, mem_type, out_index, false}, real_size, no_align_size);
-          if (mem_type == kOutput) {
-            auto iter = anchor_to_symbol_.find(NodeIndexIO(n, out_index, kOut).ToString());
-            if (iter != anchor_to_symbol_.end()) {
-              reusable_block->AddSymbol(iter->second);
-            }
-          }
-          reusable_block->continuous_block_ = continuous;
-          reusable_block->ref_count_++;
-          ReduceReusableBlockCount(*reusable_block, reusable_block_counts_);
-          reusable_blocks_[stream_id].erase(it);
-          return reusable_block;
+      // A node can reuse blocks of the same stream and preorder streams
+      MemoryBlock *reusable_block = TakeReusableBlock(reusable_blocks_[stream_id], block_size);
+      if (reusable_block != nullptr) {
+        reusable_block->AddNodeTypeIndex({n, mem_type, out_index, false}, real_size, no_align_size);
+        if (symbol_id != kInvalidSymbolId) {
+          reusable_block->AddSymbol(symbol_id);
         }
+        reusable_block->continuous_block_ = continuous;
+        reusable_block->ref_count_++;
+        return reusable_block;
       }
     }
   }
@@ -827,11 +785,8 @@ MemoryBlock *BlockMemAssigner::ApplyMemory(size_t block_size, size_t real_size,
   block->stream_id_ = node_op_desc->GetStreamId();
   block->ref_count_++;
   block->continuous_block_ = continuous;
-  if (mem_type == kOutput) {
-    auto iter = anchor_to_symbol_.find(NodeIndexIO(n, out_index, kOut).ToString());
-    if (iter != anchor_to_symbol_.end()) {
-      block->AddSymbol(iter->second);
-    }
+  if (symbol_id != kInvalidSymbolId) {
+    block->AddSymbol(symbol_id);
   }
   memory_blocks_.emplace_back(block);
   blocks_store_.emplace_back(block);
@@ -885,7 +840,6 @@ MemoryBlock *BlockMemAssigner::ApplyOutMemory(const NodePtr &n, uint32_t index,
   auto node_op_desc = n->GetOpDesc();
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(node_op_desc == nullptr, return nullptr, "node_op_desc is null.");
   MemoryBlock *block = nullptr;
-  NodeIndexIO node_index_io(n, index, kOut);
   int64_t size = 0;
   auto output_op_desc = node_op_desc->GetOutputDescPtr(index);
   if (output_op_desc != nullptr) {
@@ -895,19 +849,15 @@ MemoryBlock *BlockMemAssigner::ApplyOutMemory(const NodePtr &n, uint32_t index,
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(GetNoAlignSize(*node_op_desc, index, no_align_size) != SUCCESS, return nullptr,
                                  "Get no align size failed");
 
-  std::string symbol;
-  if (IsSymbolExist(node_index_io, symbol)) {
-    block = symbol_blocks_[symbol];
+  int64_t symbol_id = GetSymbolId(n, index);
+  if ((symbol_id != kInvalidSymbolId) && (symbol_blocks_[symbol_id] != nullptr)) {
+    block = symbol_blocks_[symbol_id];
     block->AddNodeTypeIndex({n, kOutput, index, true}, size, no_align_size);
     block->ref_count_++;
   } else {
     int64_t max_size = size;
-    auto iter1 = anchor_to_symbol_.find(node_index_io.ToString());
-    if (iter1 != anchor_to_symbol_.end()) {
-      auto iter2 = symbol_size_.find(iter1->second);
-      if (iter2 != symbol_size_.end()) {
-        max_size = iter2->second;
-      }
+    if ((symbol_id != kInvalidSymbolId) && (symbol_size_[symbol_id] >= 0)) {
+      max_size = symbol_size_[symbol_id];
     }
     auto block_size = GetBlockSize(max_size, ranges);
     vector<bool> workspace_reuse_flag;
@@ -1005,27 +955,26 @@ bool IsKnownSubgraphData(const NodePtr &node) {
   return node->GetOpDesc()->HasAttr(ATTR_NAME_PARENT_NODE_INDEX);
 }
 
-void BlockMemAssigner::ReleaseMemory(MemoryBlock *to_release, vector<MemoryBlock *> &reusable_memory) {
+void BlockMemAssigner::ReleaseMemory(MemoryBlock *to_release, ReusableBlocks &reusable_memory) {
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(to_release == nullptr, return, "Input parameter to_release is null.");
   GE_CHK_TRUE_EXEC_INFO(to_release->ref_count_ <= 0, return, "Release memory");
   GE_CHK_TRUE_EXEC_INFO(!to_release->reuse_mem_, return, "doesn't reuse memory");
   --to_release->ref_count_;
   if (to_release->ref_count_ == 0) {
     to_release->SetLifeTimeEnd(life_time_);
-    reusable_memory.emplace_back(to_release);
-    AddReusableBlockCount(*to_release, reusable_block_counts_);
+    reusable_memory[to_release->Size()].emplace_back(to_release);
   }
 }
 
-void BlockMemAssigner::ReleaseMemorys(const vector<MemoryBlock *> &to_releases,
-                                      vector<MemoryBlock *> &reusable_memory) {
+void BlockMemAssigner::ReleaseMemorys(const vector<MemoryBlock *> &to_releases, ReusableBlocks &reusable_memory) {
   for (auto mem_block : to_releases) {
     ReleaseMemory(mem_block, reusable_memory);
   }
 }
 
-void BlockMemAssigner::ReleaseInputNodeOutMemory(const unordered_map<string, vector<MemoryBlock *>> &node_out_blocks,
-                                                 vector<MemoryBlock *> &reusable_memory, NodePtr &node) {
+void BlockMemAssigner::ReleaseInputNodeOutMemory(
+  const unordered_map<const Node *, vector<MemoryBlock *>> &node_out_blocks, ReusableBlocks &reusable_memory,
+  NodePtr &node) {
   for (const auto &in_anchor : node->GetAllInDataAnchors()) {
     if ((in_anchor->GetPeerOutAnchor() == nullptr) ||
         (in_anchor->GetPeerOutAnchor()->GetOwnerNode()->GetOpDesc() == nullptr) || (node->GetOpDesc() == nullptr)) {
@@ -1033,14 +982,12 @@ void BlockMemAssigner::ReleaseInputNodeOutMemory(const unordered_map<string, vec
     }
     GE_IF_BOOL_EXEC(IsOutputBlock(in_anchor), continue);
 
-    auto node_name = in_anchor->GetPeerOutAnchor()->GetOwnerNode()->GetName();
-
     GE_IF_BOOL_EXEC((in_anchor->GetPeerOutAnchor()->GetOwnerNode()->GetType() == CONSTANT) ||
                       (in_anchor->GetPeerOutAnchor()->GetOwnerNode()->GetType() == FASTRCNNPREDICTIONS) ||
                       (in_anchor->GetPeerOutAnchor()->GetOwnerNode()->GetType() == CONSTANTOP),
                     continue);
 
-    auto it = node_out_blocks.find(node_name);
+    auto it = node_out_blocks.find(in_anchor->GetPeerOutAnchor()->GetOwnerNode().get());
     if (it == node_out_blocks.end()) {
       continue;
     }
@@ -1064,6 +1011,39 @@ void BlockMemAssigner::ReleaseInputNodeOutMemory(const unordered_map<string, vec
   }
 }
 
+MemoryBlock *BlockMemAssigner::TakeReusableBlock(ReusableBlocks &reusable_memory, size_t block_size) {
+  auto it = reusable_memory.lower_bound(block_size);
+  while (it != reusable_memory.end()) {
+    auto &blocks = it->second;
+    while (!blocks.empty() && !IsPostReuse(blocks.front())) {
+      blocks.front()->reuse_mem_ = false;
+      GELOGI("Unreusable block.");
+      blocks.pop_front();
+    }
+    size_t reusable_size = it->first;
+    if (blocks.empty()) {
+      it = reusable_memory.erase(it);
+      continue;
+    }
+    // a larger block is only taken when many of its size are idle
+    if ((reusable_size != block_size) && (blocks.size() <= static_cast<size_t>(kReuseMaxCount))) {
+      ++it;
+      continue;
+    }
+
+    MemoryBlock *block = blocks.front();
+    blocks.pop_front();
+    if (blocks.empty()) {
+      reusable_memory.erase(it);
+    }
+    if (reusable_size != block_size) {
+      GELOGD("Less size mem reuse, reuse block size:%zu, current block size:%zu", reusable_size, block_size);
+    }
+    return block;
+  }
+  return nullptr;
+}
+
 void SplitStringByComma(const string &str, vector<string> &sub_str_vec) {
   std::string tmp_string = str + ",";
   std::string::size_type start_pos = 0;
@@ -1167,16 +1147,15 @@ Status BlockMemAssigner::AssignOutputMemoryWithReuse(const NodePtr &node, vector
     }
     MemoryBlock *mem_block = ApplyOutMemory(node, i, ranges, is_op_reuse_mem_, out_node_set_continuous_input);
     if (mem_block != nullptr) {
-      node_out_blocks_[node->GetName()].emplace_back(mem_block);
+      node_out_blocks_[node.get()].emplace_back(mem_block);
       if (out_node_set_continuous_input) {
         node_continuous_input_blocks_[peer_name][peer_input_index] = mem_block;
       }
-      NodeIndexIO node_index_io(node, i, kOut);
-      auto iter = anchor_to_symbol_.find(node_index_io.ToString());
-      if (iter == anchor_to_symbol_.end()) {
+      int64_t symbol_id = GetSymbolId(node, i);
+      if (symbol_id == kInvalidSymbolId) {
         continue;
       }
-      symbol_blocks_[iter->second] = mem_block;
+      symbol_blocks_[symbol_id] = mem_block;
     }
   }
   return SUCCESS;
@@ -1253,7 +1232,8 @@ void BlockMemAssigner::AssignMemoryWithReuse(vector<int64_t> &ranges) {
 
   bool merge_dynamic_batch = false;
   GE_IF_BOOL_EXEC(!(ge_disable_reuse_mem_env_ == "1"), merge_dynamic_batch = MergeDynamicBatchBlocks());
-  GE_IF_BOOL_EXEC((!(ge_disable_reuse_mem_env_ == "1") && !merge_dynamic_batch), ReuseBlocksByLifeTime(ranges.size()));
+  is_life_reuse_ = !(ge_disable_reuse_mem_env_ == "1") && !merge_dynamic_batch;
+  GE_IF_BOOL_EXEC(is_life_reuse_, ReuseBlocksByLifeTime(ranges.size()));
   AssignContinuousBlocks();
   ResizeMemoryBlocks();
 
@@ -1310,8 +1290,8 @@ void MergeBlocks(std::vector<MemoryBlock *> &dest, std::vector<MemoryBlock *> &s
                dest[i]->String().c_str(), dest[i]->stream_id_, src[i]->String().c_str(), src[i]->stream_id_);
         continue;
       }
-      for (auto &symbol : src[i]->SymbolList()) {
-        dest[i]->AddSymbol(symbol);
+      for (auto symbol_id : src[i]->SymbolList()) {
+        dest[i]->AddSymbol(symbol_id);
       }
       for (size_t j = 0; j < src[i]->NodeTypeIndexList().size(); ++j) {
         dest[i]->AddNodeTypeIndex(src[i]->NodeTypeIndexList()[j], src[i]->RealSizeList()[j],
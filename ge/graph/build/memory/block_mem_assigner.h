@@ -17,6 +17,7 @@
 #ifndef GE_GRAPH_BUILD_MEMORY_BLOCK_MEM_ASSIGNER_H_
 #define GE_GRAPH_BUILD_MEMORY_BLOCK_MEM_ASSIGNER_H_
 
+#include <deque>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -33,6 +34,7 @@
 
 namespace ge {
 const size_t kMaxLifeTime = 0xffffffff;
+const int64_t kInvalidSymbolId = -1;
 
 using DependStreamLife = std::map<int64_t, std::map<int64_t, size_t>>;
 
@@ -106,10 +108,10 @@ class MemoryBlock {
     no_align_size_list_.emplace_back(no_align_size);
   }
 
-  void AddSymbol(const std::string &symbol) { symbol_list_.emplace_back(symbol); }
+  void AddSymbol(int64_t symbol_id) { symbol_list_.emplace_back(symbol_id); }
 
   const std::vector<NodeTypeIndex> &NodeTypeIndexList() const { return node_type_index_list_; }
-  const std::vector<std::string> &SymbolList() const { return symbol_list_; }
+  const std::vector<int64_t> &SymbolList() const { return symbol_list_; }
   const std::vector<size_t> &RealSizeList() const { return real_size_list_; }
   const std::vector<MemoryBlock *> &ChildBlockList() const { return child_blocks_; }
   const std::vector<size_t> &NoAlignSizeList() const { return no_align_size_list_; }
@@ -153,10 +155,15 @@ class MemoryBlock {
   size_t tail_offset_;
   size_t child_offset_;
   std::vector<NodeTypeIndex> node_type_index_list_;
-  std::vector<std::string> symbol_list_;
+  std::vector<int64_t> symbol_list_;
   std::vector<MemoryBlock *> child_blocks_;
 };
 
+///
+/// Released blocks of one stream ordered by size, blocks of the same size are reused in the order of release
+///
+using ReusableBlocks = std::map<size_t, std::deque<MemoryBlock *>>;
+
 class BlockMemAssigner : public MemAssigner {
  public:
   BlockMemAssigner(ComputeGraphPtr compute_graph, const std::map<std::string, std::string> &anchor_to_symbol,
@@ -199,7 +206,7 @@ class BlockMemAssigner : public MemAssigner {
   /// @brief traverse all memory size, resize, and calculate offset
   /// @param [in&out] memory_blocks memory size, resize and calculate memory address after offset
   ///
-  void ResizeMemoryBlocks();
+  virtual void ResizeMemoryBlocks();
 
   void GetOutAndWorkSpaceMem(std::vector<int64_t> &all_memory_size);
 
@@ -240,12 +247,19 @@ class BlockMemAssigner : public MemAssigner {
 
   ///
   /// @ingroup GE
-  /// @brief check if symbol of cur node_index_io has block
-  /// @param [in] node_index_io
-  /// @param [out] symbol
-  /// @return bool
+  /// @brief number the symbols by their order in symbol_to_anchors_ and map every output tensor to its symbol id
+  /// @return void
   ///
-  bool IsSymbolExist(const NodeIndexIO &node_index_io, std::string &symbol);
+  void InitSymbolIds();
+
+  ///
+  /// @ingroup GE
+  /// @brief get symbol id of an output tensor
+  /// @param [in] node
+  /// @param [in] out_index
+  /// @return kInvalidSymbolId if the tensor has no symbol
+  ///
+  int64_t GetSymbolId(const NodePtr &node, uint32_t out_index) const;
 
   ///
   /// @ingroup GE
@@ -266,9 +280,18 @@ class BlockMemAssigner : public MemAssigner {
   // ref mapping
   const std::map<std::string, std::list<NodeIndexIO>> &symbol_to_anchors_;
   const std::map<std::string, std::string> &anchor_to_symbol_;
-  std::map<std::string, bool> pre_reuse_flag_;
-  std::map<std::string, bool> post_reuse_flag_;
-  std::map<std::string, size_t> symbol_size_;
+  // symbol id of every output of the nodes
+  std::unordered_map<const Node *, std::vector<int64_t>> out_symbol_ids_;
+  // indexed by symbol id
+  std::vector<bool> pre_reuse_flag_;
+  std::vector<bool> post_reuse_flag_;
+  // max output size of the symbol, -1 if no output of the symbol applies memory by itself
+  std::vector<int64_t> symbol_size_;
+
+  // blocks may share memory by life time, false if reuse is disabled or blocks of different batches are merged
+  bool is_life_reuse_ = false;
+
+  DependStreamLife total_node_depend_stream_life_;
 
  private:
   ///
@@ -321,7 +344,7 @@ class BlockMemAssigner : public MemAssigner {
   /// @return void
   /// @author
   ///
-  void ReleaseMemory(MemoryBlock *to_release, vector<MemoryBlock *> &reusable_memory);
+  void ReleaseMemory(MemoryBlock *to_release, ReusableBlocks &reusable_memory);
 
   ///
   /// @ingroup GE
@@ -331,7 +354,7 @@ class BlockMemAssigner : public MemAssigner {
   /// @return void
   /// @author
   ///
-  void ReleaseMemorys(const vector<MemoryBlock *> &to_releases, vector<MemoryBlock *> &reusable_memory);
+  void ReleaseMemorys(const vector<MemoryBlock *> &to_releases, ReusableBlocks &reusable_memory);
 
   ///
   /// @ingroup GE
@@ -342,8 +365,18 @@ class BlockMemAssigner : public MemAssigner {
   /// @return void
   /// @author
   ///
-  void ReleaseInputNodeOutMemory(const std::unordered_map<string, vector<MemoryBlock *>> &node_out_blocks,
-                                 vector<MemoryBlock *> &reusable_memory, ge::NodePtr &n);
+  void ReleaseInputNodeOutMemory(const std::unordered_map<const Node *, vector<MemoryBlock *>> &node_out_blocks,
+                                 ReusableBlocks &reusable_memory, ge::NodePtr &n);
+
+  ///
+  /// @ingroup GE
+  /// @brief Take the released block of the same size, or of the smallest larger size of which enough blocks are
+  ///        released. The blocks which can not be reused by the following nodes are dropped on the way
+  /// @param [in] reusable_memory reusable list
+  /// @param [in] block_size applied memory block size
+  /// @return MemoryBlock*, nullptr if no block can be reused
+  ///
+  MemoryBlock *TakeReusableBlock(ReusableBlocks &reusable_memory, size_t block_size);
 
   ///
   /// @ingroup GE
@@ -375,15 +408,14 @@ class BlockMemAssigner : public MemAssigner {
 
   MemoryBlock *ApplyContinuousMemory(const NodePtr &n, const vector<int64_t> &ranges, const bool is_op_reuse_mem);
 
-  std::unordered_map<int64_t, std::vector<MemoryBlock *>> reusable_blocks_;
-
-  std::map<std::string, uint64_t> reusable_block_counts_;
+  std::unordered_map<int64_t, ReusableBlocks> reusable_blocks_;
 
   std::unordered_map<int64_t, std::vector<MemoryBlock *>> stream_workspace_blocks_;
 
-  std::unordered_map<std::string, std::vector<MemoryBlock *>> node_out_blocks_;
+  std::unordered_map<const Node *, std::vector<MemoryBlock *>> node_out_blocks_;
 
-  std::unordered_map<std::string, MemoryBlock *> symbol_blocks_;
+  // indexed by symbol id
+  std::vector<MemoryBlock *> symbol_blocks_;
 
   std::unordered_map<std::string, std::unordered_map<uint32_t, MemoryBlock *>> node_continuous_input_blocks_;
 
@@ -401,8 +433,6 @@ class BlockMemAssigner : public MemAssigner {
   size_t life_time_;
 
   int64_t atomic_addr_clean_id_ = 0;
-
-  DependStreamLife total_node_depend_stream_life_;
 };
 }  // namespace ge
 #endif  // GE_GRAPH_BUILD_MEMORY_BLOCK_MEM_ASSIGNER_H_
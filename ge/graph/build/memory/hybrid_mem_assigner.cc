@@ -15,10 +15,12 @@
  */
 
 #include "graph/build/memory/hybrid_mem_assigner.h"
+#include <algorithm>
 #include <utility>
 #include <vector>
 #include "framework/common/debug/ge_log.h"
 #include "graph/build/memory/binary_block_mem_assigner.h"
+#include "graph/build/memory/interval_block_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
 
 namespace ge {
@@ -54,16 +56,27 @@ Status HybridMemAssigner::Assign() {
     new (std::nothrow) MaxBlockMemAssigner(compute_graph_, anchor_to_symbol_, symbol_to_anchors_));
   GE_CHECK_NOTNULL(max_assigner);
 
+  std::unique_ptr<BlockMemAssigner> interval_assigner(
+    new (std::nothrow) IntervalBlockMemAssigner(compute_graph_, anchor_to_symbol_, symbol_to_anchors_));
+  GE_CHECK_NOTNULL(interval_assigner);
+
   size_t bin_mem_size = 0;
   size_t max_mem_size = 0;
+  size_t interval_mem_size = 0;
 
   GE_CHK_STATUS_RET(AssignMemory(binary_assigner, bin_mem_size), "BinaryBlock Method AssignMemory Fail!");
   GE_CHK_STATUS_RET(AssignMemory(max_assigner, max_mem_size), "MaxBlock Method AssignMemory Fail!");
+  GE_CHK_STATUS_RET(AssignMemory(interval_assigner, interval_mem_size), "Interval Method AssignMemory Fail!");
 
   std::unique_ptr<BlockMemAssigner> priority_assigner;
 
-  GELOGI("Binary-block memory size:%zu, max-block memory size:%zu", bin_mem_size, max_mem_size);
-  if (bin_mem_size <= max_mem_size) {
+  GELOGI("Binary-block memory size:%zu, max-block memory size:%zu, interval memory size:%zu", bin_mem_size,
+         max_mem_size, interval_mem_size);
+  size_t block_mem_size = std::min(bin_mem_size, max_mem_size);
+  if (interval_mem_size < block_mem_size) {
+    GELOGI("Use interval memory assigner method, %zu bytes of feature map saved", block_mem_size - interval_mem_size);
+    priority_assigner = std::move(interval_assigner);
+  } else if (bin_mem_size <= max_mem_size) {
     GELOGI("Use binary-block memory assigner method");
     priority_assigner = std::move(binary_assigner);
   } else {
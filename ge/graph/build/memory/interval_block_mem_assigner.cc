@@ -0,0 +1,204 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "graph/build/memory/interval_block_mem_assigner.h"
+#include <algorithm>
+#include <map>
+#include <set>
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace {
+///
+/// Blocks placed together: one block with its child blocks, or all blocks of a continuous memory
+///
+struct MemoryUnit {
+  std::vector<MemoryBlock *> blocks;
+  size_t size = 0;
+  size_t offset = 0;
+  bool continuous = false;
+  bool shareable = true;
+  // the latest node of every stream which the unit depends on before its first use
+  std::map<int64_t, size_t> life_begin;
+  // the last node of every stream which uses the unit
+  std::map<int64_t, size_t> life_end;
+};
+
+// same rule as MemoryBlock::AddLifeReuseBlock: every use of next starts after every use of prev has finished
+bool IsLifeBefore(const MemoryUnit &prev, const MemoryUnit &next) {
+  for (const auto &end : prev.life_end) {
+    auto it = next.life_begin.find(end.first);
+    if (it == next.life_begin.end() || it->second <= end.second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsConflict(const MemoryUnit &left, const MemoryUnit &right) {
+  if (!left.shareable || !right.shareable) {
+    return true;
+  }
+  return !IsLifeBefore(left, right) && !IsLifeBefore(right, left);
+}
+
+using PlacedUnits = std::multimap<size_t, const MemoryUnit *>;
+
+// best fit: the smallest gap between the conflicting units which is large enough, or the top of them.
+// placed units are kept ordered by offset, so the gaps are found in one pass without sorting
+size_t FindOffset(const MemoryUnit &unit, const PlacedUnits &placed_units) {
+  size_t gap_begin = 0;
+  size_t best_offset = 0;
+  size_t best_gap = 0;
+  bool found = false;
+  for (const auto &placed : placed_units) {
+    const MemoryUnit &other = *placed.second;
+    if ((other.offset + other.size <= gap_begin) || !IsConflict(unit, other)) {
+      continue;
+    }
+    if (other.offset > gap_begin) {
+      size_t gap = other.offset - gap_begin;
+      if (gap >= unit.size && (!found || gap < best_gap)) {
+        best_offset = gap_begin;
+        best_gap = gap;
+        found = true;
+        if (gap == unit.size) {
+          // no gap fits better
+          return best_offset;
+        }
+      }
+    }
+    gap_begin = std::max(gap_begin, other.offset + other.size);
+  }
+  return found ? best_offset : gap_begin;
+}
+}  // namespace
+
+void IntervalBlockMemAssigner::ResizeMemoryBlocks() {
+  std::vector<MemoryUnit> units;
+  std::set<int64_t> streams;
+  bool in_continuous = false;
+  size_t stacked_size = 0;
+  for (auto &memory_block : memory_blocks_) {
+    if (memory_block == nullptr || memory_block->deleted_block_ || memory_block->is_zero_copy_) {
+      continue;
+    }
+    memory_block->Resize();
+    if (!in_continuous) {
+      units.emplace_back();
+      if (memory_block->first_continuous_block_) {
+        units.back().continuous = true;
+        units.back().size = MEM_ALIGN_SIZE;
+        in_continuous = true;
+      }
+    }
+    if (memory_block->last_continuous_block_) {
+      in_continuous = false;
+    }
+
+    auto &unit = units.back();
+    unit.blocks.emplace_back(memory_block);
+    unit.size += memory_block->Size();
+    if (!is_life_reuse_ || unit.continuous || !memory_block->reuse_mem_ || !IsPostReuse(memory_block)) {
+      unit.shareable = false;
+    }
+    streams.insert(memory_block->stream_id_);
+    for (auto child : memory_block->ChildBlockList()) {
+      if (child != nullptr) {
+        streams.insert(child->stream_id_);
+      }
+    }
+  }
+  size_t shareable_num = 0;
+  for (const auto &unit : units) {
+    stacked_size += unit.size;
+    shareable_num += unit.shareable ? 1 : 0;
+  }
+  if (shareable_num == 0) {
+    GELOGI("No memory unit of %zu can be shared, stack them.", units.size());
+    BlockMemAssigner::ResizeMemoryBlocks();
+    return;
+  }
+
+  // units which are never shared conflict with every other one, they are stacked at the bottom
+  size_t planned_size = 0;
+  std::vector<MemoryUnit *> sorted_units;
+  for (auto &unit : units) {
+    if (unit.shareable) {
+      sorted_units.emplace_back(&unit);
+    } else {
+      unit.offset = planned_size;
+      planned_size += unit.size;
+    }
+  }
+  const size_t shared_base = planned_size;
+
+  for (auto unit : sorted_units) {
+    auto &begin = unit->life_begin;
+    auto &end = unit->life_end;
+    std::vector<MemoryBlock *> blocks = unit->blocks;
+    for (auto block : unit->blocks) {
+      for (auto child : block->ChildBlockList()) {
+        if (child != nullptr) {
+          blocks.emplace_back(child);
+        }
+      }
+    }
+    for (auto block : blocks) {
+      auto &stream_end = end[block->stream_id_];
+      stream_end = std::max(stream_end, block->GetLifeEnd());
+      for (auto stream_id : streams) {
+        size_t stream_begin = block->GetDependLifeBegin(stream_id, total_node_depend_stream_life_);
+        auto it = begin.find(stream_id);
+        if (it == begin.end() || stream_begin < it->second) {
+          begin[stream_id] = stream_begin;
+        }
+      }
+    }
+  }
+
+  // greedy by size, the earlier unit goes first if the sizes are the same
+  std::stable_sort(sorted_units.begin(), sorted_units.end(),
+                   [](const MemoryUnit *left, const MemoryUnit *right) { return left->size > right->size; });
+  PlacedUnits placed_units;
+  for (auto unit : sorted_units) {
+    unit->offset = FindOffset(*unit, placed_units);
+    planned_size = std::max(planned_size, shared_base + unit->offset + unit->size);
+    placed_units.emplace(unit->offset, unit);
+  }
+  for (auto unit : sorted_units) {
+    unit->offset += shared_base;
+  }
+
+  GELOGI("Interval planner placed %zu memory units in %zu bytes, stacked size is %zu.", units.size(), planned_size,
+         stacked_size);
+  if (planned_size >= stacked_size) {
+    BlockMemAssigner::ResizeMemoryBlocks();
+    return;
+  }
+
+  for (const auto &unit : units) {
+    size_t offset = mem_offset_ + unit.offset + (unit.continuous ? MEM_ALIGN_SIZE : 0);
+    for (auto memory_block : unit.blocks) {
+      memory_block->SetHeadOffset(offset);
+      offset += memory_block->Size();
+      memory_block->SetTailOffset(offset - 1);
+    }
+  }
+  mem_offset_ += planned_size;
+  GELOGI("mem_offset_ exclude zero_copy_memory is %zu.", mem_offset_);
+}
+}  // namespace ge
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_GRAPH_BUILD_MEMORY_INTERVAL_BLOCK_MEM_ASSIGNER_H_
+#define GE_GRAPH_BUILD_MEMORY_INTERVAL_BLOCK_MEM_ASSIGNER_H_
+
+#include <utility>
+#include <vector>
+#include "graph/build/memory/binary_block_mem_assigner.h"
+
+namespace ge {
+///
+/// Blocks are formed the same way as BinaryBlockMemAssigner, but instead of stacking them one after another,
+/// every block is placed at the lowest offset which does not overlap the blocks alive at the same time,
+/// so a block can live in the gap between others.
+///
+class IntervalBlockMemAssigner : public BinaryBlockMemAssigner {
+ public:
+  IntervalBlockMemAssigner(ComputeGraphPtr compute_graph, const std::map<std::string, std::string> &anchor_to_symbol,
+                           const std::map<std::string, std::list<NodeIndexIO>> &symbol_to_anchors)
+      : BinaryBlockMemAssigner(std::move(compute_graph), anchor_to_symbol, symbol_to_anchors) {}
+
+  IntervalBlockMemAssigner(const IntervalBlockMemAssigner &) = delete;
+
+  IntervalBlockMemAssigner &operator=(const IntervalBlockMemAssigner &) = delete;
+
+  ~IntervalBlockMemAssigner() override = default;
+
+ protected:
+  ///
+  /// @ingroup GE
+  /// @brief resize memory blocks and place them by size and life time, falls back to stacking if it is not smaller
+  ///
+  void ResizeMemoryBlocks() override;
+};
+}  // namespace ge
+#endif  // GE_GRAPH_BUILD_MEMORY_INTERVAL_BLOCK_MEM_ASSIGNER_H_
@@ -35,4 +35,11 @@ OmgContext &GetLocalOmgContext() {
     return domi::GetContext();
   }
 }
+
+LocalContextGuard::LocalContextGuard() : ge_context_(GetThreadLocalContext()), omg_context_(omg_context) {}
+
+LocalContextGuard::~LocalContextGuard() {
+  GetThreadLocalContext() = ge_context_;
+  omg_context = omg_context_;
+}
 }  // namespace ge
@@ -17,10 +17,28 @@
 #ifndef GE_GRAPH_COMMON_LOCAL_CONTEXT_H_
 #define GE_GRAPH_COMMON_LOCAL_CONTEXT_H_
 
+#include "graph/ge_local_context.h"
 #include "omg/omg_inner_types.h"
 
 namespace ge {
 void SetLocalOmgContext(OmgContext &context);
 OmgContext &GetLocalOmgContext();
+
+///
+/// Saves the thread local ge and omg contexts and restores them on destruction.
+/// Used by tasks that set the contexts on a shared worker thread, so that they do not leak into later tasks.
+///
+class LocalContextGuard {
+ public:
+  LocalContextGuard();
+  ~LocalContextGuard();
+
+  LocalContextGuard(const LocalContextGuard &) = delete;
+  LocalContextGuard &operator=(const LocalContextGuard &) = delete;
+
+ private:
+  GEThreadLocalContext ge_context_;
+  OmgContext *omg_context_;
+};
 }  // namespace ge
 #endif  // GE_GRAPH_COMMON_LOCAL_CONTEXT_H_
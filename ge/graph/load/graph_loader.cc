@@ -119,7 +119,7 @@ Status GraphLoader::GetMaxUsedMemory(uint32_t model_id, uint64_t &max_size) {
 }
 
 Status GraphLoader::LoadDataFromFile(const std::string &path, const std::string &key_path, int32_t priority,
-                                     ModelData &model_data) {
+                                     ModelData &model_data, bool is_mapped) {
   Status ret;
   if (!CheckInputPathValid(path)) {
     GELOGE(GE_EXEC_MODEL_PATH_INVALID, "model path is invalid: %s", path.c_str());
@@ -132,13 +132,14 @@ Status GraphLoader::LoadDataFromFile(const std::string &path, const std::string
     return GE_EXEC_MODEL_KEY_PATH_INVALID;
   }
 
-  ret = DavinciModelParser::LoadFromFile(path.c_str(), key_path.c_str(), priority, model_data);
+  if (is_mapped) {
+    ret = DavinciModelParser::MapFromFile(path.c_str(), key_path.c_str(), priority, model_data);
+  } else {
+    ret = DavinciModelParser::LoadFromFile(path.c_str(), key_path.c_str(), priority, model_data);
+  }
   if (ret != SUCCESS) {
     GELOGE(ret, "LoadModelFromFile: Load failed. ret = %u", ret);
-    if (model_data.model_data != nullptr) {
-      delete[] static_cast<char *>(model_data.model_data);
-      model_data.model_data = nullptr;
-    }
+    DavinciModelParser::ReleaseModelData(model_data);
     return ret;
   }
   return SUCCESS;
@@ -148,30 +149,19 @@ Status GraphLoader::LoadModelFromFile(const std::string &path, const std::string
                                       const std::shared_ptr<ModelListener> &listener, uint32_t &model_id) {
   Status ret;
   ModelData model_data;
-  ret = LoadDataFromFile(path, key_path, priority, model_data);
+  ret = LoadDataFromFile(path, key_path, priority, model_data, true);
   if (ret != SUCCESS) {
     GELOGE(ret, "LoadModelFromFile: Load failed. ret = %u", ret);
-    if (model_data.model_data != nullptr) {
-      delete[] static_cast<char *>(model_data.model_data);
-      model_data.model_data = nullptr;
-    }
+    DavinciModelParser::ReleaseModelData(model_data);
     return ret;
   }
 
   ret = LoadModel(model_data, listener, model_id);
   if (ret != SUCCESS) {
     GELOGE(ret, "LoadModel: Load failed. ret = %u", ret);
-    if (model_data.model_data != nullptr) {
-      delete[] static_cast<char *>(model_data.model_data);
-      model_data.model_data = nullptr;
-    }
-  }
-
-  if (model_data.model_data != nullptr) {
-    delete[] static_cast<char *>(model_data.model_data);
-    model_data.model_data = nullptr;
   }
 
+  DavinciModelParser::ReleaseModelData(model_data);
   return ret;
 }
 
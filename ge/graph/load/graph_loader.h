@@ -54,8 +54,9 @@ class GraphLoader {
 
   static Status GetMemoryInfo(int64_t &free);
 
+  // a mapped model data must be released by DavinciModelParser::ReleaseModelData
   static Status LoadDataFromFile(const std::string &path, const std::string &key_path, int32_t priority,
-                                 ModelData &model_data);
+                                 ModelData &model_data, bool is_mapped = false);
 
   static Status LoadModelFromData(uint32_t &model_id, const ModelData &model_data, void *dev_ptr, size_t mem_size,
                                   void *weight_ptr, size_t weight_size);
@@ -34,6 +34,7 @@
 #include "common/profiling/profiling_manager.h"
 #include "common/properties_manager.h"
 #include "common/scope_guard.h"
+#include "common/task_scheduler.h"
 #include "common/thread_pool.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/common/ge_call_wrapper.h"
@@ -80,7 +81,6 @@ namespace {
 const uint32_t kDataIndex = 0;
 const uint32_t kOutputNum = 1;
 const uint32_t kTrueBranchStreamNum = 1;
-const uint32_t kThreadNum = 16;
 const uint32_t kAddrLen = sizeof(void *);
 const int kDecimal = 10;
 const int kBytes = 8;
@@ -88,6 +88,22 @@ const uint32_t kDataMemAlignSizeCompare = 64;
 const uint32_t kDumpL1FusionOpMByteSize = 2 * 1024 * 1024;
 const uint32_t kDumpFlagOfL1Fusion = 0;
 const char *const kDefaultBatchLable = "Batch_default";
+const char *const kEnvModelPipelineDepth = "GE_MODEL_PIPELINE_DEPTH";
+const int64_t kMaxPipelineDepth = 8;
+const uint32_t kInvalidSlotId = UINT32_MAX;
+const uint64_t kPipelineMemAlignSize = 512;
+// kernel tasks are initialized concurrently in chunks of consecutive tasks
+const size_t kMinTasksPerInitChunk = 64;
+// args carved from the args memory of the model, memcpy addr tasks need the alignment
+const size_t kTaskArgsAlignSize = 64;
+const size_t kMemcpyAddrArgsSize = 2 * sizeof(void *);
+const size_t kArgsNotCarved = SIZE_MAX;
+// updated args closer than this are uploaded by one copy, copying the clean bytes between them is cheaper than a copy
+const size_t kZeroCopyArgsMergeGap = 4096;
+
+inline size_t AlignTaskArgsSize(size_t size) {
+  return (size + kTaskArgsAlignSize - 1) / kTaskArgsAlignSize * kTaskArgsAlignSize;
+}
 
 inline bool IsDataOp(const std::string &node_type) {
   return node_type == DATA_TYPE || node_type == AIPP_DATA_TYPE || node_type == ANN_DATA_TYPE;
@@ -199,6 +215,10 @@ DavinciModel::~DavinciModel() {
     CleanTbeHandle();
 
     var_mem_base_ = nullptr;
+    if (task_args_mem_ != nullptr) {
+      GE_CHK_RT(rtFree(task_args_mem_));
+      task_args_mem_ = nullptr;
+    }
     if (known_node_) {
       if (args_ != nullptr) {
         GE_CHK_RT(rtFree(args_));
@@ -266,8 +286,8 @@ Status DavinciModel::InitModelMem(void *dev_ptr, size_t mem_size, void *weight_p
   is_model_has_inited_ = true;
 
   std::size_t data_size = TotalMemSize();
-  const Buffer &weights = ge_model_->GetWeight();
-  std::size_t weights_size = weights.GetSize();
+  const uint8_t *weights_data = ge_model_->GetWeightData();
+  std::size_t weights_size = ge_model_->GetWeightSize();
   GE_CHECK_LE(weights_size, ALLOC_MEMORY_MAX_SIZE);
 
   if ((dev_ptr != nullptr) && (mem_size < TotalMemSize())) {
@@ -313,7 +333,7 @@ Status DavinciModel::InitModelMem(void *dev_ptr, size_t mem_size, void *weight_p
     }
     GELOGI("[IMAS]InitModelMem graph_%u MallocMemory type[W] memaddr[%p] mem_size[%zu]", runtime_param_.graph_id,
            weights_mem_base_, weights_size);
-    GE_CHK_RT_RET(rtMemcpy(weights_mem_base_, weights_size, weights.GetData(), weights_size, RT_MEMCPY_HOST_TO_DEVICE));
+    GE_CHK_RT_RET(rtMemcpy(weights_mem_base_, weights_size, weights_data, weights_size, RT_MEMCPY_HOST_TO_DEVICE));
     GELOGI("copy weights data to device");
   }
 
@@ -427,10 +447,12 @@ Status DavinciModel::BindModelStream() {
 
 Status DavinciModel::DoTaskSink() {
   // task sink is supported as model_task_def is set
-  const auto &model_task_def = ge_model_->GetModelTaskDefPtr();
-  if (model_task_def == nullptr) {
+  if (!ge_model_->HasModelTaskDef()) {
     return SUCCESS;
   }
+  // the task partition of a loaded model is decoded here
+  const auto &model_task_def = ge_model_->GetModelTaskDefPtr();
+  GE_CHECK_NOTNULL(model_task_def);
 
   GE_CHK_RT_RET(rtGetAicpuDeploy(&deploy_type_));
   GELOGI("do task_sink. AiCpu deploy type is: %x.", deploy_type_);
@@ -2187,10 +2209,12 @@ void DavinciModel::SetProfileTime(ModelProcStage stage, int64_t endTime) {
 /// @param [in] data_id: the index of output_data
 /// @param [in/out] output_data: real user output_data
 /// @param [in] kind: the kind of rtMemcpy
+/// @param [in] src_addrs: copy from these addresses instead of the model outputs if not null
 /// @return Status result
 /// @author
 ///
-Status DavinciModel::CopyOutputData(uint32_t data_id, OutputData &output_data, rtMemcpyKind_t kind) {
+Status DavinciModel::CopyOutputData(uint32_t data_id, OutputData &output_data, rtMemcpyKind_t kind,
+                                    const std::map<uint32_t, void *> *src_addrs) {
   if (output_op_list_.empty()) {
     Status ret = SyncVarData();
     return ret;
@@ -2233,10 +2257,17 @@ Status DavinciModel::CopyOutputData(uint32_t data_id, OutputData &output_data, r
     uint64_t data_size = output.second.GetDataSize();
     uint64_t buffer_length = buffer.length;
     void *buffer_addr = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(buffer.data));
+    void *src_addr = output.second.GetBasicAddr();
+    if (src_addrs != nullptr) {
+      auto it = src_addrs->find(output.first);
+      if (it != src_addrs->end()) {
+        src_addr = it->second;
+      }
+    }
 
     GELOGI("[IMAS]CopyPlainData memcpy graph_%u type[F] output[%u] memaddr[%p] mem_size[%lu] datasize[%u]",
-           runtime_param_.graph_id, output.first, output.second.GetBasicAddr(), data_size, buffer_length);
-    GE_CHK_RT_RET(rtMemcpy(buffer_addr, buffer_length, output.second.GetBasicAddr(), data_size, kind));
+           runtime_param_.graph_id, output.first, src_addr, data_size, buffer_length);
+    GE_CHK_RT_RET(rtMemcpy(buffer_addr, buffer_length, src_addr, data_size, kind));
   }
   return SUCCESS;
 }
@@ -2291,11 +2322,12 @@ Status DavinciModel::GenOutputTensorInfo(const OpDescPtr &op_desc, uint32_t data
 /// @param [in] rslt_flg: result flag
 /// @param [in] seq_end_flag: sequence end flag
 /// @param [out] output_data: real user output_data
+/// @param [in] src_addrs: copy from these addresses instead of the model outputs if not null
 /// @return Status result
 /// @author
 ///
 Status DavinciModel::ReturnResult(uint32_t data_id, const bool rslt_flg, const bool seq_end_flag,
-                                  OutputData *output_data) {
+                                  OutputData *output_data, const std::map<uint32_t, void *> *src_addrs) {
   GE_CHK_BOOL_EXEC(listener_ != nullptr, return PARAM_INVALID, "listener_ is null.");
   std::vector<ge::OutputTensorInfo> outputs;
 
@@ -2335,7 +2367,7 @@ Status DavinciModel::ReturnResult(uint32_t data_id, const bool rslt_flg, const b
     data_index += op_desc->GetInputsSize();
   }
 
-  if (CopyOutputData(data_id, *output_data, RT_MEMCPY_DEVICE_TO_HOST) != SUCCESS) {
+  if (CopyOutputData(data_id, *output_data, RT_MEMCPY_DEVICE_TO_HOST, src_addrs) != SUCCESS) {
     GE_CHK_STATUS(listener_->OnComputeDone(model_id_, data_id, INTERNAL_ERROR, outputs), "OnComputeDone failed");
     return INTERNAL_ERROR;
   }
@@ -2369,6 +2401,15 @@ Status DavinciModel::ReturnNoOutput(uint32_t data_id) {
   return SUCCESS;
 }
 
+void DavinciModel::FinishIteration(const InputData &current_data) {
+  // pipelined execution is not enabled with profiling on, time info is sunk by the serial execution only
+  GE_IF_BOOL_EXEC(ProfilingManager::Instance().ProfilingModelExecuteOn(), (void)SinkTimeProfile(current_data));
+
+  iterator_count_++;
+  is_first_execute_ = false;
+  GELOGI("run iterator count is %lu", iterator_count_);
+}
+
 void *DavinciModel::Run(DavinciModel *model) {
   GE_CHK_BOOL_EXEC(model != nullptr,
                    CsaInteract::GetInstance().WriteErrorCode(FAILED, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
@@ -2492,11 +2533,7 @@ void *DavinciModel::Run(DavinciModel *model) {
                     GE_TIMESTAMP_EVENT_END(ReturnResult3, "GraphExcute::CopyDataFromDeviceToHost"));
     GE_IF_BOOL_EXEC(ProfilingManager::Instance().ProfilingModelExecuteOn(),
                     model->SetProfileTime(MODEL_AFTER_PROC_END));
-    GE_IF_BOOL_EXEC(ProfilingManager::Instance().ProfilingModelExecuteOn(), (void)model->SinkTimeProfile(current_data));
-
-    model->iterator_count_++;
-    model->is_first_execute_ = false;
-    GELOGI("run iterator count is %lu", model->iterator_count_);
+    model->FinishIteration(current_data);
   }
 
   CsaInteract::GetInstance().WriteInternalErrorCode();
@@ -2504,6 +2541,222 @@ void *DavinciModel::Run(DavinciModel *model) {
   return nullptr;
 }
 
+///
+/// @ingroup ge
+/// @brief create the in-flight slots of pipelined execution.
+/// @brief every slot owns device copies of the model inputs and outputs, so the inputs of the next requests and the
+/// @brief outputs of the finished ones are copied while the current request is executing.
+/// @return Status result
+///
+Status DavinciModel::InitPipeline() {
+  const char *depth_env = std::getenv(kEnvModelPipelineDepth);
+  if (depth_env == nullptr) {
+    return SUCCESS;
+  }
+  int64_t depth = std::strtol(depth_env, nullptr, kDecimal);
+  if (depth <= 1) {
+    return SUCCESS;
+  }
+  // variables and global step are synced from host for every request, and variable graphs broadcast them back
+  if (output_op_list_.empty() || !variable_op_list_.empty() || ProfilingManager::Instance().ProfilingOpTraceOn() ||
+      ProfilingManager::Instance().ProfilingModelExecuteOn()) {
+    GELOGW("Pipelined execution is not supported by model %u, requests are executed one by one.", model_id_);
+    return SUCCESS;
+  }
+  depth = std::min(depth, kMaxPipelineDepth);
+
+  uint64_t slot_mem_size = 0;
+  for (const auto &data : new_input_data_info_) {
+    slot_mem_size += (data.second.GetDataSize() + kPipelineMemAlignSize - 1) / kPipelineMemAlignSize *
+                     kPipelineMemAlignSize;
+  }
+  for (const auto &output : new_output_data_info_) {
+    slot_mem_size += (output.second.GetDataSize() + kPipelineMemAlignSize - 1) / kPipelineMemAlignSize *
+                     kPipelineMemAlignSize;
+  }
+
+  pipeline_slots_.resize(static_cast<size_t>(depth));
+  for (auto &slot : pipeline_slots_) {
+    GE_CHK_RT_RET(rtEventCreate(&slot.event));
+    if (slot_mem_size > 0) {
+      GE_CHK_RT_RET(rtMalloc(&slot.mem, slot_mem_size, RT_MEMORY_HBM));
+    }
+    uint8_t *addr = static_cast<uint8_t *>(slot.mem);
+    for (const auto &data : new_input_data_info_) {
+      slot.input_addrs[data.first] = addr;
+      addr += (data.second.GetDataSize() + kPipelineMemAlignSize - 1) / kPipelineMemAlignSize * kPipelineMemAlignSize;
+    }
+    for (const auto &output : new_output_data_info_) {
+      slot.output_addrs[output.first] = addr;
+      addr +=
+        (output.second.GetDataSize() + kPipelineMemAlignSize - 1) / kPipelineMemAlignSize * kPipelineMemAlignSize;
+    }
+  }
+
+  for (uint32_t i = 0; i < pipeline_slots_.size(); ++i) {
+    (void)free_slots_.Push(i);
+  }
+  pipeline_depth_ = static_cast<uint32_t>(depth);
+  GELOGI("Pipelined execution enabled, model id:%u, depth:%u, slot memory size:%lu.", model_id_, pipeline_depth_,
+         slot_mem_size);
+  return SUCCESS;
+}
+
+void DavinciModel::ReleasePipeline() {
+  if (pipeline_depth_ > 1) {
+    // both threads are stopped, all slots are back in the free list
+    uint32_t slot_id = kInvalidSlotId;
+    for (uint32_t i = 0; i < pipeline_depth_; ++i) {
+      (void)free_slots_.Pop(slot_id);
+    }
+  }
+  for (auto &slot : pipeline_slots_) {
+    if (slot.event != nullptr) {
+      GE_LOGW_IF(rtEventDestroy(slot.event) != RT_ERROR_NONE, "Destroy event failed.");
+      slot.event = nullptr;
+    }
+    if (slot.mem != nullptr) {
+      GE_CHK_RT(rtFree(slot.mem));
+      slot.mem = nullptr;
+    }
+  }
+  pipeline_slots_.clear();
+  pipeline_depth_ = 1;
+}
+
+Status DavinciModel::LaunchPipelineSlot(const InputData &input_data, PipelineSlot &slot) {
+  slot.is_launched = false;
+  const std::vector<DataBuffer> &blobs = input_data.blobs;
+  for (const auto &data : new_input_data_info_) {
+    if (data.first >= blobs.size()) {
+      GELOGE(FAILED, "Blobs not match: blobs=%zu, tensor=%zu, index=%u", blobs.size(), new_input_data_info_.size(),
+             data.first);
+      return FAILED;
+    }
+
+    const DataBuffer &data_buf = blobs[data.first];
+    if (data_buf.length == 0) {
+      GELOGW("No data need to memcpy, input index:%u.", data.first);
+      continue;
+    }
+    uint64_t data_size = data.second.GetDataSize();
+    GE_CHK_BOOL_RET_STATUS(data_size >= data_buf.length, PARAM_INVALID,
+                           "input data size(%lu) does not match model required size(%lu), ret failed.", data_buf.length,
+                           data_size);
+    void *staging_addr = slot.input_addrs[data.first];
+    GE_CHK_RT_RET(rtMemcpy(staging_addr, data_size, data_buf.data, data_buf.length, RT_MEMCPY_HOST_TO_DEVICE));
+    // the model input is overwritten only after the previous request on the stream has finished
+    GE_CHK_RT_RET(rtMemcpyAsync(data.second.GetBasicAddr(), data_size, staging_addr, data_buf.length,
+                                RT_MEMCPY_DEVICE_TO_DEVICE, rt_model_stream_));
+  }
+
+  GE_CHK_RT_RET(rtModelExecute(rt_model_handle_, rt_model_stream_, 0));
+
+  for (const auto &output : new_output_data_info_) {
+    uint64_t data_size = output.second.GetDataSize();
+    if (data_size == 0) {
+      continue;
+    }
+    GE_CHK_RT_RET(rtMemcpyAsync(slot.output_addrs[output.first], data_size, output.second.GetBasicAddr(), data_size,
+                                RT_MEMCPY_DEVICE_TO_DEVICE, rt_model_stream_));
+  }
+  GE_CHK_RT_RET(rtEventRecord(slot.event, rt_model_stream_));
+  slot.is_launched = true;
+  return SUCCESS;
+}
+
+void *DavinciModel::RunPipelined(DavinciModel *model) {
+  GE_CHK_BOOL_EXEC(model != nullptr,
+                   CsaInteract::GetInstance().WriteErrorCode(FAILED, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+                   return nullptr, "model_pointer is null!")
+  uint32_t model_id = model->Id();
+  uint32_t device_id = model->GetDeviceId();
+
+  GELOGI("Model pipelined run thread start, model_id:%u, depth:%u.", model_id, model->pipeline_depth_);
+  rtError_t rt_ret = rtSetDevice(static_cast<int32_t>(device_id));
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(FAILED, "Model run rtsetdevice failed.");
+    return nullptr;
+  }
+  // DeviceReset before thread run finished!
+  GE_MAKE_GUARD(not_used_var, [&] { GE_CHK_RT(rtDeviceReset(device_id)); });
+
+  while (model->RunFlag()) {
+    if (model->GetDataInputer() == nullptr) {
+      GELOGW("Data inputer is nullptr.");
+      CsaInteract::GetInstance().StoreInternalErrorCode(FAILED, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+      break;
+    }
+
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    Status ret = model->GetDataInputer()->Pop(data_wrapper);
+    if (data_wrapper == nullptr || ret != SUCCESS) {
+      GELOGI("data_wrapper is null!");
+      continue;
+    }
+    GE_IF_BOOL_EXEC(!model->RunFlag(), break);
+
+    // blocks while pipeline_depth_ requests are in flight
+    uint32_t slot_id = kInvalidSlotId;
+    if (!model->free_slots_.Pop(slot_id) || slot_id >= model->pipeline_slots_.size()) {
+      GELOGE(INTERNAL_ERROR, "Failed to get free slot, model id:%u.", model_id);
+      break;
+    }
+    PipelineSlot &slot = model->pipeline_slots_[slot_id];
+    slot.data_wrapper = data_wrapper;
+    GELOGI("Model thread launch, model id:%u, data index:%u, slot:%u.", model_id, data_wrapper->GetInput().index,
+           slot_id);
+    ret = model->LaunchPipelineSlot(data_wrapper->GetInput(), slot);
+    if (ret != SUCCESS) {
+      GELOGE(ret, "Launch request failed, model id:%u, data index:%u.", model_id, data_wrapper->GetInput().index);
+      CsaInteract::GetInstance().StoreInternalErrorCode(ret, ERROR_MODULE_FMK, JOBSUBSTATE_GRAPH_EXEC);
+    }
+    // failed requests are returned by the completion thread as well, to keep the results in order
+    (void)model->inflight_slots_.Push(slot_id);
+  }
+
+  CsaInteract::GetInstance().WriteInternalErrorCode();
+  GELOGI("Model pipelined run end, model id:%u", model_id);
+  return nullptr;
+}
+
+void *DavinciModel::RunPipelineCompletion(DavinciModel *model) {
+  GE_CHK_BOOL_EXEC(model != nullptr, return nullptr, "model_pointer is null!")
+  uint32_t device_id = model->GetDeviceId();
+  // keep draining the slots even if the device can not be set, the run thread is waiting for them
+  rtError_t rt_ret = rtSetDevice(static_cast<int32_t>(device_id));
+  bool is_device_set = (rt_ret == RT_ERROR_NONE);
+  GE_IF_BOOL_EXEC(!is_device_set, GELOGE(FAILED, "Model completion rtsetdevice failed."));
+  GE_MAKE_GUARD(not_used_var, [&] { GE_IF_BOOL_EXEC(is_device_set, GE_CHK_RT(rtDeviceReset(device_id))); });
+
+  uint32_t slot_id = kInvalidSlotId;
+  while (model->inflight_slots_.Pop(slot_id) && slot_id < model->pipeline_slots_.size()) {
+    PipelineSlot &slot = model->pipeline_slots_[slot_id];
+    uint32_t data_index = slot.data_wrapper->GetInput().index;
+    OutputData *output_data = slot.data_wrapper->GetOutput();
+    if (!slot.is_launched) {
+      (void)model->ReturnResult(data_index, false, false, output_data);
+    } else {
+      rt_ret = rtEventSynchronize(slot.event);
+      if (rt_ret == RT_ERROR_NONE) {
+        // copy output data of the slot from device to host
+        (void)model->ReturnResult(data_index, true, false, output_data, &slot.output_addrs);
+        model->FinishIteration(slot.data_wrapper->GetInput());
+      } else {
+        bool seq_end_flag = (rt_ret == RT_ERROR_END_OF_SEQUENCE);
+        GELOGI("seq_end_flg: %d", seq_end_flag);
+        (void)model->ReturnResult(data_index, false, seq_end_flag, output_data, &slot.output_addrs);
+        CsaInteract::GetInstance().StoreInternalErrorCode(rt_ret, ERROR_MODULE_RUNTIME, JOBSUBSTATE_GRAPH_EXEC);
+      }
+    }
+    slot.data_wrapper.reset();
+    (void)model->free_slots_.Push(slot_id);
+  }
+
+  GELOGI("Model pipeline completion end, model id:%u", model->model_id_);
+  return nullptr;
+}
+
 ///
 /// @ingroup ge
 /// @brief call API provided by data inputer to destroy thread
@@ -2522,6 +2775,13 @@ Status DavinciModel::DestroyThread() {
     thread_id_.join();
   }
 
+  if (pipeline_thread_.joinable()) {
+    // the requests already launched are completed before the thread exits
+    (void)inflight_slots_.Push(kInvalidSlotId);
+    pipeline_thread_.join();
+  }
+  ReleasePipeline();
+
   return SUCCESS;
 }
 
@@ -2552,7 +2812,13 @@ Status DavinciModel::ModelRunStart() {
   int64_t maxDumpOpNum = std::strtol(opt.c_str(), nullptr, kDecimal);
   maxDumpOpNum_ = maxDumpOpNum;
 
-  CREATE_STD_THREAD(thread_id_, DavinciModel::Run, this);
+  GE_CHK_STATUS_RET(InitPipeline(), "Init pipelined execution failed, model id:%u.", model_id_);
+  if (pipeline_depth_ > 1) {
+    CREATE_STD_THREAD(pipeline_thread_, DavinciModel::RunPipelineCompletion, this);
+    CREATE_STD_THREAD(thread_id_, DavinciModel::RunPipelined, this);
+  } else {
+    CREATE_STD_THREAD(thread_id_, DavinciModel::Run, this);
+  }
   GELOGI("model tread create success, model id:%u.", model_id_);
   return SUCCESS;
 }
@@ -2691,6 +2957,13 @@ Status DavinciModel::UpdateKnownNodeArgs(const vector<void *> &inputs, const vec
 Status DavinciModel::InitTaskInfo(domi::ModelTaskDef &model_task_def) {
   GELOGI("InitTaskInfo in, task size %zu", model_task_def.task().size());
   task_list_.resize(model_task_def.task_size());
+  GE_CHK_STATUS_RET(MallocTaskArgsMem(model_task_def), "Malloc task args memory failed.");
+  // the args are written again by the init, take the host copy of them again at the next run
+  zero_copy_args_layout_.clear();
+  // kernel tasks only touch the shared members of the model through locked interfaces, known node models record
+  // the io addrs of every task in task order
+  bool parallel_init = !known_node_ && TaskScheduler::GetInstance().GetWorkerNum() > 1;
+  std::vector<int> kernel_tasks;
   for (int i = 0; i < model_task_def.task_size(); ++i) {
     // dynamic shape will create task_list_ before
     const domi::TaskDef &task = model_task_def.task(i);
@@ -2698,19 +2971,134 @@ Status DavinciModel::InitTaskInfo(domi::ModelTaskDef &model_task_def) {
       task_list_[i] = TaskInfoFactory::Instance().Create(static_cast<rtModelTaskType_t>(task.type()));
     }
     GE_CHECK_NOTNULL(task_list_[i]);
+    if (parallel_init && static_cast<rtModelTaskType_t>(task.type()) == RT_MODEL_TASK_KERNEL) {
+      kernel_tasks.emplace_back(i);
+      continue;
+    }
     Status ret = task_list_[i]->Init(task, this);
     if (ret != SUCCESS) {
       GELOGE(ret, "Task index %d init failed.", i);
       return ret;
     }
   }
+
+  GE_CHK_STATUS_RET(InitKernelTasks(model_task_def, kernel_tasks), "Init kernel tasks failed.");
   GELOGI("InitTaskInfo out");
   return SUCCESS;
 }
 
+Status DavinciModel::MallocTaskArgsMem(const domi::ModelTaskDef &model_task_def) {
+  // known node models carve the args from their own args memory, tasks of a reloaded model are carved again
+  if (known_node_ || task_args_mem_ != nullptr) {
+    return SUCCESS;
+  }
+  size_t mem_size = 0;
+  for (int i = 0; i < model_task_def.task_size(); ++i) {
+    const domi::TaskDef &task = model_task_def.task(i);
+    auto task_type = static_cast<rtModelTaskType_t>(task.type());
+    if (task_type == RT_MODEL_TASK_KERNEL) {
+      auto kernel_type = static_cast<cce::ccKernelType>(task.kernel().context().kernel_type());
+      if (kernel_type == cce::ccKernelType::TE || kernel_type == cce::ccKernelType::AI_CPU ||
+          kernel_type == cce::ccKernelType::CUST_AI_CPU) {
+        mem_size += AlignTaskArgsSize(task.kernel().args_size());
+      }
+    } else if (task_type == RT_MODEL_TASK_MEMCPY_ADDR_ASYNC) {
+      mem_size += AlignTaskArgsSize(kMemcpyAddrArgsSize);
+    }
+  }
+  if (mem_size == 0) {
+    return SUCCESS;
+  }
+
+  void *mem = nullptr;
+  // the alignment of device memory is no less than kTaskArgsAlignSize
+  GE_CHK_RT_RET(rtMalloc(&mem, mem_size, RT_MEMORY_HBM));
+  GE_PRINT_DYNAMIC_MEMORY(rtMalloc, "task args memory.", mem_size)
+  task_args_mem_ = static_cast<uint8_t *>(mem);
+  task_args_mem_size_ = mem_size;
+  task_args_mem_offset_ = 0;
+  GELOGI("[ZCPY] Malloc task args memory, addr: %p, size: %zu.", task_args_mem_, task_args_mem_size_);
+  return SUCCESS;
+}
+
+void *DavinciModel::CarveTaskArgs(size_t size) {
+  size_t aligned_size = AlignTaskArgsSize(size);
+  std::lock_guard<std::mutex> lk(task_args_mem_mutex_);
+  if (task_args_mem_ == nullptr || aligned_size > task_args_mem_size_ - task_args_mem_offset_) {
+    return nullptr;
+  }
+  void *args = task_args_mem_ + task_args_mem_offset_;
+  task_args_mem_offset_ += aligned_size;
+  return args;
+}
+
+Status DavinciModel::InitKernelTasks(const domi::ModelTaskDef &model_task_def, const std::vector<int> &task_indexes) {
+  if (task_indexes.empty()) {
+    return SUCCESS;
+  }
+  size_t chunk_num = (task_indexes.size() + kMinTasksPerInitChunk - 1) / kMinTasksPerInitChunk;
+  chunk_num = std::min(chunk_num, static_cast<size_t>(TaskScheduler::GetInstance().GetWorkerNum()));
+  std::vector<Status> results(task_indexes.size(), SUCCESS);
+  auto init_tasks = [&](rtContext_t context, size_t begin, size_t end) {
+    // workers of the scheduler are shared, restore their context when done
+    rtContext_t origin_context = nullptr;
+    (void)rtCtxGetCurrent(&origin_context);
+    if (rtCtxSetCurrent(context) != RT_ERROR_NONE) {
+      std::fill(results.begin() + begin, results.begin() + end, RT_FAILED);
+      return;
+    }
+    for (size_t i = begin; i < end; ++i) {
+      int task_index = task_indexes[i];
+      results[i] = task_list_[task_index]->Init(model_task_def.task(task_index), this);
+      if (results[i] != SUCCESS) {
+        break;
+      }
+    }
+    if (origin_context != nullptr && origin_context != context) {
+      (void)rtCtxSetCurrent(origin_context);
+    }
+  };
+
+  rtContext_t context = nullptr;
+  GE_CHK_RT_RET(rtCtxGetCurrent(&context));
+  size_t zero_copy_task_num = zero_copy_tasks_.size();
+  if (chunk_num <= 1) {
+    init_tasks(context, 0, task_indexes.size());
+  } else {
+    GELOGI("Init %zu kernel tasks in %zu chunks.", task_indexes.size(), chunk_num);
+    size_t tasks_per_chunk = (task_indexes.size() + chunk_num - 1) / chunk_num;
+    TaskGroup group;
+    for (size_t begin = 0; begin < task_indexes.size(); begin += tasks_per_chunk) {
+      size_t end = std::min(begin + tasks_per_chunk, task_indexes.size());
+      auto future = group.Commit(init_tasks, context, begin, end);
+      if (!future.valid()) {
+        group.Wait();
+        GELOGE(FAILED, "Failed to commit init task of kernel tasks [%zu, %zu).", begin, end);
+        return FAILED;
+      }
+    }
+    group.Wait();
+    // chunks add zero copy tasks in any order, sort them to keep the model the same from load to load
+    std::stable_sort(zero_copy_tasks_.begin() + zero_copy_task_num, zero_copy_tasks_.end(),
+                     [](const ZeroCopyTask &lhs, const ZeroCopyTask &rhs) { return lhs.GetOpId() < rhs.GetOpId(); });
+    zero_copy_args_index_.clear();
+    zero_copy_args_layout_.clear();
+  }
+
+  // report the first failed task, same as the serial init
+  for (size_t i = 0; i < task_indexes.size(); ++i) {
+    if (results[i] != SUCCESS) {
+      GELOGE(results[i], "Task index %d init failed.", task_indexes[i]);
+      return results[i];
+    }
+  }
+  return SUCCESS;
+}
+
 Status DavinciModel::MallocKnownArgs() {
   GELOGI("DavinciModel::MallocKnownArgs in");
   const auto &model_task_def = ge_model_->GetModelTaskDefPtr();
+  GE_CHECK_NOTNULL(model_task_def);
   if (model_task_def->task_size() == 0) {
     GELOGW("DavinciModel::MallocKnownArgs davincimodel has no task info.");
     return SUCCESS;
@@ -2767,6 +3155,7 @@ Status DavinciModel::DistributeTask() {
   }
 
   const auto &model_task_def = ge_model_->GetModelTaskDefPtr();
+  GE_CHECK_NOTNULL(model_task_def);
   GELOGI("there are %zu task need to save.", task_list_.size());
   for (size_t task_index = 0; task_index < task_list_.size(); ++task_index) {
     auto &task = task_list_.at(task_index);
@@ -2911,6 +3300,7 @@ void DavinciModel::SetZeroCopyAddr(const OpDescPtr &op_desc, const std::vector<v
       }
     }
   }
+  zero_copy_task.SetOpId(op_desc->GetId());
   auto it = zero_copy_op_id_batch_label_.find(op_desc->GetId());
   if (it == zero_copy_op_id_batch_label_.end()) {
     zero_copy_task.SetBatchLabel(kDefaultBatchLable);
@@ -2922,6 +3312,8 @@ void DavinciModel::SetZeroCopyAddr(const OpDescPtr &op_desc, const std::vector<v
   if (zero_copy_task.IsTaskArgsSet()) {
     zero_copy_task.SetOriginalArgs(info, offset + nums * kAddrLen);
     zero_copy_tasks_.emplace_back(zero_copy_task);
+    zero_copy_args_index_.clear();
+    zero_copy_args_layout_.clear();
   }
 }
 
@@ -2946,6 +3338,33 @@ void DavinciModel::SetBatchLabelAddr(const OpDescPtr &op_desc, uintptr_t addr) {
   }
 }
 
+const DavinciModel::ZeroCopyArgsIndex &DavinciModel::GetZeroCopyArgsIndex(const string &batch_label) {
+  auto it = zero_copy_args_index_.find(batch_label);
+  if (it != zero_copy_args_index_.end()) {
+    return it->second;
+  }
+
+  ZeroCopyArgsIndex &args_index = zero_copy_args_index_[batch_label];
+  size_t slot_num = 0;
+  for (ZeroCopyTask &task : zero_copy_tasks_) {
+    if (task.GetBatchLabel() != kDefaultBatchLable && task.GetBatchLabel() != batch_label) {
+      continue;
+    }
+    for (const auto &addr_offsets : task.GetTaskArgsOffset()) {
+      for (auto offset : addr_offsets.second) {
+        if (!task.CheckDynamicBatch(zero_copy_batch_label_addrs_, batch_label, task.GetArgsAddr(offset))) {
+          continue;
+        }
+        args_index[addr_offsets.first].push_back({&task, offset});
+        ++slot_num;
+      }
+    }
+  }
+  GELOGI("[ZCPY] Build args index of batch label %s, task num: %zu, addr num: %zu, slot num: %zu.",
+         batch_label.c_str(), zero_copy_tasks_.size(), args_index.size(), slot_num);
+  return args_index;
+}
+
 ///
 /// @ingroup ge
 /// @brief Copy Check input size and model op size.
@@ -3013,15 +3432,93 @@ Status DavinciModel::CopyModelData(const InputData &input_data, OutputData &outp
     return PARAM_INVALID;
   }
 
-  for (ZeroCopyTask &task : zero_copy_tasks_) {
-    GE_CHK_STATUS_RET(task.DistributeParam(is_async_mode_, rt_model_stream_), "[ZCPY] Update args failed.");
-  }
+  GE_CHK_STATUS_RET(DistributeZeroCopyArgs(), "[ZCPY] Update args failed.");
 
   output_data.index = input_data.index;
   output_data.model_id = model_id_;
   return SUCCESS;
 }
 
+Status DavinciModel::DistributeZeroCopyArgs() {
+  // carved args are only written by the init of their task, which clears the layout or carves more args. Taking
+  // the host copy again in both cases keeps it the same as the device for the bytes outside of the zero copy slots.
+  if ((zero_copy_args_layout_.size() != zero_copy_tasks_.size()) ||
+      (zero_copy_args_host_.size() != task_args_mem_offset_)) {
+    zero_copy_args_host_.resize(task_args_mem_offset_);
+    if (!zero_copy_args_host_.empty()) {
+      GE_CHK_RT_RET(rtMemcpy(zero_copy_args_host_.data(), zero_copy_args_host_.size(), task_args_mem_,
+                             zero_copy_args_host_.size(), RT_MEMCPY_DEVICE_TO_HOST));
+    }
+    zero_copy_args_layout_.clear();
+    uintptr_t mem_begin = reinterpret_cast<uintptr_t>(task_args_mem_);
+    uintptr_t mem_end = mem_begin + zero_copy_args_host_.size();
+    for (size_t i = 0; i < zero_copy_tasks_.size(); ++i) {
+      uintptr_t args_addr = zero_copy_tasks_[i].GetArgsAddr(0);
+      bool is_carved = args_addr >= mem_begin && args_addr < mem_end &&
+                       zero_copy_tasks_[i].GetArgsInfo().size() <= mem_end - args_addr;
+      zero_copy_args_layout_.emplace_back(i, is_carved ? args_addr - mem_begin : kArgsNotCarved);
+    }
+    GELOGI("[ZCPY] Build args layout, task num: %zu, args memory size: %zu.", zero_copy_tasks_.size(),
+           zero_copy_args_host_.size());
+  }
+
+  size_t copy_num = 0;
+  auto upload = [this, &copy_num](void *dst, const uint8_t *src, size_t size) -> Status {
+    rtError_t rt_err = RT_ERROR_NONE;
+    if (is_async_mode_) {
+      rt_err = rtMemcpyAsync(dst, size, src, size, RT_MEMCPY_HOST_TO_DEVICE_EX, rt_model_stream_);
+    } else {
+      rt_err = rtMemcpy(dst, size, src, size, RT_MEMCPY_HOST_TO_DEVICE);
+    }
+    if (rt_err != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "[ZCPY] Distribute task args failed, args_addr: %p, size: %zu, error=0x%x", dst, size, rt_err);
+      return RT_ERROR_TO_GE_STATUS(rt_err);
+    }
+    ++copy_num;
+    return SUCCESS;
+  };
+
+  // [begin, end) of zero_copy_args_host_ updated by every task
+  std::vector<std::pair<size_t, size_t>> updated_ranges;
+  for (const auto &task_offset : zero_copy_args_layout_) {
+    ZeroCopyTask &task = zero_copy_tasks_[task_offset.first];
+    if (!task.IsUpdated()) {
+      continue;
+    }
+    task.ClearUpdated();
+    const vector<uint8_t> &args_info = task.GetArgsInfo();
+    if (args_info.empty()) {
+      continue;
+    }
+    if (task_offset.second == kArgsNotCarved) {
+      GE_CHK_STATUS_RET_NOLOG(upload(reinterpret_cast<void *>(task.GetArgsAddr(0)), args_info.data(),
+                                     args_info.size()));
+      continue;
+    }
+    if (memcpy_s(zero_copy_args_host_.data() + task_offset.second, zero_copy_args_host_.size() - task_offset.second,
+                 args_info.data(), args_info.size()) != EOK) {
+      GELOGE(FAILED, "[ZCPY] Copy args to host buffer failed, size: %zu", args_info.size());
+      return FAILED;
+    }
+    updated_ranges.emplace_back(task_offset.second, task_offset.second + args_info.size());
+  }
+
+  // args are carved in the order the tasks are initialized, not the order of the zero copy tasks
+  std::sort(updated_ranges.begin(), updated_ranges.end());
+  size_t i = 0;
+  while (i < updated_ranges.size()) {
+    size_t begin = updated_ranges[i].first;
+    size_t end = updated_ranges[i].second;
+    for (++i; i < updated_ranges.size() && updated_ranges[i].first <= end + kZeroCopyArgsMergeGap; ++i) {
+      end = std::max(end, updated_ranges[i].second);
+    }
+    GE_CHK_STATUS_RET_NOLOG(upload(task_args_mem_ + begin, zero_copy_args_host_.data() + begin, end - begin));
+  }
+  zero_copy_args_copy_num_ = copy_num;
+  GELOGD("[ZCPY] Distribute args of %zu tasks by %zu copies.", zero_copy_tasks_.size(), copy_num);
+  return SUCCESS;
+}
+
 ///
 /// @ingroup ge
 /// @brief Copy Data addr to model for direct use.
@@ -3042,6 +3539,7 @@ Status DavinciModel::UpdateIoTaskArgs(const std::map<uint32_t, ZeroCopyOffset> &
     return FAILED;
   }
 
+  const ZeroCopyArgsIndex &args_index = GetZeroCopyArgsIndex(batch_label);
   for (const auto &data : data_info) {
     if (data.first >= blobs.size()) {  // check data index.
       GELOGE(FAILED, "Verify %s data num failed: can not find No.%zu data, because user only feeds %zu",
@@ -3082,14 +3580,12 @@ Status DavinciModel::UpdateIoTaskArgs(const std::map<uint32_t, ZeroCopyOffset> &
       GELOGI("[ZCPY] Copy %s blobs_index %u, virtual_addr: %p, size: %ld, user_data_addr: %p", input_or_output.c_str(),
              data.first, addr, size, buffer_addr);
       // For input data, just copy for rts task.
-      for (ZeroCopyTask &task : zero_copy_tasks_) {
-        if (task.GetBatchLabel() != kDefaultBatchLable && task.GetBatchLabel() != batch_label) {
-          continue;
-        }
-        uintptr_t addr_val = reinterpret_cast<uintptr_t>(addr);
-        if (task.UpdateTaskParam(addr_val, buffer_addr, zero_copy_batch_label_addrs_, batch_label) != SUCCESS) {
-          return FAILED;
-        }
+      auto iter = args_index.find(reinterpret_cast<uintptr_t>(addr));
+      if (iter == args_index.end()) {
+        continue;
+      }
+      for (const auto &args_ref : iter->second) {
+        args_ref.task->SetTaskParam(args_ref.offset, buffer_addr);
       }
     }
   }
@@ -3123,6 +3619,7 @@ void DavinciModel::GetUniqueId(const OpDescPtr &op_desc, std::string &unique_ide
 /// @return void*
 ///
 const char *DavinciModel::GetRegisterStub(const string &binfile, const string &session_graph_id) {
+  std::lock_guard<std::mutex> lock(tvm_bin_kernel_mutex_);
   string binfile_key;
   if (session_graph_id.empty()) {
     binfile_key = binfile;
@@ -3447,8 +3944,9 @@ Status DavinciModel::NnExecute(rtStream_t stream, bool async_mode, const InputDa
   GELOGI("Model Run begin, model id:%u, data index:%u, flag:%d.", model_id_, input_data.index, is_async_mode_);
   GE_CHK_STATUS_RET(InitModelStream(stream), "Init model stream failed.");
   is_dynamic_ = input_data.is_dynamic_batch;
-  if (!is_dynamic_) {
+  if (!is_dynamic_ && !zero_copy_batch_label_addrs_.empty()) {
     zero_copy_batch_label_addrs_.clear();
+    zero_copy_args_index_.clear();
   }
 
   GE_IF_BOOL_EXEC(ProfilingManager::Instance().ProfilingModelExecuteOn(), SetProfileTime(MODEL_PRE_PROC_START));
@@ -3613,8 +4111,7 @@ Status DavinciModel::TransAllVarData(ComputeGraphPtr &graph, uint32_t graph_id)
     variable_node_list.emplace_back(node);
   }
 
-  GE_CHK_STATUS_RET_NOLOG(
-    TransVarDataUtils::TransAllVarData(variable_node_list, session_id_, ctx, graph_id, kThreadNum));
+  GE_CHK_STATUS_RET_NOLOG(TransVarDataUtils::TransAllVarData(variable_node_list, session_id_, ctx, graph_id));
 
   GELOGI("TransAllVarData success.");
   return SUCCESS;
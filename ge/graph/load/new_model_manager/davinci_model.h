@@ -22,8 +22,10 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "common/blocking_queue.h"
 #include "common/ge_types.h"
 #include "common/helper/model_helper.h"
 #include "common/helper/om_file_helper.h"
@@ -137,6 +139,20 @@ class DavinciModel {
 
   static void *Run(DavinciModel *model_pointer);
 
+  ///
+  /// @ingroup ge
+  /// @brief launch requests without waiting for the previous ones, used when pipelined execution is enabled
+  /// @param [in] model_pointer: model to run
+  ///
+  static void *RunPipelined(DavinciModel *model_pointer);
+
+  ///
+  /// @ingroup ge
+  /// @brief wait for the launched requests in order and return their results
+  /// @param [in] model_pointer: model to run
+  ///
+  static void *RunPipelineCompletion(DavinciModel *model_pointer);
+
   ///
   /// @ingroup ge
   /// @brief NnExecute
@@ -349,7 +365,8 @@ class DavinciModel {
                                            vector<InputOutputDescInfo> &output_desc,
                                            std::vector<uint32_t> &inputFormats, std::vector<uint32_t> &output_formats);
 
-  Status ReturnResult(uint32_t data_id, const bool rslt_flg, const bool seq_end_flg, OutputData *output_data);
+  Status ReturnResult(uint32_t data_id, const bool rslt_flg, const bool seq_end_flg, OutputData *output_data,
+                      const std::map<uint32_t, void *> *src_addrs = nullptr);
 
   Status ReturnNoOutput(uint32_t data_id);
 
@@ -480,6 +497,14 @@ class DavinciModel {
     }
     return UINT32_MAX;
   }
+  ///
+  /// @ingroup ge
+  /// @brief carve the args of a task from the args memory of the model, which is uploaded in batch for zero copy
+  /// @param [in] size: args size
+  /// @return args addr, nullptr if the args memory is used up and the task has to malloc its own
+  ///
+  void *CarveTaskArgs(size_t size);
+
   void SetKnownNode(bool known_node) { known_node_ = known_node; }
   bool IsKnownNode() { return known_node_; }
   Status MallocKnownArgs();
@@ -573,9 +598,76 @@ class DavinciModel {
   Status UpdateIoTaskArgs(const std::map<uint32_t, ZeroCopyOffset> &data_info, bool is_input,
                           const vector<DataBuffer> &blobs, bool is_dynamic, const string &batch_label);
 
+  // slot of zero copy task args patched by a model input or output address
+  struct ZeroCopyArgsRef {
+    ZeroCopyTask *task;
+    size_t offset;
+  };
+  using ZeroCopyArgsIndex = std::unordered_map<uintptr_t, std::vector<ZeroCopyArgsRef>>;
+
+  ///
+  /// @ingroup ge
+  /// @brief Get the index from virtual address to the task args slots used by the batch label, build it if absent.
+  /// @param [in] batch_label: batch label for multi-batch scenes
+  /// @return index of the batch label
+  ///
+  const ZeroCopyArgsIndex &GetZeroCopyArgsIndex(const string &batch_label);
+
+  ///
+  /// @ingroup ge
+  /// @brief Upload the updated args of zero copy tasks. The args carved from the args memory of the model are
+  /// @brief patched on a host copy of it, and the updated ranges close to each other are uploaded by one copy.
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  Status DistributeZeroCopyArgs();
+
+  ///
+  /// @ingroup ge
+  /// @brief Malloc the args memory of the model for the tasks whose args may be patched by zero copy.
+  /// @param [in] model_task_def: tasks of the model
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  Status MallocTaskArgsMem(const domi::ModelTaskDef &model_task_def);
+
   Status CopyInputData(const InputData &input_data, bool device_data = false);
 
-  Status CopyOutputData(uint32_t data_id, OutputData &output_data, rtMemcpyKind_t kind);
+  Status CopyOutputData(uint32_t data_id, OutputData &output_data, rtMemcpyKind_t kind,
+                        const std::map<uint32_t, void *> *src_addrs = nullptr);
+
+  // device buffers and completion event of one in-flight request in pipelined execution
+  struct PipelineSlot {
+    void *mem = nullptr;
+    std::map<uint32_t, void *> input_addrs;
+    std::map<uint32_t, void *> output_addrs;
+    rtEvent_t event = nullptr;
+    std::shared_ptr<InputDataWrapper> data_wrapper;
+    bool is_launched = false;
+  };
+
+  ///
+  /// @ingroup ge
+  /// @brief create the in-flight slots if pipelined execution is enabled and supported by the model
+  /// @return Status
+  ///
+  Status InitPipeline();
+
+  void ReleasePipeline();
+
+  ///
+  /// @ingroup ge
+  /// @brief stage the inputs of one request and launch it on rt_model_stream_ without waiting
+  /// @param [in] input_data: user input data
+  /// @param [in] slot: slot of the request
+  /// @return Status
+  ///
+  Status LaunchPipelineSlot(const InputData &input_data, PipelineSlot &slot);
+
+  ///
+  /// @ingroup ge
+  /// @brief bookkeeping of a request whose results are returned, shared by the serial and pipelined execution
+  /// @param [in] current_data: input data of the request
+  ///
+  void FinishIteration(const InputData &current_data);
 
   Status SyncVarData();
 
@@ -589,6 +681,15 @@ class DavinciModel {
 
   Status InitTaskInfo(domi::ModelTaskDef &modelTaskInfo);
 
+  ///
+  /// @ingroup ge
+  /// @brief init kernel tasks concurrently, the results do not depend on the order of init
+  /// @param [in] model_task_def: task defs of model
+  /// @param [in] task_indexes: indexes of the kernel tasks in model_task_def
+  /// @return Status
+  ///
+  Status InitKernelTasks(const domi::ModelTaskDef &model_task_def, const std::vector<int> &task_indexes);
+
   void UnbindHcomStream();
 
   Status DistributeTask();
@@ -852,6 +953,13 @@ class DavinciModel {
 
   std::thread thread_id_;
 
+  // pipelined execution, at most pipeline_depth_ requests are in flight
+  uint32_t pipeline_depth_ = 1;
+  std::vector<PipelineSlot> pipeline_slots_;
+  BlockingQueue<uint32_t> free_slots_;
+  BlockingQueue<uint32_t> inflight_slots_;
+  std::thread pipeline_thread_;
+
   std::shared_ptr<ModelListener> listener_;
 
   bool run_flg_;
@@ -882,6 +990,20 @@ class DavinciModel {
   std::map<int64_t, std::string> zero_copy_op_id_batch_label_;
   // {batch_label, addrs}
   std::map<std::string, std::set<uintptr_t>> zero_copy_batch_label_addrs_;
+  // {batch_label, {virtual_addr, task args slots}}, built on first use and dropped when the tasks or addrs change
+  std::map<std::string, ZeroCopyArgsIndex> zero_copy_args_index_;
+  // host copy of task_args_mem_, the args of zero copy tasks are patched here and uploaded in one copy
+  std::vector<uint8_t> zero_copy_args_host_;
+  // {task index, offset in zero_copy_args_host_}, the offset is kArgsNotCarved for the tasks with their own args
+  std::vector<std::pair<size_t, size_t>> zero_copy_args_layout_;
+  // host to device copies made by the latest DistributeZeroCopyArgs
+  size_t zero_copy_args_copy_num_ = 0;
+
+  // args memory of kernel and memcpy addr tasks, carved at task init
+  std::mutex task_args_mem_mutex_;
+  uint8_t *task_args_mem_ = nullptr;
+  size_t task_args_mem_size_ = 0;
+  size_t task_args_mem_offset_ = 0;
 
   std::vector<TaskInfoPtr> task_list_;
   // rt_moodel_handle
@@ -921,6 +1043,7 @@ class DavinciModel {
   RuntimeParam runtime_param_;
 
   static std::mutex tvm_bin_mutex_;
+  std::mutex tvm_bin_kernel_mutex_;
   std::set<std::string> tvm_bin_kernel_;
 
   std::map<std::string, uint32_t> used_tbe_handle_map_;
@@ -194,13 +194,12 @@ void ModelManager::DestroyAicpuSession(uint64_t session_id) {
 
 ge::Status ModelManager::DestroyAicpuSessionForInfer(uint32_t model_id) {
   GELOGI("Destroy aicpu session for infer, model id is %u.", model_id);
-  std::lock_guard<std::mutex> lock(map_mutex_);
-  auto it = model_map_.find(model_id);
-  if (it == model_map_.end()) {
+  std::shared_ptr<DavinciModel> davinci_model = GetModel(model_id);
+  if (davinci_model == nullptr) {
     GELOGE(GE_EXEC_MODEL_ID_INVALID, "model id %u does not exists.", model_id);
     return GE_EXEC_MODEL_ID_INVALID;
   }
-  uint64_t session_id = it->second->GetSessionId();
+  uint64_t session_id = davinci_model->GetSessionId();
   GELOGI("Destroy aicpu session for infer, session id is %lu.", session_id);
   DestroyAicpuSession(session_id);
   return SUCCESS;
@@ -235,6 +234,8 @@ ge::Status ModelManager::CreateAicpuKernel(uint64_t session_id, uint32_t model_i
 ModelManager::~ModelManager() {
   std::lock_guard<std::mutex> lock(map_mutex_);
   model_map_.clear();
+  hybrid_model_map_.clear();
+  (void)PublishModels();
   model_aicpu_kernel_.clear();
 
   GE_IF_BOOL_EXEC(device_count > 0, GE_CHK_RT(rtDeviceReset(0)));
@@ -344,12 +345,14 @@ void ModelManager::InsertModel(uint32_t id, std::shared_ptr<DavinciModel> &davin
   GE_CHK_BOOL_EXEC(davinci_model != nullptr, return, "davinci_model ptr is null, id: %u", id);
   std::lock_guard<std::mutex> lock(map_mutex_);
   model_map_[id] = davinci_model;
+  (void)PublishModels();
 }
 
 void ModelManager::InsertModel(uint32_t id, shared_ptr<hybrid::HybridDavinciModel> &hybrid_model) {
   GE_CHK_BOOL_EXEC(hybrid_model != nullptr, return, "hybrid_model ptr is null, id: %u", id);
   std::lock_guard<std::mutex> lock(map_mutex_);
   hybrid_model_map_[id] = hybrid_model;
+  (void)PublishModels();
 }
 
 Status ModelManager::DeleteModel(uint32_t id) {
@@ -372,21 +375,42 @@ Status ModelManager::DeleteModel(uint32_t id) {
     return GE_EXEC_MODEL_ID_INVALID;
   }
 
+  return PublishModels();
+}
+
+Status ModelManager::PublishModels() {
+  std::unique_ptr<ModelRegistry> registry(new (std::nothrow) ModelRegistry());
+  if (registry == nullptr) {
+    GELOGE(MEMALLOC_FAILED, "Failed to create model registry.");
+    return MEMALLOC_FAILED;
+  }
+  registry->models = model_map_;
+  registry->hybrid_models = hybrid_model_map_;
+  // returns after the lookups of the old registry are finished, the models removed are released here
+  registry_.Update(std::move(registry));
   return SUCCESS;
 }
 
 std::shared_ptr<DavinciModel> ModelManager::GetModel(uint32_t id) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-
-  auto it = model_map_.find(id);
-  return (it == model_map_.end()) ? nullptr : it->second;
+  std::shared_ptr<DavinciModel> davinci_model;
+  (void)registry_.Read([id, &davinci_model](const ModelRegistry &registry) {
+    auto it = registry.models.find(id);
+    if (it != registry.models.end()) {
+      davinci_model = it->second;
+    }
+  });
+  return davinci_model;
 }
 
 std::shared_ptr<hybrid::HybridDavinciModel> ModelManager::GetHybridModel(uint32_t id) {
-  std::lock_guard<std::mutex> lock(map_mutex_);
-
-  auto it = hybrid_model_map_.find(id);
-  return (it == hybrid_model_map_.end()) ? nullptr : it->second;
+  std::shared_ptr<hybrid::HybridDavinciModel> hybrid_model;
+  (void)registry_.Read([id, &hybrid_model](const ModelRegistry &registry) {
+    auto it = registry.hybrid_models.find(id);
+    if (it != registry.hybrid_models.end()) {
+      hybrid_model = it->second;
+    }
+  });
+  return hybrid_model;
 }
 
 Status ModelManager::Unload(uint32_t model_id) {
@@ -1186,15 +1210,11 @@ Status ModelManager::GetModelMemAndWeightSize(const ModelData &model, size_t &me
     return GE_EXEC_LOAD_TASK_PARTITION_FAILED;
   }
 
-  std::shared_ptr<domi::ModelTaskDef> model_task_def = MakeShared<domi::ModelTaskDef>();
-  if (model_task_def == nullptr) {
-    return MEMALLOC_FAILED;
-  }
-  if (task_partition.size != 0) {
-    if (!ReadProtoFromArray(task_partition.data, static_cast<int>(task_partition.size), model_task_def.get())) {
-      GELOGE(GE_EXEC_LOAD_TASK_PARTITION_FAILED, "ReadProtoFromArray failed.");
-      return GE_EXEC_LOAD_TASK_PARTITION_FAILED;
-    }
+  // only the sizes are needed, the tasks are not decoded
+  domi::ModelTaskDef task_meta;
+  if (ModelHelper::LoadTaskMeta(task_partition, task_meta) != SUCCESS) {
+    GELOGE(GE_EXEC_LOAD_TASK_PARTITION_FAILED, "Load meta of task partition failed.");
+    return GE_EXEC_LOAD_TASK_PARTITION_FAILED;
   }
 
   ModelPartition partition_weight;
@@ -1202,7 +1222,7 @@ Status ModelManager::GetModelMemAndWeightSize(const ModelData &model, size_t &me
   GE_CHK_BOOL_TRUE_EXEC_WITH_LOG(ret != SUCCESS, return GE_EXEC_LOAD_WEIGHT_PARTITION_FAILED,
                                  "Get weight partition failed. ret = %u", ret);
 
-  mem_size = model_task_def->memory_size();
+  mem_size = task_meta.memory_size();
   weight_size = partition_weight.size;
   return SUCCESS;
 }
@@ -1251,8 +1271,13 @@ ge::Status ModelManager::SyncExecuteModel(uint32_t model_id, const vector<GeTens
 }
 
 Status ModelManager::GetOpDescInfo(uint32_t device_id, uint32_t stream_id, uint32_t task_id, OpDescInfo &op_desc_info) {
-  for (const auto &model : model_map_) {
-    auto davinci_model = model.second;
+  std::vector<std::shared_ptr<DavinciModel>> davinci_models;
+  (void)registry_.Read([&davinci_models](const ModelRegistry &registry) {
+    for (const auto &model : registry.models) {
+      davinci_models.emplace_back(model.second);
+    }
+  });
+  for (const auto &davinci_model : davinci_models) {
     if (davinci_model->GetDeviceId() == device_id) {
       GELOGI("Start to GetOpDescInfo of device_id: %u.", device_id);
       if (davinci_model->GetOpDescInfo(stream_id, task_id, op_desc_info)) {
@@ -32,6 +32,7 @@
 #include "common/helper/model_helper.h"
 #include "common/helper/om_file_helper.h"
 #include "common/properties_manager.h"
+#include "common/read_mostly.h"
 #include "common/types.h"
 #include "ge/ge_api_types.h"
 #include "graph/ge_context.h"
@@ -328,11 +329,24 @@ class FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY ModelManager {
 
   void GenModelId(uint32_t *id);
 
+  ///
+  /// @ingroup domi_ome
+  /// @brief publish the models of model_map_ and hybrid_model_map_ to the lookups, called with map_mutex_ held
+  ///
+  ge::Status PublishModels();
+
+  struct ModelRegistry {
+    std::map<uint32_t, std::shared_ptr<DavinciModel>> models;
+    std::map<uint32_t, std::shared_ptr<hybrid::HybridDavinciModel>> hybrid_models;
+  };
+
+  // written under map_mutex_ and published to registry_ for the lookups
   std::map<uint32_t, std::shared_ptr<DavinciModel>> model_map_;
   std::map<uint32_t, std::shared_ptr<hybrid::HybridDavinciModel>> hybrid_model_map_;
   std::map<std::string, std::vector<uint64_t>> model_aicpu_kernel_;
   uint32_t max_model_id_;
   std::mutex map_mutex_;
+  ReadMostly<ModelRegistry> registry_;
   std::mutex sess_ids_mutex_;
   std::mutex session_id_create_mutex_;
   static ::std::mutex exeception_infos_mutex_;
@@ -460,6 +460,10 @@ Status KernelTaskInfo::Release() {
   rtError_t ret = rtCtxGetCurrent(&ctx);
 
   if (ret == RT_ERROR_NONE) {
+    // carved args are freed with the model
+    if (is_args_carved_) {
+      args_ = nullptr;
+    }
     FreeRtMem(&args_);
     FreeRtMem(&superkernel_device_args_addr_);
     FreeRtMem(&superkernel_dev_nav_table_);
@@ -590,10 +594,9 @@ Status KernelTaskInfo::InitTVMTask(uint16_t offset, const domi::KernelDef &kerne
   tensor_device_addrs.insert(tensor_device_addrs.end(), workspace_data_addrs.begin(), workspace_data_addrs.end());
 
   // malloc args memory
-  rt_ret = rtMalloc(&args_, args_size_, RT_MEMORY_HBM);
-  if (rt_ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "Call rt api failed, ret: 0x%X", rt_ret);
-    return RT_ERROR_TO_GE_STATUS(rt_ret);
+  Status ret = MallocArgs();
+  if (ret != SUCCESS) {
+    return ret;
   }
 
   // copy orign args
@@ -913,15 +916,13 @@ Status KernelTaskInfo::InitAicpuTask(uint32_t op_index, const domi::KernelDef &k
   aicpu_param_head->extInfoLength = reinterpret_cast<uintptr_t>(ext_info.size());
 
   // malloc device memory for args
-  rtError_t rt_ret = rtMalloc(static_cast<void **>(&args_), args_size_, RT_MEMORY_HBM);
-  if (rt_ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "Call rt api(rtMalloc) failed, ret: 0x%X", rt_ret);
-    return RT_ERROR_TO_GE_STATUS(rt_ret);
+  init_ret = MallocArgs();
+  if (init_ret != SUCCESS) {
+    return init_ret;
   }
-  GE_PRINT_DYNAMIC_MEMORY(rtMalloc, "cce task physical memory.", args_size_)
 
   // copy args to device
-  rt_ret = rtMemcpy(args_, args_size_, args_addr.get(), args_size_, RT_MEMCPY_HOST_TO_DEVICE);
+  rtError_t rt_ret = rtMemcpy(args_, args_size_, args_addr.get(), args_size_, RT_MEMCPY_HOST_TO_DEVICE);
   if (rt_ret != RT_ERROR_NONE) {
     GELOGE(RT_FAILED, "Call rt api(rtMemcpy) failed, ret: 0x%X", rt_ret);
     return RT_ERROR_TO_GE_STATUS(rt_ret);
@@ -1067,6 +1068,24 @@ Status KernelTaskInfo::SetContext(const domi::KernelDef &kernel_def) {
   return SUCCESS;
 }
 
+Status KernelTaskInfo::MallocArgs() {
+  // args of te and aicpu tasks may be patched by zero copy, they are carved from the args memory of the model and
+  // uploaded in batch
+  args_ = davinci_model_->CarveTaskArgs(args_size_);
+  if (args_ != nullptr) {
+    is_args_carved_ = true;
+    return SUCCESS;
+  }
+
+  rtError_t rt_ret = rtMalloc(&args_, args_size_, RT_MEMORY_HBM);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(RT_FAILED, "Call rt api(rtMalloc) failed, ret: 0x%X", rt_ret);
+    return RT_ERROR_TO_GE_STATUS(rt_ret);
+  }
+  GE_PRINT_DYNAMIC_MEMORY(rtMalloc, "cce task physical memory.", args_size_)
+  return SUCCESS;
+}
+
 void KernelTaskInfo::FreeRtMem(void **ptr) {
   if (ptr == nullptr || *ptr == nullptr) {
     return;
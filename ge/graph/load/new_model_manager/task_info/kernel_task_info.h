@@ -129,6 +129,8 @@ class KernelTaskInfo : public TaskInfo {
   Status SuperKernelDistribute();
   bool IsL1FusionOp(const OpDescPtr &op_desc);
 
+  Status MallocArgs();
+
   // For super kernel
   Status SaveSKTDumpInfo();
   void UpdateTaskId();
@@ -161,6 +163,8 @@ class KernelTaskInfo : public TaskInfo {
   uint32_t args_offset_ = 0;
   int64_t fixed_addr_offset_ = 0;
   bool call_save_dump_ = false;
+  // args_ is carved from the args memory of the model
+  bool is_args_carved_ = false;
 
   // aicpu ext_info device mem
   void *aicpu_ext_info_addr_ = nullptr;
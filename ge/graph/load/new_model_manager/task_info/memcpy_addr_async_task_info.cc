@@ -64,17 +64,22 @@ Status MemcpyAddrAsyncTaskInfo::Init(const domi::TaskDef &task_def, DavinciModel
     memory_type = RT_MEMORY_TS_4G;
   }
   GELOGI("memory_type: %u", memory_type);
-  rtError_t rt_ret = rtMalloc(&args_, args_size + kAlignBytes, memory_type);
-  if (rt_ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "Call rt api failed, ret: 0x%X", rt_ret);
-    return RT_ERROR_TO_GE_STATUS(rt_ret);
+  // args in hbm are carved from the args memory of the model, aligned to kAlignBytes and uploaded in batch
+  if (memory_type == RT_MEMORY_HBM) {
+    args_align_ = davinci_model->CarveTaskArgs(args_size);
+  }
+  if (args_align_ == nullptr) {
+    rtError_t rt_ret = rtMalloc(&args_, args_size + kAlignBytes, memory_type);
+    if (rt_ret != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "Call rt api failed, ret: 0x%X", rt_ret);
+      return RT_ERROR_TO_GE_STATUS(rt_ret);
+    }
+    args_align_ = reinterpret_cast<void *>((reinterpret_cast<uintptr_t>(args_) / kAlignBytes + 1) * kAlignBytes);
   }
-
-  args_align_ = reinterpret_cast<void *>((reinterpret_cast<uintptr_t>(args_) / kAlignBytes + 1) * kAlignBytes);
   // copy orign src/dst
   GELOGI("src_args:%p, destMax:%zu, src_:%p, dst_args:%p, dst_:%p, count=%zu", args_align_, args_size, src_,
          static_cast<uint8_t *>(args_align_) + args_size, dst_, io_addrs.size());
-  rt_ret = rtMemcpy(args_align_, args_size, io_addrs.data(), args_size, RT_MEMCPY_HOST_TO_DEVICE);
+  rtError_t rt_ret = rtMemcpy(args_align_, args_size, io_addrs.data(), args_size, RT_MEMCPY_HOST_TO_DEVICE);
   if (rt_ret != RT_ERROR_NONE) {
     GELOGE(RT_FAILED, "Call rt api for src failed, ret: 0x%X", rt_ret);
     return RT_ERROR_TO_GE_STATUS(rt_ret);
@@ -79,7 +79,7 @@ void ZeroCopyTask::SetOriginalArgs(const void *info, size_t size) {
  * @return: true / false
  */
 bool ZeroCopyTask::CheckDynamicBatch(const map<string, set<uintptr_t>> &batch_addrs, const string &batch_label,
-                                     uintptr_t addr) {
+                                     uintptr_t addr) const {
   // Used for dynamic batch / resolution scene
   set<uintptr_t> dynamic_input_addrs;
   auto dynamic_input_iter = batch_addrs.find(batch_label);
@@ -106,68 +106,4 @@ bool ZeroCopyTask::CheckDynamicBatch(const map<string, set<uintptr_t>> &batch_ad
 
   return true;
 }
-
-/**
- * @ingroup ge
- * @brief Set user data addr to Task param.
- * @param [in] addr: virtual address value from Op.
- * @param [in] buffer_addr: real_data_buffer_addr from user.
- * @param [in] batch_addrs: dynamic batch addr info.
- * @param [in] batch_label: batch label.
- * @return: void
- */
-Status ZeroCopyTask::UpdateTaskParam(uintptr_t addr, void *buffer_addr, const map<string, set<uintptr_t>> &batch_addrs,
-                                     const string &batch_label) {
-  auto iter = task_addr_offset_.find(addr);
-  if (iter != task_addr_offset_.end()) {
-    auto &cur_pair = *iter;
-    uint8_t *args_info = args_info_.data();
-    for (auto offset : cur_pair.second) {
-      if (!CheckDynamicBatch(batch_addrs, batch_label, reinterpret_cast<uintptr_t>(args_addr_ + offset))) {
-        continue;
-      }
-
-      auto dst_addr = static_cast<uint8_t *>(buffer_addr);
-      GELOGI("[ZCPY] %s update task, args_addr: %p, size: %zu, offset: %zu, virtual_addr: 0x%lx, user_data_addr: %p",
-             name_.c_str(), args_addr_, args_size_, offset, addr, buffer_addr);
-      *(uintptr_t *)(args_info + offset) = reinterpret_cast<uintptr_t>(dst_addr);
-      is_updated_ = true;
-    }
-  }
-
-  return SUCCESS;
-}
-
-/**
- * @ingroup ge
- * @brief Update task param to device.
- * @param [in] async_mode: true for asychronous mode.
- * @param [in] stream: Stream for asychronous update.
- * @return: 0 SUCCESS / others FAILED
- */
-Status ZeroCopyTask::DistributeParam(bool async_mode, rtStream_t stream) {
-  if (!is_updated_) {
-    return SUCCESS;
-  }
-
-  is_updated_ = false;
-  GE_CHECK_NOTNULL(args_addr_);
-  rtError_t rt_err = RT_ERROR_NONE;
-  if (async_mode) {
-    rt_err =
-      rtMemcpyAsync(args_addr_, args_size_, args_info_.data(), args_info_.size(), RT_MEMCPY_HOST_TO_DEVICE_EX, stream);
-  } else {
-    __builtin_prefetch(args_addr_);
-    rt_err = rtMemcpy(args_addr_, args_size_, args_info_.data(), args_info_.size(), RT_MEMCPY_HOST_TO_DEVICE);
-  }
-
-  if (rt_err != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "[ZCPY] %s distribute task param failed, error=0x%x", name_.c_str(), rt_err);
-    return RT_ERROR_TO_GE_STATUS(rt_err);
-  }
-
-  GELOGI("[ZCPY] %s refresh task args success, args_addr: %p, size: %zu, args_info_: %p, length: %zu", name_.c_str(),
-         args_addr_, args_size_, args_info_.data(), args_info_.size());
-  return SUCCESS;
-}
 }  // namespace ge
@@ -64,31 +64,45 @@ class ZeroCopyTask {
 
   /**
    * @ingroup ge
-   * @brief Set user data addr to Task param.
-   * @param [in] addr: virtual address value from Op.
+   * @brief Set user data addr to one slot of task args, the slot is resolved by caller.
+   * @param [in] offset: offset in task args.
    * @param [in] buffer_addr: data buffer_addr from user.
-   * @param [in] batch_addrs: dynamic batch addr info.
-   * @param [in] batch_label: batch label.
-   * @return: 0 SUCCESS / others FAILED
+   * @return: void
    */
-  ge::Status UpdateTaskParam(uintptr_t addr, void *buffer_addr, const map<string, set<uintptr_t>> &batch_addrs,
-                             const string &batch_label);
+  void SetTaskParam(size_t offset, void *buffer_addr) {
+    *reinterpret_cast<uintptr_t *>(args_info_.data() + offset) = reinterpret_cast<uintptr_t>(buffer_addr);
+    is_updated_ = true;
+  }
 
   /**
    * @ingroup ge
-   * @brief Update task param to device.
-   * @param [in] async_mode: true for asychronous mode.
-   * @param [in] stream: Stream for asychronous update.
-   * @return: 0 SUCCESS / others FAILED
+   * @brief Check if the slot of task args is used by the batch label.
+   * @param [in] batch_addrs: dynamic batch addr info.
+   * @param [in] batch_label: batch label.
+   * @param [in] addr: address of the slot in task args.
+   * @return: true / false
    */
-  ge::Status DistributeParam(bool async_mode, rtStream_t stream);
+  bool CheckDynamicBatch(const map<string, set<uintptr_t>> &batch_addrs, const string &batch_label,
+                         uintptr_t addr) const;
+
+  uintptr_t GetArgsAddr(size_t offset) const { return reinterpret_cast<uintptr_t>(args_addr_ + offset); }
+
+  // host copy of the args, uploaded to args_addr_ by the model in batch
+  const vector<uint8_t> &GetArgsInfo() const { return args_info_; }
+
+  bool IsUpdated() const { return is_updated_; }
+
+  void ClearUpdated() { is_updated_ = false; }
+
+  const map<uintptr_t, vector<size_t>> &GetTaskArgsOffset() const { return task_addr_offset_; }
 
   void SetBatchLabel(const string &batch_label) { batch_label_ = batch_label; }
 
   const string &GetBatchLabel() const { return batch_label_; }
 
- protected:
-  bool CheckDynamicBatch(const map<string, set<uintptr_t>> &batch_addrs, const string &batch_label, uintptr_t addr);
+  void SetOpId(int64_t op_id) { op_id_ = op_id; }
+
+  int64_t GetOpId() const { return op_id_; }
 
  private:
   const string name_;
@@ -98,6 +112,7 @@ class ZeroCopyTask {
   vector<uint8_t> args_info_;
   bool is_updated_;
   string batch_label_;
+  int64_t op_id_ = -1;
   // <address from Op, {offset in args}>
   map<uintptr_t, vector<size_t>> task_addr_offset_;
 };
@@ -16,6 +16,9 @@
 
 #ifndef GE_GRAPH_MANAGER_BLOCK_MEMORY_H_
 #define GE_GRAPH_MANAGER_BLOCK_MEMORY_H_
+
+#include "runtime/base.h"
+
 namespace ge {
 struct Block;
 typedef bool (*Comparison)(const Block *, const Block *);
@@ -29,13 +32,16 @@ struct Block {
   bool allocated;      // in-use flag
   Block *prev;         // prev block if split from a larger allocation
   Block *next;         // next block if split from a larger allocation
+  rtStream_t stream;   // stream the block is used on while allocated
 
   Block(uint32_t device, size_t size, BlockBin *bin, uint8_t *ptr)
-      : device_id(device), size(size), bin(bin), ptr(ptr), allocated(false), prev(nullptr), next(nullptr) {}
+      : device_id(device), size(size), bin(bin), ptr(ptr), allocated(false), prev(nullptr), next(nullptr),
+        stream(nullptr) {}
 
   // constructor for search key
   Block(uint32_t device, size_t size, uint8_t *ptr)
-      : device_id(device), size(size), bin(nullptr), ptr(ptr), allocated(false), prev(nullptr), next(nullptr) {}
+      : device_id(device), size(size), bin(nullptr), ptr(ptr), allocated(false), prev(nullptr), next(nullptr),
+        stream(nullptr) {}
 
   bool IsSplit() const { return (prev != nullptr) || (next != nullptr); }
 };
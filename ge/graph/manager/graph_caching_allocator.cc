@@ -16,10 +16,14 @@
 
 #include "graph/manager/graph_caching_allocator.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <set>
 #include <string>
 #include <utility>
 
+#include "common/ge/ge_util.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/manager/graph_mem_allocator.h"
 
@@ -83,7 +87,146 @@ bool ShouldSplit(const Block *block, size_t size) {
   return static_cast<double>(size) <= (static_cast<double>(block->size) * kSplitThreshold);
 }
 
-CachingAllocator::CachingAllocator(rtMemType_t memory_type) : memory_type_(memory_type), memory_allocator_(nullptr) {
+namespace {
+// blocks up to this size are kept in thread caches
+const size_t kMaxThreadCachedBlockSize = 4 * kMByteSize;
+// bytes kept by one thread cache at most, the rest goes back to the bins
+const size_t kMaxThreadCachedSize = 64 * kMByteSize;
+const size_t kMaxThreadCachedBlocksPerClass = 16;
+// size classes per power of two
+const size_t kSizeClassSteps = 4;
+
+std::vector<size_t> InitSizeClasses() {
+  std::vector<size_t> size_classes;
+  for (size_t base = kRoundBlockSize; base < kMaxThreadCachedBlockSize; base *= 2) {
+    for (size_t step = 0; step < kSizeClassSteps; ++step) {
+      size_classes.emplace_back(base + base / kSizeClassSteps * step);
+    }
+  }
+  size_classes.emplace_back(kMaxThreadCachedBlockSize);
+  return size_classes;
+}
+
+const std::vector<size_t> &GetSizeClasses() {
+  static const std::vector<size_t> size_classes = InitSizeClasses();
+  return size_classes;
+}
+
+///
+/// @brief smallest size class which can hold size
+///
+size_t GetSizeClassIndex(size_t size) {
+  const auto &size_classes = GetSizeClasses();
+  return static_cast<size_t>(std::lower_bound(size_classes.begin(), size_classes.end(), size) -
+                             size_classes.begin());
+}
+
+///
+/// @brief largest size class a block of size can serve
+///
+size_t GetServedSizeClassIndex(size_t size) {
+  const auto &size_classes = GetSizeClasses();
+  return static_cast<size_t>(std::upper_bound(size_classes.begin(), size_classes.end(), size) -
+                             size_classes.begin()) - 1;
+}
+
+std::atomic<uint64_t> next_instance_id(0);
+
+const char *const kEnvStatsDumpInterval = "GE_CACHING_ALLOCATOR_STATS_INTERVAL";
+const int64_t kMsPerSecond = 1000;
+
+int64_t GetSteadyTimeMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void UpdatePeak(std::atomic<uint64_t> &peak, uint64_t value) {
+  uint64_t current = peak.load();
+  while ((value > current) && !peak.compare_exchange_weak(current, value)) {
+  }
+}
+
+}  // namespace
+
+struct CachingAllocator::StreamCache {
+  explicit StreamCache(const std::shared_ptr<std::atomic<uint32_t>> &orphan_num)
+      : orphan_cache_num(orphan_num), blocks(GetSizeClasses().size()) {}
+
+  // cleared when the owner thread exits, the blocks may then be taken by any thread
+  std::atomic<bool> in_use{true};
+  // set by threads short of memory, the owner returns its blocks to the bins on its next call
+  std::atomic<bool> flush_requested{false};
+  std::shared_ptr<std::atomic<uint32_t>> orphan_cache_num;
+  size_t cached_size = 0;
+  // free blocks by size class, only touched by the owner thread while it is alive
+  std::vector<std::vector<Block *>> blocks;
+
+  Block *Pop(size_t class_index) {
+    auto &class_blocks = blocks[class_index];
+    if (class_blocks.empty()) {
+      return nullptr;
+    }
+    Block *block = class_blocks.back();
+    class_blocks.pop_back();
+    cached_size -= block->size;
+    return block;
+  }
+
+  bool Push(Block *block) {
+    auto &class_blocks = blocks[GetServedSizeClassIndex(block->size)];
+    if ((class_blocks.size() >= kMaxThreadCachedBlocksPerClass) || (cached_size + block->size > kMaxThreadCachedSize)) {
+      return false;
+    }
+    class_blocks.emplace_back(block);
+    cached_size += block->size;
+    return true;
+  }
+
+  void TakeAll(std::vector<Block *> &all_blocks) {
+    if (cached_size == 0) {
+      return;
+    }
+    for (auto &class_blocks : blocks) {
+      all_blocks.insert(all_blocks.end(), class_blocks.begin(), class_blocks.end());
+      class_blocks.clear();
+    }
+    cached_size = 0;
+  }
+};
+
+namespace {
+struct AllocatorCaches {
+  uint64_t generation = 0;
+  std::unordered_map<rtStream_t, std::shared_ptr<CachingAllocator::StreamCache>> caches;
+};
+
+///
+/// Thread local caches by allocator instance and stream, the caches are left to the allocator when thread exits
+///
+struct ThreadCacheHolder {
+  ~ThreadCacheHolder() {
+    for (auto &allocator_caches : allocators) {
+      for (auto &it : allocator_caches.second.caches) {
+        it.second->in_use.store(false, std::memory_order_release);
+        it.second->orphan_cache_num->fetch_add(1);
+      }
+    }
+  }
+  std::unordered_map<uint64_t, AllocatorCaches> allocators;
+};
+
+thread_local ThreadCacheHolder thread_cache_holder;
+}  // namespace
+
+CachingAllocator::CachingAllocator(rtMemType_t memory_type)
+    : memory_type_(memory_type),
+      memory_allocator_(nullptr),
+      instance_id_(next_instance_id.fetch_add(1)),
+      cache_generation_(0),
+      orphan_cache_num_(ge::MakeShared<std::atomic<uint32_t>>(0)),
+      device_stats_(new (std::nothrow) DeviceStats[kMaxStatsDeviceNum]),
+      stats_dump_interval_ms_(0),
+      last_stats_dump_ms_(0) {
   for (uint32_t i = 0; i < kNumBins; ++i) {
     free_block_bins_[i] = nullptr;
   }
@@ -109,32 +252,79 @@ Status CachingAllocator::Initialize(uint32_t device_id) {
   if (memory_allocator_ == nullptr) {
     return ge::FAILED;
   }
+  const char *dump_interval = std::getenv(kEnvStatsDumpInterval);
+  if (dump_interval != nullptr) {
+    stats_dump_interval_ms_ = std::strtol(dump_interval, nullptr, 10) * kMsPerSecond;
+    last_stats_dump_ms_.store(GetSteadyTimeMs());
+    GELOGI("Dump caching allocator statistics every %ld ms", stats_dump_interval_ms_);
+  }
   return ge::SUCCESS;
 }
 
 void CachingAllocator::Finalize(uint32_t device_id) {
   GELOGI("Device id %u", device_id);
+  DumpStats(device_id, "finalize");
   FreeBlocks();
   FreeBlockBins();
 }
 
-uint8_t *CachingAllocator::Malloc(size_t size, uint8_t *org_ptr, uint32_t device_id) {
+uint8_t *CachingAllocator::Malloc(size_t size, uint8_t *org_ptr, uint32_t device_id, rtStream_t stream) {
   uint8_t *ptr = nullptr;
   size = GetBlockSize(size);
+  DeviceStats *stats = GetDeviceStats(device_id);
+  if (stats != nullptr) {
+    stats->malloc_num++;
+  }
+  // a reuse hint can only be served by the bins
+  if ((org_ptr == nullptr) && (size <= kMaxThreadCachedBlockSize)) {
+    size_t class_index = GetSizeClassIndex(size);
+    size = GetSizeClasses()[class_index];
+    StreamCache *cache = GetStreamCache(stream);
+    Block *cached_block = (cache == nullptr) ? nullptr : cache->Pop(class_index);
+    if (cached_block != nullptr) {
+      AddAllocatedBlock(cached_block);
+      if (stats != nullptr) {
+        stats->thread_cache_hit_num++;
+        stats->thread_cached_size -= cached_block->size;
+        UpdatePeak(stats->in_use_peak_size, stats->in_use_size += cached_block->size);
+      }
+      GELOGI("Malloc from stream cache device id = %u, size= %zu", device_id, size);
+      return cached_block->ptr;
+    }
+  }
+  size_t bin_index = GetBinIndex(size);
   Block *block = FindFreeBlock(size, org_ptr, device_id);
   if (block != nullptr) {
     ptr = block->ptr;
+    if (stats != nullptr) {
+      stats->bin_hit_num[bin_index]++;
+    }
   } else {
-    if (ge::SUCCESS == TryExtendCache(size, device_id)) {
+    if (stats != nullptr) {
+      stats->bin_miss_num[bin_index]++;
+    }
+    // blocks cached by this thread for other streams and by exited threads are free as well, take them back
+    // before asking the device for more
+    if (FlushStreamCaches()) {
       block = FindFreeBlock(size, org_ptr, device_id);
-      if (block != nullptr) {
-        ptr = block->ptr;
-      }
+    }
+    if ((block == nullptr) && (ge::SUCCESS == TryExtendCache(size, device_id))) {
+      block = FindFreeBlock(size, org_ptr, device_id);
+    }
+    if (block != nullptr) {
+      ptr = block->ptr;
     }
   }
   if (ptr == nullptr) {
     GELOGE(FAILED, "Malloc failed device id = %u, size= %zu", device_id, size);
+    DumpStats(device_id, "malloc failed");
+    return nullptr;
+  }
+  block->stream = stream;
+  if (stats != nullptr) {
+    UpdatePeak(stats->in_use_peak_size, stats->in_use_size += block->size);
   }
+  TryDumpStatsPeriodically(device_id);
   return ptr;
 }
 
@@ -145,18 +335,126 @@ Status CachingAllocator::Free(uint8_t *ptr, uint32_t device_id) {
     return ge::PARAM_INVALID;
   }
 
-  std::lock_guard<std::recursive_mutex> lock(mutex_);
-  auto it = allocated_blocks_.find(ptr);
-  if (it == allocated_blocks_.end()) {
+  Block *block = RemoveAllocatedBlock(ptr);
+  if (block == nullptr) {
     GELOGE(PARAM_INVALID, "Invalid memory pointer");
     return ge::PARAM_INVALID;
   }
-  Block *block = it->second;
-  allocated_blocks_.erase(it);
+  DeviceStats *stats = GetDeviceStats(block->device_id);
+  if (stats != nullptr) {
+    stats->free_num++;
+    stats->in_use_size -= block->size;
+  }
+  if (block->size <= kMaxThreadCachedBlockSize) {
+    StreamCache *cache = GetStreamCache(block->stream);
+    if ((cache != nullptr) && cache->Push(block)) {
+      if (stats != nullptr) {
+        stats->thread_cached_size += block->size;
+      }
+      return ge::SUCCESS;
+    }
+  }
   FreeBlock(block);
   return ge::SUCCESS;
 }
 
+CachingAllocator::StreamCache *CachingAllocator::GetStreamCache(rtStream_t stream) {
+  if (orphan_cache_num_ == nullptr) {
+    return nullptr;
+  }
+  auto &allocator_caches = thread_cache_holder.allocators[instance_id_];
+  uint64_t generation = cache_generation_.load(std::memory_order_acquire);
+  if (allocator_caches.generation != generation) {
+    // the blocks of the caches were taken back when the allocator was finalized
+    allocator_caches.caches.clear();
+    allocator_caches.generation = generation;
+  }
+  auto &cache = allocator_caches.caches[stream];
+  if (cache == nullptr) {
+    cache = ge::MakeShared<StreamCache>(orphan_cache_num_);
+    if (cache == nullptr) {
+      GELOGW("Make stream cache failed, malloc from bins directly");
+      allocator_caches.caches.erase(stream);
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(stream_caches_mutex_);
+    stream_caches_.emplace_back(cache);
+  }
+  if (cache->flush_requested.load(std::memory_order_relaxed) && cache->flush_requested.exchange(false)) {
+    std::vector<Block *> blocks;
+    cache->TakeAll(blocks);
+    GELOGI("Flush %zu blocks from stream cache on request", blocks.size());
+    ReturnCachedBlocks(blocks);
+  }
+  return cache.get();
+}
+
+bool CachingAllocator::FlushStreamCaches() {
+  std::vector<Block *> blocks;
+  auto it = thread_cache_holder.allocators.find(instance_id_);
+  if ((it != thread_cache_holder.allocators.end()) &&
+      (it->second.generation == cache_generation_.load(std::memory_order_acquire))) {
+    for (auto &stream_cache : it->second.caches) {
+      stream_cache.second->TakeAll(blocks);
+    }
+  }
+  // the caches of exited threads are taken only when there are any, a bin miss does not walk all caches
+  if ((orphan_cache_num_ != nullptr) && (orphan_cache_num_->load() > 0)) {
+    std::lock_guard<std::mutex> lock(stream_caches_mutex_);
+    for (auto cache_it = stream_caches_.begin(); cache_it != stream_caches_.end();) {
+      if ((*cache_it)->in_use.load(std::memory_order_acquire)) {
+        ++cache_it;
+        continue;
+      }
+      (*cache_it)->TakeAll(blocks);
+      orphan_cache_num_->fetch_sub(1);
+      cache_it = stream_caches_.erase(cache_it);
+    }
+  }
+  if (blocks.empty()) {
+    return false;
+  }
+  GELOGI("Flush %zu blocks from stream caches", blocks.size());
+  ReturnCachedBlocks(blocks);
+  return true;
+}
+
+void CachingAllocator::RequestFlushStreamCaches() {
+  std::lock_guard<std::mutex> lock(stream_caches_mutex_);
+  for (auto &stream_cache : stream_caches_) {
+    stream_cache->flush_requested.store(true);
+  }
+}
+
+void CachingAllocator::ReturnCachedBlocks(const std::vector<Block *> &blocks) {
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+  for (auto block : blocks) {
+    DeviceStats *stats = GetDeviceStats(block->device_id);
+    if (stats != nullptr) {
+      stats->thread_cached_size -= block->size;
+    }
+    FreeBlock(block);
+  }
+}
+
+void CachingAllocator::AddAllocatedBlock(Block *block) {
+  auto &shard = allocated_shards_[(reinterpret_cast<uintptr_t>(block->ptr) / kRoundBlockSize) % kNumAllocatedShards];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.blocks[block->ptr] = block;
+}
+
+Block *CachingAllocator::RemoveAllocatedBlock(uint8_t *ptr) {
+  auto &shard = allocated_shards_[(reinterpret_cast<uintptr_t>(ptr) / kRoundBlockSize) % kNumAllocatedShards];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.blocks.find(ptr);
+  if (it == shard.blocks.end()) {
+    return nullptr;
+  }
+  Block *block = it->second;
+  shard.blocks.erase(it);
+  return block;
+}
+
 void CachingAllocator::FreeBlock(Block *block) {
   if (block == nullptr || !block->allocated) {
     return;
@@ -194,6 +492,10 @@ void CachingAllocator::MergeBlocks(Block *dst, Block *src, BlockBin &bin) {
   dst->size += src->size;
   bin.erase(src);
   delete src;
+  DeviceStats *stats = GetDeviceStats(dst->device_id);
+  if (stats != nullptr) {
+    stats->merge_num++;
+  }
 }
 
 BlockBin *CachingAllocator::GetBlockBin(size_t size) {
@@ -222,7 +524,7 @@ Block *CachingAllocator::FindFreeBlock(size_t size, uint8_t *org_ptr, uint32_t d
 
       if (block->ptr != nullptr) {
         block->allocated = true;
-        allocated_blocks_[block->ptr] = block;
+        AddAllocatedBlock(block);
         GELOGI("Malloc device id = %u, size= %zu", device_id, size);
       }
     }
@@ -249,6 +551,10 @@ Block *CachingAllocator::SplitBlock(Block *block, size_t size, BlockBin &bin, ui
   remaining->ptr = remaining->ptr + size;
   remaining->size -= size;
   bin.insert(remaining);
+  DeviceStats *stats = GetDeviceStats(device_id);
+  if (stats != nullptr) {
+    stats->split_num++;
+  }
   return new_block;
 }
 
@@ -263,6 +569,10 @@ Status CachingAllocator::TryExtendCache(size_t size, uint32_t device_id) {
     if (memory_addr == nullptr) {
       GELOGE(ge::FAILED, "TryExtendCache failed, no enough memory for size = %zu, device_id = %u", memory_size,
              device_id);
+      DeviceStats *stats = GetDeviceStats(device_id);
+      if (stats != nullptr) {
+        stats->extend_fail_num++;
+      }
       return ge::FAILED;
     }
   }
@@ -270,6 +580,11 @@ Status CachingAllocator::TryExtendCache(size_t size, uint32_t device_id) {
     (void)memory_allocator_->FreeMemory(memory_addr);
     return ge::FAILED;
   }
+  DeviceStats *stats = GetDeviceStats(device_id);
+  if (stats != nullptr) {
+    stats->extend_num++;
+    UpdatePeak(stats->cached_peak_size, stats->cached_size += memory_size);
+  }
   return ge::SUCCESS;
 }
 
@@ -297,6 +612,9 @@ Status CachingAllocator::AddToBlockBin(uint8_t *ptr, size_t size, uint32_t devic
 void CachingAllocator::FreeCachedBlocks() {
   GELOGI("Free cached blocks");
   std::lock_guard<std::recursive_mutex> lock(mutex_);
+  (void)FlushStreamCaches();
+  // the blocks cached by live threads come back on their next call
+  RequestFlushStreamCaches();
   for (uint32_t i = 0; i < kNumBins; ++i) {
     auto pool = free_block_bins_[i];
     if (pool == nullptr) {
@@ -307,6 +625,10 @@ void CachingAllocator::FreeCachedBlocks() {
       // free block memory that has not been split
       if ((block != nullptr) && (block->ptr != nullptr) && (block->prev == nullptr) && (block->next == nullptr) &&
           (memory_allocator_->FreeMemory(block->ptr) == ge::SUCCESS)) {
+        DeviceStats *stats = GetDeviceStats(block->device_id);
+        if (stats != nullptr) {
+          stats->cached_size -= block->size;
+        }
         pool->erase(it++);
         delete block;
         continue;
@@ -320,10 +642,35 @@ void CachingAllocator::FreeBlocks() {
   GELOGI("Free blocks");
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   // free allocated blocks and put to cache
-  for (auto &it : allocated_blocks_) {
-    FreeBlock(it.second);
+  for (auto &shard : allocated_shards_) {
+    std::unordered_map<uint8_t *, Block *> blocks;
+    {
+      std::lock_guard<std::mutex> shard_lock(shard.mutex);
+      blocks.swap(shard.blocks);
+    }
+    for (auto &it : blocks) {
+      DeviceStats *stats = GetDeviceStats(it.second->device_id);
+      if (stats != nullptr) {
+        stats->in_use_size -= it.second->size;
+      }
+      FreeBlock(it.second);
+    }
+  }
+
+  // no thread may use the allocator while it is initialized or finalized, the caches of live threads are taken
+  // as well and the threads drop them on their next call
+  std::vector<Block *> cached_blocks;
+  {
+    std::lock_guard<std::mutex> cache_lock(stream_caches_mutex_);
+    for (auto &stream_cache : stream_caches_) {
+      stream_cache->TakeAll(cached_blocks);
+    }
+    stream_caches_.clear();
   }
-  allocated_blocks_.clear();
+  cache_generation_.fetch_add(1, std::memory_order_release);
+  // caches of the older generation left by exiting threads are not counted any more
+  orphan_cache_num_ = ge::MakeShared<std::atomic<uint32_t>>(0);
+  ReturnCachedBlocks(cached_blocks);
 
   FreeCachedBlocks();
 }
@@ -338,4 +685,88 @@ void CachingAllocator::FreeBlockBins() {
     }
   }
 }
+
+CachingAllocator::DeviceStats *CachingAllocator::GetDeviceStats(uint32_t device_id) {
+  if ((device_stats_ == nullptr) || (device_id >= kMaxStatsDeviceNum)) {
+    return nullptr;
+  }
+  return &device_stats_[device_id];
+}
+
+Status CachingAllocator::GetStats(uint32_t device_id, CachingAllocatorStats &stats) {
+  DeviceStats *device_stats = GetDeviceStats(device_id);
+  if (device_stats == nullptr) {
+    GELOGE(PARAM_INVALID, "No statistics for device id = %u", device_id);
+    return ge::PARAM_INVALID;
+  }
+  stats.malloc_num = device_stats->malloc_num.load();
+  stats.free_num = device_stats->free_num.load();
+  stats.thread_cache_hit_num = device_stats->thread_cache_hit_num.load();
+  stats.bin_stats.resize(kNumBins);
+  for (uint32_t i = 0; i < kNumBins; ++i) {
+    stats.bin_stats[i].hit_num = device_stats->bin_hit_num[i].load();
+    stats.bin_stats[i].miss_num = device_stats->bin_miss_num[i].load();
+  }
+  stats.split_num = device_stats->split_num.load();
+  stats.merge_num = device_stats->merge_num.load();
+  stats.extend_num = device_stats->extend_num.load();
+  stats.extend_fail_num = device_stats->extend_fail_num.load();
+  stats.cached_size = device_stats->cached_size.load();
+  stats.cached_peak_size = device_stats->cached_peak_size.load();
+  stats.in_use_size = device_stats->in_use_size.load();
+  stats.in_use_peak_size = device_stats->in_use_peak_size.load();
+
+  stats.free_size = 0;
+  stats.largest_free_block_size = 0;
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    for (uint32_t i = 0; i < kNumBins; ++i) {
+      if (free_block_bins_[i] == nullptr) {
+        continue;
+      }
+      for (const Block *block : *free_block_bins_[i]) {
+        if ((block != nullptr) && (block->device_id == device_id)) {
+          stats.free_size += block->size;
+          stats.largest_free_block_size = std::max<uint64_t>(stats.largest_free_block_size, block->size);
+        }
+      }
+    }
+  }
+  stats.fragmentation_ratio =
+      (stats.free_size == 0)
+          ? 0.0
+          : 1.0 - static_cast<double>(stats.largest_free_block_size) / static_cast<double>(stats.free_size);
+
+  stats.thread_cached_size = device_stats->thread_cached_size.load();
+  return ge::SUCCESS;
+}
+
+void CachingAllocator::DumpStats(uint32_t device_id, const char *reason) {
+  CachingAllocatorStats stats;
+  if (GetStats(device_id, stats) != ge::SUCCESS) {
+    return;
+  }
+  GEEVENT("Caching allocator stats(%s) device id = %u: malloc %lu, free %lu, thread cache hit %lu, split %lu, "
+          "merge %lu, extend %lu, extend fail %lu, cached %lu/peak %lu, in use %lu/peak %lu, free in bins %lu, "
+          "thread cached %lu, largest free block %lu, fragmentation %.3f",
+          reason, device_id, stats.malloc_num, stats.free_num, stats.thread_cache_hit_num, stats.split_num,
+          stats.merge_num, stats.extend_num, stats.extend_fail_num, stats.cached_size, stats.cached_peak_size,
+          stats.in_use_size, stats.in_use_peak_size, stats.free_size, stats.thread_cached_size,
+          stats.largest_free_block_size, stats.fragmentation_ratio);
+  for (uint32_t i = 0; i < kNumBins; ++i) {
+    GEEVENT("Caching allocator stats(%s) device id = %u: bin[%u] up to %zu, hit %lu, miss %lu", reason, device_id, i,
+            bin_ranges[i], stats.bin_stats[i].hit_num, stats.bin_stats[i].miss_num);
+  }
+}
+
+void CachingAllocator::TryDumpStatsPeriodically(uint32_t device_id) {
+  if (stats_dump_interval_ms_ <= 0) {
+    return;
+  }
+  int64_t now = GetSteadyTimeMs();
+  int64_t last = last_stats_dump_ms_.load();
+  if ((now - last >= stats_dump_interval_ms_) && last_stats_dump_ms_.compare_exchange_strong(last, now)) {
+    DumpStats(device_id, "periodic");
+  }
+}
 }  // namespace ge
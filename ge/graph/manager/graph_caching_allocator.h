@@ -17,6 +17,7 @@
 #ifndef GE_GRAPH_MANAGER_GRAPH_CACHING_ALLOCATOR_H_
 #define GE_GRAPH_MANAGER_GRAPH_CACHING_ALLOCATOR_H_
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -28,6 +29,7 @@
 #include <unordered_set>
 
 #include "framework/common/ge_inner_error_codes.h"
+#include "framework/memory/memory_api.h"
 #include "graph/node.h"
 #include "graph/manager/block_memory.h"
 #include "runtime/mem.h"
@@ -40,11 +42,25 @@ constexpr size_t kMByteSize = 1024 * 1024;
 constexpr size_t kGByteSize = 1024 * 1024 * 1024;
 
 static const uint32_t kNumBins = 8;
+// allocated blocks are spread over shards by address, Malloc and Free of different threads do not contend
+static const uint32_t kNumAllocatedShards = 16;
+// statistics are kept for devices with smaller id
+static const uint32_t kMaxStatsDeviceNum = 64;
 
 class MemoryAllocator;
 
+///
+/// Device memory is carved from large chunks kept in size ordered bins (the central heap).
+/// Small freed blocks are kept in caches by finer size classes. A cache belongs to one thread and one stream,
+/// a freed block goes to the cache of the freeing thread for the stream the block was allocated on and is only
+/// handed out again for that stream, after the work of its former user in stream order. Only the owner thread
+/// touches a cache, so the cache path takes no lock. Other threads get the cached blocks back when the owner
+/// exits, or from the owner itself on its next call after they ran short of memory.
+///
 class CachingAllocator {
  public:
+  struct StreamCache;
+
   explicit CachingAllocator(rtMemType_t memory_type);
 
   CachingAllocator(const CachingAllocator &) = delete;
@@ -74,9 +90,10 @@ class CachingAllocator {
   /// @param [in] size memory size
   /// @param [in] try to reuse the same memory
   /// @param [in] device id
+  /// @param [in] stream the memory is used on, freed small blocks are only reused on the same stream
   /// @return  memory address
   ///
-  uint8_t *Malloc(size_t size, uint8_t *org_ptr = nullptr, uint32_t device_id = 0);
+  uint8_t *Malloc(size_t size, uint8_t *org_ptr = nullptr, uint32_t device_id = 0, rtStream_t stream = nullptr);
 
   ///
   /// @ingroup ge_graph
@@ -87,7 +104,64 @@ class CachingAllocator {
   ///
   Status Free(uint8_t *memory_addr, uint32_t device_id = 0);
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief get allocation statistics of device
+  /// @param [in] device_id device id
+  /// @param [out] stats statistics
+  /// @return Status result of function
+  ///
+  Status GetStats(uint32_t device_id, CachingAllocatorStats &stats);
+
  private:
+  struct DeviceStats {
+    DeviceStats() {
+      for (uint32_t i = 0; i < kNumBins; ++i) {
+        bin_hit_num[i].store(0);
+        bin_miss_num[i].store(0);
+      }
+    }
+    std::atomic<uint64_t> malloc_num{0};
+    std::atomic<uint64_t> free_num{0};
+    std::atomic<uint64_t> thread_cache_hit_num{0};
+    std::atomic<uint64_t> bin_hit_num[kNumBins];
+    std::atomic<uint64_t> bin_miss_num[kNumBins];
+    std::atomic<uint64_t> split_num{0};
+    std::atomic<uint64_t> merge_num{0};
+    std::atomic<uint64_t> extend_num{0};
+    std::atomic<uint64_t> extend_fail_num{0};
+    std::atomic<uint64_t> cached_size{0};
+    std::atomic<uint64_t> cached_peak_size{0};
+    std::atomic<uint64_t> in_use_size{0};
+    std::atomic<uint64_t> in_use_peak_size{0};
+    std::atomic<uint64_t> thread_cached_size{0};
+  };
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief get statistics of device
+  /// @param [in] device_id device id
+  /// @return stats ptr, nullptr if the device id is out of range
+  ///
+  DeviceStats *GetDeviceStats(uint32_t device_id);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief log statistics of device
+  /// @param [in] device_id device id
+  /// @param [in] reason why the statistics are dumped
+  /// @return void
+  ///
+  void DumpStats(uint32_t device_id, const char *reason);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief dump statistics if the dump interval has passed since last dump
+  /// @param [in] device_id device id
+  /// @return void
+  ///
+  void TryDumpStatsPeriodically(uint32_t device_id);
+
   ///
   /// @ingroup ge_graph
   /// @brief extend cache by size
@@ -132,6 +206,52 @@ class CachingAllocator {
   ///
   void FreeBlock(Block *block);
 
+  ///
+  /// @ingroup ge_graph
+  /// @brief get the cache of calling thread for stream, create it on first use
+  /// @param [in] stream
+  /// @return stream cache ptr
+  ///
+  StreamCache *GetStreamCache(rtStream_t stream);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief return blocks held by the caches of calling thread and of exited threads to the bins
+  /// @return true if any block was returned
+  ///
+  bool FlushStreamCaches();
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief ask the threads owning caches to return their blocks to the bins on their next call
+  /// @return void
+  ///
+  void RequestFlushStreamCaches();
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief return blocks taken out of stream caches to the bins
+  /// @param [in] blocks
+  /// @return void
+  ///
+  void ReturnCachedBlocks(const std::vector<Block *> &blocks);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief record allocated block in its shard
+  /// @param [in] block ptr
+  /// @return void
+  ///
+  void AddAllocatedBlock(Block *block);
+
+  ///
+  /// @ingroup ge_graph
+  /// @brief remove allocated block from its shard
+  /// @param [in] memory ptr
+  /// @return block ptr, nullptr if memory was not allocated by this allocator
+  ///
+  Block *RemoveAllocatedBlock(uint8_t *ptr);
+
   ///
   /// @ingroup ge_graph
   /// @brief free all cached blocks to right bin and release the memory when memory is not enough
@@ -175,19 +295,43 @@ class CachingAllocator {
   Block *SplitBlock(Block *block, size_t size, BlockBin &bin, uint32_t device_id);
 
  private:
+  struct AllocatedShard {
+    std::mutex mutex;
+    std::unordered_map<uint8_t *, Block *> blocks;
+  };
+
   rtMemType_t memory_type_;
 
   // device memory allocator
   MemoryAllocator *memory_allocator_;
 
-  // lock around all operations
+  // lock around operations on the bins
   mutable std::recursive_mutex mutex_;
 
   // allocated blocks by memory pointer
-  std::unordered_map<uint8_t *, Block *> allocated_blocks_;
+  AllocatedShard allocated_shards_[kNumAllocatedShards];
+
+  // identifies the allocator in the thread local cache table, addresses may be reused after delete
+  uint64_t instance_id_;
+
+  // bumped when the cached blocks are taken back by FreeBlocks, the thread local caches of older ones are dropped
+  std::atomic<uint64_t> cache_generation_;
+
+  // caches of all threads, the blocks of caches of exited threads are taken back on a bin miss
+  std::mutex stream_caches_mutex_;
+  std::vector<std::shared_ptr<StreamCache>> stream_caches_;
+
+  // number of caches whose owner thread exited, shared with the caches which may outlive the allocator
+  std::shared_ptr<std::atomic<uint32_t>> orphan_cache_num_;
 
   // block bins by different block size
   BlockBin *free_block_bins_[kNumBins];
+
+  std::unique_ptr<DeviceStats[]> device_stats_;
+
+  // statistics are logged periodically when GE_CACHING_ALLOCATOR_STATS_INTERVAL is set, in seconds
+  int64_t stats_dump_interval_ms_;
+  std::atomic<int64_t> last_stats_dump_ms_;
 };
 }  // namespace ge
 #endif  // GE_GRAPH_MANAGER_GRAPH_CACHING_ALLOCATOR_H_
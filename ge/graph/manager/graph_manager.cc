@@ -27,7 +27,7 @@
 
 #include "common/ge/ge_util.h"
 #include "common/math/math_util.h"
-#include "common/thread_pool.h"
+#include "common/task_scheduler.h"
 #include "common/util.h"
 #include "external/graph/types.h"
 #include "framework/common/debug/ge_log.h"
@@ -376,9 +376,8 @@ Status GraphManager::CopySubGraphAndMarkFusion(const ComputeGraphPtr &compute_gr
 Status GraphManager::OptimizeSubGraphWithMultiThreads(ComputeGraphPtr compute_graph,
                                                       Graph2SubGraphInfoList &sub_graph_map, uint64_t session_id) {
   GE_CHECK_NOTNULL(compute_graph);
-  // use default 16 multi thread
-  const uint32_t thread_num = 16;
-  ThreadPool executor(thread_num);
+  // tasks run on the process wide scheduler, the group waits for all of them before returning
+  TaskGroup executor;
   std::vector<std::future<Status>> vector_future;
   const auto &root_subgraph_list = sub_graph_map[compute_graph];
   std::string op_compile_strategy;
@@ -388,7 +387,7 @@ Status GraphManager::OptimizeSubGraphWithMultiThreads(ComputeGraphPtr compute_gr
     if (!op_compile_strategy.empty()) {
       (void)AttrUtils::SetStr(subgraph->GetSubGraph(), ATTR_NAME_OP_COMPILE_STRATEGY, op_compile_strategy);
     }
-    std::future<Status> f = executor.commit(GraphManager::ProcessSubGraphWithMultiThreads, this, subgraph, session_id,
+    std::future<Status> f = executor.Commit(GraphManager::ProcessSubGraphWithMultiThreads, this, subgraph, session_id,
                                             GetThreadLocalContext());
     if (!f.valid()) {
       GELOGE(FAILED, "Future is invalid");
@@ -403,7 +402,7 @@ Status GraphManager::OptimizeSubGraphWithMultiThreads(ComputeGraphPtr compute_gr
       if (!op_compile_strategy.empty()) {
         (void)AttrUtils::SetStr(subgraph->GetSubGraph(), ATTR_NAME_OP_COMPILE_STRATEGY, op_compile_strategy);
       }
-      std::future<Status> f = executor.commit(GraphManager::ProcessSubGraphWithMultiThreads, this, subgraph, session_id,
+      std::future<Status> f = executor.Commit(GraphManager::ProcessSubGraphWithMultiThreads, this, subgraph, session_id,
                                               GetThreadLocalContext());
       if (!f.valid()) {
         GELOGE(FAILED, "Future is invalid");
@@ -1968,7 +1967,8 @@ Status GraphManager::OptimizeStage1(ge::ComputeGraphPtr &compute_graph) {
   names_to_passes.emplace_back("ConstantFoldingPass", &constant_folding_pass);
   names_to_passes.emplace_back("DimensionAdjustPass", &dimension_adjust_pass);
   GE_TIMESTAMP_START(names_to_passes);
-  ret = GEPass(compute_graph).Run(names_to_passes);
+  GEPass ge_passes(compute_graph);
+  ret = ge_passes.Run(names_to_passes);
   GE_TIMESTAMP_END(names_to_passes, "GraphManager::OptimizeStage1_2");
   if (ret != SUCCESS) {
     GELOGE(ret, "Run passes when OptimizeStage1_2 failed, ret:%u.", ret);
@@ -2022,7 +2022,9 @@ Status GraphManager::OptimizeStage1(ge::ComputeGraphPtr &compute_graph) {
   GE_TIMESTAMP_START(identity_remove_pass);
   IdentityPass identity_force_pass(false);  // after SwitchToStreamSwitchPass
   identity_remove_pass.emplace_back("IdentityPass", &identity_force_pass);
-  ret = GEPass(compute_graph).Run(identity_remove_pass);
+  GEPass identity_ge_passes(compute_graph);
+  identity_ge_passes.SetParallel(true);
+  ret = identity_ge_passes.Run(identity_remove_pass);
   GE_TIMESTAMP_END(identity_remove_pass, "GraphPrepare::IdentityRemovePass");
   if (ret != SUCCESS) {
     GELOGE(ret, "Run identity remove pass for preprocess failed, ret:%u.", ret);
@@ -2058,7 +2060,8 @@ Status GraphManager::OptimizeStage2(ge::ComputeGraphPtr &compute_graph) {
   names_to_passes.emplace_back("CondRemovePass", &condition_remove_pass);
   names_to_passes.emplace_back("BitcastPass", &bitcast_pass);
   GE_TIMESTAMP_START(names_to_passes);
-  ret = GEPass(compute_graph).Run(names_to_passes);
+  GEPass ge_passes(compute_graph);
+  ret = ge_passes.Run(names_to_passes);
   GE_TIMESTAMP_END(names_to_passes, "OptimizeStage2::MergedGraphNameToPasses");
   if (ret != SUCCESS) {
     GELOGE(ret, "Run ge_passes optimize for OptimizeAfterMergeSubGraph failed, ret:%d.", ret);
@@ -2261,6 +2264,8 @@ Status GraphManager::ProcessSubGraphWithMultiThreads(GraphManager *graph_manager
                                                      const SubGraphInfoPtr &sub_graph_info_ptr, uint64_t session_id,
                                                      const GEThreadLocalContext &ge_context) {
   Status ret = SUCCESS;
+  // the worker is shared by all sessions, leave its contexts as they were for the tasks after this one
+  LocalContextGuard context_guard;
   GetThreadLocalContext() = ge_context;
   if (sub_graph_info_ptr != nullptr && graph_manager != nullptr) {
     SetLocalOmgContext(graph_manager->omg_context_);
@@ -18,6 +18,7 @@
 
 #include <memory>
 
+#include "graph/manager/graph_caching_allocator.h"
 #include "graph/manager/graph_mem_allocator.h"
 #include "graph/manager/host_mem_manager.h"
 #include "graph/manager/rdma_pool_allocator.h"
@@ -42,4 +43,9 @@ Status GetVarBaseAddrAndSize(const string &var_name, uint64_t &base_addr, uint64
   GELOGD("GetVarBaseAddrAndSize in");
   return HostMemManager::Instance().QueryVarMemInfo(var_name, base_addr, var_size);
 }
+
+Status GetCachingAllocatorStats(uint32_t device_id, CachingAllocatorStats &stats, rtMemType_t mem_type) {
+  GELOGD("GetCachingAllocatorStats in, device id %u", device_id);
+  return MemManager::Instance().CachingInstance(mem_type).GetStats(device_id, stats);
+}
 }  // namespace ge
\ No newline at end of file
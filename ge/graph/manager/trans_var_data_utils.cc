@@ -25,7 +25,7 @@
 #include "graph/manager/graph_var_manager.h"
 #include "graph/types.h"
 #include "graph/utils/type_utils.h"
-#include "common/thread_pool.h"
+#include "common/task_scheduler.h"
 #include <algorithm>
 
 namespace ge {
@@ -427,8 +427,8 @@ Status TransVarDataUtils::SyncTensorToDevice(const string &var_name, const uint8
 }
 
 Status TransVarDataUtils::TransAllVarData(const vector<NodePtr> &variable_nodes, uint64_t session_id,
-                                          rtContext_t context, uint32_t graph_id, uint32_t thread_num) {
-  ThreadPool executor(thread_num);
+                                          rtContext_t context, uint32_t graph_id) {
+  TaskGroup executor;
   std::vector<std::future<Status>> vector_future;
   for (auto &node : variable_nodes) {
     if (node == nullptr) {
@@ -439,7 +439,7 @@ Status TransVarDataUtils::TransAllVarData(const vector<NodePtr> &variable_nodes,
       continue;
     }
 
-    std::future<Status> f = executor.commit(
+    std::future<Status> f = executor.Commit(
       [](const ge::NodePtr &node, uint64_t session_id, rtContext_t ctx, uint32_t graph_id) -> Status {
         rtError_t rt_ret = rtCtxSetCurrent(ctx);
         if (rt_ret != RT_ERROR_NONE) {
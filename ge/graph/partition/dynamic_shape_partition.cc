@@ -18,10 +18,12 @@
 
 #include <algorithm>
 #include <iostream>
+#include <list>
 #include <memory>
 #include <queue>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include "common/ge/ge_util.h"
@@ -99,7 +101,7 @@ Status DynamicShapePartitioner::PartitionImpl() {
 
 void DynamicShapePartitioner::PruneUniqueClusters() {
   for (auto &node : root_graph_->GetDirectNode()) {
-    auto cluster = node_2_cluster_[node];
+    auto cluster = GetCluster(node);
     if (unique_clusters_.count(cluster) != 0) {
       continue;
     }
@@ -234,7 +236,7 @@ Status DynamicShapePartitioner::TopologicalSortClusters() {
   std::unordered_map<ClusterPtr, size_t> cluster_pending_count;
   std::unordered_set<ClusterPtr> seen_clusters;
   for (auto &node : root_graph_->GetDirectNode()) {
-    auto &cluster = node_2_cluster_[node];
+    auto cluster = GetCluster(node);
     if (seen_clusters.count(cluster) != 0) {
       continue;
     }
@@ -294,11 +296,6 @@ void DynamicShapePartitioner::MergeClustersUnknownShape() {
       auto merged_clusters = cluster->MergeAllPathFrom(in_cluster);
       GELOGD("Merge all path cluster from %lu to %lu %s.", in_cluster->Id(), cluster->Id(),
              ToString(merged_clusters).c_str());
-      for (const auto &merged_cluster : merged_clusters) {
-        for (const auto &node : merged_cluster->Nodes()) {
-          node_2_cluster_[node] = cluster;
-        }
-      }
     }
   }
 }
@@ -309,7 +306,6 @@ void DynamicShapePartitioner::MergeClustersKnownShape() {
     if (cluster->IsRefVariable() && cluster->Inputs().size() == 1) {
       auto in_cluster = *(cluster->Inputs().begin());
       in_cluster->Merge(cluster);
-      node_2_cluster_[*(cluster->Nodes().begin())] = in_cluster;
       continue;
     }
 
@@ -319,9 +315,6 @@ void DynamicShapePartitioner::MergeClustersKnownShape() {
       }
       if (cluster->TryMerge(in_cluster)) {
         GELOGD("Success merge known shape cluster from %lu to %lu.", in_cluster->Id(), cluster->Id());
-        for (const auto &node : in_cluster->Nodes()) {
-          node_2_cluster_[node] = cluster;
-        }
       }
     }
   }
@@ -339,10 +332,7 @@ void DynamicShapePartitioner::MergeClustersInputData() {
     } else {
       cluster_pre = cluster;
     }
-    GELOGD("Success merge input node cluster from %lu to %lu.", cluster->Id(), cluster->Id());
-    for (const auto &node : cluster->Nodes()) {
-      node_2_cluster_[node] = cluster_pre;
-    }
+    GELOGD("Success merge input node cluster from %lu to %lu.", cluster->Id(), cluster_pre->Id());
   }
 }
 
@@ -475,6 +465,48 @@ bool DynamicShapePartitioner::IsUnknownShapeTensor(const GeTensorDesc &tensor) {
   return false;
 }
 
+ClusterPtr DynamicShapePartitioner::GetCluster(const NodePtr &node) {
+  auto &cluster = node_2_cluster_[node];
+  if (cluster != nullptr) {
+    cluster = cluster->FindMergedCluster();
+  }
+  return cluster;
+}
+
+bool DynamicShapePartitioner::ClusterSet::Insert(const ClusterPtr &cluster) {
+  if (index_.count(cluster.get()) != 0) {
+    return false;
+  }
+  index_[cluster.get()] = clusters_.insert(clusters_.end(), cluster);
+  return true;
+}
+void DynamicShapePartitioner::ClusterSet::Erase(const ClusterPtr &cluster) {
+  auto iter = index_.find(cluster.get());
+  if (iter == index_.end()) {
+    return;
+  }
+  clusters_.erase(iter->second);
+  index_.erase(iter);
+}
+bool DynamicShapePartitioner::ClusterSet::Contains(const ClusterPtr &cluster) const {
+  return index_.count(cluster.get()) != 0;
+}
+size_t DynamicShapePartitioner::ClusterSet::Size() const { return clusters_.size(); }
+bool DynamicShapePartitioner::ClusterSet::Empty() const { return clusters_.empty(); }
+void DynamicShapePartitioner::ClusterSet::Clear() {
+  clusters_.clear();
+  index_.clear();
+}
+std::vector<ClusterPtr> DynamicShapePartitioner::ClusterSet::ToVector() const {
+  return std::vector<ClusterPtr>(clusters_.begin(), clusters_.end());
+}
+DynamicShapePartitioner::ClusterSet::const_iterator DynamicShapePartitioner::ClusterSet::begin() const {
+  return clusters_.begin();
+}
+DynamicShapePartitioner::ClusterSet::const_iterator DynamicShapePartitioner::ClusterSet::end() const {
+  return clusters_.end();
+}
+
 std::string Cluster::DebugString() const {
   std::stringstream ss;
   switch (type_) {
@@ -521,54 +553,46 @@ bool Cluster::IsUnknownShape() const { return type_ == UNKNOWN_SHAPE; };
 bool Cluster::IsNetOutput() const { return type_ == NETOUTPUT; };
 bool Cluster::IsInputNode() const { return type_ == INPUT_NODE; };
 bool Cluster::IsRefVariable() const {
-  if ((nodes_.size() == 1) && ((nodes_[0]->GetType() == VARIABLE) || (nodes_[0]->GetType() == VARIABLEV2))) {
+  if ((nodes_.size() == 1) && ((nodes_.front()->GetType() == VARIABLE) || (nodes_.front()->GetType() == VARIABLEV2))) {
     std::string ref_variable_name;
-    return (AttrUtils::GetStr(nodes_[0]->GetOpDesc(), REF_VAR_SRC_VAR_NAME, ref_variable_name) &&
+    return (AttrUtils::GetStr(nodes_.front()->GetOpDesc(), REF_VAR_SRC_VAR_NAME, ref_variable_name) &&
             !ref_variable_name.empty());
   }
   return false;
 }
 void Cluster::AddInput(ClusterPtr in) {
-  if (std::find(in_clusters_.begin(), in_clusters_.end(), in) != in_clusters_.end()) return;
-  in_clusters_.insert(in_clusters_.end(), in);
-  if (std::find(in->out_clusters_.begin(), in->out_clusters_.end(), shared_from_this()) != in->out_clusters_.end())
-    return;
-  in->out_clusters_.insert(in->out_clusters_.end(), shared_from_this());
+  if (!in_clusters_.Insert(in)) return;
+  in->out_clusters_.Insert(shared_from_this());
 };
 void Cluster::RemoveInput(ClusterPtr in) {
-  in_clusters_.erase(std::remove(in_clusters_.begin(), in_clusters_.end(), in), in_clusters_.end());
-  in->out_clusters_.erase(std::remove(in->out_clusters_.begin(), in->out_clusters_.end(), shared_from_this()),
-                          in->out_clusters_.end());
+  in_clusters_.Erase(in);
+  in->out_clusters_.Erase(shared_from_this());
 };
 void Cluster::AddOutput(ClusterPtr out) {
-  if (std::find(out_clusters_.begin(), out_clusters_.end(), out) != out_clusters_.end()) return;
-  out_clusters_.insert(out_clusters_.end(), out);
-  if (std::find(out->in_clusters_.begin(), out->in_clusters_.end(), shared_from_this()) != out->in_clusters_.end())
-    return;
-  out->in_clusters_.insert(out->in_clusters_.end(), shared_from_this());
+  if (!out_clusters_.Insert(out)) return;
+  out->in_clusters_.Insert(shared_from_this());
 };
 void Cluster::RemoveOutput(ClusterPtr out) {
-  out_clusters_.erase(std::remove(out_clusters_.begin(), out_clusters_.end(), out), out_clusters_.end());
-  out->in_clusters_.erase(std::remove(out->in_clusters_.begin(), out->in_clusters_.end(), shared_from_this()),
-                          out->in_clusters_.end());
+  out_clusters_.Erase(out);
+  out->in_clusters_.Erase(shared_from_this());
 };
 void Cluster::Merge(ClusterPtr other) {
-  nodes_.insert(nodes_.end(), other->nodes_.begin(), other->nodes_.end());
-  other->in_clusters_.erase(std::remove(other->in_clusters_.begin(), other->in_clusters_.end(), shared_from_this()),
-                            other->in_clusters_.end());
-  other->out_clusters_.erase(std::remove(other->out_clusters_.begin(), other->out_clusters_.end(), shared_from_this()),
-                             other->out_clusters_.end());
-  in_clusters_.erase(std::remove(in_clusters_.begin(), in_clusters_.end(), other), in_clusters_.end());
-  out_clusters_.erase(std::remove(out_clusters_.begin(), out_clusters_.end(), other), out_clusters_.end());
-  auto in_clusters = other->in_clusters_;
-  for (const auto &cluster : in_clusters) {
+  auto self = shared_from_this();
+  nodes_.splice(nodes_.end(), other->nodes_);
+  other->in_clusters_.Erase(self);
+  other->out_clusters_.Erase(self);
+  in_clusters_.Erase(other);
+  out_clusters_.Erase(other);
+  // Each move removes the front link of other, so only the links of other are visited
+  while (!other->in_clusters_.Empty()) {
+    auto cluster = *other->in_clusters_.begin();
     cluster->RemoveOutput(other);
-    cluster->AddOutput(shared_from_this());
+    cluster->AddOutput(self);
   }
-  auto out_clusters = other->out_clusters_;
-  for (const auto &cluster : out_clusters) {
+  while (!other->out_clusters_.Empty()) {
+    auto cluster = *other->out_clusters_.begin();
     cluster->RemoveInput(other);
-    cluster->AddInput(shared_from_this());
+    cluster->AddInput(self);
   }
   if (other->max_ > max_) {
     max_ = other->max_;
@@ -576,9 +600,11 @@ void Cluster::Merge(ClusterPtr other) {
   if (other->min_ < min_) {
     min_ = other->min_;
   }
+  other->merged_to_ = self;
 };
 bool Cluster::TryMerge(ClusterPtr other) {
   std::queue<ClusterPtr> forward_reached;
+  std::unordered_set<Cluster *> forward_reached_clusters;
   forward_reached.push(other);
   while (!forward_reached.empty()) {
     auto current_cluster = forward_reached.front();
@@ -586,7 +612,7 @@ bool Cluster::TryMerge(ClusterPtr other) {
     for (const auto &cluster : current_cluster->out_clusters_) {
       if (cluster->max_ == max_ && current_cluster != other) {
         return false;
-      } else if (cluster->min_ < max_) {
+      } else if (cluster->min_ < max_ && forward_reached_clusters.insert(cluster.get()).second) {
         forward_reached.push(cluster);
       }
     }
@@ -595,42 +621,64 @@ bool Cluster::TryMerge(ClusterPtr other) {
   return true;
 };
 std::vector<ClusterPtr> Cluster::MergeAllPathFrom(ClusterPtr other) {
-  std::queue<ClusterPtr> forward_reached_queue;
+  enum PathState { kUnresolved, kOnPath, kOffPath };
   std::queue<ClusterPtr> backward_reached_queue;
-
-  std::unordered_set<ClusterPtr> forward_reached_clusters;
-  std::unordered_set<ClusterPtr> backward_reached_clusters;
+  std::vector<ClusterPtr> backward_reached_clusters;
+  std::unordered_map<Cluster *, PathState> path_states;
   std::vector<ClusterPtr> path_clusters;
 
-  if (std::find(other->out_clusters_.begin(), other->out_clusters_.end(), shared_from_this()) ==
-      other->out_clusters_.end()) {
+  if (!other->out_clusters_.Contains(shared_from_this())) {
     return path_clusters;
   }
   path_clusters.push_back(other);
-  forward_reached_queue.push(other);
+  // Every cluster on a path from other reaches this, and is after other in topological order
   backward_reached_queue.push(shared_from_this());
-  while (!forward_reached_queue.empty()) {
-    auto current_cluster = forward_reached_queue.front();
-    forward_reached_queue.pop();
-    for (const auto &cluster : current_cluster->out_clusters_) {
-      if (cluster->min_ < max_ && cluster->max_ != max_ && forward_reached_clusters.count(cluster) == 0) {
-        forward_reached_clusters.insert(cluster);
-        forward_reached_queue.push(cluster);
-      }
-    }
-  }
   while (!backward_reached_queue.empty()) {
     auto current_cluster = backward_reached_queue.front();
     backward_reached_queue.pop();
     for (const auto &cluster : current_cluster->in_clusters_) {
       if (cluster->max_ > other->min_ && cluster->max_ != other->max_ &&
-          backward_reached_clusters.count(cluster) == 0) {
-        backward_reached_clusters.insert(cluster);
+          path_states.emplace(cluster.get(), kUnresolved).second) {
+        backward_reached_clusters.push_back(cluster);
         backward_reached_queue.push(cluster);
-        if (forward_reached_clusters.count(cluster) != 0) {
-          path_clusters.push_back(cluster);
+      }
+    }
+  }
+  // A reached cluster is on a path if one of its inputs is other or on a path, inputs of a cluster on a path are
+  // either other or reached as well. Each input link is checked only once.
+  std::vector<std::pair<Cluster *, ClusterSet::const_iterator>> unresolved_clusters;
+  for (const auto &reached_cluster : backward_reached_clusters) {
+    if (path_states[reached_cluster.get()] != kUnresolved) {
+      continue;
+    }
+    unresolved_clusters.emplace_back(reached_cluster.get(), reached_cluster->in_clusters_.begin());
+    while (!unresolved_clusters.empty()) {
+      auto current_cluster = unresolved_clusters.back().first;
+      auto &iter = unresolved_clusters.back().second;
+      PathState state = kOffPath;
+      Cluster *unresolved_input = nullptr;
+      for (; iter != current_cluster->in_clusters_.end(); ++iter) {
+        auto input_state = path_states.find(iter->get());
+        if (iter->get() == other.get() || (input_state != path_states.end() && input_state->second == kOnPath)) {
+          state = kOnPath;
+          break;
+        }
+        if (input_state != path_states.end() && input_state->second == kUnresolved) {
+          unresolved_input = iter->get();
+          break;
         }
       }
+      if (unresolved_input != nullptr) {
+        unresolved_clusters.emplace_back(unresolved_input, unresolved_input->in_clusters_.begin());
+        continue;
+      }
+      path_states[current_cluster] = state;
+      unresolved_clusters.pop_back();
+    }
+  }
+  for (const auto &cluster : backward_reached_clusters) {
+    if (path_states[cluster.get()] == kOnPath) {
+      path_clusters.push_back(cluster);
     }
   }
   for (const auto &cluster : path_clusters) {
@@ -638,9 +686,22 @@ std::vector<ClusterPtr> Cluster::MergeAllPathFrom(ClusterPtr other) {
   }
   return path_clusters;
 }
-std::vector<ClusterPtr> Cluster::Inputs() const { return in_clusters_; };
-std::vector<ClusterPtr> Cluster::Outputs() const { return out_clusters_; };
-std::vector<NodePtr> Cluster::Nodes() const { return nodes_; };
+ClusterPtr Cluster::FindMergedCluster() {
+  auto merged_cluster = shared_from_this();
+  while (merged_cluster->merged_to_ != nullptr) {
+    merged_cluster = merged_cluster->merged_to_;
+  }
+  auto cluster = shared_from_this();
+  while (cluster->merged_to_ != nullptr) {
+    auto next = cluster->merged_to_;
+    cluster->merged_to_ = merged_cluster;
+    cluster = next;
+  }
+  return merged_cluster;
+}
+std::vector<ClusterPtr> Cluster::Inputs() const { return in_clusters_.ToVector(); };
+std::vector<ClusterPtr> Cluster::Outputs() const { return out_clusters_.ToVector(); };
+std::vector<NodePtr> Cluster::Nodes() const { return std::vector<NodePtr>(nodes_.begin(), nodes_.end()); };
 
 void Cluster::AddFrameInput(InDataAnchorPtr anchor) {
   inputs_index_[anchor] = inputs_.size();
@@ -672,7 +733,7 @@ Status Cluster::BuildFrame() {
     auto in_control_anchor = node->GetInControlAnchor();
     if (in_control_anchor != nullptr) {
       for (const auto &peer_out_control_anchor : in_control_anchor->GetPeerOutControlAnchors()) {
-        auto src_cluster = partitioner_->node_2_cluster_[peer_out_control_anchor->GetOwnerNode()];
+        auto src_cluster = partitioner_->GetCluster(peer_out_control_anchor->GetOwnerNode());
         if (src_cluster->id_ != id_) {
           REQUIRE_GRAPH_SUCCESS(
             GraphUtils::RemoveEdge(peer_out_control_anchor, in_control_anchor),
@@ -725,7 +786,7 @@ Status Cluster::BuildPartitionFrame() {
       if (peer_out_anchor == nullptr) {
         continue;  // Skip overhang input.
       }
-      auto src_cluster = partitioner_->node_2_cluster_[peer_out_anchor->GetOwnerNode()];
+      auto src_cluster = partitioner_->GetCluster(peer_out_anchor->GetOwnerNode());
       if (src_cluster->id_ != id_) {
         AddFrameInput(anchor);
         REQUIRE_GRAPH_SUCCESS(partition_op->AddInputDesc(node->GetOpDesc()->GetInputDesc(anchor->GetIdx())),
@@ -738,7 +799,7 @@ Status Cluster::BuildPartitionFrame() {
         if (peer_out_control_anchor == nullptr) {
           continue;
         }
-        auto src_cluster = partitioner_->node_2_cluster_[peer_out_control_anchor->GetOwnerNode()];
+        auto src_cluster = partitioner_->GetCluster(peer_out_control_anchor->GetOwnerNode());
         if (src_cluster->id_ != id_) {
           REQUIRE_GRAPH_SUCCESS(
             GraphUtils::RemoveEdge(peer_out_control_anchor, in_control_anchor),
@@ -752,7 +813,7 @@ Status Cluster::BuildPartitionFrame() {
     for (const auto &anchor : node->GetAllOutDataAnchors()) {
       auto peer_in_anchors = anchor->GetPeerInDataAnchors();
       for (const auto &peer_in_anchor : peer_in_anchors) {
-        auto src_cluster = partitioner_->node_2_cluster_[peer_in_anchor->GetOwnerNode()];
+        auto src_cluster = partitioner_->GetCluster(peer_in_anchor->GetOwnerNode());
         if (src_cluster->id_ != id_) {
           AddFrameOutput(anchor);
           REQUIRE_GRAPH_SUCCESS(partition_op->AddOutputDesc(node->GetOpDesc()->GetOutputDesc(anchor->GetIdx())),
@@ -779,7 +840,7 @@ Status Cluster::BuildPartitionFrame() {
 Status Cluster::CombinePartitionFrame() {
   for (const auto &anchor : inputs_) {
     auto peer_out_anchor = anchor->GetPeerOutAnchor();
-    auto src_cluster = partitioner_->node_2_cluster_[peer_out_anchor->GetOwnerNode()];
+    auto src_cluster = partitioner_->GetCluster(peer_out_anchor->GetOwnerNode());
     auto src_anchor = src_cluster->GetFrameOutDataAnchor(peer_out_anchor);
     auto dst_anchor = GetFrameInDataAnchor(anchor);
     REQUIRE_GRAPH_SUCCESS(GraphUtils::RemoveEdge(peer_out_anchor, anchor), "Failed remove edge from %s:%d to %s:%d.",
@@ -863,6 +924,7 @@ void Cluster::Clear() {
   in_clusters_.clear();
   out_clusters_.clear();
   nodes_.clear();
+  merged_to_.reset();
   partitioner_ = nullptr;
   inputs_index_.clear();
   outputs_index_.clear();
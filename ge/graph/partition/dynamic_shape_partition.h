@@ -17,6 +17,8 @@
 #ifndef GE_GRAPH_PARTITION_DYNAMIC_SHAPE_PARTITION_H_
 #define GE_GRAPH_PARTITION_DYNAMIC_SHAPE_PARTITION_H_
 
+#include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,6 +29,26 @@
 namespace ge {
 class DynamicShapePartitioner {
  public:
+  class Cluster;
+  // Clusters in the order they were added, adding, removing and looking up a cluster take constant time
+  class ClusterSet {
+   public:
+    using const_iterator = std::list<std::shared_ptr<Cluster>>::const_iterator;
+    // Add cluster to the end, return false if it is already in the set
+    bool Insert(const std::shared_ptr<Cluster> &cluster);
+    void Erase(const std::shared_ptr<Cluster> &cluster);
+    bool Contains(const std::shared_ptr<Cluster> &cluster) const;
+    size_t Size() const;
+    bool Empty() const;
+    void Clear();
+    std::vector<std::shared_ptr<Cluster>> ToVector() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+
+   private:
+    std::list<std::shared_ptr<Cluster>> clusters_;
+    std::unordered_map<const Cluster *, std::list<std::shared_ptr<Cluster>>::iterator> index_;
+  };
   // An cluster means set of nodes that can be merged in same partition,
   // Corresponding relationship between cluster type and node:
   // DATA:DATA, UNKNOWN_SHAPE:unknowshape, KNOWN_SHAPE:knowshape, NETOUTPUT:NETOUTPUT.
@@ -66,6 +88,8 @@ class DynamicShapePartitioner {
     bool TryMerge(std::shared_ptr<Cluster> other);
     // Merge all clusters on path(s) from other to this
     std::vector<std::shared_ptr<Cluster>> MergeAllPathFrom(std::shared_ptr<Cluster> other);
+    // The cluster this cluster was merged into at last, itself if it was never merged
+    std::shared_ptr<Cluster> FindMergedCluster();
     // Convert cluster to functioned call functions
     void AddFrameInput(InDataAnchorPtr anchor);
     void AddFrameOutput(OutDataAnchorPtr anchor);
@@ -87,9 +111,11 @@ class DynamicShapePartitioner {
     size_t min_;  // maximum topological order
     size_t max_;  // minimum topological order
     Type type_;
-    std::vector<std::shared_ptr<Cluster>> in_clusters_;
-    std::vector<std::shared_ptr<Cluster>> out_clusters_;
-    std::vector<NodePtr> nodes_;
+    ClusterSet in_clusters_;
+    ClusterSet out_clusters_;
+    std::list<NodePtr> nodes_;
+    // Set when this cluster is merged, shortened to the last cluster on every FindMergedCluster
+    std::shared_ptr<Cluster> merged_to_;
     // Fileds for build partitoned call and subgraph
     DynamicShapePartitioner *partitioner_;  // Not owned, the partitioner this cluster belongs to
     std::unordered_map<InDataAnchorPtr, size_t> inputs_index_;
@@ -150,8 +176,11 @@ class DynamicShapePartitioner {
   Status IsUnknownShapeGraph(ge::ComputeGraphPtr graph, bool &is_unknow);
   Status IsUnknownShapeNode(ge::NodePtr node, bool &is_unknow);
   bool IsUnknownShapeTensor(const ge::GeTensorDesc &tensor);
-  ge::ComputeGraphPtr root_graph_;                                        // The original graph to partition
-  std::unordered_map<NodePtr, std::shared_ptr<Cluster>> node_2_cluster_;  // Record nodes and the cluster it belongs to
+  // The cluster node belongs to after merging
+  std::shared_ptr<Cluster> GetCluster(const NodePtr &node);
+  ge::ComputeGraphPtr root_graph_;  // The original graph to partition
+  // Record nodes and the cluster it belongs to, merges are not written back at once, read it by GetCluster
+  std::unordered_map<NodePtr, std::shared_ptr<Cluster>> node_2_cluster_;
   // topological sorted clusters, this field will change with the splitting.
   // When partitioning UNKNOWN_SHAPE cluster, it is a collection of all topological sorted UNKNOWN_SHAPE clusters
   // When partitioning KNOWN_SHAPE cluster, it is a collection of all topological sorted KNOWN_SHAPE clusters
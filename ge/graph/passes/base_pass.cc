@@ -16,10 +16,13 @@
 
 #include "graph/passes/base_pass.h"
 
+#include <algorithm>
 #include <queue>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "common/debug/log.h"
+#include "common/task_scheduler.h"
 #include "framework/common/debug/ge_log.h"
 #include "graph/compute_graph.h"
 #include "graph/utils/graph_utils.h"
@@ -30,56 +33,418 @@ constexpr int kMaxRePassTimes = 1000;
 constexpr size_t kMaxOneInNodes = 1000;
 // Each iteration, we take about 0.3k memory on the stack, we should change the recursion to loop later
 constexpr int kMaxRecursiveDepth = 20;
+// Analysis of one node is cheap, do not split a wave into tasks smaller than this
+constexpr size_t kMinNodesPerAnalyzeTask = 64;
+// Passes after the first 64 ones are not tracked and always run on the nodes
+constexpr size_t kMaxTrackedPasses = 64;
+constexpr uint64_t kAllPassesPending = ~0ULL;
+}  // namespace
 
-void GetAllNodesNoInputEdge(const ComputeGraphPtr &graph, std::queue<NodePtr> &input_edge_nodes,
-                            std::unordered_set<Node *> &nodes_seen, std::unordered_set<NodePtr> &nodes_last) {
-  nodes_last.clear();
-  for (auto &node : graph->GetDirectNode()) {
-    if (node == nullptr) {
-      continue;
+///
+/// Traversal state of one graph, indexed by dense node ids.
+/// `pending_in_nums_` counts the in nodes of a node which are not seen yet, so the check
+/// whether all in nodes are seen does not rescan the inputs of the node on every in edge.
+/// Nodes reported by passes or added after the index was built are marked dirty, their counters
+/// may be stale and they are checked against their current in nodes instead. A change that was not reported
+/// may leave the counter of a clean node too high, such nodes are found when the queue runs empty.
+/// `pending_passes_` is the change journal folded per node: bit i is set while pass i has not seen
+/// the latest version of the node and its neighbours, a re-passed node only runs the passes which have not seen
+/// its changes.
+///
+class NodeTraversalState {
+ public:
+  explicit NodeTraversalState(const ComputeGraphPtr &graph) {
+    auto direct_nodes = graph->GetDirectNode();
+    Reserve(direct_nodes.size());
+    for (const auto &node : direct_nodes) {
+      if (node == nullptr) {
+        continue;
+      }
+      (void)AddNode(node, false);
+    }
+  }
+
+  uint32_t GetId(const NodePtr &node) {
+    auto iter = ids_.find(node.get());
+    if (iter != ids_.end()) {
+      return iter->second;
+    }
+    return AddNode(node, true);
+  }
+
+  const NodePtr &GetNode(uint32_t id) const { return nodes_[id]; }
+
+  uint32_t GetNodeNum() const { return static_cast<uint32_t>(nodes_.size()); }
+
+  int64_t GetInNodesNum(uint32_t id) const { return in_nums_[id]; }
+
+  bool IsSeen(uint32_t id) const { return seen_[id]; }
+
+  ///
+  /// @return true if the node was not seen before
+  ///
+  bool MarkSeen(uint32_t id) {
+    if (seen_[id]) {
+      return false;
+    }
+    seen_[id] = true;
+    NodePtr node = nodes_[id];
+    for (const auto &out_node : node->GetOutNodes()) {
+      if (out_node != nullptr) {
+        --pending_in_nums_[GetId(out_node)];
+      }
+    }
+    return true;
+  }
+
+  bool IsAllInNodesSeen(uint32_t id) {
+    if (!dirty_[id] && pending_in_nums_[id] > 0) {
+      return false;
+    }
+    NodePtr node = nodes_[id];
+    for (const auto &in_node : node->GetInNodes()) {
+      if (in_node != nullptr && !seen_[GetId(in_node)]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  ///
+  /// Nodes whose counter blocks them although all their current in nodes are seen. A pass may remove an in edge
+  /// of a node without recording it, the counter of the node then never reaches zero. The nodes found are marked
+  /// seen, the counters of the blocked ones are not trusted any more and they are checked against the graph.
+  ///
+  std::vector<uint32_t> TakeStaleBlocked() {
+    std::vector<uint32_t> ids;
+    for (uint32_t id = 0; id < GetNodeNum(); ++id) {
+      if (seen_[id] || deleted_[id] || last_[id] || dirty_[id] || pending_in_nums_[id] <= 0) {
+        continue;
+      }
+      dirty_[id] = true;
+      if (IsAllInNodesSeen(id) && MarkSeen(id)) {
+        ids.emplace_back(id);
+      }
+    }
+    return ids;
+  }
+
+  ///
+  /// The node or its neighbourhood was changed, every pass has to see it again
+  ///
+  void MarkChanged(uint32_t id) {
+    dirty_[id] = true;
+    MarkStale(id);
+  }
+
+  ///
+  /// A neighbour of the node was changed, the passes which read it have to see the node again
+  ///
+  void MarkStale(uint32_t id) { pending_passes_[id] = kAllPassesPending; }
+
+  bool NeedRun(uint32_t id, size_t pass_index) const {
+    return (pass_index >= kMaxTrackedPasses) || ((pending_passes_[id] & (1ULL << pass_index)) != 0);
+  }
+
+  void MarkPassSeen(uint32_t id, size_t pass_index) {
+    if (pass_index < kMaxTrackedPasses) {
+      pending_passes_[id] &= ~(1ULL << pass_index);
+    }
+  }
+
+  void CountRun() { ++run_num_; }
+
+  void CountSkipped() { ++skip_num_; }
+
+  void CountChanges(size_t pass_index, size_t change_num) {
+    if (pass_index >= changes_by_pass_.size()) {
+      changes_by_pass_.resize(pass_index + 1, 0);
+    }
+    changes_by_pass_[pass_index] += change_num;
+  }
+
+  size_t GetRunNum() const { return run_num_; }
+
+  size_t GetSkipNum() const { return skip_num_; }
+
+  size_t GetChangeNum(size_t pass_index) const {
+    return pass_index < changes_by_pass_.size() ? changes_by_pass_[pass_index] : 0;
+  }
+
+  bool IsDeleted(uint32_t id) const { return deleted_[id]; }
+
+  void MarkDeleted(uint32_t id) { deleted_[id] = true; }
+
+  bool IsLast(uint32_t id) const { return last_[id]; }
+
+  void AddLast(uint32_t id) {
+    if (!last_[id]) {
+      last_[id] = true;
+      last_ids_.emplace_back(id);
+    }
+  }
+
+  std::vector<uint32_t> TakeLast() {
+    std::vector<uint32_t> last_ids;
+    last_ids.swap(last_ids_);
+    for (auto id : last_ids) {
+      last_[id] = false;
+    }
+    return last_ids;
+  }
+
+  bool HasRePass() const { return re_pass_num_ > 0; }
+
+  void AddRePass(uint32_t id) {
+    if (!re_pass_[id]) {
+      re_pass_[id] = true;
+      ++re_pass_num_;
+      re_pass_ids_.emplace_back(id);
     }
-    size_t in_nums = node->GetInNodes().size();
+  }
+
+  void RemoveRePass(uint32_t id) {
+    if (re_pass_[id]) {
+      re_pass_[id] = false;
+      --re_pass_num_;
+    }
+  }
+
+  ///
+  /// Take the nodes still waiting for re-pass in the order they were added
+  ///
+  std::vector<uint32_t> TakeRePass() {
+    std::vector<uint32_t> re_pass_ids;
+    re_pass_ids.reserve(re_pass_num_);
+    for (auto id : re_pass_ids_) {
+      if (re_pass_[id]) {
+        re_pass_[id] = false;
+        re_pass_ids.emplace_back(id);
+      }
+    }
+    re_pass_ids_.clear();
+    re_pass_num_ = 0;
+    return re_pass_ids;
+  }
+
+ private:
+  void Reserve(size_t node_num) {
+    ids_.reserve(node_num);
+    nodes_.reserve(node_num);
+    in_nums_.reserve(node_num);
+    pending_in_nums_.reserve(node_num);
+    pending_passes_.reserve(node_num);
+    seen_.reserve(node_num);
+    deleted_.reserve(node_num);
+    re_pass_.reserve(node_num);
+    last_.reserve(node_num);
+    dirty_.reserve(node_num);
+  }
+
+  uint32_t AddNode(const NodePtr &node, bool dirty) {
+    uint32_t id = static_cast<uint32_t>(nodes_.size());
+    int64_t in_num = dirty ? 0 : static_cast<int64_t>(node->GetInNodes().size());
+    ids_.emplace(node.get(), id);
+    nodes_.emplace_back(node);
+    in_nums_.emplace_back(in_num);
+    pending_in_nums_.emplace_back(in_num);
+    pending_passes_.emplace_back(kAllPassesPending);
+    seen_.emplace_back(false);
+    deleted_.emplace_back(false);
+    re_pass_.emplace_back(false);
+    last_.emplace_back(false);
+    dirty_.emplace_back(dirty);
+    return id;
+  }
+
+  std::unordered_map<const Node *, uint32_t> ids_;
+  std::vector<NodePtr> nodes_;
+  std::vector<int64_t> in_nums_;
+  std::vector<int64_t> pending_in_nums_;
+  std::vector<uint64_t> pending_passes_;
+  std::vector<bool> seen_;
+  std::vector<bool> deleted_;
+  std::vector<bool> re_pass_;
+  std::vector<bool> last_;
+  std::vector<bool> dirty_;
+  std::vector<uint32_t> re_pass_ids_;
+  std::vector<uint32_t> last_ids_;
+  std::vector<size_t> changes_by_pass_;
+  size_t re_pass_num_ = 0;
+  size_t run_num_ = 0;
+  size_t skip_num_ = 0;
+};
+
+namespace {
+
+void GetAllNodesNoInputEdge(NodeTraversalState &state, std::queue<uint32_t> &input_edge_nodes) {
+  uint32_t node_num = state.GetNodeNum();
+  for (uint32_t id = 0; id < node_num; ++id) {
+    int64_t in_nums = state.GetInNodesNum(id);
     if (in_nums == 0) {
-      input_edge_nodes.push(node);
-      nodes_seen.insert(node.get());
-    } else if (in_nums > kMaxOneInNodes) {
-      nodes_last.insert(node);
+      input_edge_nodes.push(id);
+      (void)state.MarkSeen(id);
+    } else if (in_nums > static_cast<int64_t>(kMaxOneInNodes)) {
+      state.AddLast(id);
     }
   }
 }
 
-void AddNextIterNodes(const Node::Vistor<NodePtr> &nodes, std::queue<NodePtr> &nodes_to_pass,
-                      std::unordered_set<Node *> &nodes_seen, std::unordered_set<NodePtr> &nodes_last) {
-  for (auto &node : nodes) {
-    if (node == nullptr) {
+void AddNextIterNodes(const NodePtr &node, std::queue<uint32_t> &nodes_to_pass, NodeTraversalState &state) {
+  for (const auto &out_node : node->GetOutNodes()) {
+    if (out_node == nullptr) {
       continue;
     }
-    if (nodes_last.count(node) != 0) {
+    uint32_t id = state.GetId(out_node);
+    if (state.IsLast(id)) {
       continue;
     }
+    if (state.IsAllInNodesSeen(id) && state.MarkSeen(id)) {
+      nodes_to_pass.push(id);
+    }
+  }
+}
+
+void GetNeighbours(const NodePtr &node, std::vector<NodePtr> &neighbours) {
+  neighbours.clear();
+  for (const auto &in_node : node->GetInNodes()) {
+    neighbours.emplace_back(in_node);
+  }
+  for (const auto &out_node : node->GetOutNodes()) {
+    neighbours.emplace_back(out_node);
+  }
+}
+
+void MarkNeighboursStale(const NodePtr &node, NodeTraversalState &state) {
+  for (const auto &in_node : node->GetInNodes()) {
+    state.MarkStale(state.GetId(in_node));
+  }
+  for (const auto &out_node : node->GetOutNodes()) {
+    state.MarkStale(state.GetId(out_node));
+  }
+}
+
+void AddRePassIfReady(const NodePtr &node, uint32_t id, NodeTraversalState &state) {
+  if (state.IsAllInNodesSeen(id)) {
+    GELOGD("The node %s will be re-pass later", node->GetName().c_str());
+    state.AddRePass(id);
+  } else {
+    GELOGD("The node %s are not all seen, don't set repass this time", node->GetName().c_str());
+  }
+}
+
+///
+/// Passes may change the edges around the node through GraphUtils without recording it. The neighbours of the
+/// node before the pass ran are compared with the current ones, the node and every neighbour whose edges to it
+/// were added or removed are handled as if the pass had recorded the edge change.
+///
+void RecordNeighbourhoodChanges(const NodePtr &node, const std::vector<NodePtr> &neighbours_before,
+                                NodeTraversalState &state) {
+  std::vector<NodePtr> neighbours;
+  GetNeighbours(node, neighbours);
+  if (neighbours == neighbours_before) {
+    return;
+  }
+  std::unordered_map<Node *, int64_t> edge_num_diffs;
+  for (const auto &neighbour : neighbours_before) {
+    --edge_num_diffs[neighbour.get()];
+  }
+  for (const auto &neighbour : neighbours) {
+    ++edge_num_diffs[neighbour.get()];
+  }
+  std::vector<NodePtr> peers;
+  for (const auto &neighbour : neighbours_before) {
+    if (edge_num_diffs[neighbour.get()] != 0) {
+      peers.emplace_back(neighbour);
+    }
+  }
+  for (const auto &neighbour : neighbours) {
+    if (edge_num_diffs[neighbour.get()] != 0) {
+      peers.emplace_back(neighbour);
+    }
+  }
+  GELOGD("The edges around node %s changed without a record", node->GetName().c_str());
+  uint32_t id = state.GetId(node);
+  state.MarkChanged(id);
+  if (!state.IsDeleted(id)) {
+    AddRePassIfReady(node, id, state);
+  }
+  for (const auto &peer : peers) {
+    uint32_t peer_id = state.GetId(peer);
+    state.MarkChanged(peer_id);
+    if (!state.IsDeleted(peer_id)) {
+      AddRePassIfReady(peer, peer_id, state);
+    }
+  }
+}
 
-    bool all_in_nodes_seen = node->IsAllInNodesSeen(nodes_seen);
-    if (all_in_nodes_seen && nodes_seen.insert(node.get()).second) {
-      nodes_to_pass.push(node);
+bool HandlePassResult(const NodePtr &node, size_t pass_index,
+                      const std::pair<std::string, BaseNodePass *> &name_to_pass, NodeTraversalState &state) {
+  const auto &changes = name_to_pass.second->GetChanges();
+  state.CountChanges(pass_index, changes.size());
+  bool current_deleted = false;
+  for (const auto &change : changes) {
+    if (change.node == nullptr) {
+      GELOGW("Found null changed node when executing %s on node %s type %s", name_to_pass.first.c_str(),
+             node->GetName().c_str(), node->GetType().c_str());
+      continue;
+    }
+    // the connections around the node changed, the precomputed in-degree is no longer valid for it
+    uint32_t id = state.GetId(change.node);
+    state.MarkChanged(id);
+    switch (change.type) {
+      case kNodeDeleted:
+        state.MarkDeleted(id);
+        current_deleted = current_deleted || (change.node == node);
+        break;
+      case kEdgeChanged:
+        AddRePassIfReady(change.node, id, state);
+        if (change.peer != nullptr) {
+          uint32_t peer_id = state.GetId(change.peer);
+          state.MarkChanged(peer_id);
+          AddRePassIfReady(change.peer, peer_id, state);
+        }
+        break;
+      default:
+        AddRePassIfReady(change.node, id, state);
+        // the passes read the neighbours of a node, a neighbour passed again has to run all of them
+        MarkNeighboursStale(change.node, state);
+        break;
     }
   }
+
+  if (current_deleted) {
+    GELOGD("The node %s was deleted by pass %s, stop the remain passes", node->GetName().c_str(),
+           name_to_pass.first.c_str());
+    return true;
+  }
+  return false;
 }
 
-Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::unordered_set<NodePtr> &nodes_re_pass,
-                 std::unordered_set<NodePtr> &nodes_deleted, std::unordered_set<Node *> &nodes_seen) {
+Status RunPasses(NodePtr &node, uint32_t id, const NamesToPass &names_to_passes, NodeTraversalState &state) {
   if (node == nullptr) {
     GELOGE(FAILED, "parameter is null.");
     return FAILED;
   }
   GELOGD("Begin to run pass for node %s", node->GetName().c_str());
-  for (const auto &name_to_pass : names_to_passes) {
+  std::vector<NodePtr> neighbours;
+  for (size_t i = 0; i < names_to_passes.size(); ++i) {
+    const auto &name_to_pass = names_to_passes[i];
     if (name_to_pass.second == nullptr) {
       GELOGE(INTERNAL_ERROR, "There is null pointer in passes(%s), skip it", name_to_pass.first.c_str());
       continue;
     }
+    if (!state.NeedRun(id, i)) {
+      GELOGD("Pass %s has seen the latest node %s, skip it", name_to_pass.first.c_str(), node->GetName().c_str());
+      state.CountSkipped();
+      continue;
+    }
 
     GELOGD("Begin to run pass %s for node %s", name_to_pass.first.c_str(), node->GetName().c_str());
+    state.MarkPassSeen(id, i);
+    state.CountRun();
     name_to_pass.second->init();
+    GetNeighbours(node, neighbours);
     auto result = name_to_pass.second->Run(node);
     if (result != SUCCESS) {
       GELOGE(INTERNAL_ERROR,
@@ -89,33 +454,82 @@ Status RunPasses(NodePtr &node, const NamesToPass &names_to_passes, std::unorder
       return result;
     }
 
-    auto nodes_to_re_pass = name_to_pass.second->GetNodesNeedRePass();
-    for (const auto &node_to_re_pass : nodes_to_re_pass) {
-      if (node_to_re_pass == nullptr) {
-        GELOGW("Found null re-pass node when executing %s on node %s type %s", name_to_pass.first.c_str(),
-               node->GetName().c_str(), node->GetType().c_str());
-        continue;
-      }
-      if (node_to_re_pass->IsAllInNodesSeen(nodes_seen)) {
-        GELOGD("The node %s will be re-pass later", node_to_re_pass->GetName().c_str());
-        nodes_re_pass.insert(node_to_re_pass);
-      } else {
-        GELOGD("The node %s are not all seen, don't set repass this time", node_to_re_pass->GetName().c_str());
-      }
+    bool current_deleted = HandlePassResult(node, i, name_to_pass, state);
+    RecordNeighbourhoodChanges(node, neighbours, state);
+    if (current_deleted) {
+      break;
     }
+  }
 
-    auto nodes_deleted_by_pass = name_to_pass.second->GetNodesDeleted();
-    nodes_deleted.insert(nodes_deleted_by_pass.begin(), nodes_deleted_by_pass.end());
-    if (nodes_deleted_by_pass.count(node) > 0) {
-      GELOGD("The node %s was deleted by pass %s, stop the remain passes", node->GetName().c_str(),
-             name_to_pass.first.c_str());
-      break;
+  return SUCCESS;
+}
+
+struct NodeAnalysis {
+  Status status = SUCCESS;
+  NodeCommit commit;
+  std::vector<NodePtr> neighbours;
+};
+
+void AnalyzeNodes(BaseNodePass *pass, const std::vector<NodePtr> &wave, const std::vector<bool> &to_run, size_t begin,
+                  size_t end, std::vector<NodeAnalysis> &analyses) {
+  for (size_t i = begin; i < end; ++i) {
+    if (!to_run[i]) {
+      continue;
+    }
+    auto &analysis = analyses[i];
+    analysis.status = pass->Analyze(wave[i], analysis.commit);
+    if (analysis.commit) {
+      GetNeighbours(wave[i], analysis.neighbours);
+    }
+  }
+}
+
+Status AnalyzeWave(const std::pair<std::string, BaseNodePass *> &name_to_pass, const std::vector<NodePtr> &wave,
+                   const std::vector<bool> &to_run, std::vector<NodeAnalysis> &analyses) {
+  analyses.clear();
+  analyses.resize(wave.size());
+  size_t task_num = (wave.size() + kMinNodesPerAnalyzeTask - 1) / kMinNodesPerAnalyzeTask;
+  task_num = std::min(task_num, static_cast<size_t>(TaskScheduler::GetInstance().GetWorkerNum()));
+  if (task_num <= 1) {
+    AnalyzeNodes(name_to_pass.second, wave, to_run, 0, wave.size(), analyses);
+  } else {
+    size_t nodes_per_task = (wave.size() + task_num - 1) / task_num;
+    TaskGroup group;
+    for (size_t begin = 0; begin < wave.size(); begin += nodes_per_task) {
+      size_t end = std::min(begin + nodes_per_task, wave.size());
+      auto future = group.Commit(AnalyzeNodes, name_to_pass.second, std::cref(wave), std::cref(to_run), begin, end,
+                                 std::ref(analyses));
+      if (!future.valid()) {
+        group.Wait();
+        GELOGE(FAILED, "Failed to commit analyze task of pass %s", name_to_pass.first.c_str());
+        return FAILED;
+      }
     }
+    group.Wait();
   }
 
+  for (size_t i = 0; i < wave.size(); ++i) {
+    if (analyses[i].status != SUCCESS) {
+      GELOGE(analyses[i].status, "Failed to analyze pass %s on node %s", name_to_pass.first.c_str(),
+             wave[i]->GetName().c_str());
+      return analyses[i].status;
+    }
+  }
   return SUCCESS;
 }
 
+// the wave order runs every pass over a wave before the next pass, which only keeps the result of the per node order
+// when no pass looks beyond the neighbours of its node
+bool IsAllNodeLocal(const NamesToPass &names_to_passes) {
+  for (const auto &name_to_pass : names_to_passes) {
+    if (name_to_pass.second != nullptr && !name_to_pass.second->IsNodeLocal()) {
+      GELOGD("Pass %s is not node-local, run the passes node by node", name_to_pass.first.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
 void SetFlagOption(NodePassOption option, NamesToPass names_to_pass) {
   for (auto &name_to_pass : names_to_pass) {
     name_to_pass.second->SetOption(option, "");
@@ -142,6 +556,12 @@ Status BaseNodePass::IsolateAndDeleteNode(NodePtr &node, const std::vector<int>
   }
 
   AddRePassNodesWithInOut(node);
+  for (const auto &in_node : node->GetInNodes()) {
+    RecordEdgeChanged(in_node, node);
+  }
+  for (const auto &out_node : node->GetOutNodes()) {
+    RecordEdgeChanged(node, out_node);
+  }
 
   if (GraphUtils::IsolateNode(node, io_map) != GRAPH_SUCCESS) {
     GELOGE(FAILED, "[%s] IsolateNode failed.", node->GetName().c_str());
@@ -180,36 +600,60 @@ Status GEPass::Run(const NamesToPass &names_to_passes) {
 
 Status GEPass::RunPassesOneGraph(const NamesToPass &names_to_passes) {
   GELOGD("Begin to run pass on graph, passes count %zu", names_to_passes.size());
-  std::queue<NodePtr> nodes;
-  std::unordered_set<Node *> nodes_seen;
-  std::unordered_set<NodePtr> nodes_deleted;
-  std::unordered_set<NodePtr> nodes_re_pass;
-  std::unordered_set<NodePtr> nodes_last;
-  GetAllNodesNoInputEdge(graph_, nodes, nodes_seen, nodes_last);
-  GELOGD("Start points count %zu", nodes.size());
+  NodeTraversalState state(graph_);
+  std::queue<uint32_t> nodes;
+  std::queue<uint32_t> nodes_next_wave;
+  GetAllNodesNoInputEdge(state, nodes);
+  GELOGD("Start points count %zu, nodes count %u", nodes.size(), state.GetNodeNum());
   int re_pass_times = 0;
+  bool parallel = parallel_ && IsAllNodeLocal(names_to_passes);
 
   do {
-    for (auto &node : nodes_re_pass) {
-      nodes.push(node);
-      nodes_seen.insert(node.get());
+    for (auto id : state.TakeRePass()) {
+      nodes.push(id);
+      (void)state.MarkSeen(id);
+    }
+
+    while (parallel && !nodes.empty()) {
+      std::vector<NodePtr> wave;
+      wave.reserve(nodes.size());
+      while (!nodes.empty()) {
+        uint32_t id = nodes.front();
+        nodes.pop();
+
+        state.RemoveRePass(id);
+        NodePtr node = state.GetNode(id);
+        if (state.IsDeleted(id)) {
+          GELOGD("The node %s was deleted before, skip it.", node->GetName().c_str());
+          continue;
+        }
+        AddNextIterNodes(node, nodes_next_wave, state);
+        wave.emplace_back(node);
+      }
+      nodes.swap(nodes_next_wave);
+
+      auto ret = RunPassesOneWave(names_to_passes, wave, state);
+      if (ret != SUCCESS) {
+        GELOGE(ret, "Failed to process passes on wave of %zu nodes, error code: %u", wave.size(), ret);
+        return ret;
+      }
     }
-    nodes_re_pass.clear();
 
     while (!nodes.empty()) {
-      NodePtr node = nodes.front();
+      uint32_t id = nodes.front();
       nodes.pop();
 
-      (void)nodes_re_pass.erase(node);
-      GE_IF_BOOL_EXEC(node == nullptr, GELOGW("node is null"); continue);
-      if (nodes_deleted.count(node) > 0) {
+      state.RemoveRePass(id);
+      // copy the pointer, the index may grow while the passes add nodes
+      NodePtr node = state.GetNode(id);
+      if (state.IsDeleted(id)) {
         GELOGD("The node %s was deleted before, skip it.", node->GetName().c_str());
         continue;
       }
 
-      AddNextIterNodes(node->GetOutNodes(), nodes, nodes_seen, nodes_last);
+      AddNextIterNodes(node, nodes, state);
 
-      auto ret = RunPasses(node, names_to_passes, nodes_re_pass, nodes_deleted, nodes_seen);
+      auto ret = RunPasses(node, id, names_to_passes, state);
       if (ret != SUCCESS) {
         GELOGE(ret, "Failed to process passes on node %s type %s, error code: %u", node->GetName().c_str(),
                node->GetType().c_str(), ret);
@@ -226,7 +670,9 @@ Status GEPass::RunPassesOneGraph(const NamesToPass &names_to_passes) {
       if (has_sub_graph) {
         GELOGD("There are subgraphs on node %s, run passes for for the second time", node->GetName().c_str());
         SetFlagOption(kOptimizeAfterSubGraph, names_to_passes);
-        ret = RunPasses(node, names_to_passes, nodes_re_pass, nodes_deleted, nodes_seen);
+        // the sub graphs are part of the node, every pass has to see the node again
+        state.MarkChanged(id);
+        ret = RunPasses(node, id, names_to_passes, state);
         if (ret != SUCCESS) {
           GELOGE(ret, "Failed to process passes on node %s type %s, error code: %u", node->GetName().c_str(),
                  node->GetType().c_str(), ret);
@@ -240,22 +686,129 @@ Status GEPass::RunPassesOneGraph(const NamesToPass &names_to_passes) {
       }
     }
 
-    for (auto &node : nodes_last) {
-      bool all_in_nodes_seen = node->IsAllInNodesSeen(nodes_seen);
-      if (all_in_nodes_seen && nodes_seen.insert(node.get()).second) {
-        nodes.push(node);
+    for (auto id : state.TakeLast()) {
+      if (state.IsAllInNodesSeen(id) && state.MarkSeen(id)) {
+        nodes.push(id);
+      }
+    }
+    if (nodes.empty()) {
+      for (auto id : state.TakeStaleBlocked()) {
+        GELOGD("The in edges of node %s changed without a record, pass it now", state.GetNode(id)->GetName().c_str());
+        nodes.push(id);
       }
     }
-    nodes_last.clear();
-  } while ((!nodes_re_pass.empty() || !nodes.empty()) && ++re_pass_times < kMaxRePassTimes);
+  } while ((state.HasRePass() || !nodes.empty()) && ++re_pass_times < kMaxRePassTimes);
 
   if (re_pass_times == kMaxRePassTimes) {
     GELOGW("re_pass_times should not come to %d", kMaxRePassTimes);
   }
-  GELOGD("All passes runs end");
+  for (size_t i = 0; i < names_to_passes.size(); ++i) {
+    GELOGD("Pass %s recorded %zu changes on graph %s", names_to_passes[i].first.c_str(), state.GetChangeNum(i),
+           graph_->GetName().c_str());
+  }
+  GELOGD("All passes runs end, %zu pass runs, %zu skipped on nodes not changed since the pass saw them",
+         state.GetRunNum(), state.GetSkipNum());
+
+  return SUCCESS;
+}
+
+Status GEPass::RunPassesOneWave(const NamesToPass &names_to_passes, std::vector<NodePtr> &wave,
+                                NodeTraversalState &state) {
+  GELOGD("Begin to run passes on wave of %zu nodes", wave.size());
+  std::vector<uint32_t> ids;
+  ids.reserve(wave.size());
+  for (const auto &node : wave) {
+    ids.emplace_back(state.GetId(node));
+  }
+  std::vector<bool> alive(wave.size(), true);
+  std::vector<bool> to_run(wave.size(), false);
+  std::vector<NodeAnalysis> analyses;
+  for (size_t pass_index = 0; pass_index < names_to_passes.size(); ++pass_index) {
+    const auto &name_to_pass = names_to_passes[pass_index];
+    if (name_to_pass.second == nullptr) {
+      GELOGE(INTERNAL_ERROR, "There is null pointer in passes(%s), skip it", name_to_pass.first.c_str());
+      continue;
+    }
+    for (size_t i = 0; i < wave.size(); ++i) {
+      // a node may have been deleted by the commit of a sibling in the wave
+      alive[i] = alive[i] && !state.IsDeleted(ids[i]);
+      to_run[i] = alive[i] && state.NeedRun(ids[i], pass_index);
+      if (to_run[i]) {
+        // the analysis is what the pass sees, changes committed after it are seen in a later visit
+        state.MarkPassSeen(ids[i], pass_index);
+        state.CountRun();
+      } else if (alive[i]) {
+        state.CountSkipped();
+      }
+    }
+    GE_CHK_STATUS_RET_NOLOG(AnalyzeWave(name_to_pass, wave, to_run, analyses));
+
+    // commit in queue order, a node whose neighbours were changed by an earlier commit is run again
+    std::vector<NodePtr> neighbours;
+    for (size_t i = 0; i < wave.size(); ++i) {
+      if (!to_run[i]) {
+        continue;
+      }
+      if (state.IsDeleted(ids[i])) {
+        GELOGD("Node %s was deleted by an earlier commit in the wave, skip it", wave[i]->GetName().c_str());
+        alive[i] = false;
+        continue;
+      }
+      if (!analyses[i].commit) {
+        continue;
+      }
+      auto &node = wave[i];
+      name_to_pass.second->init();
+      GetNeighbours(node, neighbours);
+      Status ret = SUCCESS;
+      if (neighbours != analyses[i].neighbours) {
+        GELOGD("Neighbours of node %s changed after analyzing pass %s, run it again", node->GetName().c_str(),
+               name_to_pass.first.c_str());
+        ret = name_to_pass.second->Run(node);
+      } else {
+        ret = analyses[i].commit();
+      }
+      if (ret != SUCCESS) {
+        GELOGE(INTERNAL_ERROR,
+               "Failed to process pass %s on node %s, result "
+               "%u, the passes will be terminated immediately.",
+               name_to_pass.first.c_str(), node->GetName().c_str(), ret);
+        return ret;
+      }
+      if (HandlePassResult(node, pass_index, name_to_pass, state)) {
+        alive[i] = false;
+      }
+      RecordNeighbourhoodChanges(node, neighbours, state);
+    }
+  }
 
+  for (size_t i = 0; i < wave.size(); ++i) {
+    if (!alive[i] || state.IsDeleted(ids[i])) {
+      continue;
+    }
+    auto &node = wave[i];
+    bool has_sub_graph = false;
+    auto ret = RunPassesOnSubGraph(node, names_to_passes, has_sub_graph);
+    if (ret != SUCCESS) {
+      GELOGE(ret, "Failed to run passes on the sub graph of node %s", node->GetName().c_str());
+      return ret;
+    }
+    if (has_sub_graph) {
+      GELOGD("There are subgraphs on node %s, run passes for for the second time", node->GetName().c_str());
+      SetFlagOption(kOptimizeAfterSubGraph, names_to_passes);
+      state.MarkChanged(ids[i]);
+      ret = RunPasses(node, ids[i], names_to_passes, state);
+      if (ret != SUCCESS) {
+        GELOGE(ret, "Failed to process passes on node %s type %s, error code: %u", node->GetName().c_str(),
+               node->GetType().c_str(), ret);
+        return ret;
+      }
+      ClearOption(names_to_passes);
+    }
+  }
   return SUCCESS;
 }
+
 Status GEPass::RunPassesOnSubGraph(const NodePtr &node, const NamesToPass &names_to_passes, bool &has_sub_graph) {
   auto sub_graph_names = node->GetOpDesc()->GetSubgraphInstanceNames();
   has_sub_graph = false;
@@ -268,7 +821,7 @@ Status GEPass::RunPassesOnSubGraph(const NodePtr &node, const NamesToPass &names
     }
     has_sub_graph = true;
     GELOGI("Begin to run passes on the sub graph %s of node %s", name.c_str(), node->GetName().c_str());
-    GEPass pass(graph, root_graph_, depth_ + 1);
+    GEPass pass(graph, root_graph_, depth_ + 1, parallel_);
     auto ret = pass.Run(names_to_passes);
     if (ret != SUCCESS) {
       GELOGE(ret, "Failed to run passes for sub graph %s from node %s", name.c_str(), node->GetName().c_str());
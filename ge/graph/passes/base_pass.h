@@ -17,6 +17,7 @@
 #ifndef GE_GRAPH_PASSES_BASE_PASS_H_
 #define GE_GRAPH_PASSES_BASE_PASS_H_
 
+#include <functional>
 #include <set>
 #include <string>
 #include <unordered_set>
@@ -39,6 +40,26 @@ enum NodePassOption {
   kOptionEnd
 };
 
+///
+/// Kinds of graph changes recorded by the passes
+///
+enum GraphChangeType {
+  // the node was added or changed, or the pass asked to optimize it again
+  kNodeChanged,
+  kNodeDeleted,
+  // an edge between the node and the peer was added or removed
+  kEdgeChanged,
+  kAttrChanged
+};
+
+struct GraphChange {
+  GraphChangeType type;
+  NodePtr node;
+  NodePtr peer;
+};
+
+using NodeCommit = std::function<Status()>;
+
 class BaseNodePass {
  public:
   ///
@@ -51,10 +72,41 @@ class BaseNodePass {
 
   virtual ~BaseNodePass() = default;
 
+  ///
+  /// A node-local pass only reads the node and its direct neighbours to make decisions, and only changes
+  /// the node itself and the edges around it. Node-local passes may be analyzed concurrently by the
+  /// parallel mode of GEPass.
+  /// @return
+  ///
+  virtual bool IsNodeLocal() const { return false; }
+
+  ///
+  /// Read-only part of `Run` for node-local passes, called concurrently on the nodes of one wave.
+  /// It must not change the graph or the members of the pass. If the node needs to be changed, set `commit`
+  /// to the mutation, the commits are called serially at the end of the wave and may use the protected
+  /// helpers. If the neighbours of the node changed before the commit, `Run` is called instead.
+  /// @param node
+  /// @param commit
+  /// @return
+  ///
+  virtual Status Analyze(const NodePtr &node, NodeCommit &commit) {
+    commit = [this, node]() {
+      NodePtr node_to_run = node;
+      return Run(node_to_run);
+    };
+    return SUCCESS;
+  }
+
   std::unordered_set<NodePtr> GetNodesNeedRePass() { return nodes_need_re_pass_; }
 
   std::unordered_set<NodePtr> GetNodesDeleted() { return nodes_deleted_; }
 
+  ///
+  /// Changes made by the pass since the last `init`, in the order they were recorded
+  /// @return
+  ///
+  const std::vector<GraphChange> &GetChanges() const { return changes_; }
+
   void SetOption(NodePassOption option, const std::string &value) { options_[option] = value; }
 
   void ClearOptions() { options_.clear(); }
@@ -62,6 +114,7 @@ class BaseNodePass {
   void init() {
     nodes_need_re_pass_.clear();
     nodes_deleted_.clear();
+    changes_.clear();
   }
 
  protected:
@@ -77,7 +130,10 @@ class BaseNodePass {
   /// optimized by other passes, call this function.
   /// @param node
   ///
-  void AddRePassNode(NodePtr &node) { nodes_need_re_pass_.insert(node); }
+  void AddRePassNode(NodePtr &node) {
+    nodes_need_re_pass_.insert(node);
+    changes_.push_back({kNodeChanged, node, nullptr});
+  }
 
   ///
   /// Add a node and it's input/output data nodes to be optimized again.
@@ -103,32 +159,62 @@ class BaseNodePass {
   /// next iterations.
   /// @param node
   ///
-  void AddNodeDeleted(const NodePtr &node) { nodes_deleted_.insert(node); }
+  void AddNodeDeleted(const NodePtr &node) {
+    nodes_deleted_.insert(node);
+    changes_.push_back({kNodeDeleted, node, nullptr});
+  }
+
+  ///
+  /// Record that an edge between `node` and `peer` was added or removed, both nodes will be optimized again.
+  /// @param node
+  /// @param peer
+  ///
+  void RecordEdgeChanged(const NodePtr &node, const NodePtr &peer) { changes_.push_back({kEdgeChanged, node, peer}); }
+
+  ///
+  /// Record that the attributes of a node were changed, the node will be optimized again.
+  /// @param node
+  ///
+  void RecordAttrChanged(const NodePtr &node) { changes_.push_back({kAttrChanged, node, nullptr}); }
 
   bool OptionExists(NodePassOption option) { return options_.count(option) > 0; }
 
  private:
   std::unordered_set<NodePtr> nodes_need_re_pass_;
   std::unordered_set<NodePtr> nodes_deleted_;
+  std::vector<GraphChange> changes_;
   std::map<NodePassOption, std::string> options_;
 };
 
 using NamesToPass = std::vector<std::pair<std::string, BaseNodePass *>>;
 
+class NodeTraversalState;
+
 class GEPass {
  public:
-  explicit GEPass(ComputeGraphPtr &graph) : graph_(graph), root_graph_(graph), depth_(1) {}
+  explicit GEPass(ComputeGraphPtr &graph) : graph_(graph), root_graph_(graph), depth_(1), parallel_(false) {}
   virtual ~GEPass() = default;
   Status Run(const NamesToPass &names_to_passes);
 
+  ///
+  /// In parallel mode the graph is processed by topological waves, every pass analyzes all nodes of the wave
+  /// concurrently and commits the changes serially before the next pass starts. It only applies when all passes
+  /// are node-local, otherwise the passes run node by node as in the serial mode.
+  /// @param parallel
+  ///
+  void SetParallel(bool parallel) { parallel_ = parallel; }
+
  private:
-  GEPass(ComputeGraphPtr &graph, ComputeGraphPtr &root_graph, int depth)
-      : graph_(graph), root_graph_(root_graph), depth_(depth) {}
+  GEPass(ComputeGraphPtr &graph, ComputeGraphPtr &root_graph, int depth, bool parallel)
+      : graph_(graph), root_graph_(root_graph), depth_(depth), parallel_(parallel) {}
   Status RunPassesOneGraph(const NamesToPass &names_to_passes);
+  Status RunPassesOneWave(const NamesToPass &names_to_passes, std::vector<NodePtr> &wave,
+                          NodeTraversalState &state);
   Status RunPassesOnSubGraph(const NodePtr &node, const NamesToPass &names_to_passes, bool &has_sub_graph);
   ComputeGraphPtr graph_;
   ComputeGraphPtr root_graph_;
   int depth_;
+  bool parallel_;
 };
 }  // namespace ge
 
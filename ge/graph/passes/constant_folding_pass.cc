@@ -41,7 +41,20 @@ const std::unordered_map<std::string, std::pair<std::uint64_t, uint64_t>>
   return statistic_of_op_constant_folding_;
 }
 
-Status ConstantFoldingPass::Run(ge::NodePtr &node) {
+void ConstantFoldingPass::UpdateStatistic(
+  std::unordered_map<std::string, std::pair<std::uint64_t, uint64_t>> &statistic, const std::string &type,
+  uint64_t cost_time) {
+  auto iter = statistic.find(type);
+  if (iter != statistic.end()) {
+    iter->second.first++;
+    iter->second.second += cost_time;
+  } else {
+    statistic[type] = std::pair<uint64_t, uint64_t>(kStartCallNum, cost_time);
+  }
+}
+
+Status ConstantFoldingPass::ComputeOutputs(NodePtr &node, vector<GeTensorPtr> &outputs, bool &need_folding) {
+  need_folding = false;
   GE_CHECK_NOTNULL(node);
   GELOGD("Begin to run constant folding on node %s", node->GetName().c_str());
 
@@ -61,7 +74,6 @@ Status ConstantFoldingPass::Run(ge::NodePtr &node) {
   }
 
   auto inputs = OpDescUtils::GetInputData(input_nodes);
-  vector<GeTensorPtr> outputs;
   // Statistic of ge constant folding kernel
   uint64_t start_time = GetCurrentTimestap();
   auto ret = RunOpKernel(node, inputs, outputs);
@@ -76,15 +88,7 @@ Status ConstantFoldingPass::Run(ge::NodePtr &node) {
     // Statistic of op and fe constant folding kernel
     start_time = GetCurrentTimestap();
     ret = op_kernel->Compute(node_desc, inputs, outputs);
-    uint64_t cost_time = GetCurrentTimestap() - start_time;
-    if (statistic_of_ge_constant_folding_.find(node->GetType()) != statistic_of_ge_constant_folding_.end()) {
-      uint64_t &cnt = statistic_of_ge_constant_folding_[node->GetType()].first;
-      uint64_t &cur_cost_time = statistic_of_ge_constant_folding_[node->GetType()].second;
-      cnt++;
-      cur_cost_time += cost_time;
-    } else {
-      statistic_of_ge_constant_folding_[node->GetType()] = std::pair<uint64_t, uint64_t>(kStartCallNum, cost_time);
-    }
+    UpdateStatistic(statistic_of_ge_constant_folding_, node->GetType(), GetCurrentTimestap() - start_time);
     if (ret != SUCCESS) {
       if (ret == NOT_CHANGED) {
         GELOGD("Node %s type %s, compute terminates and exits the constant folding.", node->GetName().c_str(),
@@ -96,15 +100,7 @@ Status ConstantFoldingPass::Run(ge::NodePtr &node) {
     }
     GELOGI("Node %s type %s, constant folding compute success.", node->GetName().c_str(), node->GetType().c_str());
   } else {
-    if (statistic_of_op_constant_folding_.find(node->GetType()) != statistic_of_op_constant_folding_.end()) {
-      uint64_t &cnt = statistic_of_op_constant_folding_[node->GetType()].first;
-      uint64_t &cost_time = statistic_of_op_constant_folding_[node->GetType()].second;
-      cnt++;
-      cost_time += GetCurrentTimestap() - start_time;
-    } else {
-      statistic_of_op_constant_folding_[node->GetType()] =
-        std::pair<uint64_t, uint64_t>(kStartCallNum, GetCurrentTimestap() - start_time);
-    }
+    UpdateStatistic(statistic_of_op_constant_folding_, node->GetType(), GetCurrentTimestap() - start_time);
   }
 
   if (outputs.empty()) {
@@ -114,7 +110,17 @@ Status ConstantFoldingPass::Run(ge::NodePtr &node) {
            node->GetName().c_str());
     return INTERNAL_ERROR;
   }
+  need_folding = true;
+  return SUCCESS;
+}
 
+Status ConstantFoldingPass::Run(ge::NodePtr &node) {
+  vector<GeTensorPtr> outputs;
+  bool need_folding = false;
+  GE_CHK_STATUS_RET_NOLOG(ComputeOutputs(node, outputs, need_folding));
+  if (!need_folding) {
+    return SUCCESS;
+  }
   return Folding(node, outputs);
 }
 }  // namespace ge
@@ -30,6 +30,10 @@ class ConstantFoldingPass : public FoldingPass {
   const std::unordered_map<std::string, std::pair<std::uint64_t, uint64_t>> &GetOpConstantFoldingPerfStatistic() const;
 
  private:
+  Status ComputeOutputs(NodePtr &node, vector<GeTensorPtr> &outputs, bool &need_folding);
+  void UpdateStatistic(std::unordered_map<std::string, std::pair<std::uint64_t, uint64_t>> &statistic,
+                       const std::string &type, uint64_t cost_time);
+
   std::unordered_map<std::string, std::pair<std::uint64_t, uint64_t>> statistic_of_op_constant_folding_;
   std::unordered_map<std::string, std::pair<std::uint64_t, uint64_t>> statistic_of_ge_constant_folding_;
 };
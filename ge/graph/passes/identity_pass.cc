@@ -91,7 +91,8 @@ Status CheckIdentityUsable(const NodePtr &node, bool &usable) {
 }
 }  // namespace
 
-Status IdentityPass::Run(NodePtr &node) {
+Status IdentityPass::GetIoMap(const NodePtr &node, std::vector<int> &io_map, bool &need_delete) const {
+  need_delete = false;
   GE_CHECK_NOTNULL(node);
   auto op_desc = node->GetOpDesc();
   GE_CHECK_NOTNULL(op_desc);
@@ -121,10 +122,33 @@ Status IdentityPass::Run(NodePtr &node) {
            node->GetOpDesc()->GetInputsSize(), n);
     return PARAM_INVALID;
   }
-  std::vector<int> io_map;
   for (size_t i = 0; i < n; i++) {
     io_map.push_back(i);
   }
+  need_delete = true;
+  return SUCCESS;
+}
+
+Status IdentityPass::Run(NodePtr &node) {
+  std::vector<int> io_map;
+  bool need_delete = false;
+  GE_CHK_STATUS_RET_NOLOG(GetIoMap(node, io_map, need_delete));
+  if (!need_delete) {
+    return SUCCESS;
+  }
   return IsolateAndDeleteNode(node, io_map);
 }
+
+Status IdentityPass::Analyze(const NodePtr &node, NodeCommit &commit) {
+  std::vector<int> io_map;
+  bool need_delete = false;
+  GE_CHK_STATUS_RET_NOLOG(GetIoMap(node, io_map, need_delete));
+  if (need_delete) {
+    commit = [this, node, io_map]() {
+      NodePtr node_to_delete = node;
+      return IsolateAndDeleteNode(node_to_delete, io_map);
+    };
+  }
+  return SUCCESS;
+}
 }  // namespace ge
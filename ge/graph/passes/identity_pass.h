@@ -17,6 +17,8 @@
 #ifndef GE_GRAPH_PASSES_IDENTITY_PASS_H_
 #define GE_GRAPH_PASSES_IDENTITY_PASS_H_
 
+#include <vector>
+
 #include "graph/passes/base_pass.h"
 
 namespace ge {
@@ -25,7 +27,11 @@ class IdentityPass : public BaseNodePass {
   explicit IdentityPass(bool force) : force_(force) {}
   ~IdentityPass() override = default;
   Status Run(NodePtr &node) override;
+  bool IsNodeLocal() const override { return true; }
+  Status Analyze(const NodePtr &node, NodeCommit &commit) override;
+
  private:
+  Status GetIoMap(const NodePtr &node, std::vector<int> &io_map, bool &need_delete) const;
   bool force_ = false;
 };
 }  // namespace ge
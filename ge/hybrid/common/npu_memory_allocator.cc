@@ -63,20 +63,16 @@ void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr) {
     buffer = malloc(allocate_size);
   } else {
     void *try_reuse_addr = nullptr;
-    int padding = kDefaultPadding;
+    rtStream_t stream = nullptr;
     if (attr != nullptr) {
       try_reuse_addr = attr->try_reuse_addr_;
-      if (attr->padding_ > 0) {
-        padding = attr->padding_;
-      }
-
-      // padding up to multiple of padding, and add extra padding
-      allocate_size = (size + 2 * padding - 1) / padding * padding;
-      GELOGD("Padding size %ld by %d. final size = %zu.", size, padding, allocate_size);
+      stream = attr->stream_;
+      allocate_size = GetAllocateSize(size, attr);
+      GELOGD("Padding size %ld. final size = %zu.", size, allocate_size);
     }
     buffer = MemManager::Instance()
                .CachingInstance(RT_MEMORY_HBM)
-               .Malloc(allocate_size, reinterpret_cast<uint8_t *>(try_reuse_addr), device_id_);
+               .Malloc(allocate_size, reinterpret_cast<uint8_t *>(try_reuse_addr), device_id_, stream);
   }
   if (buffer == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Failed to malloc memory, device_id = %u, size = %zu", device_id_, allocate_size);
@@ -87,6 +83,15 @@ void *NpuMemoryAllocator::Allocate(std::size_t size, AllocationAttr *attr) {
   return buffer;
 }
 
+size_t NpuMemoryAllocator::GetAllocateSize(std::size_t size, const AllocationAttr *attr) {
+  if (attr == nullptr) {
+    return size;
+  }
+  int padding = attr->padding_ > 0 ? attr->padding_ : kDefaultPadding;
+  // padding up to multiple of padding, and add extra padding
+  return (size + 2 * padding - 1) / padding * padding;
+}
+
 void NpuMemoryAllocator::Deallocate(void *data, MemStorageType mem_type) {
   GELOGI("To deallocating buffer, addr = %p", data);
   if (data != nullptr) {
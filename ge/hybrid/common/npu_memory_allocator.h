@@ -36,12 +36,16 @@ class AllocationAttr {
   ~AllocationAttr() = default;
   void SetMemType(MemStorageType memType) { mem_type_ = memType; }
   MemStorageType GetMemType() { return mem_type_; }
+  // small HBM buffers freed are only reused on the stream they were allocated for
+  void SetStream(rtStream_t stream) { stream_ = stream; }
 
  private:
   friend class NpuMemoryAllocator;
+  friend class TensorArena;
   int padding_ = 0;
   void *try_reuse_addr_ = nullptr;
   MemStorageType mem_type_ = HBM;
+  rtStream_t stream_ = nullptr;
 };
 
 class NpuMemoryAllocator {
@@ -58,6 +62,9 @@ class NpuMemoryAllocator {
   void *Allocate(std::size_t size, AllocationAttr *attr = nullptr);
   void Deallocate(void *data, MemStorageType mem_type = HBM);
 
+  // size actually allocated for a HBM buffer of `size`, padded as requested by attr
+  static size_t GetAllocateSize(std::size_t size, const AllocationAttr *attr);
+
   static constexpr int kDefaultPadding = 32;
 
  private:
@@ -0,0 +1,217 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hybrid/common/tensor_arena.h"
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "common/ge/ge_util.h"
+#include "framework/common/debug/ge_log.h"
+#include "hybrid/common/npu_memory_allocator.h"
+
+namespace ge {
+namespace hybrid {
+namespace {
+const size_t kPoolBucketSize = 16;
+const size_t kPoolBucketNum = 16;
+const size_t kMaxPooledObjectNum = 1024;
+
+const size_t kArenaAlignment = 512;
+// larger buffers are rare and well served by the caching allocator
+const size_t kMaxArenaBufferSize = 1024 * 1024;
+const size_t kMaxArenaSize = 64 * 1024 * 1024;
+const size_t kSlabGranularity = 1024 * 1024;
+
+struct FreeLists {
+  ~FreeLists();
+  std::vector<void *> lists[kPoolBucketNum];
+};
+
+// objects may be released by other thread local destructors after the free lists are gone
+thread_local bool free_lists_destroyed = false;
+thread_local FreeLists free_lists;
+
+FreeLists::~FreeLists() {
+  free_lists_destroyed = true;
+  for (auto &list : lists) {
+    for (auto ptr : list) {
+      ::operator delete(ptr);
+    }
+    list.clear();
+  }
+}
+
+size_t GetBucketIndex(size_t size) { return (size + kPoolBucketSize - 1) / kPoolBucketSize - 1; }
+
+size_t AlignUp(size_t size, size_t alignment) { return (size + alignment - 1) / alignment * alignment; }
+}  // namespace
+
+void *SmallObjectPool::Allocate(size_t size) {
+  size_t index = GetBucketIndex(size);
+  if (size == 0 || index >= kPoolBucketNum || free_lists_destroyed) {
+    return ::operator new(size, std::nothrow);
+  }
+
+  auto &list = free_lists.lists[index];
+  if (list.empty()) {
+    return ::operator new((index + 1) * kPoolBucketSize, std::nothrow);
+  }
+  void *ptr = list.back();
+  list.pop_back();
+  return ptr;
+}
+
+void SmallObjectPool::Deallocate(void *ptr, size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+  size_t index = GetBucketIndex(size);
+  if (size == 0 || index >= kPoolBucketNum || free_lists_destroyed) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  auto &list = free_lists.lists[index];
+  if (list.size() >= kMaxPooledObjectNum) {
+    ::operator delete(ptr);
+    return;
+  }
+  list.emplace_back(ptr);
+}
+
+///
+/// Device memory of the arena, alive as long as the arena or a buffer in it holds it
+///
+class TensorArena::Slab {
+ public:
+  Slab(NpuMemoryAllocator *allocator, void *base, size_t size) : allocator_(allocator), base_(base), size_(size) {}
+
+  ~Slab() { allocator_->Deallocate(base_); }
+
+  void *Allocate(size_t block_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = free_blocks_.find(block_size);
+    if ((it != free_blocks_.end()) && !it->second.empty()) {
+      void *ptr = it->second.back();
+      it->second.pop_back();
+      return ptr;
+    }
+    if (offset_ + block_size > size_) {
+      return nullptr;
+    }
+    void *ptr = static_cast<uint8_t *>(base_) + offset_;
+    offset_ += block_size;
+    return ptr;
+  }
+
+  void Free(void *ptr, size_t block_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_blocks_[block_size].emplace_back(ptr);
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    offset_ = 0;
+    free_blocks_.clear();
+  }
+
+  size_t GetSize() const { return size_; }
+
+ private:
+  NpuMemoryAllocator *allocator_;
+  void *base_;
+  size_t size_;
+  std::mutex mutex_;
+  size_t offset_ = 0;
+  // released blocks by size
+  std::unordered_map<size_t, std::vector<void *>> free_blocks_;
+};
+
+TensorArena::TensorArena(NpuMemoryAllocator *allocator) : allocator_(allocator), live_size_(0), peak_size_(0) {}
+
+void *TensorArena::Allocate(size_t size, AllocationAttr *attr, Block &block) {
+  block.slab.reset();
+  block.size = 0;
+  if (size == 0 || size > kMaxArenaBufferSize) {
+    return nullptr;
+  }
+  if (attr != nullptr && (attr->GetMemType() != HBM || attr->try_reuse_addr_ != nullptr)) {
+    return nullptr;
+  }
+
+  block.size = AlignUp(NpuMemoryAllocator::GetAllocateSize(size, attr), kArenaAlignment);
+  size_t live_size = live_size_.fetch_add(block.size) + block.size;
+  size_t peak_size = peak_size_.load();
+  while ((live_size > peak_size) && !peak_size_.compare_exchange_weak(peak_size, live_size)) {
+  }
+
+  if (slab_ == nullptr) {
+    return nullptr;
+  }
+  void *ptr = slab_->Allocate(block.size);
+  if (ptr != nullptr) {
+    block.slab = slab_;
+  }
+  return ptr;
+}
+
+void TensorArena::Release(void *ptr, const Block &block) {
+  live_size_.fetch_sub(block.size);
+  if (block.slab != nullptr) {
+    block.slab->Free(ptr, block.size);
+  }
+}
+
+size_t TensorArena::GetSlabSize() const { return (slab_ == nullptr) ? 0 : slab_->GetSize(); }
+
+Status TensorArena::Reset() {
+  // buffers still alive are carried over to the next step
+  size_t peak_size = peak_size_.exchange(live_size_.load());
+  if ((slab_ != nullptr) && (slab_.use_count() > 1)) {
+    // graph outputs are allocated separately, so this happens only when a tensor outlives its step by accident
+    GELOGD("Tensors of the last step are still in use, they keep the slab of size %zu", slab_->GetSize());
+    slab_.reset();
+  }
+
+  size_t target_size = AlignUp(std::min(peak_size, kMaxArenaSize), kSlabGranularity);
+  if (slab_ != nullptr) {
+    if (target_size <= slab_->GetSize() && target_size >= slab_->GetSize() / 2) {
+      slab_->Clear();
+      return SUCCESS;
+    }
+    slab_.reset();
+  }
+  if (target_size == 0) {
+    return SUCCESS;
+  }
+
+  void *base = allocator_->Allocate(target_size);
+  if (base == nullptr) {
+    GELOGW("Failed to allocate arena of size %zu, tensors of this step are allocated separately.", target_size);
+    return SUCCESS;
+  }
+  slab_ = MakeShared<Slab>(allocator_, base, target_size);
+  if (slab_ == nullptr) {
+    allocator_->Deallocate(base);
+    GELOGW("Failed to create arena of size %zu, tensors of this step are allocated separately.", target_size);
+    return SUCCESS;
+  }
+  GELOGD("Arena resized to %zu, peak size of the last step = %zu", target_size, peak_size);
+  return SUCCESS;
+}
+}  // namespace hybrid
+}  // namespace ge
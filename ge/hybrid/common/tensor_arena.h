@@ -0,0 +1,136 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_HYBRID_COMMON_TENSOR_ARENA_H_
+#define GE_HYBRID_COMMON_TENSOR_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include "external/ge/ge_api_error_codes.h"
+
+namespace ge {
+namespace hybrid {
+class NpuMemoryAllocator;
+class AllocationAttr;
+
+///
+/// Thread local free lists of small heap objects, used for the tensor buffers and their shared_ptr control blocks
+/// which are created and released for every output of every node in every step.
+///
+class SmallObjectPool {
+ public:
+  static void *Allocate(size_t size);
+  static void Deallocate(void *ptr, size_t size);
+};
+
+///
+/// Allocator of shared_ptr control blocks backed by SmallObjectPool
+///
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  PoolAllocator() = default;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    void *ptr = SmallObjectPool::Allocate(n * sizeof(T));
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *ptr, size_t n) { SmallObjectPool::Deallocate(ptr, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &) {
+  return false;
+}
+
+///
+/// Step scoped allocator of small device buffers.
+/// Buffers are bump allocated from a slab, a released buffer is reused by later requests of the same size in the
+/// same step. The slab is sized from the peak of live bytes of the previous step and recycled at once by Reset when
+/// the next step starts. Requests that do not fit fall back to the NpuMemoryAllocator.
+///
+class TensorArena {
+ public:
+  class Slab;
+
+  // where a buffer of the arena lives, slab is nullptr if the buffer fell back to the NpuMemoryAllocator
+  struct Block {
+    std::shared_ptr<Slab> slab;
+    size_t size = 0;
+  };
+
+  explicit TensorArena(NpuMemoryAllocator *allocator);
+  ~TensorArena() = default;
+
+  TensorArena(const TensorArena &) = delete;
+  TensorArena &operator=(const TensorArena &) = delete;
+
+  ///
+  /// @ingroup ge
+  /// @brief bump allocate a buffer from the slab
+  /// @param [in] size: size of the buffer
+  /// @param [in] attr: allocation attributes
+  /// @param [out] block: size is 0 if the request is not for the arena (too large, not HBM or with an address to
+  ///                     reuse), otherwise it is counted as live until Release
+  /// @return nullptr if the request can not be served by the arena
+  ///
+  void *Allocate(size_t size, AllocationAttr *attr, Block &block);
+
+  ///
+  /// @ingroup ge
+  /// @brief release a block counted by Allocate, the buffer is given back to its slab if it was served by one
+  /// @param [in] ptr: address of the buffer
+  /// @param [in] block: the block
+  ///
+  void Release(void *ptr, const Block &block);
+
+  ///
+  /// @ingroup ge
+  /// @brief release all buffers of the last step and resize the slab to its peak of live bytes.
+  /// If buffers of the last step are still alive, they keep the old slab and a new one is made for the next step.
+  /// @return Status
+  ///
+  Status Reset();
+
+  size_t GetSlabSize() const;
+
+  size_t GetPeakSize() const { return peak_size_.load(); }
+
+ private:
+  NpuMemoryAllocator *allocator_;
+  std::shared_ptr<Slab> slab_;
+  std::atomic<size_t> live_size_;
+  std::atomic<size_t> peak_size_;
+};
+}  // namespace hybrid
+}  // namespace ge
+#endif  // GE_HYBRID_COMMON_TENSOR_ARENA_H_
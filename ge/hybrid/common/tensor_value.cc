@@ -18,6 +18,7 @@
 #include <sstream>
 #include "framework/common/debug/ge_log.h"
 #include "hybrid/common/npu_memory_allocator.h"
+#include "hybrid/common/tensor_arena.h"
 
 namespace ge {
 namespace hybrid {
@@ -55,10 +56,60 @@ std::unique_ptr<TensorBuffer> TensorBuffer::Create(void *buffer, size_t size) {
   return std::unique_ptr<TensorBuffer>(new (std::nothrow) TensorBuffer(nullptr, buffer, size));
 }
 
+std::shared_ptr<TensorBuffer> TensorBuffer::CreateShared(const std::shared_ptr<TensorArena> &arena,
+                                                         NpuMemoryAllocator *allocator, size_t size,
+                                                         AllocationAttr *attr) {
+  std::unique_ptr<TensorBuffer> tensor_buffer;
+  TensorArena::Block block;
+  void *buffer = (arena == nullptr) ? nullptr : arena->Allocate(size, attr, block);
+  if (buffer != nullptr) {
+    GELOGD("Tensor created in arena. addr = %p, size = %zu", buffer, size);
+    tensor_buffer.reset(new (std::nothrow) TensorBuffer(nullptr, buffer, size));
+  } else {
+    tensor_buffer = Create(allocator, size, attr);
+  }
+  if (tensor_buffer == nullptr) {
+    if (block.size > 0) {
+      arena->Release(buffer, block);
+    }
+    return nullptr;
+  }
+  if (block.size > 0) {
+    // counted by the arena even if it is allocated separately, so that the arena learns the demand of the step
+    tensor_buffer->arena_ = arena;
+    tensor_buffer->arena_block_ = std::move(block);
+  }
+
+  try {
+    return std::shared_ptr<TensorBuffer>(tensor_buffer.release(), std::default_delete<TensorBuffer>(),
+                                         PoolAllocator<TensorBuffer>());
+  } catch (const std::bad_alloc &) {
+    GELOGE(MEMALLOC_FAILED, "Failed to create shared tensor buffer.");
+    return nullptr;
+  }
+}
+
+void *TensorBuffer::operator new(size_t size) {
+  void *ptr = SmallObjectPool::Allocate(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *TensorBuffer::operator new(size_t size, const std::nothrow_t &) noexcept {
+  return SmallObjectPool::Allocate(size);
+}
+
+void TensorBuffer::operator delete(void *ptr, size_t size) noexcept { SmallObjectPool::Deallocate(ptr, size); }
+
 TensorBuffer::~TensorBuffer() {
   if (allocator_ != nullptr && buffer_ != nullptr) {
     allocator_->Deallocate(buffer_, mem_type_);
   }
+  if (arena_ != nullptr) {
+    arena_->Release(buffer_, arena_block_);
+  }
 }
 
 TensorValue::TensorValue(std::shared_ptr<TensorBuffer> buffer) : buffer_(std::move(buffer)) {}
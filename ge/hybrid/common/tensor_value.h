@@ -20,6 +20,7 @@
 #include <atomic>
 #include <cstddef>
 #include <memory>
+#include "hybrid/common/tensor_arena.h"
 #include "memory/memory_api.h"
 
 namespace ge {
@@ -34,6 +35,18 @@ class TensorBuffer {
 
   static std::unique_ptr<TensorBuffer> Create(void *buffer, size_t size);
 
+  ///
+  /// Create a buffer for one step of execution. Small buffers are taken from the arena if it is given,
+  /// the buffer object and its control block come from SmallObjectPool.
+  ///
+  static std::shared_ptr<TensorBuffer> CreateShared(const std::shared_ptr<TensorArena> &arena,
+                                                    NpuMemoryAllocator *allocator, size_t size,
+                                                    AllocationAttr *attr = nullptr);
+
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept;
+  static void operator delete(void *ptr, size_t size) noexcept;
+
   TensorBuffer(const TensorBuffer &) = delete;
   TensorBuffer &operator=(const TensorBuffer &) = delete;
   ~TensorBuffer();
@@ -46,6 +59,8 @@ class TensorBuffer {
   TensorBuffer(NpuMemoryAllocator *allocator, void *buffer, size_t size, MemStorageType mem_type = HBM);
 
   NpuMemoryAllocator *allocator_ = nullptr;
+  std::shared_ptr<TensorArena> arena_;
+  TensorArena::Block arena_block_;
   void *buffer_ = nullptr;
   size_t size_ = 0;
   MemStorageType mem_type_;
@@ -23,6 +23,7 @@
 #include "common/properties_manager.h"
 #include "framework/common/debug/ge_log.h"
 #include "hybrid/common/npu_memory_allocator.h"
+#include "hybrid/common/tensor_arena.h"
 #include "hybrid/common/tensor_value.h"
 #include "hybrid/executor/hybrid_profiler.h"
 #include "hybrid/executor/node_done_manager.h"
@@ -43,6 +44,8 @@ struct GraphExecutionContext {
   rtContext_t rt_gen_context = nullptr;
   std::unique_ptr<CallbackManager> callback_manager;
   NpuMemoryAllocator *allocator = nullptr;
+  // small tensors of one step, recycled when the next step starts
+  std::shared_ptr<TensorArena> arena;
   mutable std::unique_ptr<HybridProfiler> profiler;
   DumpProperties dump_properties;
   bool trace_enabled = false;
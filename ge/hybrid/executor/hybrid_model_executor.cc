@@ -55,6 +55,10 @@ Status HybridModelExecutor::Execute(HybridModelExecutor::ExecuteArgs &args) {
   if (context_.profiler != nullptr) {
     context_.profiler->Dump(std::cout);
     context_.profiler->Reset();
+    uint64_t hit_num = 0;
+    uint64_t miss_num = 0;
+    model_->GetInferShapeCacheStats(hit_num, miss_num);
+    GEEVENT("[%s] Infer shape cache: hit = %lu, miss = %lu", model_->GetModelName().c_str(), hit_num, miss_num);
   }
 
   context_.iteration += 1;
@@ -96,6 +100,8 @@ Status HybridModelExecutor::InitExecutionContext() {
   GELOGD("session id from model = %lu, from context = %lu", model_->GetSessionId(), context_.session_id);
   context_.allocator = NpuMemoryAllocator::GetAllocator(device_id_);
   GE_CHECK_NOTNULL(context_.allocator);
+  context_.arena = MakeShared<TensorArena>(context_.allocator);
+  GE_CHECK_NOTNULL(context_.arena);
   context_.callback_manager = std::unique_ptr<CallbackManager>(new (std::nothrow) CallbackManager(stream_));
   GE_CHECK_NOTNULL(context_.callback_manager);
   context_.dump_properties = PropertiesManager::Instance().GetDumpProperties(context_.session_id);
@@ -117,6 +123,10 @@ Status HybridModelExecutor::InitExecutionContext() {
 
 Status HybridModelExecutor::ResetExecutionContext(GraphExecutionContext &context) {
   GE_CHK_STATUS_RET_NOLOG(context.callback_manager->Init());
+  // outputs of the last step are copied out after Execute returns, so the arena is recycled here instead of Cleanup
+  if (context.arena != nullptr) {
+    GE_CHK_STATUS_RET(context.arena->Reset(), "Failed to reset tensor arena");
+  }
   string ctx_id = std::to_string(context.session_id);
   RuntimeInferenceContext::DestroyContext(ctx_id);
   GE_CHK_GRAPH_STATUS_RET(RuntimeInferenceContext::CreateContext(ctx_id), "Failed to Destroy RuntimeInferenceContext");
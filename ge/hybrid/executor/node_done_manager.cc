@@ -22,63 +22,96 @@ namespace ge {
 namespace hybrid {
 namespace {
 constexpr int kDefaultWaitTimeoutInSec = 60 * 10;
-}
+constexpr int kStatePending = 0;
+constexpr int kStateReleased = 1;
+constexpr int kStateCancelled = 2;
+}  // namespace
 bool NodeDoneManager::Cond::Await() {
-  std::unique_lock<std::mutex> lk(cond_mu_);
-  if (!cv_.wait_for(lk, std::chrono::seconds(kDefaultWaitTimeoutInSec),
-                    [&]() { return is_released_ || is_cancelled_; })) {
-    GELOGE(INTERNAL_ERROR, "Wait timed out.");
-    return false;
+  if (state_.load() == kStatePending) {
+    // the waiter count is published before checking the state, so that SetState never misses a waiter
+    waiter_num_.fetch_add(1);
+    std::unique_lock<std::mutex> lk(cond_mu_);
+    bool done = cv_.wait_for(lk, std::chrono::seconds(kDefaultWaitTimeoutInSec),
+                             [&]() { return state_.load() != kStatePending; });
+    waiter_num_.fetch_sub(1);
+    if (!done) {
+      GELOGE(INTERNAL_ERROR, "Wait timed out.");
+      return false;
+    }
   }
 
-  return is_released_;
+  return state_.load() == kStateReleased;
 }
 
-void NodeDoneManager::Cond::Release() {
-  std::unique_lock<std::mutex> lk(cond_mu_);
-  is_released_ = true;
-  cv_.notify_all();
+void NodeDoneManager::Cond::SetState(int state) {
+  int expected = kStatePending;
+  if (!state_.compare_exchange_strong(expected, state)) {
+    return;
+  }
+  // only wake up the nodes waiting on this one
+  if (waiter_num_.load() > 0) {
+    std::lock_guard<std::mutex> lk(cond_mu_);
+    cv_.notify_all();
+  }
 }
 
-void NodeDoneManager::Cond::Cancel() {
-  std::unique_lock<std::mutex> lk(cond_mu_);
-  is_cancelled_ = true;
-  cv_.notify_all();
-}
+void NodeDoneManager::Cond::Release() { SetState(kStateReleased); }
 
-bool NodeDoneManager::Cond::IsRelease() {
-  std::unique_lock<std::mutex> lk(cond_mu_);
-  return is_released_;
+void NodeDoneManager::Cond::Cancel() { SetState(kStateCancelled); }
+
+bool NodeDoneManager::Cond::IsRelease() const { return state_.load() == kStateReleased; }
+
+void NodeDoneManager::Init(const std::vector<NodePtr> &nodes) {
+  for (auto &node : nodes) {
+    auto &subject = subjects_[node.get()];
+    if (subject == nullptr) {
+      subject.reset(new (std::nothrow) Cond());
+    }
+  }
 }
 
 NodeDoneManager::Cond *NodeDoneManager::GetSubject(const NodePtr &node) {
-  std::lock_guard<std::mutex> lk(mu_);
-  if (destroyed_) {
+  if (destroyed_.load()) {
     GELOGD("Already destroyed.");
     return nullptr;
   }
 
-  auto it = subjects_.find(node);
-  if (it == subjects_.end()) {
-    return &subjects_[node];
+  auto it = subjects_.find(node.get());
+  if (it != subjects_.end() && it->second != nullptr) {
+    return it->second.get();
   }
 
-  return &it->second;
+  std::lock_guard<std::mutex> lk(mu_);
+  if (destroyed_.load()) {
+    GELOGD("Already destroyed.");
+    return nullptr;
+  }
+  auto &subject = extra_subjects_[node.get()];
+  if (subject == nullptr) {
+    subject.reset(new (std::nothrow) Cond());
+  }
+  return subject.get();
 }
 
 void NodeDoneManager::Destroy() {
   GELOGD("Start to reset NodeDoneManager.");
-  std::lock_guard<std::mutex> lk(mu_);
-  GELOGD("Cond size = %zu.", subjects_.size());
+  destroyed_.store(true);
+  // waiters may still hold the conditions, they are freed with the manager
   for (auto &sub : subjects_) {
-    if (!sub.second.IsRelease()) {
-      sub.second.Cancel();
+    if (sub.second != nullptr && !sub.second->IsRelease()) {
+      sub.second->Cancel();
       GELOGD("[%s] Node canceled.", sub.first->GetName().c_str());
     }
   }
 
-  subjects_.clear();
-  destroyed_ = true;
+  std::lock_guard<std::mutex> lk(mu_);
+  GELOGD("Cond size = %zu.", subjects_.size() + extra_subjects_.size());
+  for (auto &sub : extra_subjects_) {
+    if (sub.second != nullptr && !sub.second->IsRelease()) {
+      sub.second->Cancel();
+      GELOGD("[%s] Node canceled.", sub.first->GetName().c_str());
+    }
+  }
   GELOGD("Done resetting NodeDoneManager successfully.");
 }
 
@@ -17,16 +17,25 @@
 #ifndef GE_HYBRID_EXECUTOR_NODE_DONE_COND_MANAGER_H_
 #define GE_HYBRID_EXECUTOR_NODE_DONE_COND_MANAGER_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 #include "graph/node.h"
 
 namespace ge {
 namespace hybrid {
 class NodeDoneManager {
  public:
+  ///
+  /// @ingroup ge
+  /// @brief register the nodes that can be awaited, looking them up afterwards takes no lock
+  /// @param [in] nodes: nodes to register
+  ///
+  void Init(const std::vector<NodePtr> &nodes);
+
   void NodeDone(const NodePtr &node);
 
   bool Await(const NodePtr &node);
@@ -36,22 +45,27 @@ class NodeDoneManager {
  private:
   class Cond {
    public:
-    bool IsRelease();
+    bool IsRelease() const;
     void Release();
     void Cancel();
     bool Await();
 
    private:
+    void SetState(int state);
+
+    std::atomic<int> state_{0};
+    std::atomic<int> waiter_num_{0};
     std::mutex cond_mu_;
     std::condition_variable cv_;
-    bool is_released_ = false;
-    bool is_cancelled_ = false;
   };
 
   Cond *GetSubject(const NodePtr &node);
+  // registered by Init, read only afterwards
+  std::unordered_map<const Node *, std::unique_ptr<Cond>> subjects_;
+  // nodes not registered by Init, guarded by mu_
   std::mutex mu_;
-  std::unordered_map<NodePtr, Cond> subjects_;
-  bool destroyed_ = false;
+  std::unordered_map<const Node *, std::unique_ptr<Cond>> extra_subjects_;
+  std::atomic<bool> destroyed_{false};
 };
 }  // namespace hybrid
 }  // namespace ge
@@ -29,9 +29,9 @@ constexpr auto kWaitInternal = 5;
 constexpr auto kMaxWaitTimes = 120;
 }  // namespace
 ShapeInferenceState::ShapeInferenceState(const NodeItem &node_item) : node_item(node_item) {
-  this->num_pending_shapes_ = node_item.num_inputs - node_item.num_static_input_shapes;
+  this->num_pending_shapes_.store(node_item.num_inputs - node_item.num_static_input_shapes);
   GELOGD("[%s] ShapeInferenceState created, pending shape count = %d", node_item.NodeName().c_str(),
-         this->num_pending_shapes_);
+         this->num_pending_shapes_.load());
 }
 
 void ShapeInferenceState::UpdateInputShape(uint32_t idx, const GeShape &ori_shape, const GeShape &shape) {
@@ -48,7 +48,19 @@ void ShapeInferenceState::UpdateInputShape(uint32_t idx, const GeShape &ori_shap
   std::lock_guard<std::mutex> lk(mu_);
   node_item.op_desc->MutableInputDesc(idx)->SetShape(shape);
   node_item.op_desc->MutableInputDesc(idx)->SetOriginShape(ori_shape);
-  if (--num_pending_shapes_ == 0) {
+  if (num_pending_shapes_.fetch_sub(1) == 1) {
+    ready_cv_.notify_all();
+  }
+}
+
+void ShapeInferenceState::MarkInputShapeReady(uint32_t idx) {
+  if (!node_item.is_dynamic || node_item.is_input_shape_static[idx]) {
+    return;
+  }
+
+  GELOGD("[%s] Input shape [%u] is unchanged.", node_item.NodeName().c_str(), idx);
+  std::lock_guard<std::mutex> lk(mu_);
+  if (num_pending_shapes_.fetch_sub(1) == 1) {
     ready_cv_.notify_all();
   }
 }
@@ -62,7 +74,7 @@ void ShapeInferenceState::UpdateInputShapeFuture(uint32_t idx, ShapeFuture &&fut
   GELOGD("[%s] Update input shape [%u] with ShapeFuture.", node_item.NodeName().c_str(), idx);
   std::lock_guard<std::mutex> lk(mu_);
   shape_futures.emplace_back(idx, std::move(future));
-  if (--num_pending_shapes_ == 0) {
+  if (num_pending_shapes_.fetch_sub(1) == 1) {
     ready_cv_.notify_all();
   }
 }
@@ -71,13 +83,14 @@ Status ShapeInferenceState::AwaitShapesReady(const GraphExecutionContext &contex
   if (!node_item.is_dynamic) {
     return SUCCESS;
   }
-  std::unique_lock<std::mutex> lk(mu_);
-  if (num_pending_shapes_ > 0) {
+  if (num_pending_shapes_.load() > 0) {
+    std::unique_lock<std::mutex> lk(mu_);
     GELOGD("[%s] Await pending shape or shape future start.", node_item.NodeName().c_str());
     int try_count = 0;
     bool wait_success = false;
     while (try_count++ < kMaxWaitTimes) {
-      if (ready_cv_.wait_for(lk, std::chrono::seconds(kWaitInternal), [&]() { return num_pending_shapes_ == 0; })) {
+      if (ready_cv_.wait_for(lk, std::chrono::seconds(kWaitInternal),
+                             [&]() { return num_pending_shapes_.load() == 0; })) {
         GELOGD("[%s] Await pending shape or shape future end.", node_item.NodeName().c_str());
         wait_success = true;
         break;
@@ -17,6 +17,7 @@
 #ifndef GE_HYBRID_EXECUTOR_NODE_STATE_H_
 #define GE_HYBRID_EXECUTOR_NODE_STATE_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <future>
 #include <mutex>
@@ -49,13 +50,17 @@ struct ShapeInferenceState {
 
   void UpdateInputShapeFuture(uint32_t idx, ShapeFuture &&future);
 
+  // the shape of the input is the same as the one set by the last execution
+  void MarkInputShapeReady(uint32_t idx);
+
   Status AwaitShapesReady(const GraphExecutionContext &context);
 
   const NodeItem &node_item;
 
  private:
   std::vector<std::pair<uint32_t, ShapeFuture>> shape_futures;
-  int num_pending_shapes_ = 0;
+  // written under mu_, read without lock when checking whether all shapes are ready
+  std::atomic<int> num_pending_shapes_{0};
   std::condition_variable ready_cv_;
   std::mutex mu_;
 };
@@ -86,6 +91,12 @@ struct NodeState {
 
   Status AwaitInputTensors(GraphExecutionContext &context) const;
 
+  // the node is ready to launch once its predecessors are launched and its preparation is done
+  void ResetLaunchDependencies(int num_dependencies) { num_pending_launch_deps_.store(num_dependencies); }
+
+  // @return true if the last pending launch dependency was released
+  bool ReleaseLaunchDependency() { return num_pending_launch_deps_.fetch_sub(1) == 1; }
+
  private:
   const NodeItem *node_item_ = nullptr;
   std::shared_ptr<NodeTask> kernel_task_ = nullptr;
@@ -94,6 +105,7 @@ struct NodeState {
   ShapeInferenceState shape_inference_state_;
   SubgraphContext *subgraph_context_;
   std::mutex mu_;
+  std::atomic<int> num_pending_launch_deps_{0};
 };
 
 using NodeStatePtr = std::shared_ptr<NodeState>;
@@ -29,6 +29,26 @@ Status SubgraphContext::Init() {
   all_inputs_.resize(static_cast<unsigned long>(graph_item_->TotalInputs()));
   all_outputs_.resize(static_cast<unsigned long>(graph_item_->TotalOutputs()));
 
+  std::vector<std::atomic<int>> use_counts(all_outputs_.size());
+  for (auto &use_count : use_counts) {
+    use_count.store(kOutputKeptAlive);
+  }
+  for (auto node_item : graph_item_->GetAllNodes()) {
+    for (size_t i = 0; i < node_item->output_use_counts.size(); ++i) {
+      auto index = node_item->output_start + i;
+      GE_CHECK_GE(use_counts.size(), index + 1U);
+      use_counts[index].store(node_item->output_use_counts[i]);
+    }
+  }
+  output_use_counts_.swap(use_counts);
+
+  std::vector<NodePtr> observed_nodes;
+  for (auto node_item : graph_item_->GetAllNodes()) {
+    if (node_item->has_observer) {
+      observed_nodes.emplace_back(node_item->node);
+    }
+  }
+  node_done_manager_.Init(observed_nodes);
   return SUCCESS;
 }
 
@@ -100,6 +120,25 @@ Status SubgraphContext::GetOutputs(std::vector<TensorValue> &outputs) {
   return SUCCESS;
 }
 
+void SubgraphContext::OnInputReleased(const NodeItem &node_item, int input_index) {
+  if (input_index < 0 || static_cast<size_t>(input_index) >= node_item.input_srcs.size()) {
+    return;
+  }
+  const auto &src = node_item.input_srcs[input_index];
+  if (src.first == nullptr) {
+    return;
+  }
+  auto index = static_cast<size_t>(src.first->output_start + src.second);
+  if (index >= output_use_counts_.size() || output_use_counts_[index].load() <= 0) {
+    return;
+  }
+  if (output_use_counts_[index].fetch_sub(1) == 1) {
+    all_outputs_[index].Destroy();
+    GELOGD("[%s] Output[%d] released after its last use by [%s].", src.first->NodeName().c_str(), src.second,
+           node_item.NodeName().c_str());
+  }
+}
+
 bool SubgraphContext::Await(const NodePtr &node) { return node_done_manager_.Await(node); }
 
 void SubgraphContext::OnError(Status error) {
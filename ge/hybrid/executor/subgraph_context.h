@@ -17,6 +17,7 @@
 #ifndef GE_HYBRID_EXECUTOR_ITERATION_CONTEXT_H_
 #define GE_HYBRID_EXECUTOR_ITERATION_CONTEXT_H_
 
+#include <atomic>
 #include <vector>
 
 #include "hybrid/common/tensor_value.h"
@@ -43,6 +44,14 @@ class SubgraphContext {
   Status GetInput(int index, TensorValue &tensor);
   Status GetOutputs(std::vector<TensorValue> &outputs);
 
+  ///
+  /// @ingroup ge
+  /// @brief called when a node no longer needs an input, the output feeding it is released after its last use
+  /// @param [in] node_item: node consuming the input
+  /// @param [in] input_index: index of the input
+  ///
+  void OnInputReleased(const NodeItem &node_item, int input_index);
+
   bool Await(const NodePtr &node);
   void NodeDone(const NodePtr &node);
 
@@ -52,6 +61,8 @@ class SubgraphContext {
   std::mutex mu_;
   std::vector<TensorValue> all_inputs_;
   std::vector<TensorValue> all_outputs_;
+  // remaining uses of every output, from the memory plan of the graph
+  std::vector<std::atomic<int>> output_use_counts_;
   NodeDoneManager node_done_manager_;
   std::unordered_map<const NodeItem *, NodeStatePtr> node_states_;
 };
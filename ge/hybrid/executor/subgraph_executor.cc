@@ -22,17 +22,28 @@
 namespace ge {
 namespace hybrid {
 namespace {
-constexpr int kDefaultThreadNum = 4;
 constexpr int kDataInputIndex = 0;
+constexpr uint32_t kPrepareWorkerNum = 4;
+
+// Prepare tasks are on the critical path of every step. They get workers of their own instead of queuing behind
+// the compile and pass tasks of the shared scheduler.
+TaskScheduler &GetPrepareScheduler() {
+  static TaskScheduler scheduler(kPrepareWorkerNum);
+  return scheduler;
+}
 }  // namespace
 
 SubgraphExecutor::SubgraphExecutor(const GraphItem *graph_item, GraphExecutionContext *context, bool force_infer_shape)
     : graph_item_(graph_item),
       context_(context),
       force_infer_shape_(force_infer_shape),
-      pre_run_pool_(kDefaultThreadNum) {}
+      pre_run_tasks_(TaskPriority::kHigh, GetPrepareScheduler()) {}
 
-SubgraphExecutor::~SubgraphExecutor() { GELOGD("[%s] SubgraphExecutor destroyed.", graph_item_->GetName().c_str()); }
+SubgraphExecutor::~SubgraphExecutor() {
+  // pending prepare tasks still reference subgraph context and shape inference engine
+  pre_run_tasks_.Wait();
+  GELOGD("[%s] SubgraphExecutor destroyed.", graph_item_->GetName().c_str());
+}
 
 Status SubgraphExecutor::Init(const std::vector<TensorValue> &inputs,
                               const std::vector<ConstGeTensorDescPtr> &input_desc) {
@@ -171,10 +182,11 @@ Status SubgraphExecutor::ExecuteAsync(TaskContext &task_context) {
   return SUCCESS;
 }
 
-Status SubgraphExecutor::PrepareNodes() {
-  GELOGD("[%s] Start to prepare nodes. force infer shape = %s.", graph_item_->GetName().c_str(),
-         force_infer_shape_ ? "true" : "false");
+Status SubgraphExecutor::InitLaunchDependencies() {
   auto &all_nodes = graph_item_->GetAllNodes();
+  node_states_.clear();
+  node_states_.reserve(all_nodes.size());
+  num_nodes_to_launch_ = 0;
   for (auto all_node : all_nodes) {
     auto &node_item = *all_node;
     // for while op
@@ -184,10 +196,45 @@ Status SubgraphExecutor::PrepareNodes() {
       mutable_node_item.SetToDynamic();
     }
 
-    GELOGD("[%s] Start to prepare node [%s].", graph_item_->GetName().c_str(), node_item.NodeName().c_str());
     auto node_state = subgraph_context_->GetOrCreateNodeState(&node_item);
     GE_CHECK_NOTNULL(node_state);
-    auto p_node_state = node_state.get();
+    node_states_.emplace_back(node_state.get());
+    if (node_item.node_type == NETOUTPUT) {
+      continue;
+    }
+
+    // released by PrepareNodes once the node is committed, and by the prepare task of a dynamic node
+    int num_dependencies = node_item.num_launch_predecessors + (node_item.is_dynamic ? 2 : 1);
+    node_state->ResetLaunchDependencies(num_dependencies);
+    num_nodes_to_launch_ += 1;
+  }
+
+  GELOGD("[%s] %zu nodes to launch.", graph_item_->GetName().c_str(), num_nodes_to_launch_);
+  return SUCCESS;
+}
+
+bool SubgraphExecutor::ReleaseLaunchDependency(NodeState &node_state) {
+  if (!node_state.ReleaseLaunchDependency()) {
+    return true;
+  }
+
+  if (!ready_queue_.Push(&node_state)) {
+    GELOGE(INTERNAL_ERROR, "[%s] Error occurs while launching tasks. failed to push node [%s].",
+           graph_item_->GetName().c_str(), node_state.GetName().c_str());
+    return false;
+  }
+  GELOGD("[%s] Push node [%s] to queue.", graph_item_->GetName().c_str(), node_state.GetName().c_str());
+  return true;
+}
+
+Status SubgraphExecutor::PrepareNodes() {
+  GELOGD("[%s] Start to prepare nodes. force infer shape = %s.", graph_item_->GetName().c_str(),
+         force_infer_shape_ ? "true" : "false");
+  auto &all_nodes = graph_item_->GetAllNodes();
+  for (size_t i = 0; i < all_nodes.size(); ++i) {
+    auto &node_item = *all_nodes[i];
+    GELOGD("[%s] Start to prepare node [%s].", graph_item_->GetName().c_str(), node_item.NodeName().c_str());
+    auto p_node_state = node_states_[i];
 
     if (node_item.node_type == NETOUTPUT) {
       // Wait for all inputs become valid
@@ -199,9 +246,14 @@ Status SubgraphExecutor::PrepareNodes() {
 
     // only do shape inference and compilation for nodes with dynamic shapes.
     if (node_item.is_dynamic) {
-      auto prepare_future = pre_run_pool_.commit([this, p_node_state]() -> Status {
-        GE_CHK_STATUS_RET_NOLOG(InferShape(shape_inference_engine_.get(), *p_node_state));
-        return PrepareForExecution(context_, *p_node_state);
+      // the node is pushed once prepared, a failed preparation is reported when it is launched
+      auto prepare_future = pre_run_tasks_.Commit([this, p_node_state]() -> Status {
+        auto ret = InferShape(shape_inference_engine_.get(), *p_node_state);
+        if (ret == SUCCESS) {
+          ret = PrepareForExecution(context_, *p_node_state);
+        }
+        (void)ReleaseLaunchDependency(*p_node_state);
+        return ret;
       });
 
       p_node_state->SetPrepareFuture(std::move(prepare_future));
@@ -212,17 +264,14 @@ Status SubgraphExecutor::PrepareNodes() {
         GE_CHK_STATUS_RET(TaskCompileEngine::Compile(*p_node_state, context_), "[%s] Failed to create task.",
                           p_node_state->GetName().c_str());
       } else {
-        node_state->SetKernelTask(node_item.kernel_task);
+        p_node_state->SetKernelTask(node_item.kernel_task);
       }
     }
 
-    if (!ready_queue_.Push(p_node_state)) {
-      GELOGE(INTERNAL_ERROR, "[%s] Error occurs while launching tasks. quit from preparing nodes.",
-             graph_item_->GetName().c_str());
+    if (!ReleaseLaunchDependency(*p_node_state)) {
+      GELOGE(INTERNAL_ERROR, "[%s] Quit from preparing nodes.", graph_item_->GetName().c_str());
       return INTERNAL_ERROR;
     }
-
-    GELOGD("[%s] Push node [%s] to queue.", graph_item_->GetName().c_str(), node_item.NodeName().c_str());
   }
 
   return SUCCESS;
@@ -256,7 +305,9 @@ Status SubgraphExecutor::PrepareForExecution(GraphExecutionContext *ctx, NodeSta
 }
 
 Status SubgraphExecutor::LaunchTasks() {
-  while (true) {
+  // nodes are launched in the order they become ready, which is a topological order of the subgraph
+  size_t num_launched = 0;
+  while (num_launched < num_nodes_to_launch_) {
     NodeState *node_state = nullptr;
     if (!ready_queue_.Pop(node_state)) {
       GELOGE(INTERNAL_ERROR, "[%s] Failed to pop node.", graph_item_->GetName().c_str());
@@ -279,14 +330,28 @@ Status SubgraphExecutor::LaunchTasks() {
                       "[%s] Execute node failed.", node_state->GetName().c_str());
 
     GELOGD("[%s] Done executing node successfully.", node_state->GetName().c_str());
+    num_launched += 1;
+    for (auto successor_index : node_state->GetNodeItem()->launch_successors) {
+      if (!ReleaseLaunchDependency(*node_states_[successor_index])) {
+        return INTERNAL_ERROR;
+      }
+    }
   }
+
+  GELOGD("[%s] All %zu nodes launched.", graph_item_->GetName().c_str(), num_launched);
+  return SUCCESS;
 }
 
 Status SubgraphExecutor::ScheduleTasks() {
+  GE_CHK_STATUS_RET(InitLaunchDependencies(), "[%s] Failed to init launch dependencies.",
+                    graph_item_->GetName().c_str());
   GELOGD("[%s] Start to schedule prepare workers.", graph_item_->GetName().c_str());
   auto prepare_future = std::async([&]() -> Status {
     auto ret = PrepareNodes();
-    ready_queue_.Push(nullptr);
+    if (ret != SUCCESS) {
+      // nodes not committed are never pushed, stop waiting for them
+      ready_queue_.Push(nullptr);
+    }
     return ret;
   });
 
@@ -19,8 +19,8 @@
 
 #include <vector>
 
-#include "common/blocking_queue.h"
-#include "common/thread_pool.h"
+#include "common/mpsc_queue.h"
+#include "common/task_scheduler.h"
 #include "hybrid/executor/subgraph_context.h"
 #include "hybrid/executor/node_state.h"
 #include "hybrid/executor/hybrid_execution_context.h"
@@ -83,6 +83,8 @@ class SubgraphExecutor {
   Status InitInputsForKnownShape(const std::vector<TensorValue> &inputs);
   Status ExecuteAsyncForKnownShape(const std::vector<TensorValue> &inputs);
   Status ScheduleTasks();
+  Status InitLaunchDependencies();
+  bool ReleaseLaunchDependency(NodeState &node_state);
   Status PrepareNodes();
   Status LaunchTasks();
   Status SetOutputsToParentNode(TaskContext &task_context);
@@ -91,8 +93,12 @@ class SubgraphExecutor {
   GraphExecutionContext *context_;
   std::unique_ptr<SubgraphContext> subgraph_context_;
   bool force_infer_shape_;
-  ThreadPool pre_run_pool_;
-  BlockingQueue<NodeState *> ready_queue_;
+  TaskGroup pre_run_tasks_;
+  // nodes whose launch dependencies are all released, pushed by the prepare workers and the launching thread
+  MpscQueue<NodeState *> ready_queue_;
+  // states of GraphItem::GetAllNodes, by index
+  std::vector<NodeState *> node_states_;
+  size_t num_nodes_to_launch_ = 0;
   std::unique_ptr<ShapeInferenceEngine> shape_inference_engine_;
   std::shared_ptr<TaskContext> known_shape_task_context_;
 };
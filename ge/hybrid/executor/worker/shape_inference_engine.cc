@@ -15,12 +15,34 @@
  */
 
 #include "hybrid/executor/worker/shape_inference_engine.h"
+#include <cstring>
+#include "graph/runtime_inference_context.h"
 #include "graph/shape_refiner.h"
 #include "graph/utils/node_utils.h"
 #include "hybrid/node_executor/node_executor.h"
 
 namespace ge {
 namespace hybrid {
+namespace {
+const size_t kMaxInferShapeCacheEntries = 8;
+
+void AppendShape(const GeShape &shape, std::vector<int64_t> &key) {
+  key.emplace_back(static_cast<int64_t>(shape.GetDimNum()));
+  for (size_t i = 0; i < shape.GetDimNum(); ++i) {
+    key.emplace_back(shape.GetDim(i));
+  }
+}
+
+void AppendData(const uint8_t *data, size_t size, std::vector<int64_t> &key) {
+  key.emplace_back(static_cast<int64_t>(size));
+  size_t offset = key.size();
+  key.resize(offset + (size + sizeof(int64_t) - 1) / sizeof(int64_t), 0);
+  if (data != nullptr && size > 0) {
+    (void)memcpy(key.data() + offset, data, size);
+  }
+}
+}  // namespace
+
 ShapeInferenceEngine::ShapeInferenceEngine(GraphExecutionContext *execution_context, SubgraphContext *subgraph_context)
     : execution_context_(execution_context), subgraph_context_(subgraph_context) {}
 
@@ -54,6 +76,11 @@ Status ShapeInferenceEngine::InferShape(NodeState &node_state) {
   // Wait for "const input nodes" if node's shape inference function requires any.
   GE_CHK_STATUS_RET_NOLOG(AwaitDependentNodes(node_state));
 
+  // output shapes of DEPEND_SHAPE_RANGE nodes are only known after execution, they are not cached
+  if (node_item.shape_inference_type != DEPEND_SHAPE_RANGE && node_item.infer_shape_cache != nullptr) {
+    return InferShapeWithCache(node_item);
+  }
+
   // Do shape inference
   GELOGD("[%s] Start to invoke InferShapeAndType", node_item.NodeName().c_str());
   {
@@ -79,6 +106,97 @@ Status ShapeInferenceEngine::InferShape(NodeState &node_state) {
   return SUCCESS;
 }
 
+Status ShapeInferenceEngine::BuildShapeCacheKey(const NodeItem &node_item, std::vector<int64_t> &key) const {
+  for (int i = 0; i < node_item.num_inputs; ++i) {
+    auto input_desc = node_item.op_desc->MutableInputDesc(static_cast<uint32_t>(i));
+    if (input_desc == nullptr) {
+      // optional input not given
+      key.emplace_back(-1);
+      continue;
+    }
+    AppendShape(input_desc->GetShape(), key);
+    AppendShape(input_desc->GetOriginShape(), key);
+  }
+
+  if (node_item.value_dependent_inputs.empty()) {
+    return SUCCESS;
+  }
+  RuntimeInferenceContext *runtime_infer_ctx = nullptr;
+  std::string session_id = std::to_string(execution_context_->session_id);
+  GE_CHK_GRAPH_STATUS_RET(RuntimeInferenceContext::GetContext(session_id, &runtime_infer_ctx),
+                          "Failed to get RuntimeInferenceContext, session_id = %s", session_id.c_str());
+  for (auto &it : node_item.value_dependent_inputs) {
+    Tensor tensor;
+    GE_CHK_GRAPH_STATUS_RET(runtime_infer_ctx->GetTensor(it.second.first, it.second.second, tensor),
+                            "[%s] Failed to get value of input[%d]", node_item.NodeName().c_str(), it.first);
+    AppendData(tensor.GetData(), tensor.GetSize(), key);
+  }
+  return SUCCESS;
+}
+
+Status ShapeInferenceEngine::InferShapeWithCache(const NodeItem &node_item) {
+  std::vector<int64_t> key;
+  GE_CHK_STATUS_RET_NOLOG(BuildShapeCacheKey(node_item, key));
+
+  auto &cache = *node_item.infer_shape_cache;
+  std::lock_guard<std::mutex> cache_lk(cache.mu);
+  cache.current = nullptr;
+  for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+    if (it->key != key) {
+      continue;
+    }
+    cache.entries.splice(cache.entries.begin(), cache.entries, it);
+    auto &entry = cache.entries.front();
+    // output descs still hold the shapes if the last inference hit the same entry
+    if (&entry != cache.last_propagated) {
+      for (int i = 0; i < node_item.num_outputs; ++i) {
+        auto output_desc = node_item.op_desc->MutableOutputDesc(static_cast<uint32_t>(i));
+        GE_CHECK_NOTNULL(output_desc);
+        output_desc->SetShape(entry.output_shapes[i]);
+        output_desc->SetOriginShape(entry.output_ori_shapes[i]);
+      }
+    }
+    cache.current = &entry;
+    cache.hit_num++;
+    GELOGD("[%s] Output shapes got from infer shape cache.", node_item.NodeName().c_str());
+    return SUCCESS;
+  }
+
+  cache.miss_num++;
+  cache.last_propagated = nullptr;
+  GELOGD("[%s] Start to invoke InferShapeAndType", node_item.NodeName().c_str());
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] Start");
+    GE_CHK_STATUS_RET(ShapeRefiner::InferShapeAndType(node_item.node), "Invoke InferShapeAndType failed.");
+    RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[InferShapeAndType] End");
+  }
+  bool is_unknown_shape = false;
+  GE_CHK_STATUS_RET(NodeUtils::GetNodeUnknownShapeStatus(*node_item.node, is_unknown_shape),
+                    "Failed to get shape status. node = %s", node_item.NodeName().c_str());
+  GE_CHK_BOOL_RET_STATUS(!is_unknown_shape, INTERNAL_ERROR, "[%s] Shape is still unknown after shape inference.",
+                         node_item.NodeName().c_str());
+
+  InferShapeCache::Entry entry;
+  entry.key = std::move(key);
+  for (int i = 0; i < node_item.num_outputs; ++i) {
+    auto output_desc = node_item.op_desc->MutableOutputDesc(static_cast<uint32_t>(i));
+    GE_CHECK_NOTNULL(output_desc);
+    entry.output_shapes.emplace_back(output_desc->GetShape());
+    entry.output_ori_shapes.emplace_back(output_desc->GetOriginShape());
+  }
+  if (cache.entries.size() >= kMaxInferShapeCacheEntries) {
+    cache.entries.pop_back();
+  }
+  cache.entries.emplace_front(std::move(entry));
+  cache.current = &cache.entries.front();
+
+  GELOGD("[%s] [HybridTrace] After shape inference. Node = %s", node_item.NodeName().c_str(),
+         node_item.DebugString().c_str());
+  GELOGD("[%s] InferShapeAndType finished successfully.", node_item.NodeName().c_str());
+  return SUCCESS;
+}
+
 Status ShapeInferenceEngine::AwaitDependentNodes(NodeState &node_state) {
   auto &node_item = *node_state.GetNodeItem();
   for (auto &src_node : node_item.dependents_for_shape_inference) {
@@ -109,6 +227,15 @@ Status ShapeInferenceEngine::PropagateOutputShapes(const NodeItem &node_item) {
   GELOGD("[%s] Start to propagate output shapes. shape_type = %d", node_item.NodeName().c_str(),
          node_item.shape_inference_type);
   RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[PropagateOutputShapes] Start");
+  // peers still hold the shapes if the same cached result was propagated by the last execution
+  InferShapeCache *cache = shape_is_future ? nullptr : node_item.infer_shape_cache.get();
+  std::unique_lock<std::mutex> cache_lk;
+  bool shapes_unchanged = false;
+  if (cache != nullptr) {
+    cache_lk = std::unique_lock<std::mutex>(cache->mu);
+    shapes_unchanged = cache->current != nullptr && cache->current == cache->last_propagated;
+    cache->last_propagated = nullptr;
+  }
   // propagate each output
   for (int i = 0; i < node_item.num_outputs; ++i) {
     auto output_desc = node_item.op_desc->MutableOutputDesc(i);
@@ -130,11 +257,16 @@ Status ShapeInferenceEngine::PropagateOutputShapes(const NodeItem &node_item) {
         ShapeFuture future(node_item.node, i, subgraph_context_);
         dst_node_state->GetShapeInferenceState().UpdateInputShapeFuture(dst_input_index_and_node.first,
                                                                         std::move(future));
+      } else if (shapes_unchanged) {
+        dst_node_state->GetShapeInferenceState().MarkInputShapeReady(dst_input_index_and_node.first);
       } else {
         dst_node_state->GetShapeInferenceState().UpdateInputShape(dst_input_index_and_node.first, ori_shape, shape);
       }
     }
   }
+  if (cache != nullptr) {
+    cache->last_propagated = cache->current;
+  }
   RECORD_SHAPE_INFERENCE_EVENT(execution_context_, node_item.NodeName().c_str(), "[PropagateOutputShapes] End");
   GELOGD("[%s] Propagating output shapes finished successfully.", node_item.NodeName().c_str());
   return SUCCESS;
@@ -37,6 +37,8 @@ class ShapeInferenceEngine {
  private:
   static Status UpdatePeerNodeShape(const Node &node);
   Status AwaitDependentNodes(NodeState &node_state);
+  Status BuildShapeCacheKey(const NodeItem &node_item, std::vector<int64_t> &key) const;
+  Status InferShapeWithCache(const NodeItem &node_item);
 
   GraphExecutionContext *execution_context_;
   SubgraphContext *subgraph_context_;
@@ -120,5 +120,17 @@ const GraphItem *HybridModel::GetSubgraphItem(const ComputeGraphPtr &subgraph) c
 }
 
 const string &HybridModel::GetModelName() const { return model_name_; }
+
+void HybridModel::GetInferShapeCacheStats(uint64_t &hit_num, uint64_t &miss_num) const {
+  hit_num = 0;
+  miss_num = 0;
+  for (auto &it : node_items_) {
+    const auto &cache = it.second->infer_shape_cache;
+    if (cache != nullptr) {
+      hit_num += cache->hit_num.load();
+      miss_num += cache->miss_num.load();
+    }
+  }
+}
 }  // namespace hybrid
 }  // namespace ge
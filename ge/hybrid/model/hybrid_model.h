@@ -71,6 +71,14 @@ class HybridModel {
 
   const string &GetModelName() const;
 
+  ///
+  /// @ingroup ge
+  /// @brief get the hit and miss counts of the infer shape caches of all nodes
+  /// @param [out] hit_num: number of shape inferences served by the caches
+  /// @param [out] miss_num: number of shape inferences actually run
+  ///
+  void GetInferShapeCacheStats(uint64_t &hit_num, uint64_t &miss_num) const;
+
  private:
   friend class HybridModelBuilder;
   friend class HybridModelAsyncExecutor;
@@ -15,6 +15,8 @@
  */
 
 #include "hybrid/model/hybrid_model_builder.h"
+#include <unordered_map>
+#include <unordered_set>
 #include "common/math/math_util.h"
 #include "graph/ge_context.h"
 #include "graph/utils/node_utils.h"
@@ -241,8 +243,10 @@ Status HybridModelBuilder::ParseDependentInputNodes(NodeItem &node_item, const s
     const auto &src_node = peer_out_anchor->GetOwnerNode();
     GE_CHECK_NOTNULL(src_node);
     auto src_node_item = MutableNodeItem(src_node);
+    GE_CHECK_NOTNULL(src_node_item);
     src_node_item->to_const_output_id_list.emplace(peer_out_anchor->GetIdx());
     src_node_item->has_observer = true;
+    node_item.value_dependent_inputs[input_index] = std::make_pair(src_node_item->node_id, peer_out_anchor->GetIdx());
 
     dependent_input_nodes.emplace(src_node);
     GELOGD("[%s] Dependent added from output of [%s:%d]", node_item.NodeName().c_str(),
@@ -750,6 +754,7 @@ Status HybridModelBuilder::LoadGeModel(ComputeGraph &sub_graph, const GeModelPtr
   auto parent_node = sub_graph.GetParentNode();
   GE_CHECK_NOTNULL(parent_node);
   auto op_type = parent_node->GetType();
+  GE_CHECK_NOTNULL(ge_model->GetModelTaskDefPtr());
   if (op_type == IF || op_type == CASE || op_type == WHILE) {
     GELOGD("Set ge_model for control op subgraph: [%s], task_size = %d", sub_graph.GetName().c_str(),
            ge_model->GetModelTaskDefPtr()->task_size());
@@ -792,7 +797,9 @@ Status HybridModelBuilder::IndexTaskDefs() {
       node_map.emplace(node_id, node);
     }
 
-    auto tasks = ge_model->GetModelTaskDefPtr()->task();
+    auto model_task_def = ge_model->GetModelTaskDefPtr();
+    GE_CHECK_NOTNULL(model_task_def);
+    auto tasks = model_task_def->task();
     for (int i = 0; i < tasks.size(); ++i) {
       const domi::TaskDef &task_def = tasks[i];
       GELOGI("Task id = %d, task type = %d", i, task_def.type());
@@ -1209,6 +1216,8 @@ Status HybridModelBuilder::LoadDynamicSubgraph(ComputeGraph &graph, bool is_root
   graph_item->total_inputs_ = input_start;
   graph_item->total_outputs_ = output_start;
   GE_CHK_STATUS_RET_NOLOG(BuildInputMapping(*graph_item, data_nodes, is_root_graph));
+  GE_CHK_STATUS_RET_NOLOG(BuildMemoryPlan(*graph_item));
+  GE_CHK_STATUS_RET_NOLOG(BuildLaunchDependencies(*graph_item));
   if (is_root_graph) {
     graph_item->SetName("Root-Graph");
     GELOGD("Done loading dynamic subgraph: [%s]", graph_item->GetName().c_str());
@@ -1222,6 +1231,79 @@ Status HybridModelBuilder::LoadDynamicSubgraph(ComputeGraph &graph, bool is_root
   return SUCCESS;
 }
 
+Status HybridModelBuilder::BuildMemoryPlan(GraphItem &graph_item) {
+  std::unordered_set<const NodeItem *> graph_nodes;
+  for (auto node_item : graph_item.node_items_) {
+    GE_CHECK_NOTNULL(node_item);
+    graph_nodes.emplace(node_item);
+    node_item->input_srcs.assign(node_item->num_inputs, std::make_pair(nullptr, -1));
+    node_item->output_use_counts.assign(node_item->num_outputs, 0);
+  }
+
+  int num_released_outputs = 0;
+  for (auto node_item : graph_item.node_items_) {
+    for (int i = 0; i < node_item->num_outputs; ++i) {
+      auto &use_count = node_item->output_use_counts[i];
+      // outputs read by the node itself after execution, or aliasing variables
+      bool keep_alive = node_item->to_const_output_id_list.count(i) > 0 || node_item->ref_outputs.count(i) > 0;
+      for (auto &dst_input_index_and_node : node_item->outputs[i]) {
+        auto dst_input_idx = dst_input_index_and_node.first;
+        auto dst_node_item = dst_input_index_and_node.second;
+        // NetOutput is not executed, its inputs are the outputs of the subgraph
+        if (graph_nodes.count(dst_node_item) == 0 || dst_node_item->NodeType() == NETOUTPUT) {
+          keep_alive = true;
+          continue;
+        }
+        if (dst_input_idx >= dst_node_item->input_srcs.size()) {
+          GELOGE(INTERNAL_ERROR, "[%s] input index out of range. index = %u, num inputs = %d",
+                 dst_node_item->NodeName().c_str(), dst_input_idx, dst_node_item->num_inputs);
+          return INTERNAL_ERROR;
+        }
+        dst_node_item->input_srcs[dst_input_idx] = std::make_pair(node_item, i);
+        use_count += 1;
+      }
+
+      if (keep_alive || use_count == 0) {
+        use_count = kOutputKeptAlive;
+      } else {
+        num_released_outputs += 1;
+      }
+      GELOGD("[%s] Output[%d] use count = %d.", node_item->NodeName().c_str(), i, use_count);
+    }
+  }
+
+  GELOGD("Memory plan built. %d of %d outputs are released once consumed.", num_released_outputs,
+         graph_item.total_outputs_);
+  return SUCCESS;
+}
+
+Status HybridModelBuilder::BuildLaunchDependencies(GraphItem &graph_item) {
+  auto &node_items = graph_item.node_items_;
+  std::unordered_map<const Node *, int> node_indices;
+  for (size_t i = 0; i < node_items.size(); ++i) {
+    GE_CHECK_NOTNULL(node_items[i]);
+    node_items[i]->launch_successors.clear();
+    node_items[i]->num_launch_predecessors = 0;
+    node_indices.emplace(node_items[i]->node.get(), static_cast<int>(i));
+  }
+
+  // a node is launched once every node before it on a data or control edge is launched, NetOutput is not launched
+  for (auto node_item : node_items) {
+    if (node_item->NodeType() == NETOUTPUT) {
+      continue;
+    }
+    for (const auto &out_node : node_item->node->GetOutAllNodes()) {
+      auto it = node_indices.find(out_node.get());
+      if (it == node_indices.end() || node_items[it->second]->NodeType() == NETOUTPUT) {
+        continue;
+      }
+      node_item->launch_successors.emplace_back(it->second);
+      node_items[it->second]->num_launch_predecessors += 1;
+    }
+  }
+  return SUCCESS;
+}
+
 Status HybridModelBuilder::ParseVarOutputs(NodeItem &node_item) {
   for (int i = 0; i < node_item.num_outputs; ++i) {
     auto output_tensor_desc = node_item.op_desc->GetOutputDesc(i);
@@ -50,6 +50,8 @@ class HybridModelBuilder {
   static Status UnfoldSubgraph(ComputeGraph &root_graph, ComputeGraph &parent_graph, ComputeGraph &sub_graph);
   static Status InitWeights();
   static Status BuildInputMapping(GraphItem &graph_item, std::vector<NodeItem *> &data_nodes, bool is_root_graph);
+  static Status BuildMemoryPlan(GraphItem &graph_item);
+  static Status BuildLaunchDependencies(GraphItem &graph_item);
   static Status ResolveRefIo(NodeItem &node_item);
   Status BuildOutputMapping(GraphItem &partitioned_call, const NodeItem &node_item, bool is_root_graph);
   Status ValidateParams();
@@ -113,6 +113,8 @@ Status NodeItem::Init() {
   GE_CHK_STATUS_RET(NodeUtils::GetNodeUnknownShapeStatus(*node, is_dynamic), "[%s] Failed to get shape status.",
                     node->GetName().c_str());
   GE_CHK_STATUS_RET(ParseFusedSubgraph(*this), "[%s] Failed to parse fused subgraph", node_name.c_str());
+  infer_shape_cache.reset(new (std::nothrow) InferShapeCache());
+  GE_CHECK_NOTNULL(infer_shape_cache);
   if (is_dynamic) {
     for (int i = 0; i < num_inputs; ++i) {
       const auto &input_desc = op_desc->MutableInputDesc(i);
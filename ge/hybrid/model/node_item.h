@@ -17,6 +17,9 @@
 #ifndef GE_HYBRID_MODEL_NODE_ITEM_H_
 #define GE_HYBRID_MODEL_NODE_ITEM_H_
 
+#include <atomic>
+#include <list>
+#include <mutex>
 #include <vector>
 #include "external/ge/ge_api_error_codes.h"
 #include "graph/node.h"
@@ -29,6 +32,9 @@ namespace hybrid {
 class NodeTask;
 class NodeExecutor;
 
+// use count of outputs that must live until the end of the subgraph
+const int kOutputKeptAlive = -1;
+
 struct FusedSubgraph {
   std::map<uint32_t, std::vector<GeTensorDescPtr>> input_mapping;
   std::map<uint32_t, OpDescPtr> output_mapping;
@@ -36,6 +42,25 @@ struct FusedSubgraph {
   ComputeGraphPtr graph;
 };
 
+// results of shape inference cached across executions, keyed by input shapes and values of value-dependent inputs
+struct InferShapeCache {
+  struct Entry {
+    std::vector<int64_t> key;
+    std::vector<GeShape> output_shapes;
+    std::vector<GeShape> output_ori_shapes;
+  };
+
+  std::mutex mu;
+  // most recently used first
+  std::list<Entry> entries;
+  // entry applied by the latest shape inference, nullptr if the result was not cached
+  const Entry *current = nullptr;
+  // entry whose shapes were last propagated to the peer nodes
+  const Entry *last_propagated = nullptr;
+  std::atomic<uint64_t> hit_num{0};
+  std::atomic<uint64_t> miss_num{0};
+};
+
 // for caching static information across execution
 struct NodeItem {
   explicit NodeItem(NodePtr node);
@@ -69,6 +94,9 @@ struct NodeItem {
   std::vector<ge::NodePtr> dependents_for_shape_inference;
   std::vector<ge::NodePtr> dependents_for_execution;
   std::set<int> to_const_output_id_list;
+  // input index -> <src node id, src output index> of inputs whose values are read by shape inference
+  std::map<int, std::pair<int, int>> value_dependent_inputs;
+  std::unique_ptr<InferShapeCache> infer_shape_cache;
 
   vector<NodeItem *> inputs;
   // src_output_id, dst_anchor_id, dst_node
@@ -83,6 +111,18 @@ struct NodeItem {
   std::vector<bool> is_input_shape_static;
   bool is_output_shape_static = true;
   int num_static_input_shapes = 0;
+
+  // memory plan of dynamic subgraphs, built by HybridModelBuilder
+  // <src_node_item, src_output_index> of every input, src_node_item is nullptr if the input is not planned
+  vector<pair<const NodeItem *, int>> input_srcs;
+  // number of inputs reading each output, the output is released after the last one is consumed
+  std::vector<int> output_use_counts;
+
+  // launch order of dynamic subgraphs, built by HybridModelBuilder
+  // index in GraphItem::GetAllNodes of the node at the end of every data or control out edge, NetOutput excluded
+  std::vector<int> launch_successors;
+  // number of in edges from nodes that are launched before this one
+  int num_launch_predecessors = 0;
 };
 }  // namespace hybrid
 }  // namespace ge
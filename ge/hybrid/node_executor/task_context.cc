@@ -17,6 +17,7 @@
 #include "task_context.h"
 #include "framework/common/ge_inner_error_codes.h"
 #include "framework/common/debug/log.h"
+#include "framework/common/types.h"
 #include "graph/utils/tensor_utils.h"
 #include "graph/debug/ge_attr_define.h"
 #include "hybrid/executor/hybrid_execution_context.h"
@@ -24,6 +25,20 @@
 
 namespace ge {
 namespace hybrid {
+namespace {
+bool IsGraphOutput(const NodeItem &node_item, int index) {
+  if (static_cast<size_t>(index) >= node_item.outputs.size()) {
+    return false;
+  }
+  for (const auto &dst_input_index_and_node : node_item.outputs[index]) {
+    if ((dst_input_index_and_node.second != nullptr) && (dst_input_index_and_node.second->NodeType() == NETOUTPUT)) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
 TaskContext::TaskContext(GraphExecutionContext *execution_context, const NodeItem *node_item,
                          SubgraphContext *subgraph_context)
     : node_item_(node_item), execution_context_(execution_context), subgraph_context_(subgraph_context) {}
@@ -158,7 +173,8 @@ string TaskContext::TensorDesc2String(const GeTensorDesc &desc) {
   return ss.str();
 }
 
-Status TaskContext::AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue &tensor, AllocationAttr *attr) {
+Status TaskContext::AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue &tensor, AllocationAttr *attr,
+                                   bool use_arena) {
   int64_t size = 0;
   if (ge::TensorUtils::GetSize(tensor_desc, size) != GRAPH_SUCCESS) {
     GELOGE(INTERNAL_ERROR, "Failed to get tensor size");
@@ -169,9 +185,10 @@ Status TaskContext::AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue
     GELOGW("size from tensor_desc == 0");
   }
 
-  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, attr);
+  auto buffer = TensorBuffer::CreateShared(use_arena ? execution_context_->arena : nullptr,
+                                           execution_context_->allocator, size, attr);
   GE_CHECK_NOTNULL(buffer);
-  tensor = TensorValue(shared_ptr<TensorBuffer>(buffer.release()));
+  tensor = TensorValue(std::move(buffer));
   return SUCCESS;
 }
 
@@ -205,7 +222,9 @@ Status TaskContext::AllocateOutput(int index, const GeTensorDesc &tensor_desc, T
       GELOGD("[%s] Output[%d] is referenced to input[%d]", GetNodeName(), index, reuse_input->second);
       outputs_start_[index] = inputs_start_[reuse_input->second];
     } else {
-      GE_CHK_STATUS_RET_NOLOG(AllocateTensor(tensor_desc, outputs_start_[index], attr));
+      // graph outputs are handed to the caller and outlive the step, keep them out of the arena
+      GE_CHK_STATUS_RET_NOLOG(
+          AllocateTensor(tensor_desc, outputs_start_[index], attr, !IsGraphOutput(*node_item_, index)));
       GELOGD("Allocating output successfully. node: %s. index = %d, size = %zu", node_item_->NodeName().c_str(), index,
              outputs_start_[index].GetSize());
     }
@@ -230,10 +249,14 @@ Status TaskContext::AllocateOutputs(AllocationAttr *attr) {
     (void)AttrUtils::GetInt(node_item_->op_desc, ATTR_OUTPUT_MEMORY_TYPE, mem_type);
     if (attr == nullptr) {
       auto tmp_attr = AllocationAttr(0, nullptr, static_cast<MemStorageType>(mem_type));
+      tmp_attr.SetStream(GetStream());
       GE_CHK_STATUS_RET_NOLOG(AllocateOutput(i, *output_desc, nullptr, &tmp_attr));
     } else {
-      attr->SetMemType(static_cast<MemStorageType>(mem_type));
-      GE_CHK_STATUS_RET_NOLOG(AllocateOutput(i, *output_desc, nullptr, attr));
+      // the attr may be shared by the tasks of other streams, keep it unchanged
+      auto output_attr = *attr;
+      output_attr.SetMemType(static_cast<MemStorageType>(mem_type));
+      output_attr.SetStream(GetStream());
+      GE_CHK_STATUS_RET_NOLOG(AllocateOutput(i, *output_desc, nullptr, &output_attr));
     }
   }
 
@@ -241,13 +264,13 @@ Status TaskContext::AllocateOutputs(AllocationAttr *attr) {
 }
 
 Status TaskContext::AllocateTensor(size_t size, TensorValue &tensor, AllocationAttr *attr) {
-  auto buffer = TensorBuffer::Create(execution_context_->allocator, size, attr);
+  auto buffer = TensorBuffer::CreateShared(execution_context_->arena, execution_context_->allocator, size, attr);
   if (buffer == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Failed to allocate buffer of size: %zu", size);
     return MEMALLOC_FAILED;
   }
 
-  tensor = TensorValue(shared_ptr<TensorBuffer>(buffer.release()));
+  tensor = TensorValue(std::move(buffer));
   return SUCCESS;
 }
 
@@ -283,6 +306,7 @@ Status TaskContext::AllocateWorkspace(size_t size, void **buffer, void *ori_addr
     *buffer = execution_context_->allocator->Allocate(size, nullptr);
   } else {
     AllocationAttr attr(ori_addr);
+    attr.SetStream(GetStream());
     *buffer = execution_context_->allocator->Allocate(size, &attr);
   }
 
@@ -340,6 +364,7 @@ void TaskContext::ReleaseInput(int index) {
   if (input_tensor != nullptr) {
     input_tensor->Destroy();
     GELOGD("[%s] Tensor of input[%d] released", GetNodeName(), index);
+    subgraph_context_->OnInputReleased(*node_item_, index);
   }
 }
 
@@ -97,7 +97,8 @@ class TaskContext {
   TaskContext(GraphExecutionContext *execution_context, const NodeItem *node_item, SubgraphContext *subgraph_context);
 
   static string TensorDesc2String(const GeTensorDesc &desc);
-  Status AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue &tensor, AllocationAttr *attr);
+  Status AllocateTensor(const GeTensorDesc &tensor_desc, TensorValue &tensor, AllocationAttr *attr,
+                        bool use_arena = true);
 
   const NodeItem *node_item_ = nullptr;
   bool force_infer_shape_ = false;
@@ -17,6 +17,8 @@
 #include "model/ge_model.h"
 #include <utility>
 #include "common/debug/log.h"
+#include "common/ge/ge_util.h"
+#include "framework/common/util.h"
 #include "graph/debug/ge_attr_define.h"
 #include "graph/utils/attr_utils.h"
 
@@ -39,13 +41,68 @@ GeModel::GeModel() {
 
 const Graph &GeModel::GetGraph() const { return this->graph_; }
 
-std::shared_ptr<domi::ModelTaskDef> GeModel::GetModelTaskDefPtr() const { return this->task_; }
+std::shared_ptr<domi::ModelTaskDef> GeModel::GetModelTaskDefPtr() const {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  if (task_data_.holder != nullptr) {
+    auto task = MakeShared<domi::ModelTaskDef>();
+    GE_CHK_BOOL_EXEC(task != nullptr, return nullptr, "Create task def failed.");
+    if (task_data_.size != 0 && !ReadProtoFromArray(task_data_.data, static_cast<int>(task_data_.size), task.get())) {
+      // the partition is kept, so the failure is reported to every caller
+      GELOGE(INTERNAL_ERROR, "Decode task partition of model %s failed, size:%zu.", name_.c_str(), task_data_.size);
+      return nullptr;
+    }
+    GELOGI("TASK_INFO op_size:%d, stream_num:%u", task->op_size(), task->stream_num());
+    task_ = task;
+    task_data_ = PartitionData();
+  }
+  return this->task_;
+}
+
+bool GeModel::HasModelTaskDef() const {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  return (task_ != nullptr) || (task_data_.holder != nullptr);
+}
+
+const TBEKernelStore &GeModel::GetTBEKernelStore() const {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  if (tbe_kernel_data_.holder != nullptr) {
+    if (tbe_kernal_store_.Load(tbe_kernel_data_.data, tbe_kernel_data_.size)) {
+      GELOGI("Load tbe kernels success, size:%zu", tbe_kernel_data_.size);
+    } else {
+      GELOGW("Load tbe kernels failed");
+    }
+    tbe_kernel_data_ = PartitionData();
+  }
+  return this->tbe_kernal_store_;
+}
+
+const CustAICPUKernelStore &GeModel::GetCustAICPUKernelStore() const {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  if (cust_aicpu_kernel_data_.holder != nullptr) {
+    if (cust_aicpu_kernal_store_.Load(cust_aicpu_kernel_data_.data, cust_aicpu_kernel_data_.size)) {
+      GELOGI("Load cust aicpu kernels success, size:%zu", cust_aicpu_kernel_data_.size);
+    } else {
+      GELOGW("Load cust aicpu kernels failed");
+    }
+    cust_aicpu_kernel_data_ = PartitionData();
+  }
+  return this->cust_aicpu_kernal_store_;
+}
 
-const TBEKernelStore &GeModel::GetTBEKernelStore() const { return this->tbe_kernal_store_; }
+Buffer GeModel::GetWeight() const {
+  if (weights_holder_ != nullptr) {
+    return Buffer::CopyFrom(weights_data_, weights_size_);
+  }
+  return this->weights_buffer_;
+}
 
-const CustAICPUKernelStore &GeModel::GetCustAICPUKernelStore() const { return this->cust_aicpu_kernal_store_; }
+const uint8_t *GeModel::GetWeightData() const {
+  return (weights_holder_ != nullptr) ? weights_data_ : weights_buffer_.GetData();
+}
 
-Buffer GeModel::GetWeight() const { return this->weights_buffer_; }
+size_t GeModel::GetWeightSize() const {
+  return (weights_holder_ != nullptr) ? weights_size_ : weights_buffer_.GetSize();
+}
 
 std::string GeModel::GetName() const { return this->name_; }
 
@@ -57,15 +114,62 @@ uint8_t GeModel::GetPlatformType() const { return this->platform_type_; }
 
 void GeModel::SetGraph(const Graph &graph) { this->graph_ = graph; }
 
-void GeModel::SetModelTaskDef(const std::shared_ptr<domi::ModelTaskDef> &task) { this->task_ = task; }
+void GeModel::SetModelTaskDef(const std::shared_ptr<domi::ModelTaskDef> &task) {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  this->task_ = task;
+  task_data_ = PartitionData();
+}
 
-void GeModel::SetTBEKernelStore(const TBEKernelStore &tbe_kernal_store) { this->tbe_kernal_store_ = tbe_kernal_store; }
+void GeModel::SetTBEKernelStore(const TBEKernelStore &tbe_kernal_store) {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  this->tbe_kernal_store_ = tbe_kernal_store;
+  tbe_kernel_data_ = PartitionData();
+}
 
 void GeModel::SetCustAICPUKernelStore(const CustAICPUKernelStore &cust_aicpu_kernal_store) {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
   this->cust_aicpu_kernal_store_ = cust_aicpu_kernal_store;
+  cust_aicpu_kernel_data_ = PartitionData();
 }
 
-void GeModel::SetWeight(const Buffer &weights_buffer) { this->weights_buffer_ = weights_buffer; }
+void GeModel::SetPartitionData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size,
+                               PartitionData &partition) {
+  partition.holder = holder;
+  partition.data = data;
+  partition.size = size;
+}
+
+void GeModel::SetModelTaskData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size) {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  task_ = nullptr;
+  SetPartitionData(holder, data, size, task_data_);
+}
+
+void GeModel::SetTBEKernelData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size) {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  tbe_kernal_store_ = TBEKernelStore();
+  SetPartitionData(holder, data, size, tbe_kernel_data_);
+}
+
+void GeModel::SetCustAICPUKernelData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size) {
+  std::lock_guard<std::mutex> lock(partition_mutex_);
+  cust_aicpu_kernal_store_ = CustAICPUKernelStore();
+  SetPartitionData(holder, data, size, cust_aicpu_kernel_data_);
+}
+
+void GeModel::SetWeight(const Buffer &weights_buffer) {
+  this->weights_buffer_ = weights_buffer;
+  weights_holder_.reset();
+  weights_data_ = nullptr;
+  weights_size_ = 0;
+}
+
+void GeModel::SetWeightData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size) {
+  weights_holder_ = holder;
+  weights_data_ = data;
+  weights_size_ = size;
+  this->weights_buffer_ = Buffer();
+}
 
 void GeModel::SetName(const std::string &name) { this->name_ = name; }
 
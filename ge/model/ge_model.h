@@ -20,6 +20,7 @@
 #include <securec.h>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "common/tbe_kernel_store.h"
 #include "common/cust_aicpu_kernel_store.h"
@@ -43,6 +44,8 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   const TBEKernelStore &GetTBEKernelStore() const;
   const CustAICPUKernelStore &GetCustAICPUKernelStore() const;
   Buffer GetWeight() const;
+  const uint8_t *GetWeightData() const;
+  size_t GetWeightSize() const;
 
   std::string GetName() const;
   uint32_t GetVersion() const;
@@ -53,7 +56,15 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   void SetModelTaskDef(const std::shared_ptr<domi::ModelTaskDef> &task);
   void SetTBEKernelStore(const TBEKernelStore &tbe_kernal_store);
   void SetCustAICPUKernelStore(const CustAICPUKernelStore &cust_aicpu_kernal_store);
+  // keep the serialized partitions owned by holder, each is decoded the first time it is got
+  void SetModelTaskData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size);
+  void SetTBEKernelData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size);
+  void SetCustAICPUKernelData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size);
+  // false if there is no task def, true also if the task partition is not decoded yet
+  bool HasModelTaskDef() const;
   void SetWeight(const Buffer &weights_buffer);
+  // use the weights owned by holder without copying them, e.g. the pages of a mapped model file
+  void SetWeightData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size);
 
   void SetName(const std::string &name);
   void SetVersion(uint32_t version);
@@ -75,15 +86,31 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeModel : public AttrHolder
   ConstProtoAttrMapHelper GetAttrMap() const override;
 
  private:
+  struct PartitionData {
+    std::shared_ptr<void> holder;
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+  };
+
   void Init();
+  static void SetPartitionData(const std::shared_ptr<void> &holder, const uint8_t *data, size_t size,
+                               PartitionData &partition);
 
   ProtoAttrMapHelper attrs_;
 
   Graph graph_;
-  std::shared_ptr<domi::ModelTaskDef> task_;
-  TBEKernelStore tbe_kernal_store_;
-  CustAICPUKernelStore cust_aicpu_kernal_store_;
+  // guards the decoding of the partitions below
+  mutable std::mutex partition_mutex_;
+  mutable std::shared_ptr<domi::ModelTaskDef> task_;
+  mutable PartitionData task_data_;
+  mutable TBEKernelStore tbe_kernal_store_;
+  mutable PartitionData tbe_kernel_data_;
+  mutable CustAICPUKernelStore cust_aicpu_kernal_store_;
+  mutable PartitionData cust_aicpu_kernel_data_;
   Buffer weights_buffer_;
+  std::shared_ptr<void> weights_holder_;
+  const uint8_t *weights_data_ = nullptr;
+  size_t weights_size_ = 0;
 
   std::string name_;
   uint32_t version_ = {0};
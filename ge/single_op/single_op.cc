@@ -24,6 +24,7 @@
 #include "graph/load/new_model_manager/model_utils.h"
 #include "runtime/mem.h"
 #include "single_op/single_op_manager.h"
+#include "single_op/single_op_sequence.h"
 #include "graph/load/new_model_manager/model_manager.h"
 
 namespace ge {
@@ -159,7 +160,22 @@ FMK_FUNC_HOST_VISIBILITY FMK_FUNC_DEV_VISIBILITY Status SingleOp::ExecuteAsync(c
   }
 
   std::lock_guard<std::mutex> lk(*stream_mutex_);
-  ret = UpdateArgs(inputs, outputs);
+  ret = DoExecuteAsync(inputs, outputs);
+  if (ret != SUCCESS) {
+    return ret;
+  }
+
+  if (stream_resource_ != nullptr) {
+    SingleOpSequence *sequence = stream_resource_->GetCapturingSequence();
+    if (sequence != nullptr) {
+      sequence->Record(this, inputs, outputs);
+    }
+  }
+  return SUCCESS;
+}
+
+Status SingleOp::DoExecuteAsync(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs) {
+  Status ret = UpdateArgs(inputs, outputs);
   if (ret != SUCCESS) {
     return ret;
   }
@@ -218,8 +234,8 @@ Status DynamicSingleOp::ValidateParams(const vector<GeTensorDesc> &input_desc, c
   return SUCCESS;
 }
 
-Status DynamicSingleOp::AllocateWorkspaces(const std::vector<int64_t> &workspace_sizes,
-                                           std::vector<void *> &workspaces) {
+Status DynamicSingleOp::AllocateWorkspaces(StreamResource &stream_resource, const std::vector<int64_t> &workspace_sizes,
+                                           uint8_t *&workspace_base, std::vector<void *> &workspaces) {
   static const std::string kPurpose("malloc workspace memory for dynamic op.");
   if (workspace_sizes.empty()) {
     GELOGD("No need to allocate workspace.");
@@ -235,15 +251,14 @@ Status DynamicSingleOp::AllocateWorkspaces(const std::vector<int64_t> &workspace
   }
 
   GELOGD("Total workspace size is %ld", total_size);
-  StreamResource *stream_resource = SingleOpManager::GetInstance().GetResource(resource_id_, stream_);
-  GE_CHECK_NOTNULL(stream_resource);
-  auto ws_base = stream_resource->MallocMemory(kPurpose, static_cast<size_t>(total_size));
+  auto ws_base = stream_resource.MallocWorkspace(kPurpose, static_cast<size_t>(total_size));
   if (ws_base == nullptr) {
     GELOGE(MEMALLOC_FAILED, "Failed to allocate memory of size: %ld", total_size);
     return MEMALLOC_FAILED;
   }
   GELOGD("Done allocating workspace memory successfully.");
 
+  workspace_base = ws_base;
   for (auto ws_offset : ws_offsets) {
     workspaces.emplace_back(ws_base + ws_offset);
   }
@@ -255,10 +270,19 @@ Status DynamicSingleOp::ExecuteTbeTask(const vector<GeTensorDesc> &input_desc, c
                                        vector<GeTensorDesc> &output_desc, vector<void *> &outputs) {
   GE_CHK_STATUS_RET_NOLOG(op_task_->UpdateRunInfo(input_desc, output_desc));
 
+  StreamResource *stream_resource = SingleOpManager::GetInstance().GetResource(resource_id_, stream_);
+  GE_CHECK_NOTNULL(stream_resource);
+  uint8_t *workspace_base = nullptr;
   std::vector<void *> workspace_buffers;
-  GE_CHK_STATUS_RET_NOLOG(AllocateWorkspaces(op_task_->GetWorkspaceSizes(), workspace_buffers));
+  GE_CHK_STATUS_RET_NOLOG(
+    AllocateWorkspaces(*stream_resource, op_task_->GetWorkspaceSizes(), workspace_base, workspace_buffers));
 
-  return op_task_->LaunchKernel(inputs, outputs, workspace_buffers, stream_);
+  auto ret = op_task_->LaunchKernel(inputs, outputs, workspace_buffers, stream_);
+  if (workspace_base != nullptr) {
+    // later launches on the stream run after this one, so they may use the workspace again
+    GE_CHK_STATUS_RET_NOLOG(stream_resource->FreeWorkspace(workspace_base));
+  }
+  return ret;
 }
 
 Status DynamicSingleOp::ExecuteAsync(const vector<GeTensorDesc> &input_desc, const vector<DataBuffer> &input_buffers,
@@ -266,7 +290,20 @@ Status DynamicSingleOp::ExecuteAsync(const vector<GeTensorDesc> &input_desc, con
   GE_CHECK_NOTNULL(op_task_);
   GE_CHK_STATUS_RET_NOLOG(ValidateParams(input_desc, input_buffers, output_desc, output_buffers));
   std::lock_guard<std::mutex> lk(*stream_mutex_);
+  SingleOpSequence *sequence = (stream_resource_ == nullptr) ? nullptr : stream_resource_->GetCapturingSequence();
+  if (sequence == nullptr) {
+    return DoExecuteAsync(input_desc, input_buffers, output_desc, output_buffers);
+  }
 
+  // the output desc may be updated by the execution, the recorded step starts from the given one
+  std::vector<GeTensorDesc> origin_output_desc = output_desc;
+  GE_CHK_STATUS_RET_NOLOG(DoExecuteAsync(input_desc, input_buffers, output_desc, output_buffers));
+  sequence->Record(this, input_desc, input_buffers, origin_output_desc, output_buffers);
+  return SUCCESS;
+}
+
+Status DynamicSingleOp::DoExecuteAsync(const vector<GeTensorDesc> &input_desc, const vector<DataBuffer> &input_buffers,
+                                       vector<GeTensorDesc> &output_desc, vector<DataBuffer> &output_buffers) {
   std::vector<void *> inputs;
   std::vector<void *> outputs;
   for (auto &buffer : input_buffers) {
@@ -288,4 +325,15 @@ Status DynamicSingleOp::ExecuteAsync(const vector<GeTensorDesc> &input_desc, con
 }
 
 void DynamicSingleOp::SetSessionID(uint64_t session_id) { aicpu_session_id_ = session_id; }
+
+Status DynamicSingleOp::GetTilingCacheStats(uint64_t &hit_count, uint64_t &miss_count) {
+  GE_CHECK_NOTNULL(op_task_);
+  hit_count = 0;
+  miss_count = 0;
+  std::lock_guard<std::mutex> lk(*stream_mutex_);
+  if (op_task_->GetOpTaskType() == OP_TASK_TBE) {
+    static_cast<TbeOpTask *>(op_task_.get())->GetTilingCacheStats(hit_count, miss_count);
+  }
+  return SUCCESS;
+}
 }  // namespace ge
@@ -30,6 +30,8 @@
 #include "cce/aicpu_engine_struct.h"
 
 namespace ge {
+class StreamResource;
+
 class SingleOp {
  public:
   SingleOp(std::mutex *stream_mutex, rtStream_t stream);
@@ -43,8 +45,12 @@ class SingleOp {
   Status ValidateArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
   Status UpdateArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
   Status GetArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
+  // called with the stream locked
+  Status DoExecuteAsync(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
 
   friend class SingleOpModel;
+  friend class SingleOpSequence;
+  friend class StreamResource;
   std::mutex *stream_mutex_;
   rtStream_t stream_ = nullptr;
   std::vector<void *> input_addr_list_;
@@ -56,6 +62,7 @@ class SingleOp {
 
   std::vector<OpTask *> tasks_;
   std::vector<std::vector<uintptr_t *>> arg_table_;
+  StreamResource *stream_resource_ = nullptr;
 };
 
 class DynamicSingleOp {
@@ -65,17 +72,25 @@ class DynamicSingleOp {
   Status ExecuteAsync(const vector<GeTensorDesc> &input_desc, const std::vector<DataBuffer> &inputs,
                       std::vector<GeTensorDesc> &output_desc, std::vector<DataBuffer> &outputs);
   void SetSessionID(uint64_t session_id);
+  Status GetTilingCacheStats(uint64_t &hit_count, uint64_t &miss_count);
 
  private:
   friend class SingleOpModel;
+  friend class SingleOpSequence;
+  friend class StreamResource;
   Status ValidateParams(const vector<GeTensorDesc> &input_desc, const std::vector<DataBuffer> &inputs,
                         std::vector<GeTensorDesc> &output_desc, std::vector<DataBuffer> &outputs) const;
 
-  Status AllocateWorkspaces(const std::vector<int64_t> &workspace_sizes, std::vector<void *> &workspaces);
+  Status AllocateWorkspaces(StreamResource &stream_resource, const std::vector<int64_t> &workspace_sizes,
+                            uint8_t *&workspace_base, std::vector<void *> &workspaces);
 
   Status ExecuteTbeTask(const vector<GeTensorDesc> &input_desc, const vector<void *> &inputs,
                         vector<GeTensorDesc> &output_desc, vector<void *> &outputs);
 
+  // called with the stream locked
+  Status DoExecuteAsync(const vector<GeTensorDesc> &input_desc, const std::vector<DataBuffer> &inputs,
+                        std::vector<GeTensorDesc> &output_desc, std::vector<DataBuffer> &outputs);
+
   std::unique_ptr<OpTask> op_task_;
   uintptr_t resource_id_ = 0;
   std::mutex *stream_mutex_;
@@ -83,6 +98,7 @@ class DynamicSingleOp {
   size_t num_inputs_ = 0;
   size_t num_outputs_ = 0;
   uint64_t aicpu_session_id_ = 0;
+  StreamResource *stream_resource_ = nullptr;
 };
 }  // namespace ge
 #endif  // GE_SINGLE_OP_SINGLE_OP_H_
@@ -121,6 +121,72 @@ Status SingleOpManager::GetDynamicOpFromModel(const string &model_name, const Mo
   return res->BuildDynamicOperator(model_name, model_data, single_op);
 }
 
+Status SingleOpManager::BeginCapture(void *stream) {
+  uintptr_t resource_id = 0;
+  GE_CHK_STATUS_RET(GetResourceId(stream, resource_id));
+  StreamResource *res = GetResource(resource_id, stream);
+  if (res == nullptr) {
+    GELOGE(MEMALLOC_FAILED, "GetResource failed");
+    return MEMALLOC_FAILED;
+  }
+
+  return res->BeginCapture();
+}
+
+Status SingleOpManager::EndCapture(void *stream, const std::vector<DataBuffer> &inputs,
+                                   const std::vector<DataBuffer> &outputs, SingleOpSequence **sequence) {
+  GE_CHECK_NOTNULL(sequence);
+  uintptr_t resource_id = 0;
+  GE_CHK_STATUS_RET(GetResourceId(stream, resource_id));
+  StreamResource *res = TryGetResource(resource_id);
+  if (res == nullptr) {
+    GELOGE(PARAM_INVALID, "Single ops on stream are not being captured.");
+    return PARAM_INVALID;
+  }
+
+  return res->EndCapture(inputs, outputs, sequence);
+}
+
+Status SingleOpManager::DestroySequence(void *stream, SingleOpSequence *sequence) {
+  GE_CHECK_NOTNULL(sequence);
+  uintptr_t resource_id = 0;
+  GE_CHK_STATUS_RET(GetResourceId(stream, resource_id));
+  StreamResource *res = TryGetResource(resource_id);
+  if (res == nullptr) {
+    GELOGE(PARAM_INVALID, "No single op resource on stream, resource id = %lu", resource_id);
+    return PARAM_INVALID;
+  }
+
+  return res->DestroySequence(sequence);
+}
+
+Status SingleOpManager::TrimMemory(void *stream, size_t high_water_mark) {
+  uintptr_t resource_id = 0;
+  GE_CHK_STATUS_RET(GetResourceId(stream, resource_id));
+  StreamResource *res = GetResource(resource_id, stream);
+  if (res == nullptr) {
+    GELOGE(MEMALLOC_FAILED, "GetResource failed");
+    return MEMALLOC_FAILED;
+  }
+
+  res->TrimMemory(high_water_mark);
+  return SUCCESS;
+}
+
+Status SingleOpManager::GetMemoryStats(void *stream, StreamMemoryPoolStats &stats) {
+  uintptr_t resource_id = 0;
+  GE_CHK_STATUS_RET(GetResourceId(stream, resource_id));
+  StreamResource *res = TryGetResource(resource_id);
+  if (res == nullptr) {
+    GELOGD("No single op resource on stream, resource id = %lu", resource_id);
+    stats = StreamMemoryPoolStats();
+    return SUCCESS;
+  }
+
+  stats = res->GetMemoryStats();
+  return SUCCESS;
+}
+
 void SingleOpManager::RegisterTilingFunc() {
   std::lock_guard<std::mutex> lk(mutex_);
   if (tiling_func_registered_) {
@@ -22,6 +22,7 @@
 #include <string>
 #include "common/ge/op_tiling_manager.h"
 #include "single_op/single_op_model.h"
+#include "single_op/weight_store.h"
 #include "single_op/stream_resource.h"
 
 namespace ge {
@@ -44,8 +45,21 @@ class SingleOpManager {
 
   Status ReleaseResource(void *stream);
 
+  Status BeginCapture(void *stream);
+
+  Status EndCapture(void *stream, const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs,
+                    SingleOpSequence **sequence);
+
+  Status DestroySequence(void *stream, SingleOpSequence *sequence);
+
+  Status TrimMemory(void *stream, size_t high_water_mark);
+
+  Status GetMemoryStats(void *stream, StreamMemoryPoolStats &stats);
+
   void RegisterTilingFunc();
 
+  WeightStore &GetWeightStore() { return weight_store_; }
+
  private:
   static Status GetResourceId(rtStream_t stream, uintptr_t &resource_id);
 
@@ -55,6 +69,8 @@ class SingleOpManager {
   bool tiling_func_registered_ = false;
   std::unordered_map<uintptr_t, StreamResource *> stream_resources_;
   OpTilingManager op_tiling_manager_;
+  // shared by the models of all streams, they release their weights in the destructor body before it is destroyed
+  WeightStore weight_store_;
 };
 }  // namespace ge
 
@@ -100,16 +100,14 @@ Status SingleOpModel::InitModelMem(StreamResource &res) {
 
   if (model_params_.weight_size > 0 && has_weight_) {
     const string purpose("malloc weights memory on model execute.");
-    model_params_.weight_base = res.MallocWeight(purpose, model_params_.weight_size);
+    auto ge_model = model_helper_.GetGeModel();
+    GE_CHECK_NOTNULL(ge_model);
+    model_params_.weight_base =
+      res.LoadWeight(purpose, model_params_.weight_size, ge_model->GetWeightData(), ge_model->GetWeightSize());
     if (model_params_.weight_base == nullptr) {
       // no need to free memory, for that was handled by StreamResources
       return RT_FAILED;
     }
-
-    auto weight_buffer = model_helper_.GetGeModel()->GetWeight();
-    GELOGI("To copy weight to device. weight size = %zu", weight_buffer.GetSize());
-    GE_CHK_RT_RET(rtMemcpy(model_params_.weight_base, model_params_.weight_size, weight_buffer.GetData(),
-                           weight_buffer.GetSize(), RT_MEMCPY_HOST_TO_DEVICE));
   }
 
   return SUCCESS;
@@ -223,7 +221,9 @@ Status SingleOpModel::SetInputsAndOutputs(SingleOp &single_op) {
 Status SingleOpModel::BuildTaskList(SingleOp &single_op) {
   auto ge_model = model_helper_.GetGeModel();
   GE_CHECK_NOTNULL(ge_model);
-  auto tasks = ge_model->GetModelTaskDefPtr()->task();
+  auto model_task_def = ge_model->GetModelTaskDefPtr();
+  GE_CHECK_NOTNULL(model_task_def);
+  auto tasks = model_task_def->task();
   for (int i = 0; i < tasks.size(); ++i) {
     const TaskDef &task_def = tasks[i];
     GELOGI("[%s] Task[%d], type = %u, DebugString = %s", model_name_.c_str(), i, task_def.type(),
@@ -404,7 +404,9 @@ Status SingleOpModel::BuildTaskListForDynamicOp(DynamicSingleOp &single_op) {
   auto ge_model = model_helper_.GetGeModel();
   GE_CHECK_NOTNULL(ge_model);
 
-  auto tasks = ge_model->GetModelTaskDefPtr()->task();
+  auto model_task_def = ge_model->GetModelTaskDefPtr();
+  GE_CHECK_NOTNULL(model_task_def);
+  auto tasks = model_task_def->task();
   for (int i = 0; i < tasks.size(); ++i) {
     const TaskDef &task_def = tasks[i];
     GELOGI("[%s] Task[%d], type = %u, DebugString = %s", model_name_.c_str(), i, task_def.type(),
@@ -0,0 +1,297 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "single_op/single_op_sequence.h"
+
+#include <algorithm>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "runtime/rt.h"
+#include "securec.h"
+#include "single_op/single_op.h"
+#include "single_op/stream_resource.h"
+
+namespace ge {
+namespace {
+const size_t kDataMemAlignSize = 32;
+
+size_t GetAlignedSize(size_t size) {
+  size_t aligned_size = (size + 2 * kDataMemAlignSize - 1) / kDataMemAlignSize * kDataMemAlignSize;
+  return aligned_size;
+}
+}  // namespace
+
+SingleOpSequence::SingleOpSequence(StreamResource *stream_resource, std::mutex *stream_mutex, rtStream_t stream)
+    : stream_resource_(stream_resource), stream_mutex_(stream_mutex), stream_(stream) {}
+
+SingleOpSequence::~SingleOpSequence() {
+  // launches of the sequence are in order with the later ones on the stream, the blocks can be reused at once
+  for (auto buffer : intermediate_buffers_) {
+    auto ret = stream_resource_->FreeWorkspace(buffer);
+    GE_IF_BOOL_EXEC(ret != SUCCESS, GELOGE(ret, "Failed to free intermediate memory of single op sequence."));
+  }
+}
+
+void SingleOpSequence::Record(SingleOp *op, const std::vector<DataBuffer> &inputs,
+                              const std::vector<DataBuffer> &outputs) {
+  Step step;
+  step.op = op;
+  step.inputs = inputs;
+  step.outputs = outputs;
+  steps_.emplace_back(std::move(step));
+}
+
+void SingleOpSequence::Record(DynamicSingleOp *op, const std::vector<GeTensorDesc> &input_desc,
+                              const std::vector<DataBuffer> &inputs, const std::vector<GeTensorDesc> &output_desc,
+                              const std::vector<DataBuffer> &outputs) {
+  Step step;
+  step.dynamic_op = op;
+  step.input_desc = input_desc;
+  step.output_desc = output_desc;
+  step.inputs = inputs;
+  step.outputs = outputs;
+  steps_.emplace_back(std::move(step));
+}
+
+Status SingleOpSequence::Finalize(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs) {
+  if (steps_.empty()) {
+    GELOGE(PARAM_INVALID, "No single op was executed while capturing.");
+    return PARAM_INVALID;
+  }
+
+  BufferMap buffers;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    input_sizes_.emplace_back(inputs[i].length);
+    (void)buffers.emplace(inputs[i].data, std::make_pair(kExternalInput, i));
+  }
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    output_sizes_.emplace_back(outputs[i].length);
+    (void)buffers.emplace(outputs[i].data, std::make_pair(kExternalOutput, i));
+  }
+
+  // outputs of the ops which are not external are only used inside of the sequence
+  std::vector<uint64_t> intermediate_sizes;
+  for (const auto &step : steps_) {
+    for (const auto &output : step.outputs) {
+      if (output.data == nullptr) {
+        continue;
+      }
+      auto ret = buffers.emplace(output.data, std::make_pair(kIntermediate, intermediate_sizes.size()));
+      if (ret.second) {
+        intermediate_sizes.emplace_back(0);
+      }
+    }
+  }
+  for (const auto &step : steps_) {
+    for (const auto *buffer_list : {&step.inputs, &step.outputs}) {
+      for (const auto &buffer : *buffer_list) {
+        auto iter = buffers.find(buffer.data);
+        if (iter != buffers.end() && iter->second.first == kIntermediate) {
+          auto &size = intermediate_sizes[iter->second.second];
+          size = std::max(size, buffer.length);
+        }
+      }
+    }
+  }
+  GE_CHK_STATUS_RET_NOLOG(AllocateIntermediates(intermediate_sizes));
+
+  for (auto &step : steps_) {
+    ResolveStep(buffers, step);
+    GE_CHK_STATUS_RET_NOLOG(BuildTaskArgs(step));
+  }
+  finalized_ = true;
+  return SUCCESS;
+}
+
+Status SingleOpSequence::AllocateIntermediates(const std::vector<uint64_t> &sizes) {
+  GE_CHECK_NOTNULL(stream_resource_);
+  for (auto size : sizes) {
+    size_t aligned_size = GetAlignedSize(size);
+    uint8_t *buffer = stream_resource_->MallocWorkspace("intermediate memory of single op sequence", aligned_size);
+    if (buffer == nullptr) {
+      GELOGE(MEMALLOC_FAILED, "Failed to malloc intermediate memory, size = %zu", aligned_size);
+      return MEMALLOC_FAILED;
+    }
+    intermediate_buffers_.emplace_back(buffer);
+  }
+  return SUCCESS;
+}
+
+void SingleOpSequence::ResolveStep(const BufferMap &buffers, Step &step) {
+  size_t arg_index = 0;
+  for (auto *buffer_list : {&step.inputs, &step.outputs}) {
+    for (auto &buffer : *buffer_list) {
+      auto iter = buffers.find(buffer.data);
+      if (iter != buffers.end()) {
+        if (iter->second.first == kIntermediate) {
+          buffer.data = intermediate_buffers_[iter->second.second];
+        } else {
+          step.external_args.push_back({arg_index, iter->second.first, iter->second.second});
+        }
+      }
+      step.io_addrs.emplace_back(reinterpret_cast<uintptr_t>(buffer.data));
+      ++arg_index;
+    }
+  }
+}
+
+Status SingleOpSequence::BuildTaskArgs(Step &step) {
+  if (step.op == nullptr || step.op->tasks_.empty()) {
+    return SUCCESS;
+  }
+  // io addresses of aicpu tasks are copied to device on every launch, such ops are launched by themselves
+  for (auto task : step.op->tasks_) {
+    if (task->GetOpTaskType() != OP_TASK_TBE) {
+      return SUCCESS;
+    }
+  }
+  if (step.op->arg_table_.size() != step.io_addrs.size()) {
+    GELOGE(INTERNAL_ERROR, "Arg num mismatch. op has %zu args, but recorded %zu", step.op->arg_table_.size(),
+           step.io_addrs.size());
+    return INTERNAL_ERROR;
+  }
+
+  for (auto task : step.op->tasks_) {
+    auto tbe_task = static_cast<TbeOpTask *>(task);
+    auto args = static_cast<const uint8_t *>(tbe_task->GetArgs());
+    GE_CHECK_NOTNULL(args);
+    step.task_args.emplace_back(args, args + tbe_task->GetArgSize());
+  }
+
+  std::vector<bool> is_external(step.io_addrs.size(), false);
+  for (const auto &external_arg : step.external_args) {
+    is_external[external_arg.arg_index] = true;
+  }
+  for (size_t arg_index = 0; arg_index < step.io_addrs.size(); ++arg_index) {
+    for (uintptr_t *arg_addr : step.op->arg_table_[arg_index]) {
+      // arg_table_ points into the kernel args of the tasks, find the task and the offset in them
+      auto addr = reinterpret_cast<const uint8_t *>(arg_addr);
+      const uint8_t *task_begin = nullptr;
+      size_t task_index = 0;
+      for (; task_index < step.op->tasks_.size(); ++task_index) {
+        auto tbe_task = static_cast<TbeOpTask *>(step.op->tasks_[task_index]);
+        task_begin = static_cast<const uint8_t *>(tbe_task->GetArgs());
+        if (addr >= task_begin && addr + sizeof(uintptr_t) <= task_begin + tbe_task->GetArgSize()) {
+          break;
+        }
+      }
+      if (task_index == step.op->tasks_.size()) {
+        GELOGE(INTERNAL_ERROR, "Address of arg[%zu] is not in the args of any task.", arg_index);
+        return INTERNAL_ERROR;
+      }
+
+      auto &task_args = step.task_args[task_index];
+      size_t offset = static_cast<size_t>(addr - task_begin);
+      if (memcpy_s(&task_args[offset], task_args.size() - offset, &step.io_addrs[arg_index], sizeof(uintptr_t)) !=
+          EOK) {
+        GELOGE(INTERNAL_ERROR, "memcpy_s arg[%zu] failed, offset = %zu", arg_index, offset);
+        return INTERNAL_ERROR;
+      }
+      if (is_external[arg_index]) {
+        step.arg_patches.push_back({task_index, offset, arg_index});
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+Status SingleOpSequence::ValidateArgs(const std::vector<DataBuffer> &inputs,
+                                      const std::vector<DataBuffer> &outputs) const {
+  if (inputs.size() != input_sizes_.size()) {
+    GELOGE(PARAM_INVALID, "Input num mismatch. sequence expect %zu, but given %zu", input_sizes_.size(),
+           inputs.size());
+    return PARAM_INVALID;
+  }
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i].length < input_sizes_[i]) {
+      GELOGE(PARAM_INVALID, "Input size mismatch. index = %zu, sequence expect %lu, but given %lu", i,
+             input_sizes_[i], inputs[i].length);
+      return PARAM_INVALID;
+    }
+  }
+
+  if (outputs.size() != output_sizes_.size()) {
+    GELOGE(PARAM_INVALID, "Output num mismatch. sequence expect %zu, but given %zu", output_sizes_.size(),
+           outputs.size());
+    return PARAM_INVALID;
+  }
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i].length < output_sizes_[i]) {
+      GELOGE(PARAM_INVALID, "Output size mismatch. index = %zu, sequence expect %lu, but given %lu", i,
+             output_sizes_[i], outputs[i].length);
+      return PARAM_INVALID;
+    }
+  }
+  return SUCCESS;
+}
+
+Status SingleOpSequence::LaunchStep(Step &step, const std::vector<DataBuffer> &inputs,
+                                    const std::vector<DataBuffer> &outputs) {
+  for (const auto &external_arg : step.external_args) {
+    const auto &buffer = (external_arg.kind == kExternalInput) ? inputs[external_arg.external_index]
+                                                                 : outputs[external_arg.external_index];
+    step.io_addrs[external_arg.arg_index] = reinterpret_cast<uintptr_t>(buffer.data);
+    if (external_arg.arg_index < step.inputs.size()) {
+      step.inputs[external_arg.arg_index].data = buffer.data;
+    } else {
+      step.outputs[external_arg.arg_index - step.inputs.size()].data = buffer.data;
+    }
+  }
+
+  if (step.task_args.empty()) {
+    if (step.op != nullptr) {
+      return step.op->DoExecuteAsync(step.inputs, step.outputs);
+    }
+    // the op updates the output descs it is given, keep the recorded ones for the next replay
+    std::vector<GeTensorDesc> output_desc = step.output_desc;
+    return step.dynamic_op->DoExecuteAsync(step.input_desc, step.inputs, output_desc, step.outputs);
+  }
+
+  for (const auto &arg_patch : step.arg_patches) {
+    auto &task_args = step.task_args[arg_patch.task_index];
+    if (memcpy_s(&task_args[arg_patch.offset], task_args.size() - arg_patch.offset, &step.io_addrs[arg_patch.arg_index],
+                 sizeof(uintptr_t)) != EOK) {
+      GELOGE(INTERNAL_ERROR, "memcpy_s arg[%zu] failed, offset = %zu", arg_patch.arg_index, arg_patch.offset);
+      return INTERNAL_ERROR;
+    }
+  }
+  for (size_t i = 0; i < step.task_args.size(); ++i) {
+    auto task = static_cast<TbeOpTask *>(step.op->tasks_[i]);
+    GE_CHK_STATUS_RET_NOLOG(task->LaunchKernelWithArgs(step.task_args[i].data(), step.task_args[i].size(), stream_));
+    GE_CHK_STATUS_RET(task->OpenDump(step.io_addrs, stream_), "Open dump failed");
+  }
+  return SUCCESS;
+}
+
+Status SingleOpSequence::ExecuteAsync(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs) {
+  if (!finalized_) {
+    GELOGE(PARAM_INVALID, "Single op sequence is not finalized.");
+    return PARAM_INVALID;
+  }
+  GE_CHK_STATUS_RET_NOLOG(ValidateArgs(inputs, outputs));
+
+  std::lock_guard<std::mutex> lk(*stream_mutex_);
+  for (size_t i = 0; i < steps_.size(); ++i) {
+    auto ret = LaunchStep(steps_[i], inputs, outputs);
+    if (ret != SUCCESS) {
+      GELOGE(ret, "Failed to launch step[%zu] of single op sequence.", i);
+      return ret;
+    }
+  }
+  return SUCCESS;
+}
+}  // namespace ge
@@ -0,0 +1,114 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_SINGLE_OP_SINGLE_OP_SEQUENCE_H_
+#define GE_SINGLE_OP_SINGLE_OP_SEQUENCE_H_
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/ge_inner_error_codes.h"
+#include "common/ge_types.h"
+#include "graph/ge_tensor.h"
+#include "runtime/stream.h"
+
+namespace ge {
+class SingleOp;
+class DynamicSingleOp;
+class StreamResource;
+
+///
+/// Executions of single ops on one stream, recorded between StreamResource::BeginCapture and EndCapture,
+/// and replayed as a whole with other external inputs and outputs.
+/// Buffers are matched by address: the ones given to EndCapture are external, the other outputs of the recorded
+/// ops are intermediate and get buffers of the sequence, the rest, such as constants, are kept as they are.
+/// The intermediate buffers are taken from the memory pool of the stream and given back when the sequence is destroyed.
+///
+class SingleOpSequence {
+ public:
+  SingleOpSequence(StreamResource *stream_resource, std::mutex *stream_mutex, rtStream_t stream);
+  ~SingleOpSequence();
+
+  SingleOpSequence(const SingleOpSequence &) = delete;
+  SingleOpSequence &operator=(const SingleOpSequence &) = delete;
+
+  Status ExecuteAsync(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
+
+  // called by the ops with the stream locked
+  void Record(SingleOp *op, const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
+  void Record(DynamicSingleOp *op, const std::vector<GeTensorDesc> &input_desc, const std::vector<DataBuffer> &inputs,
+              const std::vector<GeTensorDesc> &output_desc, const std::vector<DataBuffer> &outputs);
+
+  // resolve the recorded buffers and allocate the intermediate ones, called once at the end of capture
+  Status Finalize(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
+
+  size_t GetStepNum() const { return steps_.size(); }
+  size_t GetIntermediateNum() const { return intermediate_buffers_.size(); }
+
+ private:
+  enum BufferKind { kExternalInput, kExternalOutput, kIntermediate };
+
+  struct ExternalArg {
+    size_t arg_index;  // index in inputs + outputs of the op
+    BufferKind kind;
+    size_t external_index;
+  };
+
+  // position of an arg of the op in the kernel args of one of its tasks
+  struct ArgPatch {
+    size_t task_index;
+    size_t offset;
+    size_t arg_index;
+  };
+
+  struct Step {
+    SingleOp *op = nullptr;
+    DynamicSingleOp *dynamic_op = nullptr;
+    std::vector<GeTensorDesc> input_desc;
+    std::vector<GeTensorDesc> output_desc;
+    std::vector<DataBuffer> inputs;
+    std::vector<DataBuffer> outputs;
+    std::vector<ExternalArg> external_args;
+    // resolved inputs and outputs of the op
+    std::vector<uintptr_t> io_addrs;
+    // kernel args of every task when all tasks of op are TBE tasks, only external args are patched on replay
+    std::vector<std::vector<uint8_t>> task_args;
+    std::vector<ArgPatch> arg_patches;
+  };
+
+  // address recorded at capture to kind and index of the buffer
+  using BufferMap = std::unordered_map<const void *, std::pair<BufferKind, size_t>>;
+
+  Status ValidateArgs(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs) const;
+  Status AllocateIntermediates(const std::vector<uint64_t> &sizes);
+  void ResolveStep(const BufferMap &buffers, Step &step);
+  Status BuildTaskArgs(Step &step);
+  Status LaunchStep(Step &step, const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs);
+
+  StreamResource *stream_resource_;
+  std::mutex *stream_mutex_;
+  rtStream_t stream_ = nullptr;
+  bool finalized_ = false;
+  std::vector<Step> steps_;
+  std::vector<uint64_t> input_sizes_;
+  std::vector<uint64_t> output_sizes_;
+  std::vector<uint8_t *> intermediate_buffers_;
+};
+}  // namespace ge
+#endif  // GE_SINGLE_OP_SINGLE_OP_SEQUENCE_H_
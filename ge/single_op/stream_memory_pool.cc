@@ -0,0 +1,158 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "single_op/stream_memory_pool.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "runtime/rt.h"
+
+namespace ge {
+namespace {
+const size_t kMinBlockSize = 512;
+// smaller blocks are rounded up to a power of 2, larger ones to a multiple of it
+const size_t kLargeBlockSize = 2 * 1024 * 1024;
+// a free block is handed out for requests down to half of its size
+const size_t kMaxReuseRatio = 2;
+}  // namespace
+
+StreamMemoryPool::~StreamMemoryPool() {
+  for (auto &free_blocks : free_blocks_) {
+    for (auto block : free_blocks.second) {
+      auto rt_ret = rtFree(block);
+      GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+    }
+  }
+  for (auto &in_use_block : in_use_blocks_) {
+    auto rt_ret = rtFree(in_use_block.first);
+    GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+  }
+}
+
+size_t StreamMemoryPool::GetBlockSize(size_t size) {
+  if (size >= kLargeBlockSize) {
+    return (size + kLargeBlockSize - 1) / kLargeBlockSize * kLargeBlockSize;
+  }
+  size_t block_size = kMinBlockSize;
+  while (block_size < size) {
+    block_size <<= 1;
+  }
+  return block_size;
+}
+
+uint8_t *StreamMemoryPool::Malloc(const std::string &purpose, size_t size) {
+  size_t block_size = GetBlockSize(size);
+  uint8_t *block = nullptr;
+  auto it = free_blocks_.lower_bound(block_size);
+  if (it != free_blocks_.end() && it->first / kMaxReuseRatio <= block_size) {
+    block_size = it->first;
+    block = it->second.back();
+    it->second.pop_back();
+    if (it->second.empty()) {
+      free_blocks_.erase(it);
+    }
+    ++stats_.reuse_num;
+    GELOGD("Reuse memory block, size = %zu, block size = %zu", size, block_size);
+  } else {
+    auto ret = rtMalloc(reinterpret_cast<void **>(&block), block_size, memory_type_);
+    if (ret != RT_ERROR_NONE && !free_blocks_.empty()) {
+      GELOGW("rtMalloc failed, size = %zu, ret = %d, retry after releasing free blocks", block_size, ret);
+      ReleaseFreeBlocks(0);
+      ret = rtMalloc(reinterpret_cast<void **>(&block), block_size, memory_type_);
+    }
+    if (ret != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "rtMalloc failed, size = %zu, ret = %d", block_size, ret);
+      return nullptr;
+    }
+    GE_PRINT_DYNAMIC_MEMORY(rtMalloc, purpose.c_str(), block_size)
+
+    ret = rtMemset(block, block_size, 0U, block_size);
+    if (ret != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "rtMemset failed, ret = %d", ret);
+      auto rt_ret = rtFree(block);
+      GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+      return nullptr;
+    }
+    stats_.cached_size += block_size;
+    GELOGD("Malloc new memory block succeeded. size = %zu, block size = %zu", size, block_size);
+  }
+
+  in_use_blocks_[block] = block_size;
+  ++stats_.malloc_num;
+  stats_.in_use_size += block_size;
+  stats_.in_use_peak_size = std::max(stats_.in_use_peak_size, stats_.in_use_size);
+  return block;
+}
+
+Status StreamMemoryPool::Free(uint8_t *memory_addr) {
+  auto it = in_use_blocks_.find(memory_addr);
+  if (it == in_use_blocks_.end()) {
+    GELOGE(PARAM_INVALID, "Memory %p was not allocated by the pool.", memory_addr);
+    return PARAM_INVALID;
+  }
+
+  size_t block_size = it->second;
+  in_use_blocks_.erase(it);
+  free_blocks_[block_size].emplace_back(memory_addr);
+  has_unsynced_free_ = true;
+  ++stats_.free_num;
+  stats_.in_use_size -= block_size;
+  // while the blocks in use alone are above the mark, releasing the free ones can not reach it and would
+  // synchronize the stream on every free, trim once in use drops to the mark, one synchronization covers all frees
+  if (high_water_mark_ > 0 && stats_.cached_size > high_water_mark_ && stats_.in_use_size <= high_water_mark_) {
+    ReleaseFreeBlocks(high_water_mark_);
+  }
+  return SUCCESS;
+}
+
+void StreamMemoryPool::Trim(size_t high_water_mark) {
+  high_water_mark_ = high_water_mark;
+  ReleaseFreeBlocks(high_water_mark);
+}
+
+void StreamMemoryPool::ReleaseFreeBlocks(size_t high_water_mark) {
+  if (free_blocks_.empty() || stats_.cached_size <= high_water_mark) {
+    return;
+  }
+  if (has_unsynced_free_) {
+    auto rt_ret = rtStreamSynchronize(stream_);
+    if (rt_ret != RT_ERROR_NONE) {
+      GELOGE(RT_FAILED, "rtStreamSynchronize failed, ret = %d, free blocks are kept", rt_ret);
+      return;
+    }
+    has_unsynced_free_ = false;
+    ++stats_.sync_num;
+  }
+  while (!free_blocks_.empty() && stats_.cached_size > high_water_mark) {
+    auto it = std::prev(free_blocks_.end());
+    uint8_t *block = it->second.back();
+    size_t block_size = it->first;
+    it->second.pop_back();
+    if (it->second.empty()) {
+      free_blocks_.erase(it);
+    }
+
+    auto rt_ret = rtFree(block);
+    GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+    stats_.cached_size -= block_size;
+    ++stats_.release_num;
+  }
+  GELOGD("Released free memory blocks, cached size = %zu, high water mark = %zu", stats_.cached_size, high_water_mark);
+}
+}  // namespace ge
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_SINGLE_OP_STREAM_MEMORY_POOL_H_
+#define GE_SINGLE_OP_STREAM_MEMORY_POOL_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/ge_inner_error_codes.h"
+#include "runtime/mem.h"
+#include "runtime/stream.h"
+
+namespace ge {
+struct StreamMemoryPoolStats {
+  uint64_t malloc_num = 0;  // blocks handed out
+  uint64_t reuse_num = 0;   // blocks handed out from the free lists
+  uint64_t free_num = 0;
+  uint64_t release_num = 0;  // blocks given back to runtime by trimming
+  uint64_t sync_num = 0;     // stream synchronizations before giving blocks back
+  size_t cached_size = 0;    // size of all blocks held by the pool, in use or free
+  size_t in_use_size = 0;
+  size_t in_use_peak_size = 0;
+};
+
+///
+/// Device memory of one stream, free blocks are kept in lists by size class.
+/// A block freed after a launch can be handed out again at once: launches on the same stream are executed in order,
+/// so the next owner only touches it after the previous one is done.
+/// Giving a block back to runtime is different, the stream is synchronized first if a block was freed since the last
+/// synchronization, as the launch it was freed after may still be running.
+/// Not thread safe, StreamResource serializes the calls.
+///
+class StreamMemoryPool {
+ public:
+  explicit StreamMemoryPool(rtStream_t stream = nullptr, rtMemType_t memory_type = RT_MEMORY_HBM)
+      : stream_(stream), memory_type_(memory_type) {}
+  ~StreamMemoryPool();
+
+  void SetStream(rtStream_t stream) { stream_ = stream; }
+
+  StreamMemoryPool(const StreamMemoryPool &) = delete;
+  StreamMemoryPool &operator=(const StreamMemoryPool &) = delete;
+
+  uint8_t *Malloc(const std::string &purpose, size_t size);
+  Status Free(uint8_t *memory_addr);
+
+  ///
+  /// @brief give free blocks back to runtime, the largest first, until the cached size is not above high_water_mark.
+  /// Later frees trim the pool again whenever it grows beyond the mark, unless the mark is 0. The trimming is put off
+  /// while the blocks in use are above the mark, until a free brings them down to it.
+  ///
+  void Trim(size_t high_water_mark);
+
+  const StreamMemoryPoolStats &GetStats() const { return stats_; }
+
+  static size_t GetBlockSize(size_t size);
+
+ private:
+  void ReleaseFreeBlocks(size_t high_water_mark);
+
+  rtStream_t stream_;
+  rtMemType_t memory_type_;
+  // a block was freed after the last stream synchronization, it may still be used by a running launch
+  bool has_unsynced_free_ = false;
+  size_t high_water_mark_ = 0;
+  // block size to free blocks of the size
+  std::map<size_t, std::vector<uint8_t *>> free_blocks_;
+  std::unordered_map<uint8_t *, size_t> in_use_blocks_;
+  StreamMemoryPoolStats stats_;
+};
+}  // namespace ge
+
+#endif  // GE_SINGLE_OP_STREAM_MEMORY_POOL_H_
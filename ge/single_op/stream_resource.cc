@@ -16,27 +16,20 @@
 
 #include "single_op/stream_resource.h"
 
+#include <algorithm>
+
 #include "framework/common/debug/ge_log.h"
 #include "framework/common/debug/log.h"
 #include "runtime/rt.h"
+#include "single_op/single_op_manager.h"
 #include "single_op/single_op_model.h"
 
 namespace ge {
 StreamResource::StreamResource(uintptr_t resource_id) : resource_id_(resource_id) {}
 
 StreamResource::~StreamResource() {
-  for (auto mem : memory_list_) {
-    if (mem != nullptr) {
-      auto rt_ret = rtFree(mem);
-      GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
-    }
-  }
-
   for (auto weight : weight_list_) {
-    if (weight != nullptr) {
-      auto rt_ret = rtFree(weight);
-      GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
-    }
+    SingleOpManager::GetInstance().GetWeightStore().Release(weight);
   }
 }
 
@@ -60,53 +53,61 @@ DynamicSingleOp *StreamResource::GetDynamicOperator(const void *key) {
   return it->second.get();
 }
 
-void StreamResource::SetStream(rtStream_t stream) { stream_ = stream; }
+void StreamResource::SetStream(rtStream_t stream) {
+  stream_ = stream;
+  std::lock_guard<std::mutex> lk(memory_mu_);
+  memory_pool_.SetStream(stream);
+}
 
-uint8_t *StreamResource::DoMallocMemory(const std::string &purpose, size_t size, size_t &max_allocated,
-                                        std::vector<uint8_t *> &allocated) {
-  if (size <= max_allocated && !allocated.empty()) {
+uint8_t *StreamResource::MallocMemory(const std::string &purpose, size_t size) {
+  GELOGD("To Malloc memory, size = %zu", size);
+  std::lock_guard<std::mutex> lk(memory_mu_);
+  if (size <= max_memory_size_ && shared_memory_ != nullptr) {
     GELOGD("reuse last memory");
-    return allocated.back();
+    return shared_memory_;
   }
 
-  uint8_t *buffer = nullptr;
-  auto ret = rtMalloc(reinterpret_cast<void **>(&buffer), size, RT_MEMORY_HBM);
-  if (ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "rtMalloc failed, size = %zu, ret = %d", size, ret);
+  // the smaller memory is still used by the ops built before, it is never given back to the pool
+  uint8_t *buffer = memory_pool_.Malloc(purpose, size);
+  if (buffer == nullptr) {
     return nullptr;
   }
-  GE_PRINT_DYNAMIC_MEMORY(rtMalloc, purpose.c_str(), size)
+  max_memory_size_ = size;
+  shared_memory_ = buffer;
+  return buffer;
+}
 
-  ret = rtMemset(buffer, size, 0U, size);
-  if (ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "rtMemset failed, ret = %d", ret);
-    auto rt_ret = rtFree(buffer);
-    GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
-    return nullptr;
-  }
+uint8_t *StreamResource::MallocWorkspace(const std::string &purpose, size_t size) {
+  GELOGD("To Malloc workspace, size = %zu", size);
+  std::lock_guard<std::mutex> lk(memory_mu_);
+  return memory_pool_.Malloc(purpose, size);
+}
 
-  GELOGD("Malloc new memory succeeded. size = %zu", size);
-  max_allocated = size;
-  allocated.emplace_back(buffer);
-  return buffer;
+Status StreamResource::FreeWorkspace(uint8_t *workspace) {
+  std::lock_guard<std::mutex> lk(memory_mu_);
+  return memory_pool_.Free(workspace);
 }
 
-uint8_t *StreamResource::MallocMemory(const std::string &purpose, size_t size) {
-  GELOGD("To Malloc memory, size = %zu", size);
-  uint8_t *buffer = DoMallocMemory(purpose, size, max_memory_size_, memory_list_);
-  return buffer;
+void StreamResource::TrimMemory(size_t high_water_mark) {
+  std::lock_guard<std::mutex> lk(memory_mu_);
+  memory_pool_.Trim(high_water_mark);
+}
+
+StreamMemoryPoolStats StreamResource::GetMemoryStats() {
+  std::lock_guard<std::mutex> lk(memory_mu_);
+  return memory_pool_.GetStats();
 }
 
-uint8_t *StreamResource::MallocWeight(const std::string &purpose, size_t size) {
-  GELOGD("To Malloc weight, size = %zu", size);
+uint8_t *StreamResource::LoadWeight(const std::string &purpose, size_t size, const uint8_t *weights,
+                                    size_t weights_size) {
+  GELOGD("To load weight, size = %zu", size);
   uint8_t *buffer = nullptr;
-  auto ret = rtMalloc(reinterpret_cast<void **>(&buffer), size, RT_MEMORY_HBM);
-  if (ret != RT_ERROR_NONE) {
-    GELOGE(RT_FAILED, "rtMalloc failed, size = %zu, ret = %d", size, ret);
+  auto ret = SingleOpManager::GetInstance().GetWeightStore().Acquire(purpose, size, weights, weights_size, &buffer);
+  if (ret != SUCCESS) {
+    GELOGE(ret, "Failed to load weights, size = %zu", size);
     return nullptr;
   }
 
-  GE_PRINT_DYNAMIC_MEMORY(rtMalloc, purpose.c_str(), size)
   weight_list_.emplace_back(buffer);
   return buffer;
 }
@@ -133,6 +134,7 @@ Status StreamResource::BuildDynamicOperator(const string &model_name, const Mode
 
   GELOGI("To build operator: %s", model_name.c_str());
   GE_CHK_STATUS_RET(model.BuildDynamicOp(*new_op), "Build op failed. op = %s, ret = %u", model_name.c_str(), ret);
+  new_op->stream_resource_ = this;
   *single_op = new_op.get();
   dynamic_op_map_[model_data.model_data] = std::move(new_op);
   return SUCCESS;
@@ -161,9 +163,69 @@ Status StreamResource::BuildOperator(const string &model_name, const ModelData &
 
   GELOGI("To build operator: %s", model_name.c_str());
   GE_CHK_STATUS_RET(model.BuildOp(*this, *new_op), "Build op failed. op = %s, ret = %u", model_name.c_str(), ret);
+  new_op->stream_resource_ = this;
 
   *single_op = new_op.get();
   op_map_[model_data.model_data] = std::move(new_op);
   return SUCCESS;
 }
+
+Status StreamResource::BeginCapture() {
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  if (capturing_sequence_ != nullptr) {
+    GELOGE(PARAM_INVALID, "Single ops on stream are being captured already.");
+    return PARAM_INVALID;
+  }
+
+  capturing_sequence_.reset(new (std::nothrow) SingleOpSequence(this, &stream_mu_, stream_));
+  GE_CHECK_NOTNULL(capturing_sequence_);
+  GELOGI("Begin to capture single ops, resource id = %lu", resource_id_);
+  return SUCCESS;
+}
+
+Status StreamResource::EndCapture(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs,
+                                  SingleOpSequence **sequence) {
+  GE_CHECK_NOTNULL(sequence);
+  std::unique_ptr<SingleOpSequence> new_sequence;
+  {
+    // the kernel args of the ops are read while finalizing, no op may run in the meantime
+    std::lock_guard<std::mutex> lk(stream_mu_);
+    new_sequence = std::move(capturing_sequence_);
+    if (new_sequence == nullptr) {
+      GELOGE(PARAM_INVALID, "Single ops on stream are not being captured.");
+      return PARAM_INVALID;
+    }
+    GE_CHK_STATUS_RET(new_sequence->Finalize(inputs, outputs), "Failed to finalize captured single ops.");
+  }
+
+  GELOGI("End capturing single ops, resource id = %lu, step num = %zu, intermediate num = %zu", resource_id_,
+         new_sequence->GetStepNum(), new_sequence->GetIntermediateNum());
+  std::lock_guard<std::mutex> lk(mu_);
+  *sequence = new_sequence.get();
+  sequences_.emplace_back(std::move(new_sequence));
+  return SUCCESS;
+}
+
+Status StreamResource::DestroySequence(SingleOpSequence *sequence) {
+  std::unique_ptr<SingleOpSequence> removed_sequence;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto it = std::find_if(sequences_.begin(), sequences_.end(),
+                           [sequence](const std::unique_ptr<SingleOpSequence> &item) {
+                             return item.get() == sequence;
+                           });
+    if (it == sequences_.end()) {
+      GELOGE(PARAM_INVALID, "Single op sequence %p was not built on the stream.", sequence);
+      return PARAM_INVALID;
+    }
+    removed_sequence = std::move(*it);
+    (void)sequences_.erase(it);
+  }
+
+  // wait for a replay in progress
+  std::lock_guard<std::mutex> lk(stream_mu_);
+  removed_sequence.reset();
+  GELOGI("Single op sequence destroyed, resource id = %lu", resource_id_);
+  return SUCCESS;
+}
 }  // namespace ge
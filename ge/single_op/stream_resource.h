@@ -19,6 +19,7 @@
 
 #include <string>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +27,8 @@
 #include "common/ge_inner_error_codes.h"
 #include "runtime/stream.h"
 #include "single_op/single_op.h"
+#include "single_op/single_op_sequence.h"
+#include "single_op/stream_memory_pool.h"
 
 namespace ge {
 class StreamResource {
@@ -45,19 +48,34 @@ class StreamResource {
   Status BuildOperator(const std::string &model_name, const ModelData &model_data, SingleOp **single_op);
   Status BuildDynamicOperator(const std::string &model_name, const ModelData &model_data, DynamicSingleOp **single_op);
 
+  // memory shared by the ops of the stream, kept until the stream is released
   uint8_t *MallocMemory(const std::string &purpose, size_t size);
-  uint8_t *MallocWeight(const std::string &purpose, size_t size);
+  // weights of size bytes holding the given ones, shared with the models of all streams having the same ones
+  uint8_t *LoadWeight(const std::string &purpose, size_t size, const uint8_t *weights, size_t weights_size);
+  // memory of one launch, it can be freed as soon as the launch is issued on the stream
+  uint8_t *MallocWorkspace(const std::string &purpose, size_t size);
+  Status FreeWorkspace(uint8_t *workspace);
+  void TrimMemory(size_t high_water_mark);
+  StreamMemoryPoolStats GetMemoryStats();
 
- private:
-  uint8_t *DoMallocMemory(const std::string &purpose, size_t size, size_t &max_allocated,
-                          std::vector<uint8_t *> &allocated);
+  Status BeginCapture();
+  Status EndCapture(const std::vector<DataBuffer> &inputs, const std::vector<DataBuffer> &outputs,
+                    SingleOpSequence **sequence);
+  Status DestroySequence(SingleOpSequence *sequence);
+  // called by the ops with the stream locked
+  SingleOpSequence *GetCapturingSequence() const { return capturing_sequence_.get(); }
 
+ private:
   uintptr_t resource_id_;
   size_t max_memory_size_ = 0;
-  std::vector<uint8_t *> memory_list_;
+  uint8_t *shared_memory_ = nullptr;
+  StreamMemoryPool memory_pool_;
+  std::mutex memory_mu_;
   std::vector<uint8_t *> weight_list_;
   std::unordered_map<const void *, std::unique_ptr<SingleOp>> op_map_;
   std::unordered_map<const void *, std::unique_ptr<DynamicSingleOp>> dynamic_op_map_;
+  std::unique_ptr<SingleOpSequence> capturing_sequence_;
+  std::vector<std::unique_ptr<SingleOpSequence>> sequences_;
   rtStream_t stream_ = nullptr;
   std::mutex mu_;
   std::mutex stream_mu_;
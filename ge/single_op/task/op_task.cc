@@ -39,6 +39,15 @@ void FreeHbm(void *var) {
     (void)rtFree(var);
   }
 }
+
+void AppendToKey(int64_t value, std::string &key) {
+  key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void AppendToKey(const std::vector<int64_t> &dims, std::string &key) {
+  AppendToKey(static_cast<int64_t>(dims.size()), key);
+  key.append(reinterpret_cast<const char *>(dims.data()), dims.size() * sizeof(int64_t));
+}
 }  // namespace
 
 Status OpTask::OpenDump(const std::vector<uintptr_t> &io_addr, rtStream_t stream) {
@@ -100,6 +109,8 @@ TbeOpTask::~TbeOpTask() {
   if (tiling_buffer_ != nullptr) {
     (void)rtFree(tiling_buffer_);
   }
+
+  tiling_cache_.ForEach([](TilingInfo &tiling_info) { FreeHbm(tiling_info.tiling_buffer); });
 }
 
 const void *TbeOpTask::GetArgs() const { return args_.get(); }
@@ -108,16 +119,18 @@ size_t TbeOpTask::GetArgSize() const { return arg_size_; }
 
 const std::string &TbeOpTask::GetStubName() const { return stub_name_; }
 
-Status TbeOpTask::LaunchKernel(rtStream_t stream) {
+Status TbeOpTask::LaunchKernel(rtStream_t stream) { return LaunchKernelWithArgs(args_.get(), arg_size_, stream); }
+
+Status TbeOpTask::LaunchKernelWithArgs(void *args, size_t arg_size, rtStream_t stream) {
   GELOGD("To invoke rtKernelLaunch. task = %s, block_dim = %u", this->stub_name_.c_str(), block_dim_);
   auto *sm_desc = reinterpret_cast<rtSmDesc_t *>(sm_desc_);
-  auto ret = rtKernelLaunch(stub_func_, block_dim_, args_.get(), static_cast<uint32_t>(arg_size_), sm_desc, stream);
+  auto ret = rtKernelLaunch(stub_func_, block_dim_, args, static_cast<uint32_t>(arg_size), sm_desc, stream);
   int retry_times = 0;
   while (ret != RT_ERROR_NONE && retry_times < kLaunchRetryTimes) {
     retry_times++;
     GELOGW("Retry after %d ms, retry_times: %d", kSleepTime, retry_times);
     std::this_thread::sleep_for(std::chrono::milliseconds(kSleepTime));
-    ret = rtKernelLaunch(stub_func_, block_dim_, args_.get(), arg_size_, sm_desc, stream);
+    ret = rtKernelLaunch(stub_func_, block_dim_, args, arg_size, sm_desc, stream);
   }
 
   if (ret != RT_ERROR_NONE) {
@@ -130,7 +143,18 @@ Status TbeOpTask::LaunchKernel(rtStream_t stream) {
 }
 
 Status TbeOpTask::UpdateRunInfo(const vector<GeTensorDesc> &input_desc, const vector<GeTensorDesc> &output_desc) {
+  std::string tiling_key;
+  GE_CHK_STATUS_RET_NOLOG(GenerateTilingKey(input_desc, output_desc, tiling_key));
+  // the node descs are read by dump and profiling, keep them matching the run even when the tiling is cached
   GE_CHK_STATUS_RET_NOLOG(UpdateNodeByShape(input_desc, output_desc));
+  tiling_info_ = tiling_cache_.Find(tiling_key);
+  if (tiling_info_ != nullptr) {
+    SetWorkspaceSizes(tiling_info_->workspace_sizes);
+    block_dim_ = tiling_info_->block_dim;
+    GELOGD("Hit tiling cache. block_dim = %u, tiling size = %zu", block_dim_, tiling_info_->tiling_data.size());
+    return SUCCESS;
+  }
+
   // invoke OpParaCalculate
   GELOGD("Start to invoke OpParaCalculate.");
   optiling::OpRunInfo run_info;
@@ -142,9 +166,64 @@ Status TbeOpTask::UpdateRunInfo(const vector<GeTensorDesc> &input_desc, const ve
   }
   SetWorkspaceSizes(run_info.workspaces);
   block_dim_ = run_info.block_dim;
-  tiling_data_ = run_info.tiling_data.str();
+  tiling_info_ = tiling_cache_.Insert(tiling_key);
+  if (tiling_info_ == nullptr) {
+    tiling_data_ = run_info.tiling_data.str();
+  } else {
+    tiling_info_->block_dim = block_dim_;
+    tiling_info_->workspace_sizes = run_info.workspaces;
+    tiling_info_->tiling_data = run_info.tiling_data.str();
+  }
   GELOGD("Done invoking OpParaCalculate successfully. block_dim = %u, tiling size = %zu", block_dim_,
-         tiling_data_.size());
+         (tiling_info_ == nullptr) ? tiling_data_.size() : tiling_info_->tiling_data.size());
+  return SUCCESS;
+}
+
+void TbeOpTask::GetTilingCacheStats(uint64_t &hit_count, uint64_t &miss_count) const {
+  hit_count = tiling_cache_.HitCount();
+  miss_count = tiling_cache_.MissCount();
+}
+
+Status TbeOpTask::GenerateTilingKey(const vector<GeTensorDesc> &input_desc, const vector<GeTensorDesc> &output_desc,
+                                    std::string &key) {
+  // the same shapes UpdateTensorDesc sets to the node, and the formats
+  for (const auto *tensors : {&input_desc, &output_desc}) {
+    AppendToKey(static_cast<int64_t>(tensors->size()), key);
+    for (const auto &tensor : *tensors) {
+      int64_t storage_format_val = static_cast<Format>(FORMAT_RESERVED);
+      (void)AttrUtils::GetInt(tensor, ge::ATTR_NAME_STORAGE_FORMAT, storage_format_val);
+      AppendToKey(storage_format_val, key);
+      AppendToKey(static_cast<int64_t>(tensor.GetFormat()), key);
+      AppendToKey(static_cast<int64_t>(tensor.GetOriginFormat()), key);
+      AppendToKey(tensor.GetShape().GetDims(), key);
+      if (static_cast<Format>(storage_format_val) == FORMAT_RESERVED) {
+        AppendToKey(tensor.GetOriginShape().GetDims(), key);
+      } else {
+        std::vector<int64_t> storage_shape;
+        if (!AttrUtils::GetListInt(tensor, ge::ATTR_NAME_STORAGE_SHAPE, storage_shape)) {
+          GELOGE(PARAM_INVALID, "Failed to get storage_shape while storage_format was set");
+          return PARAM_INVALID;
+        }
+        AppendToKey(storage_shape, key);
+      }
+    }
+  }
+  return SUCCESS;
+}
+
+Status TbeOpTask::UploadTilingData(TilingInfo &tiling_info, rtStream_t stream) {
+  if (tiling_info.is_uploaded) {
+    return SUCCESS;
+  }
+  if (tiling_info.tiling_buffer == nullptr) {
+    GE_CHK_RT_RET(rtMalloc(&tiling_info.tiling_buffer, max_tiling_size_, RT_MEMORY_HBM));
+    GE_CHECK_NOTNULL(tiling_info.tiling_buffer);
+  }
+  // a reused buffer may still be read by a kernel launched before, copy on the same stream to wait for it
+  GELOGD("[%s] Start to upload tiling info. size = %zu", node_->GetName().c_str(), tiling_info.tiling_data.size());
+  GE_CHK_RT_RET(rtMemcpyAsync(tiling_info.tiling_buffer, max_tiling_size_, tiling_info.tiling_data.data(),
+                              tiling_info.tiling_data.size(), RT_MEMCPY_HOST_TO_DEVICE_EX, stream));
+  tiling_info.is_uploaded = true;
   return SUCCESS;
 }
 
@@ -209,11 +288,15 @@ Status TbeOpTask::LaunchKernel(const vector<void *> &inputs, const vector<void *
   args.insert(args.end(), workspaces.begin(), workspaces.end());
 
   if (tiling_buffer_ != nullptr) {
-    GELOGD("[%s] Start to copy tiling info. size = %zu", node_->GetName().c_str(), tiling_data_.size());
-    GE_CHK_RT_RET(rtMemcpyAsync(tiling_buffer_, max_tiling_size_, tiling_data_.data(), tiling_data_.size(),
-                                RT_MEMCPY_HOST_TO_DEVICE_EX, stream));
-
-    args.emplace_back(tiling_buffer_);
+    if (tiling_info_ != nullptr) {
+      GE_CHK_STATUS_RET_NOLOG(UploadTilingData(*tiling_info_, stream));
+      args.emplace_back(tiling_info_->tiling_buffer);
+    } else {
+      GELOGD("[%s] Start to copy tiling info. size = %zu", node_->GetName().c_str(), tiling_data_.size());
+      GE_CHK_RT_RET(rtMemcpyAsync(tiling_buffer_, max_tiling_size_, tiling_data_.data(), tiling_data_.size(),
+                                  RT_MEMCPY_HOST_TO_DEVICE_EX, stream));
+      args.emplace_back(tiling_buffer_);
+    }
   }
 
   if (memcpy_s(args_.get(), arg_size_, args.data(), args.size() * sizeof(void *)) != EOK) {
@@ -30,6 +30,7 @@
 #include "cce/aicpu_engine_struct.h"
 #include "hybrid/node_executor/aicpu/aicpu_ext_info.h"
 #include "init/gelib.h"
+#include "single_op/task/tiling_cache.h"
 
 namespace ge {
 enum OpTaskType {
@@ -76,6 +77,8 @@ class TbeOpTask : public OpTask {
  public:
   ~TbeOpTask() override;
   Status LaunchKernel(rtStream_t stream) override;
+  // launch with a copy of the kernel args, such as the ones of a recorded single op sequence
+  Status LaunchKernelWithArgs(void *args, size_t arg_size, rtStream_t stream);
   OpTaskType GetOpTaskType() override { return OP_TASK_TBE; }
   const void *GetIOAddr() const override { return nullptr; }
   void SetSmDesc(void *sm_desc);
@@ -91,10 +94,14 @@ class TbeOpTask : public OpTask {
   size_t GetArgSize() const;
   const std::string &GetStubName() const;
   void EnableDynamicSupport(const NodePtr &node, void *tiling_buffer, size_t max_tiling_size);
+  void GetTilingCacheStats(uint64_t &hit_count, uint64_t &miss_count) const;
 
  private:
   static Status UpdateTensorDesc(const GeTensorDesc &src_tensor, GeTensorDesc &dst_tensor);
+  static Status GenerateTilingKey(const vector<GeTensorDesc> &input_desc, const vector<GeTensorDesc> &output_desc,
+                                  std::string &key);
   Status UpdateNodeByShape(const vector<GeTensorDesc> &input_desc, const vector<GeTensorDesc> &output_desc);
+  Status UploadTilingData(TilingInfo &tiling_info, rtStream_t stream);
 
   const void *stub_func_ = nullptr;
   std::unique_ptr<uint8_t[]> args_;
@@ -107,6 +114,9 @@ class TbeOpTask : public OpTask {
   uint32_t max_tiling_size_ = 0;
   std::string tiling_data_;
   NodePtr node_;
+  // tiling results by shapes, each with its own device buffer, so a hit neither calculates nor copies the tiling
+  TilingCache tiling_cache_;
+  TilingInfo *tiling_info_ = nullptr;  // tiling of the current run, owned by tiling_cache_
 };
 
 class AiCpuBaseTask : public OpTask {
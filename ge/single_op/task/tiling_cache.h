@@ -0,0 +1,128 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_SINGLE_OP_TASK_TILING_CACHE_H_
+#define GE_SINGLE_OP_TASK_TILING_CACHE_H_
+
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ge {
+const size_t kDefaultTilingCacheCapacity = 16;
+
+///
+/// Result of OpParaCalculate for one set of input and output shapes
+///
+struct TilingInfo {
+  uint32_t block_dim = 0;
+  std::vector<int64_t> workspace_sizes;
+  std::string tiling_data;
+  // device copy of tiling_data, allocated and freed by the owner of the cache, kept when the entry is reused
+  void *tiling_buffer = nullptr;
+  bool is_uploaded = false;
+};
+
+///
+/// Least recently used cache of tiling results, keyed by the shapes and formats of a task.
+/// Not thread safe, the task using it is serialized by its stream.
+///
+class TilingCache {
+ public:
+  explicit TilingCache(size_t capacity = kDefaultTilingCacheCapacity) : capacity_(capacity) {}
+  ~TilingCache() = default;
+
+  TilingCache(const TilingCache &) = delete;
+  TilingCache &operator=(const TilingCache &) = delete;
+
+  ///
+  /// @return the cached tiling of key and mark it as the most recently used, nullptr if not cached
+  ///
+  TilingInfo *Find(const std::string &key) {
+    auto iter = index_.find(key);
+    if (iter == index_.end()) {
+      ++miss_count_;
+      return nullptr;
+    }
+    ++hit_count_;
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    return &iter->second->second;
+  }
+
+  ///
+  /// Add an empty entry of key. When the cache is full, the least recently used entry is reused,
+  /// its tiling_buffer is kept and has to be uploaded again.
+  /// @return entry to be filled by the caller, nullptr if the capacity is 0
+  ///
+  TilingInfo *Insert(const std::string &key) {
+    if (capacity_ == 0) {
+      return nullptr;
+    }
+    auto iter = index_.find(key);
+    if (iter != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, iter->second);
+      ResetEntry(iter->second->second);
+      return &iter->second->second;
+    }
+    if (entries_.size() < capacity_) {
+      entries_.emplace_front(key, TilingInfo());
+    } else {
+      entries_.splice(entries_.begin(), entries_, std::prev(entries_.end()));
+      index_.erase(entries_.front().first);
+      entries_.front().first = key;
+      ResetEntry(entries_.front().second);
+      ++evict_count_;
+    }
+    index_[key] = entries_.begin();
+    return &entries_.front().second;
+  }
+
+  template <typename Func>
+  void ForEach(Func &&func) {
+    for (auto &entry : entries_) {
+      func(entry.second);
+    }
+  }
+
+  size_t Size() const { return entries_.size(); }
+  uint64_t HitCount() const { return hit_count_; }
+  uint64_t MissCount() const { return miss_count_; }
+  uint64_t EvictCount() const { return evict_count_; }
+
+ private:
+  using Entry = std::pair<std::string, TilingInfo>;
+
+  static void ResetEntry(TilingInfo &tiling_info) {
+    tiling_info.block_dim = 0;
+    tiling_info.workspace_sizes.clear();
+    tiling_info.tiling_data.clear();
+    tiling_info.is_uploaded = false;
+  }
+
+  size_t capacity_;
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+  uint64_t evict_count_ = 0;
+};
+}  // namespace ge
+
+#endif  // GE_SINGLE_OP_TASK_TILING_CACHE_H_
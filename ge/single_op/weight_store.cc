@@ -0,0 +1,225 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "single_op/weight_store.h"
+
+#include <cstring>
+
+#include "framework/common/debug/ge_log.h"
+#include "framework/common/debug/log.h"
+#include "runtime/rt.h"
+
+namespace ge {
+namespace {
+const size_t kSha256BlockSize = 64;
+const size_t kSha256LengthSize = 8;
+const int kBitsPerByte = 8;
+const uint32_t kSha256InitState[] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                     0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+const uint32_t kSha256RoundConstants[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+uint32_t RotateRight(uint32_t value, int bits) { return (value >> bits) | (value << (32 - bits)); }
+
+void Sha256Compress(uint32_t state[], const uint8_t *block) {
+  uint32_t w[kSha256BlockSize];
+  for (size_t i = 0; i < 16; ++i) {
+    w[i] = (static_cast<uint32_t>(block[i * 4]) << 24) | (static_cast<uint32_t>(block[i * 4 + 1]) << 16) |
+           (static_cast<uint32_t>(block[i * 4 + 2]) << 8) | static_cast<uint32_t>(block[i * 4 + 3]);
+  }
+  for (size_t i = 16; i < kSha256BlockSize; ++i) {
+    uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0];
+  uint32_t b = state[1];
+  uint32_t c = state[2];
+  uint32_t d = state[3];
+  uint32_t e = state[4];
+  uint32_t f = state[5];
+  uint32_t g = state[6];
+  uint32_t h = state[7];
+  for (size_t i = 0; i < kSha256BlockSize; ++i) {
+    uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+    uint32_t ch = (e & f) ^ (~e & g);
+    uint32_t temp1 = h + s1 + ch + kSha256RoundConstants[i] + w[i];
+    uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t temp2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+}  // namespace
+
+WeightStore::~WeightStore() {
+  for (auto &it : entries_) {
+    auto rt_ret = rtFree(it.second.device_weights);
+    GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+  }
+}
+
+WeightStore::Fingerprint WeightStore::GetFingerprint(const uint8_t *data, size_t size) {
+  uint32_t state[sizeof(kSha256InitState) / sizeof(kSha256InitState[0])];
+  (void)memcpy(state, kSha256InitState, sizeof(state));
+  size_t offset = 0;
+  for (; offset + kSha256BlockSize <= size; offset += kSha256BlockSize) {
+    Sha256Compress(state, data + offset);
+  }
+
+  // the tail is padded with 0x80 and zeros, and ends with the bit length in big endian
+  uint8_t tail[kSha256BlockSize * 2] = {0};
+  size_t tail_size = size - offset;
+  if (tail_size > 0) {
+    (void)memcpy(tail, data + offset, tail_size);
+  }
+  tail[tail_size] = 0x80;
+  size_t padded_size = (tail_size + 1 + kSha256LengthSize <= kSha256BlockSize) ? kSha256BlockSize : sizeof(tail);
+  uint64_t bit_size = static_cast<uint64_t>(size) * kBitsPerByte;
+  for (size_t i = 0; i < kSha256LengthSize; ++i) {
+    tail[padded_size - 1 - i] = static_cast<uint8_t>(bit_size >> (i * kBitsPerByte));
+  }
+  for (size_t block_offset = 0; block_offset < padded_size; block_offset += kSha256BlockSize) {
+    Sha256Compress(state, tail + block_offset);
+  }
+
+  Fingerprint fingerprint;
+  for (size_t i = 0; i < kFingerprintSize; ++i) {
+    fingerprint[i] = static_cast<uint8_t>(state[i / 4] >> ((3 - i % 4) * kBitsPerByte));
+  }
+  return fingerprint;
+}
+
+uint8_t *WeightStore::FindWeights(const Fingerprint &fingerprint, int32_t device_id, size_t size,
+                                  size_t weights_size) {
+  auto range = entries_.equal_range(fingerprint);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto &entry = it->second;
+    if (entry.device_id == device_id && entry.size == size && entry.weights_size == weights_size) {
+      ++entry.ref_count;
+      return entry.device_weights;
+    }
+  }
+  return nullptr;
+}
+
+Status WeightStore::Acquire(const std::string &purpose, size_t size, const uint8_t *weights, size_t weights_size,
+                            uint8_t **device_weights) {
+  GE_CHECK_NOTNULL(weights);
+  GE_CHECK_NOTNULL(device_weights);
+  if (weights_size > size) {
+    GELOGE(PARAM_INVALID, "Weights size %zu is larger than weight memory size %zu", weights_size, size);
+    return PARAM_INVALID;
+  }
+  int32_t device_id = 0;
+  GE_CHK_RT_RET(rtGetDevice(&device_id));
+  Fingerprint fingerprint = GetFingerprint(weights, weights_size);
+
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    uint8_t *shared_weights = FindWeights(fingerprint, device_id, size, weights_size);
+    if (shared_weights != nullptr) {
+      *device_weights = shared_weights;
+      GELOGI("Share weights of size %zu on device %d", size, device_id);
+      return SUCCESS;
+    }
+  }
+
+  uint8_t *buffer = nullptr;
+  auto rt_ret = rtMalloc(reinterpret_cast<void **>(&buffer), size, RT_MEMORY_HBM);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(RT_FAILED, "rtMalloc failed, size = %zu, ret = %d", size, rt_ret);
+    return RT_FAILED;
+  }
+  GE_PRINT_DYNAMIC_MEMORY(rtMalloc, purpose.c_str(), size)
+
+  GELOGI("To copy weight to device. weight size = %zu", weights_size);
+  rt_ret = rtMemcpy(buffer, size, weights, weights_size, RT_MEMCPY_HOST_TO_DEVICE);
+  if (rt_ret != RT_ERROR_NONE) {
+    GELOGE(RT_FAILED, "rtMemcpy weights failed, size = %zu, ret = %d", weights_size, rt_ret);
+    GE_IF_BOOL_EXEC(rtFree(buffer) != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+    return RT_FAILED;
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  // the same weights may have been uploaded by another thread in the meantime
+  uint8_t *shared_weights = FindWeights(fingerprint, device_id, size, weights_size);
+  if (shared_weights != nullptr) {
+    GE_IF_BOOL_EXEC(rtFree(buffer) != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+    *device_weights = shared_weights;
+    GELOGI("Share weights of size %zu on device %d", size, device_id);
+    return SUCCESS;
+  }
+  auto it = entries_.emplace(fingerprint, Entry{device_id, size, weights_size, buffer, 1});
+  device_weights_index_[buffer] = it;
+  *device_weights = buffer;
+  return SUCCESS;
+}
+
+void WeightStore::Release(uint8_t *device_weights) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto index_it = device_weights_index_.find(device_weights);
+  if (index_it == device_weights_index_.end()) {
+    GELOGW("Weights %p are not in the store.", device_weights);
+    return;
+  }
+
+  auto it = index_it->second;
+  if (--it->second.ref_count > 0) {
+    return;
+  }
+  auto rt_ret = rtFree(device_weights);
+  GE_IF_BOOL_EXEC(rt_ret != RT_ERROR_NONE, GELOGE(RT_FAILED, "rtFree failed"));
+  device_weights_index_.erase(index_it);
+  entries_.erase(it);
+}
+
+WeightStoreStats WeightStore::GetStats() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  WeightStoreStats stats;
+  for (const auto &it : entries_) {
+    const auto &entry = it.second;
+    ++stats.entry_num;
+    stats.ref_num += entry.ref_count;
+    stats.device_size += entry.size;
+    stats.saved_size += (entry.ref_count - 1) * entry.size;
+  }
+  return stats;
+}
+}  // namespace ge
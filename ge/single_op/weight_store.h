@@ -0,0 +1,94 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GE_SINGLE_OP_WEIGHT_STORE_H_
+#define GE_SINGLE_OP_WEIGHT_STORE_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/ge_inner_error_codes.h"
+
+namespace ge {
+struct WeightStoreStats {
+  size_t entry_num = 0;
+  size_t ref_num = 0;
+  size_t device_size = 0;  // device memory held by the store
+  size_t saved_size = 0;   // device memory the models would take on top of it without sharing
+};
+
+///
+/// Device copies of single op model weights, shared by all models with the same weight bytes on a device.
+/// Weights are looked up by the SHA-256 digest of their bytes, and weights of the same digest are taken as the same
+/// without reading the device copies back. Uploads are outside of the lock, when the first loads of the same weights
+/// on several threads race, the copy added first is shared and the others are freed.
+/// The weights are constants of the models, the ops never write to them.
+///
+class WeightStore {
+ public:
+  static const size_t kFingerprintSize = 32;
+  using Fingerprint = std::array<uint8_t, kFingerprintSize>;
+
+  WeightStore() = default;
+  ~WeightStore();
+
+  WeightStore(const WeightStore &) = delete;
+  WeightStore &operator=(const WeightStore &) = delete;
+
+  ///
+  /// @brief get device weights holding the weights of a model, a copy is uploaded if none matches
+  /// @param [in] purpose purpose of the device memory
+  /// @param [in] size size of the device memory
+  /// @param [in] weights weights of the model
+  /// @param [in] weights_size size of the weights, not larger than size
+  /// @param [out] device_weights device weights, released by Release
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  Status Acquire(const std::string &purpose, size_t size, const uint8_t *weights, size_t weights_size,
+                 uint8_t **device_weights);
+
+  void Release(uint8_t *device_weights);
+
+  WeightStoreStats GetStats();
+
+  // SHA-256 digest of the data
+  static Fingerprint GetFingerprint(const uint8_t *data, size_t size);
+
+ private:
+  struct Entry {
+    int32_t device_id;
+    size_t size;
+    size_t weights_size;
+    uint8_t *device_weights;
+    size_t ref_count;
+  };
+  using EntryMap = std::multimap<Fingerprint, Entry>;
+
+  // called with the lock held
+  uint8_t *FindWeights(const Fingerprint &fingerprint, int32_t device_id, size_t size, size_t weights_size);
+
+  std::mutex mutex_;
+  // fingerprint of the weights to the device copies
+  EntryMap entries_;
+  std::unordered_map<const uint8_t *, EntryMap::iterator> device_weights_index_;
+};
+}  // namespace ge
+
+#endif  // GE_SINGLE_OP_WEIGHT_STORE_H_
@@ -36,6 +36,10 @@ class ModelHelper {
                        ge::ModelBufferData& model);
   Status SaveOriginalGraphToOmModel(const ge::Graph& graph, const std::string& output_file);
   Status LoadModel(const ge::ModelData& model_data);
+  // decode the scalar fields of the task partition, the tasks and op defs are skipped without being decoded
+  static Status LoadTaskMeta(const ModelPartition& task_partition, domi::ModelTaskDef& task_meta);
+  // the partitions of mapped files are shared and decoded on first use, other partitions are decoded at once
+  static Status LoadTaskPartition(const ModelPartition& task_partition, GeModel& ge_model);
   Status GetModelBufferData(ge::ModelBufferData& model);
 
   const ModelFileHeader* GetFileHeader() const { return file_header_; }
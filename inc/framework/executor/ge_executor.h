@@ -34,6 +34,7 @@ class ModelListenerAdapter;
 
 class SingleOp;
 class DynamicSingleOp;
+class SingleOpSequence;
 
 struct RunModelData {
   uint32_t index;  // Data index
@@ -268,6 +269,81 @@ class GE_FUNC_DEV_VISIBILITY GE_FUNC_HOST_VISIBILITY GeExecutor {
                                  const std::vector<DataBuffer> &inputs, std::vector<GeTensorDesc> &output_desc,
                                  std::vector<DataBuffer> &outputs);
 
+  ///
+  /// @ingroup ge
+  /// @brief Get the tiling cache statistics of a dynamic single op, both are 0 if the op is not a TBE op
+  /// @param [in] DynamicSingleOp *executor: dynamic single op loaded by LoadDynamicSingleOp
+  /// @param [out] uint64_t &hit_count: executions which reused a cached tiling result
+  /// @param [out] uint64_t &miss_count: executions which invoked the tiling calculation
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  static ge::Status GetTilingCacheStats(DynamicSingleOp *executor, uint64_t &hit_count, uint64_t &miss_count);
+
+  ///
+  /// @ingroup ge
+  /// @brief Start recording the executions of single ops on a stream
+  /// @param [in] void *stream: stream the single ops were loaded on
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  static ge::Status BeginSingleOpCapture(void *stream);
+
+  ///
+  /// @ingroup ge
+  /// @brief Stop recording the executions of single ops on a stream and build a sequence replaying them.
+  /// Buffers of the recorded executions are matched by address: inputs and outputs are given on every replay,
+  /// other outputs of the recorded ops are allocated by the sequence, the remaining buffers are kept as they are.
+  /// @param [in] void *stream: stream the capture was started on
+  /// @param [in] const std::vector<DataBuffer> &inputs: buffers used as inputs of the sequence while recording
+  /// @param [in] const std::vector<DataBuffer> &outputs: buffers used as outputs of the sequence while recording
+  /// @param [out] SingleOpSequence **sequence: sequence owned by the stream, destroyed with DestroySingleOpSequence
+  /// or ReleaseSingleOpResource
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  static ge::Status EndSingleOpCapture(void *stream, const std::vector<DataBuffer> &inputs,
+                                       const std::vector<DataBuffer> &outputs, SingleOpSequence **sequence);
+
+  ///
+  /// @ingroup ge
+  /// @brief Replay the single ops recorded in a sequence on its stream, with other inputs and outputs
+  /// @param [in] SingleOpSequence *executor: sequence built by EndSingleOpCapture
+  /// @param [in] const std::vector<DataBuffer> &inputs: inputs in the order given to EndSingleOpCapture, no smaller
+  /// than the recorded ones
+  /// @param [out] std::vector<DataBuffer> &outputs: outputs in the order given to EndSingleOpCapture, no smaller
+  /// than the recorded ones
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  static ge::Status ExecuteAsync(SingleOpSequence *executor, const std::vector<DataBuffer> &inputs,
+                                 std::vector<DataBuffer> &outputs);
+
+  ///
+  /// @ingroup ge
+  /// @brief Destroy a sequence and give its intermediate memory back to the stream
+  /// @param [in] void *stream: stream the sequence was captured on
+  /// @param [in] SingleOpSequence *sequence: sequence built by EndSingleOpCapture, not used afterwards
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  static ge::Status DestroySingleOpSequence(void *stream, SingleOpSequence *sequence);
+
+  ///
+  /// @ingroup ge
+  /// @brief Give the free single op memory of a stream back to runtime until at most high_water_mark bytes are
+  /// cached, and keep the stream at the mark afterwards
+  /// @param [in] void *stream: stream the single ops were loaded on
+  /// @param [in] size_t high_water_mark: bytes of memory the stream may cache, 0 to stop trimming it automatically
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  static ge::Status TrimSingleOpMemory(void *stream, size_t high_water_mark);
+
+  ///
+  /// @ingroup ge
+  /// @brief Get the single op memory statistics of a stream
+  /// @param [in] void *stream: stream the single ops were loaded on
+  /// @param [out] size_t &cached_size: device memory held by the stream, in use or free
+  /// @param [out] size_t &in_use_peak_size: peak of the device memory in use by the stream
+  /// @return SUCCESS handle successfully / others handle failed
+  ///
+  static ge::Status GetSingleOpMemoryStats(void *stream, size_t &cached_size, size_t &in_use_peak_size);
+
   static ge::Status ReleaseSingleOpResource(void *stream);
 
   ge::Status GetBatchInfoSize(uint32_t model_id, size_t &shape_count);
@@ -35,6 +35,34 @@ struct HostVarInfo {
   uint64_t var_size;
 };
 
+struct CachingAllocatorBinStats {
+  uint64_t hit_num = 0;
+  uint64_t miss_num = 0;
+};
+
+struct CachingAllocatorStats {
+  uint64_t malloc_num = 0;
+  uint64_t free_num = 0;
+  uint64_t thread_cache_hit_num = 0;
+  std::vector<CachingAllocatorBinStats> bin_stats;
+  uint64_t split_num = 0;
+  uint64_t merge_num = 0;
+  uint64_t extend_num = 0;
+  uint64_t extend_fail_num = 0;
+  // bytes requested from device and kept by the allocator
+  uint64_t cached_size = 0;
+  uint64_t cached_peak_size = 0;
+  // bytes handed out to users
+  uint64_t in_use_size = 0;
+  uint64_t in_use_peak_size = 0;
+  // free bytes in bins and in thread caches
+  uint64_t free_size = 0;
+  uint64_t thread_cached_size = 0;
+  uint64_t largest_free_block_size = 0;
+  // 1 - largest_free_block_size / free_size of the bins, 0 when nothing is free
+  double fragmentation_ratio = 0.0;
+};
+
 ///
 /// \param size [in] rdma pool memory size to be allocated.
 /// \param mem_type [in] memory type for rdma pool.
@@ -53,5 +81,13 @@ Status RdmaRemoteRegister(const std::vector<HostVarInfo> &var_info, rtMemType_t
 /// \param var_size [out] var_size memory_size of host variable.
 /// \return Status result of function
 Status GetVarBaseAddrAndSize(const std::string &var_name, uint64_t &base_addr, uint64_t &var_size);
+
+///
+/// \param device_id [in] device id.
+/// \param stats [out] statistics of the caching allocator on the device.
+/// \param mem_type [in] memory type of the caching allocator.
+/// \return Status result of function
+Status GetCachingAllocatorStats(uint32_t device_id, CachingAllocatorStats &stats,
+                                rtMemType_t mem_type = RT_MEMORY_HBM);
 }  // namespace ge
 #endif  // INC_FRAMEWORK_MEMORY_MEMORY_API_H_
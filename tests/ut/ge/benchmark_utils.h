@@ -0,0 +1,54 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UT_GE_BENCHMARK_UTILS_H_
+#define UT_GE_BENCHMARK_UTILS_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "framework/common/debug/ge_log.h"
+
+namespace ge {
+namespace ut {
+///
+/// Times a section of a benchmark case. The result is written as a property of the running test, it shows up in
+/// the report of --gtest_output=xml, so that an old and a new implementation measured by one case can be compared.
+///
+class BenchmarkTimer {
+ public:
+  BenchmarkTimer() : start_(std::chrono::steady_clock::now()) {}
+
+  int64_t ElapsedUs() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_).count();
+  }
+
+  int64_t Record(const std::string &name) const {
+    int64_t cost_us = ElapsedUs();
+    testing::Test::RecordProperty(name + "_us", std::to_string(cost_us));
+    GELOGI("Benchmark %s: %ld us", name.c_str(), cost_us);
+    return cost_us;
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+};
+}  // namespace ut
+}  // namespace ge
+#endif  // UT_GE_BENCHMARK_UTILS_H_
@@ -0,0 +1,122 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "benchmark_utils.h"
+#include "common/formats/format_transfers/datatype_transfer.h"
+#include "common/fp16_t.h"
+
+// Cast time of DataTypeTransfer next to the legacy transfer, which converted the elements one by one with fp16_t and
+// static_cast on the calling thread, replayed on the same data. The times are test properties, see them with
+// --gtest_output=xml; the 64M element cases take seconds and are disabled.
+namespace ge {
+namespace formats {
+namespace {
+// above the size converted by several tasks, with a tail that is not a multiple of the vector width
+const size_t kSmallElemNum = 4 * 1024 * 1024 + 3;
+const size_t kLargeElemNum = 64 * 1024 * 1024;
+
+template <typename T>
+std::vector<T> MakeRandomData(size_t num, double min_value, double max_value) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> distribution(min_value, max_value);
+  std::vector<T> data(num);
+  for (auto &value : data) {
+    value = static_cast<T>(distribution(generator));
+  }
+  return data;
+}
+
+template <typename SrcT, typename DstT>
+void RunCast(const std::string &name, const std::vector<SrcT> &data, DataType src_type, DataType dst_type,
+             const std::function<DstT(SrcT)> &legacy_cast) {
+  ut::BenchmarkTimer legacy_timer;
+  std::unique_ptr<DstT[]> expect(new (std::nothrow) DstT[data.size()]);
+  ASSERT_NE(expect, nullptr);
+  for (size_t i = 0; i < data.size(); ++i) {
+    expect[i] = legacy_cast(data[i]);
+  }
+  (void)legacy_timer.Record("legacy_" + name);
+
+  CastArgs args{reinterpret_cast<const uint8_t *>(data.data()), data.size(), src_type, dst_type};
+  TransResult result;
+  DataTypeTransfer transfer;
+  ut::BenchmarkTimer timer;
+  ASSERT_EQ(transfer.TransDataType(args, result), SUCCESS);
+  (void)timer.Record(name);
+  ASSERT_EQ(result.length, data.size() * sizeof(DstT));
+  EXPECT_EQ(memcmp(result.data.get(), expect.get(), result.length), 0);
+}
+
+void RunFp32ToFp16(size_t num) {
+  // beyond the fp16 range at both ends, so that the saturated steps are measured too
+  auto data = MakeRandomData<float>(num, -70000.0, 70000.0);
+  RunCast<float, uint16_t>("fp32_to_fp16", data, DT_FLOAT, DT_FLOAT16, [](float value) {
+    fp16_t fp16;
+    fp16 = value;
+    return fp16.val;
+  });
+}
+
+void RunFp16ToFp32(size_t num) {
+  auto float_data = MakeRandomData<float>(num, -65504.0, 65504.0);
+  std::vector<uint16_t> data(num);
+  fp16_t fp16;
+  for (size_t i = 0; i < num; ++i) {
+    fp16 = float_data[i];
+    data[i] = fp16.val;
+  }
+  RunCast<uint16_t, float>("fp16_to_fp32", data, DT_FLOAT16, DT_FLOAT, [](uint16_t value) {
+    fp16_t fp16;
+    fp16.val = value;
+    return static_cast<float>(fp16);
+  });
+}
+
+void RunInt32ToFp32(size_t num) {
+  auto data = MakeRandomData<int32_t>(num, -1.0e9, 1.0e9);
+  RunCast<int32_t, float>("int32_to_fp32", data, DT_INT32, DT_FLOAT,
+                          [](int32_t value) { return static_cast<float>(value); });
+}
+}  // namespace
+
+class UtestDataTypeTransferBenchmark : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestDataTypeTransferBenchmark, fp32_to_fp16) { RunFp32ToFp16(kSmallElemNum); }
+
+TEST_F(UtestDataTypeTransferBenchmark, fp16_to_fp32) { RunFp16ToFp32(kSmallElemNum); }
+
+TEST_F(UtestDataTypeTransferBenchmark, int32_to_fp32) { RunInt32ToFp32(kSmallElemNum); }
+
+TEST_F(UtestDataTypeTransferBenchmark, DISABLED_fp32_to_fp16_64m) { RunFp32ToFp16(kLargeElemNum); }
+
+TEST_F(UtestDataTypeTransferBenchmark, DISABLED_fp16_to_fp32_64m) { RunFp16ToFp32(kLargeElemNum); }
+
+TEST_F(UtestDataTypeTransferBenchmark, DISABLED_int32_to_fp32_64m) { RunInt32ToFp32(kLargeElemNum); }
+}  // namespace formats
+}  // namespace ge
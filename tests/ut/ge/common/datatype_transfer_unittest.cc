@@ -15,6 +15,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <climits>
+#include <vector>
 
 #include "common/formats/format_transfers/datatype_transfer.h"
 
@@ -397,5 +399,97 @@ TEST_F(UtestDataTypeTransfer, unsupprot_trans2) {
   EXPECT_EQ(transfer.TransDataType(args, result), UNSUPPORTED);
   EXPECT_EQ(TransDataType(args, result), UNSUPPORTED);
 }
+
+TEST_F(UtestDataTypeTransfer, fp16_all_values_same_as_fp16_t) {
+  std::vector<uint16_t> data(UINT16_MAX + 1);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint16_t>(i);
+  }
+  TransResult float_result;
+  TransResult int32_result;
+  CastArgs float_args{reinterpret_cast<uint8_t *>(data.data()), data.size(), DT_FLOAT16, DT_FLOAT};
+  CastArgs int32_args{reinterpret_cast<uint8_t *>(data.data()), data.size(), DT_FLOAT16, DT_INT32};
+  ASSERT_EQ(TransDataType(float_args, float_result), SUCCESS);
+  ASSERT_EQ(TransDataType(int32_args, int32_result), SUCCESS);
+
+  auto float_data = reinterpret_cast<uint32_t *>(float_result.data.get());
+  auto int32_data = reinterpret_cast<int32_t *>(int32_result.data.get());
+  for (size_t i = 0; i < data.size(); ++i) {
+    fp16_t fp16;
+    fp16.val = data[i];
+    float expect_float = fp16;
+    // compare the bits, the inf and nan of fp16 are finite values in fp16_t
+    ASSERT_EQ(float_data[i], *reinterpret_cast<uint32_t *>(&expect_float)) << "fp16 " << data[i];
+    ASSERT_EQ(int32_data[i], static_cast<int32_t>(fp16)) << "fp16 " << data[i];
+  }
+}
+
+TEST_F(UtestDataTypeTransfer, fp32_fp16_edge_values_same_as_fp16_t) {
+  std::vector<uint32_t> data = {
+      0x00000000, 0x80000000, 0x00000001, 0x33000000, 0x33000001, 0x387FE000, 0x387FF000, 0x38800000,
+      0x3F800000, 0x3F801000, 0x3F803000, 0x477FE000, 0x477FEFFF, 0x477FF000, 0x477FFFFF, 0x47800000,
+      0x47FFFFFF, 0x48000000, 0x7F7FFFFF, 0x7F800000, 0x7FC00000, 0xFF800000, 0xC77FF000, 0xC8000000,
+  };
+  // every value in every position of the 8 element steps and the scalar tail
+  size_t data_num = data.size();
+  for (size_t i = 0; i < 7; ++i) {
+    data.insert(data.end(), data.begin() + 1, data.begin() + data_num);
+  }
+  TransResult result;
+  CastArgs args{reinterpret_cast<uint8_t *>(data.data()), data.size(), DT_FLOAT, DT_FLOAT16};
+  ASSERT_EQ(TransDataType(args, result), SUCCESS);
+  auto fp16_data = reinterpret_cast<uint16_t *>(result.data.get());
+  for (size_t i = 0; i < data.size(); ++i) {
+    fp16_t fp16;
+    fp16 = *reinterpret_cast<float *>(&data[i]);
+    ASSERT_EQ(fp16_data[i], fp16.val) << "float bits " << std::hex << data[i];
+  }
+}
+
+TEST_F(UtestDataTypeTransfer, int32_fp16_edge_values_same_as_fp16_t) {
+  std::vector<int32_t> data = {INT32_MIN, INT32_MIN + 1, -65536, -65520, -65519, -2049, -2048, -1, 0, 1, 2047,
+                               2049, 4097, 65504, 65519, 65520, 65535, INT32_MAX};
+  for (int32_t i = -70000; i <= 70000; i += 7) {
+    data.emplace_back(i);
+  }
+  TransResult result;
+  CastArgs args{reinterpret_cast<uint8_t *>(data.data()), data.size(), DT_INT32, DT_FLOAT16};
+  ASSERT_EQ(TransDataType(args, result), SUCCESS);
+  auto fp16_data = reinterpret_cast<uint16_t *>(result.data.get());
+  for (size_t i = 0; i < data.size(); ++i) {
+    fp16_t fp16;
+    fp16 = data[i];
+    ASSERT_EQ(fp16_data[i], fp16.val) << "int32 " << data[i];
+  }
+}
+
+TEST_F(UtestDataTypeTransfer, large_data_with_odd_tail_same_as_scalar) {
+  // above twice the size converted by one task, so that the data is split into chunks, and not a multiple of the
+  // vector width
+  const size_t data_num = 4 * 1024 * 1024 + 13;
+  std::vector<float> float_data(data_num);
+  std::vector<int32_t> int32_data(data_num);
+  for (size_t i = 0; i < data_num; ++i) {
+    float_data[i] = static_cast<float>(static_cast<int64_t>(i % 140009) - 70000) + 0.25f;
+    int32_data[i] = static_cast<int32_t>(i * 2654435761U);
+  }
+  TransResult fp16_result;
+  TransResult int64_result;
+  CastArgs fp16_args{reinterpret_cast<uint8_t *>(float_data.data()), data_num, DT_FLOAT, DT_FLOAT16};
+  CastArgs int64_args{reinterpret_cast<uint8_t *>(int32_data.data()), data_num, DT_INT32, DT_INT64};
+  ASSERT_EQ(TransDataType(fp16_args, fp16_result), SUCCESS);
+  ASSERT_EQ(TransDataType(int64_args, int64_result), SUCCESS);
+  ASSERT_EQ(fp16_result.length, data_num * sizeof(uint16_t));
+  ASSERT_EQ(int64_result.length, data_num * sizeof(int64_t));
+
+  auto fp16_data = reinterpret_cast<uint16_t *>(fp16_result.data.get());
+  auto int64_data = reinterpret_cast<int64_t *>(int64_result.data.get());
+  for (size_t i = 0; i < data_num; ++i) {
+    fp16_t fp16;
+    fp16 = float_data[i];
+    ASSERT_EQ(fp16_data[i], fp16.val) << "index " << i;
+    ASSERT_EQ(int64_data[i], static_cast<int64_t>(int32_data[i])) << "index " << i;
+  }
+}
 }  // namespace formats
 }  // namespace ge
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "common/mpsc_queue.h"
+
+namespace ge {
+class UtestMpscQueue : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestMpscQueue, pop_in_push_order) {
+  MpscQueue<int> queue;
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(queue.Push(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    int item = -1;
+    ASSERT_TRUE(queue.Pop(item));
+    EXPECT_EQ(item, i);
+  }
+}
+
+TEST_F(UtestMpscQueue, many_producers) {
+  const int kProducerNum = 4;
+  const int kItemNum = 10000;
+  MpscQueue<int> queue;
+  std::vector<std::thread> producers;
+  for (int producer = 0; producer < kProducerNum; ++producer) {
+    producers.emplace_back([&queue, producer]() {
+      for (int i = 0; i < kItemNum; ++i) {
+        (void)queue.Push(producer * kItemNum + i);
+      }
+    });
+  }
+
+  // the items of one producer keep their order
+  std::vector<int> last_items(kProducerNum, -1);
+  for (int i = 0; i < kProducerNum * kItemNum; ++i) {
+    int item = -1;
+    ASSERT_TRUE(queue.Pop(item));
+    int producer = item / kItemNum;
+    ASSERT_GE(producer, 0);
+    ASSERT_LT(producer, kProducerNum);
+    EXPECT_GT(item % kItemNum, last_items[producer]);
+    last_items[producer] = item % kItemNum;
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  for (auto last_item : last_items) {
+    EXPECT_EQ(last_item, kItemNum - 1);
+  }
+}
+
+TEST_F(UtestMpscQueue, push_wakes_up_sleeping_consumer) {
+  MpscQueue<int> queue;
+  std::thread producer([&queue]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    (void)queue.Push(1);
+  });
+  int item = 0;
+  EXPECT_TRUE(queue.Pop(item));
+  EXPECT_EQ(item, 1);
+  producer.join();
+}
+
+TEST_F(UtestMpscQueue, stop_wakes_up_sleeping_consumer) {
+  MpscQueue<int> queue;
+  std::thread stopper([&queue]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.Stop();
+  });
+  int item = 0;
+  EXPECT_FALSE(queue.Pop(item));
+  stopper.join();
+  EXPECT_FALSE(queue.Push(1));
+}
+}  // namespace ge
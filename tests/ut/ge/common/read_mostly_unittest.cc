@@ -0,0 +1,113 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define protected public
+#define private public
+#include "common/read_mostly.h"
+#undef protected
+#undef private
+
+namespace ge {
+namespace {
+const size_t kReaderNum = 8;
+const int64_t kUpdateNum = 500;
+
+std::atomic<int64_t> g_live_num(0);
+
+// a value is consistent while it is alive, its destructor breaks it
+struct Payload {
+  Payload() : version(0), check(0), alive(true) { ++g_live_num; }
+  explicit Payload(int64_t ver) : version(ver), check(-ver), alive(true) { ++g_live_num; }
+  ~Payload() {
+    alive.store(false);
+    check = 1;
+    --g_live_num;
+  }
+  int64_t version;
+  int64_t check;
+  std::atomic<bool> alive;
+};
+}  // namespace
+
+class UtestReadMostly : public testing::Test {
+ protected:
+  void SetUp() { g_live_num = 0; }
+  void TearDown() {}
+};
+
+TEST_F(UtestReadMostly, read_and_update) {
+  ReadMostly<Payload> value;
+  int64_t version = -1;
+  EXPECT_TRUE(value.Read([&version](const Payload &payload) { version = payload.version; }));
+  EXPECT_EQ(version, 0);
+
+  value.Update(std::unique_ptr<Payload>(new Payload(1)));
+  EXPECT_TRUE(value.Read([&version](const Payload &payload) { version = payload.version; }));
+  EXPECT_EQ(version, 1);
+  EXPECT_EQ(g_live_num.load(), 1);
+
+  value.Update(nullptr);
+  EXPECT_FALSE(value.Read([](const Payload &) {}));
+  EXPECT_EQ(g_live_num.load(), 0);
+}
+
+TEST_F(UtestReadMostly, reader_shards_on_own_cache_line) {
+  EXPECT_EQ(alignof(ReadMostly<Payload>::ReaderShard) % 64, 0);
+  EXPECT_EQ(sizeof(ReadMostly<Payload>::ReaderShard) % 64, 0);
+}
+
+TEST_F(UtestReadMostly, read_during_update) {
+  {
+    ReadMostly<Payload> value;
+    std::atomic<bool> stop(false);
+    std::atomic<int64_t> broken_num(0);
+    std::vector<int64_t> last_versions(kReaderNum, 0);
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < kReaderNum; ++i) {
+      readers.emplace_back([&value, &stop, &broken_num, &last_versions, i]() {
+        while (!stop.load()) {
+          (void)value.Read([&broken_num, &last_versions, i](const Payload &payload) {
+            // the value seen must not be deleted before the reader leaves, and versions never go back
+            if (!payload.alive.load() || (payload.version + payload.check != 0) ||
+                (payload.version < last_versions[i])) {
+              ++broken_num;
+            }
+            last_versions[i] = payload.version;
+          });
+        }
+      });
+    }
+    for (int64_t version = 1; version <= kUpdateNum; ++version) {
+      value.Update(std::unique_ptr<Payload>(new Payload(version)));
+      // deleted right in Update, not deferred
+      EXPECT_EQ(g_live_num.load(), 1);
+    }
+    stop = true;
+    for (auto &reader : readers) {
+      reader.join();
+    }
+    EXPECT_EQ(broken_num.load(), 0);
+  }
+  EXPECT_EQ(g_live_num.load(), 0);
+}
+}  // namespace ge
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "common/task_scheduler.h"
+
+namespace ge {
+class UtestTaskScheduler : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestTaskScheduler, commit_and_get) {
+  TaskScheduler scheduler(4);
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 1000; ++i) {
+    futures.emplace_back(scheduler.Commit([](int x) { return x * 2; }, i));
+  }
+  int64_t sum = 0;
+  for (auto &future : futures) {
+    ASSERT_TRUE(future.valid());
+    sum += future.get();
+  }
+  EXPECT_EQ(sum, 999 * 1000);
+}
+
+TEST_F(UtestTaskScheduler, priority_commit) {
+  TaskScheduler scheduler(2);
+  auto future = scheduler.Commit(TaskPriority::kHigh, []() -> Status { return SUCCESS; });
+  ASSERT_TRUE(future.valid());
+  EXPECT_EQ(future.get(), SUCCESS);
+}
+
+TEST_F(UtestTaskScheduler, group_then_after_all) {
+  TaskScheduler scheduler(4);
+  std::atomic<int> count(0);
+  std::atomic<int> count_in_continuation(-1);
+  TaskGroup group(TaskPriority::kNormal, scheduler);
+  for (int i = 0; i < 100; ++i) {
+    group.Commit([&count]() { ++count; });
+  }
+  std::promise<void> done;
+  group.Then([&count, &count_in_continuation, &done]() {
+    count_in_continuation = count.load();
+    done.set_value();
+  });
+  group.Wait();
+  done.get_future().wait();
+  EXPECT_EQ(count_in_continuation.load(), 100);
+}
+
+TEST_F(UtestTaskScheduler, nested_wait_on_worker) {
+  TaskScheduler scheduler(1);
+  auto future = scheduler.Commit([&scheduler]() {
+    std::atomic<int> count(0);
+    TaskGroup inner(TaskPriority::kNormal, scheduler);
+    for (int i = 0; i < 10; ++i) {
+      inner.Commit([&count]() { ++count; });
+    }
+    // only one worker, waiting must run the inner tasks itself
+    inner.Wait();
+    return count.load();
+  });
+  EXPECT_EQ(future.get(), 10);
+}
+
+TEST_F(UtestTaskScheduler, wait_not_run_tasks_of_other_groups) {
+  TaskScheduler scheduler(1);
+  std::atomic<bool> in_wait(false);
+  std::promise<bool> run_in_wait;
+  auto future = scheduler.Commit([&scheduler, &in_wait, &run_in_wait]() {
+    // queued before the task of the group, a helping waiter would run it first
+    scheduler.Commit([&in_wait, &run_in_wait]() { run_in_wait.set_value(in_wait.load()); });
+    std::atomic<int> count(0);
+    TaskGroup inner(TaskPriority::kNormal, scheduler);
+    inner.Commit([&count]() { ++count; });
+    in_wait = true;
+    inner.Wait();
+    in_wait = false;
+    return count.load();
+  });
+  EXPECT_EQ(future.get(), 1);
+  // the other task runs on the only worker after the waiting task
+  EXPECT_FALSE(run_in_wait.get_future().get());
+}
+
+TEST_F(UtestTaskScheduler, commit_after_stop) {
+  std::promise<void> started;
+  std::atomic<bool> got_fail_future(false);
+  auto scheduler = new TaskScheduler(1);
+  scheduler->Commit([scheduler, &started, &got_fail_future]() {
+    started.set_value();
+    // the scheduler is stopped by the destructor while this task runs
+    while (scheduler->Commit([]() {}).valid()) {
+      std::this_thread::yield();
+    }
+    got_fail_future = true;
+  });
+  started.get_future().wait();
+  delete scheduler;
+  EXPECT_TRUE(got_fail_future.load());
+}
+}  // namespace ge
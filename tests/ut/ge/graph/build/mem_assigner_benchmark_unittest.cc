@@ -0,0 +1,358 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "benchmark_utils.h"
+#include "framework/common/types.h"
+#include "graph/utils/graph_utils.h"
+#include "graph/utils/tensor_utils.h"
+
+#define protected public
+#define private public
+#include "graph/build/memory/binary_block_mem_assigner.h"
+#include "graph/build/memory/hybrid_mem_assigner.h"
+#include "graph/build/memory/interval_block_mem_assigner.h"
+#include "graph/build/memory/max_block_mem_assigner.h"
+#undef protected
+#undef private
+
+// Feature map size of the memory assigners on a graph shaped like resnet50: 4 stages of 3, 4, 6, 3 bottleneck
+// blocks, the feature map shrinks by 2 in every stage while the channels grow.
+// Assignment time and memory of all assigners on large synthetic graphs, next to the string keyed symbol lookup
+// and the linear reusable block scan BlockMemAssigner had before, replayed on the same graph. The times and sizes
+// are test properties, see them with --gtest_output=xml; the 100k and 1M tensor cases take minutes and are disabled.
+namespace ge {
+namespace {
+const int kStageBlockNum[] = {3, 4, 6, 3};
+const int64_t kStemOutputSize = 56 * 56 * 256 * 2;
+const int64_t kWorkspaceSize = 64 * 1024;
+const int kLargeGraphStreamNum = 4;
+const int kLargeGraphStreamLayerNum = 1000;
+const uint64_t kLegacyReuseMaxCount = 10;
+
+NodePtr AddNode(ComputeGraphPtr &graph, const std::string &name, const std::string &type, int in_cnt,
+                int64_t out_size, int64_t workspace_size = 0) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>(name, type);
+  GeTensorDesc tensor_desc;
+  TensorUtils::SetSize(tensor_desc, out_size);
+  for (int i = 0; i < in_cnt; ++i) {
+    op_desc->AddInputDesc(tensor_desc);
+  }
+  op_desc->AddOutputDesc(tensor_desc);
+  if (workspace_size > 0) {
+    op_desc->SetWorkspaceBytes({workspace_size});
+  }
+  op_desc->SetStreamId(0);
+  return graph->AddNode(op_desc);
+}
+
+NodePtr AddConv(ComputeGraphPtr &graph, const std::string &name, const NodePtr &input, int64_t out_size) {
+  auto conv = AddNode(graph, name, CONVOLUTION, 1, out_size, kWorkspaceSize);
+  GraphUtils::AddEdge(input->GetOutDataAnchor(0), conv->GetInDataAnchor(0));
+  return conv;
+}
+
+ComputeGraphPtr BuildResnetLikeGraph() {
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("resnet_like");
+  auto tail = AddNode(graph, "data", DATA, 0, 224 * 224 * 3 * 2);
+  tail = AddConv(graph, "stem", tail, kStemOutputSize);
+
+  int64_t out_size = kStemOutputSize;
+  for (size_t stage = 0; stage < sizeof(kStageBlockNum) / sizeof(kStageBlockNum[0]); ++stage) {
+    for (int block = 0; block < kStageBlockNum[stage]; ++block) {
+      std::string prefix = "stage" + std::to_string(stage) + "_block" + std::to_string(block) + "_";
+      // the first block of a stage halves the height and width and doubles the channels
+      int64_t block_out_size = (stage > 0 && block == 0) ? out_size / 2 : out_size;
+      auto conv1 = AddConv(graph, prefix + "conv1", tail, block_out_size / 4);
+      auto conv2 = AddConv(graph, prefix + "conv2", conv1, block_out_size / 4);
+      auto conv3 = AddConv(graph, prefix + "conv3", conv2, block_out_size);
+      NodePtr shortcut = tail;
+      if (block == 0) {
+        shortcut = AddConv(graph, prefix + "shortcut", tail, block_out_size);
+      }
+      auto add = AddNode(graph, prefix + "add", ADD, 2, block_out_size);
+      GraphUtils::AddEdge(conv3->GetOutDataAnchor(0), add->GetInDataAnchor(0));
+      GraphUtils::AddEdge(shortcut->GetOutDataAnchor(0), add->GetInDataAnchor(1));
+      auto relu = AddNode(graph, prefix + "relu", RELU, 1, block_out_size);
+      GraphUtils::AddEdge(add->GetOutDataAnchor(0), relu->GetInDataAnchor(0));
+      tail = relu;
+      out_size = block_out_size;
+    }
+  }
+
+  auto pool = AddNode(graph, "pool", POOLING, 1, 2048 * 2);
+  GraphUtils::AddEdge(tail->GetOutDataAnchor(0), pool->GetInDataAnchor(0));
+  auto net_output = AddNode(graph, "net_output", NETOUTPUT, 1, 2048 * 2);
+  GraphUtils::AddEdge(pool->GetOutDataAnchor(0), net_output->GetInDataAnchor(0));
+  graph->TopologicalSorting();
+  return graph;
+}
+
+// every layer is an Add of the last two layers, so every tensor is read twice. The layers are put on the streams
+// in turn, kLargeGraphStreamLayerNum layers at a time
+ComputeGraphPtr BuildLargeGraph(int tensor_num) {
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("large_" + std::to_string(tensor_num));
+  auto prev = AddNode(graph, "data", DATA, 0, 1024);
+  auto tail = AddConv(graph, "conv", prev, 1024);
+  for (int layer = 0; layer < tensor_num; ++layer) {
+    // a few different sizes, so the free lists of several sizes are in use at the same time
+    int64_t out_size = 1024 * (1 + layer % 7);
+    auto add = AddNode(graph, "add_" + std::to_string(layer), ADD, 2, out_size, (layer % 3 == 0) ? kWorkspaceSize : 0);
+    add->GetOpDesc()->SetStreamId((layer / kLargeGraphStreamLayerNum) % kLargeGraphStreamNum);
+    GraphUtils::AddEdge(tail->GetOutDataAnchor(0), add->GetInDataAnchor(0));
+    GraphUtils::AddEdge(prev->GetOutDataAnchor(0), add->GetInDataAnchor(1));
+    prev = tail;
+    tail = add;
+  }
+  auto net_output = AddNode(graph, "net_output", NETOUTPUT, 1, 1024);
+  GraphUtils::AddEdge(tail->GetOutDataAnchor(0), net_output->GetInDataAnchor(0));
+  graph->TopologicalSorting();
+  return graph;
+}
+
+// the time and the memory of the assigner are recorded as <name>_us and <name>_bytes
+template <typename Assigner>
+size_t RunAssigner(const std::string &name, Assigner &assigner) {
+  ut::BenchmarkTimer timer;
+  EXPECT_EQ(assigner.Assign(), SUCCESS);
+  (void)timer.Record(name);
+  testing::Test::RecordProperty(name + "_bytes", std::to_string(assigner.GetMemOffset()));
+  return assigner.GetMemOffset();
+}
+}  // namespace
+
+class UtestMemAssignerBenchmark : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestMemAssignerBenchmark, resnet_like_feature_map) {
+  auto graph = BuildResnetLikeGraph();
+  std::map<std::string, std::string> anchor_to_symbol;
+  std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors;
+  ASSERT_EQ(GraphUtils::GetRefMapping(graph, symbol_to_anchors, anchor_to_symbol), GRAPH_SUCCESS);
+
+  BinaryBlockMemAssigner binary_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  MaxBlockMemAssigner max_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  IntervalBlockMemAssigner interval_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  size_t binary_size = RunAssigner("binary_block", binary_assigner);
+  size_t max_size = RunAssigner("max_block", max_assigner);
+  size_t interval_size = RunAssigner("interval", interval_assigner);
+  size_t block_size = std::min(binary_size, max_size);
+  testing::Test::RecordProperty("interval_saved_bytes",
+                                std::to_string(interval_size < block_size ? block_size - interval_size : 0));
+
+  // the interval planner places the blocks of the binary method, it never uses more memory than stacking them
+  EXPECT_LE(interval_size, binary_size);
+
+  HybridMemAssigner hybrid_assigner(graph);
+  EXPECT_EQ(hybrid_assigner.Assign(), SUCCESS);
+  EXPECT_EQ(hybrid_assigner.GetMemOffset(), std::min(block_size, interval_size));
+}
+
+namespace {
+///
+/// @brief the reusable blocks of a stream before the size ordered free lists: a vector in release order which is
+/// scanned from the front, with the idle count of every size kept under a string key
+///
+class LegacyReusableBlocks {
+ public:
+  void Release(MemoryBlock *block) {
+    blocks_.emplace_back(block);
+    ++counts_[Key(*block)];
+  }
+
+  MemoryBlock *Take(size_t block_size) {
+    for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+      MemoryBlock *block = *it;
+      bool can_reuse = (block->Size() == block_size);
+      if (!can_reuse) {
+        auto count = counts_.find(Key(*block));
+        can_reuse = (count != counts_.end()) && (count->second > kLegacyReuseMaxCount) && (block->Size() > block_size);
+      }
+      if (can_reuse) {
+        --counts_[Key(*block)];
+        blocks_.erase(it);
+        return block;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  static std::string Key(const MemoryBlock &block) {
+    return std::to_string(block.Size()) + "_" + std::to_string(block.stream_id_);
+  }
+
+  std::vector<MemoryBlock *> blocks_;
+  std::map<std::string, uint64_t> counts_;
+};
+
+class ReusableBlocksOfAssigner {
+ public:
+  explicit ReusableBlocksOfAssigner(BlockMemAssigner &assigner) : assigner_(assigner) {}
+
+  void Release(MemoryBlock *block) { blocks_[block->Size()].emplace_back(block); }
+
+  MemoryBlock *Take(size_t block_size) { return assigner_.TakeReusableBlock(blocks_, block_size); }
+
+ private:
+  BlockMemAssigner &assigner_;
+  ReusableBlocks blocks_;
+};
+
+///
+/// @brief apply and release the outputs and workspaces of the graph in topological order, every output is released
+/// after its last reader. The blocks are looked up in the reusable blocks of the stream of the node
+/// @return bytes of the blocks created
+///
+template <typename Reusable, typename... Args>
+size_t ReplayReuse(const ComputeGraphPtr &graph, Args &... args) {
+  std::map<int64_t, Reusable> stream_blocks;
+  std::vector<std::unique_ptr<MemoryBlock>> created;
+  std::unordered_map<const Node *, std::vector<MemoryBlock *>> out_blocks;
+  std::unordered_map<const Node *, size_t> reader_counts;
+  size_t created_size = 0;
+  auto apply = [&](Reusable &reusable, size_t size, int64_t stream_id) {
+    size_t block_size = (size + MEM_ALIGN_SIZE - 1) / MEM_ALIGN_SIZE * MEM_ALIGN_SIZE;
+    MemoryBlock *block = reusable.Take(block_size);
+    if (block == nullptr) {
+      created.emplace_back(new MemoryBlock(block_size, stream_id));
+      block = created.back().get();
+      created_size += block_size;
+    }
+    return block;
+  };
+
+  for (const auto &node : graph->GetDirectNode()) {
+    auto op_desc = node->GetOpDesc();
+    int64_t stream_id = op_desc->GetStreamId();
+    auto it = stream_blocks.find(stream_id);
+    if (it == stream_blocks.end()) {
+      it = stream_blocks.emplace(stream_id, Reusable(args...)).first;
+    }
+    Reusable &reusable = it->second;
+    for (size_t i = 0; i < op_desc->GetOutputsSize(); ++i) {
+      int64_t size = 0;
+      (void)TensorUtils::GetSize(op_desc->GetOutputDesc(i), size);
+      out_blocks[node.get()].emplace_back(apply(reusable, static_cast<size_t>(size), stream_id));
+    }
+    reader_counts[node.get()] = node->GetOutDataNodes().size();
+    for (auto workspace_size : op_desc->GetWorkspaceBytes()) {
+      reusable.Release(apply(reusable, static_cast<size_t>(workspace_size), stream_id));
+    }
+    for (const auto &in_node : node->GetInDataNodes()) {
+      if (--reader_counts[in_node.get()] == 0) {
+        for (auto block : out_blocks[in_node.get()]) {
+          reusable.Release(block);
+        }
+      }
+    }
+  }
+  return created_size;
+}
+
+void RunReuseLookup(const ComputeGraphPtr &graph, BlockMemAssigner &assigner) {
+  ut::BenchmarkTimer legacy_timer;
+  size_t legacy_size = ReplayReuse<LegacyReusableBlocks>(graph);
+  (void)legacy_timer.Record("legacy_reuse_lookup");
+  ut::BenchmarkTimer timer;
+  size_t size = ReplayReuse<ReusableBlocksOfAssigner>(graph, assigner);
+  (void)timer.Record("reuse_lookup");
+  testing::Test::RecordProperty("legacy_reuse_lookup_bytes", std::to_string(legacy_size));
+  testing::Test::RecordProperty("reuse_lookup_bytes", std::to_string(size));
+  EXPECT_GT(size, 0);
+}
+
+void RunSymbolLookup(const ComputeGraphPtr &graph, const std::map<std::string, std::string> &anchor_to_symbol,
+                     const std::map<std::string, std::list<NodeIndexIO>> &symbol_to_anchors,
+                     BlockMemAssigner &assigner) {
+  // the reuse flags were kept by symbol string
+  std::map<std::string, bool> legacy_flags;
+  for (const auto &pair : symbol_to_anchors) {
+    legacy_flags[pair.first] = true;
+  }
+  ut::BenchmarkTimer legacy_timer;
+  size_t legacy_found = 0;
+  for (const auto &node : graph->GetDirectNode()) {
+    for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
+      auto symbol = anchor_to_symbol.find(NodeIndexIO(node, out_anchor->GetIdx(), kOut).ToString());
+      if ((symbol != anchor_to_symbol.end()) && legacy_flags[symbol->second]) {
+        ++legacy_found;
+      }
+    }
+  }
+  (void)legacy_timer.Record("legacy_symbol_lookup");
+
+  ut::BenchmarkTimer timer;
+  assigner.InitSymbolIds();
+  assigner.pre_reuse_flag_.assign(assigner.pre_reuse_flag_.size(), true);
+  size_t found = 0;
+  for (const auto &node : graph->GetDirectNode()) {
+    for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
+      int64_t symbol_id = assigner.GetSymbolId(node, static_cast<uint32_t>(out_anchor->GetIdx()));
+      if ((symbol_id != kInvalidSymbolId) && assigner.pre_reuse_flag_[symbol_id]) {
+        ++found;
+      }
+    }
+  }
+  (void)timer.Record("symbol_lookup");
+  EXPECT_EQ(found, legacy_found);
+  EXPECT_GT(found, 0);
+}
+
+void RunLargeGraph(int tensor_num) {
+  auto graph = BuildLargeGraph(tensor_num);
+  std::map<std::string, std::string> anchor_to_symbol;
+  std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors;
+  ASSERT_EQ(GraphUtils::GetRefMapping(graph, symbol_to_anchors, anchor_to_symbol), GRAPH_SUCCESS);
+
+  BinaryBlockMemAssigner lookup_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  RunSymbolLookup(graph, anchor_to_symbol, symbol_to_anchors, lookup_assigner);
+  RunReuseLookup(graph, lookup_assigner);
+
+  BinaryBlockMemAssigner binary_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  MaxBlockMemAssigner max_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  IntervalBlockMemAssigner interval_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  HybridMemAssigner hybrid_assigner(graph);
+  size_t binary_size = RunAssigner("binary_block", binary_assigner);
+  size_t max_size = RunAssigner("max_block", max_assigner);
+  size_t interval_size = RunAssigner("interval", interval_assigner);
+  size_t hybrid_size = RunAssigner("hybrid", hybrid_assigner);
+  // only the last layers of every stream are alive at the same time
+  EXPECT_GT(binary_size, 0);
+  EXPECT_LT(binary_size, static_cast<size_t>(tensor_num) * 1024);
+  EXPECT_LT(max_size, static_cast<size_t>(tensor_num) * 1024);
+  EXPECT_LE(interval_size, binary_size);
+  EXPECT_EQ(hybrid_size, std::min(std::min(binary_size, max_size), interval_size));
+}
+}  // namespace
+
+TEST_F(UtestMemAssignerBenchmark, large_graph_10k) { RunLargeGraph(10000); }
+
+TEST_F(UtestMemAssignerBenchmark, DISABLED_large_graph_100k) { RunLargeGraph(100000); }
+
+TEST_F(UtestMemAssignerBenchmark, DISABLED_large_graph_1m) { RunLargeGraph(1000000); }
+}  // namespace ge
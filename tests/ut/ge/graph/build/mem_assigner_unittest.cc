@@ -30,6 +30,7 @@
 #define private public
 #include "graph/build/memory/binary_block_mem_assigner.h"
 #include "graph/build/memory/hybrid_mem_assigner.h"
+#include "graph/build/memory/interval_block_mem_assigner.h"
 #include "graph/build/memory/max_block_mem_assigner.h"
 #undef protected
 #undef private
@@ -181,3 +182,113 @@ TEST_F(UtestMemoryAssignerTest, Mock_block_mem_assigner_failed) {
 
   EXPECT_EQ(mock_assigner.Assign(), FAILED);
 }
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_not_larger_than_binary) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  make_graph(graph);
+  std::map<std::string, std::string> anchor_to_symbol;
+  std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors;
+  EXPECT_EQ(GraphUtils::GetRefMapping(graph, symbol_to_anchors, anchor_to_symbol), GRAPH_SUCCESS);
+
+  BinaryBlockMemAssigner binary_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  IntervalBlockMemAssigner interval_assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  EXPECT_EQ(binary_assigner.Assign(), SUCCESS);
+  EXPECT_EQ(interval_assigner.Assign(), SUCCESS);
+  EXPECT_LE(interval_assigner.GetMemOffset(), binary_assigner.GetMemOffset());
+
+  HybridMemAssigner hybrid_assigner(graph);
+  EXPECT_EQ(hybrid_assigner.Assign(), SUCCESS);
+  EXPECT_LE(hybrid_assigner.GetMemOffset(), interval_assigner.GetMemOffset());
+}
+
+namespace {
+// a block for the output of a node alive in [begin, end] of stream 0
+MemoryBlock *AddLiveBlock(ge::ComputeGraphPtr &graph, BlockMemAssigner &assigner, size_t size, int64_t begin,
+                          size_t end, bool reuse_mem = true) {
+  ge::OpDescPtr op_desc = make_shared<ge::OpDesc>("node_" + std::to_string(assigner.blocks_store_.size()), "some");
+  op_desc->SetId(begin);
+  op_desc->SetStreamId(0);
+  ge::NodePtr node = graph->AddNode(op_desc);
+  MemoryBlock *block = new MemoryBlock(size, 0, reuse_mem);
+  block->Init(size, kOutput, node, 0, size);
+  block->SetLifeTimeEnd(end);
+  assigner.blocks_store_.emplace_back(block);
+  assigner.memory_blocks_.emplace_back(block);
+  return block;
+}
+
+// blocks sharing memory must not be alive at the same time, blocks which are not reused share nothing
+void ExpectLiveBlocksNotOverlapped(const std::vector<MemoryBlock *> &blocks) {
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    for (size_t j = i + 1; j < blocks.size(); ++j) {
+      MemoryBlock *left = blocks[i];
+      MemoryBlock *right = blocks[j];
+      bool mem_overlapped = (left->HeadOffset() <= right->TailOffset()) && (right->HeadOffset() <= left->TailOffset());
+      if (!mem_overlapped) {
+        continue;
+      }
+      EXPECT_TRUE(left->reuse_mem_ && right->reuse_mem_) << "block " << i << " and " << j;
+      bool life_overlapped =
+        (left->GetLifeBegin() <= right->GetLifeEnd()) && (right->GetLifeBegin() <= left->GetLifeEnd());
+      EXPECT_FALSE(life_overlapped) << "block " << i << " and " << j;
+    }
+  }
+}
+}  // namespace
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_fills_gap) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  std::map<std::string, std::string> anchor_to_symbol;
+  std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors;
+  IntervalBlockMemAssigner assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  assigner.is_life_reuse_ = true;
+  // b and c are alive together after a, stacking needs a + b + c
+  MemoryBlock *a = AddLiveBlock(graph, assigner, 102400, 0, 2);
+  MemoryBlock *b = AddLiveBlock(graph, assigner, 61440, 3, 5);
+  MemoryBlock *c = AddLiveBlock(graph, assigner, 40960, 4, 5);
+  assigner.ResizeMemoryBlocks();
+
+  EXPECT_EQ(assigner.GetMemOffset(), 102400);
+  EXPECT_EQ(a->HeadOffset(), 0);
+  EXPECT_EQ(b->HeadOffset(), 0);
+  EXPECT_EQ(c->HeadOffset(), 61440);
+  EXPECT_EQ(c->TailOffset(), 102399);
+  ExpectLiveBlocksNotOverlapped(assigner.memory_blocks_);
+}
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_live_blocks_not_overlapped) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  std::map<std::string, std::string> anchor_to_symbol;
+  std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors;
+  IntervalBlockMemAssigner assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  assigner.is_life_reuse_ = true;
+  size_t stacked_size = 0;
+  uint32_t seed = 1;
+  for (int64_t i = 0; i < 300; ++i) {
+    seed = seed * 1103515245U + 12345U;
+    size_t size = 512 * (1 + (seed >> 16) % 64);
+    size_t end = i + (seed >> 8) % 20;
+    // every 7th block is not reusable and must not share memory with any other
+    (void)AddLiveBlock(graph, assigner, size, i, end, i % 7 != 0);
+    stacked_size += size;
+  }
+  assigner.ResizeMemoryBlocks();
+
+  EXPECT_LT(assigner.GetMemOffset(), stacked_size);
+  ExpectLiveBlocksNotOverlapped(assigner.memory_blocks_);
+}
+
+TEST_F(UtestMemoryAssignerTest, interval_block_mem_assigner_stacks_without_life_reuse) {
+  ge::ComputeGraphPtr graph = make_shared<ge::ComputeGraph>("");
+  std::map<std::string, std::string> anchor_to_symbol;
+  std::map<std::string, std::list<NodeIndexIO>> symbol_to_anchors;
+  IntervalBlockMemAssigner assigner(graph, anchor_to_symbol, symbol_to_anchors);
+  assigner.is_life_reuse_ = false;
+  MemoryBlock *a = AddLiveBlock(graph, assigner, 102400, 0, 2);
+  MemoryBlock *b = AddLiveBlock(graph, assigner, 61440, 3, 5);
+  assigner.ResizeMemoryBlocks();
+
+  EXPECT_EQ(assigner.GetMemOffset(), 102400 + 61440);
+  EXPECT_EQ(a->HeadOffset(), 0);
+  EXPECT_EQ(b->HeadOffset(), 102400);
+}
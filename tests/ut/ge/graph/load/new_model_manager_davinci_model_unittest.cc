@@ -15,6 +15,10 @@
  */
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "common/debug/log.h"
 #include "common/debug/memory_dumper.h"
 #include "common/types.h"
@@ -1437,4 +1441,378 @@ TEST_F(UtestModelManagerDavinciModel, init_tbe_handle_ge_registered) {
   EXPECT_EQ(it->second, 3);
   DavinciModel::tvm_bin_kernel_.clear();
 }
+
+TEST_F(UtestModelManagerDavinciModel, init_pipeline_not_supported) {
+  DavinciModel model(0, g_label_call_back);
+  unsetenv("GE_MODEL_PIPELINE_DEPTH");
+  EXPECT_EQ(model.InitPipeline(), SUCCESS);
+  EXPECT_EQ(model.pipeline_depth_, 1);
+
+  // model without output op runs requests one by one
+  setenv("GE_MODEL_PIPELINE_DEPTH", "2", 1);
+  EXPECT_EQ(model.InitPipeline(), SUCCESS);
+  EXPECT_EQ(model.pipeline_depth_, 1);
+  EXPECT_TRUE(model.pipeline_slots_.empty());
+  unsetenv("GE_MODEL_PIPELINE_DEPTH");
+}
+
+TEST_F(UtestModelManagerDavinciModel, init_pipeline_success) {
+  DavinciModel model(0, g_label_call_back);
+  model.output_op_list_.push_back(CreateOpDesc("output", NETOUTPUT));
+  setenv("GE_MODEL_PIPELINE_DEPTH", "16", 1);
+  EXPECT_EQ(model.InitPipeline(), SUCCESS);
+  EXPECT_EQ(model.pipeline_depth_, 8);
+  EXPECT_EQ(model.pipeline_slots_.size(), 8);
+  unsetenv("GE_MODEL_PIPELINE_DEPTH");
+
+  model.ReleasePipeline();
+  EXPECT_EQ(model.pipeline_depth_, 1);
+  EXPECT_TRUE(model.pipeline_slots_.empty());
+  model.output_op_list_.clear();
+}
+
+namespace {
+const int64_t kPipelineInputSize = 16;
+
+// records the results in the order they are returned, the first one can be held to keep requests in flight
+class PipelineListener : public ModelListener {
+ public:
+  Status OnComputeDone(uint32_t model_id, uint32_t data_index, uint32_t result_code,
+                       std::vector<ge::OutputTensorInfo> &outputs) override {
+    std::unique_lock<std::mutex> lk(mu_);
+    results_.emplace_back(data_index, result_code);
+    cv_.notify_all();
+    cv_.wait(lk, [this]() { return !hold_first_ || released_; });
+    return SUCCESS;
+  }
+
+  bool WaitForResults(size_t num) {
+    std::unique_lock<std::mutex> lk(mu_);
+    return cv_.wait_for(lk, std::chrono::seconds(10), [this, num]() { return results_.size() >= num; });
+  }
+
+  void ReleaseFirst() {
+    std::lock_guard<std::mutex> lk(mu_);
+    released_ = true;
+    cv_.notify_all();
+  }
+
+  std::vector<std::pair<uint32_t, uint32_t>> GetResults() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return results_;
+  }
+
+  bool hold_first_ = false;
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool released_ = false;
+  std::vector<std::pair<uint32_t, uint32_t>> results_;
+};
+
+// pipelined model of depth 2 with one input, requests with a larger input fail to launch
+void StartPipelinedModel(DavinciModel &model, uint8_t *input_addr) {
+  model.output_op_list_.push_back(CreateOpDesc("output", NETOUTPUT));
+  model.new_input_data_info_[0].data_size_ = kPipelineInputSize;
+  model.new_input_data_info_[0].basic_addr_ = input_addr;
+  model.data_inputer_ = new DataInputer();
+  setenv("GE_MODEL_PIPELINE_DEPTH", "2", 1);
+  ASSERT_EQ(model.ModelRunStart(), SUCCESS);
+  unsetenv("GE_MODEL_PIPELINE_DEPTH");
+  ASSERT_EQ(model.pipeline_depth_, 2);
+}
+
+void PushRequest(DavinciModel &model, uint32_t index, uint8_t *data, uint64_t length) {
+  InputData input_data;
+  input_data.index = index;
+  input_data.model_id = 0;
+  input_data.blobs.push_back({data, length, false});
+  auto data_wrapper = std::make_shared<InputDataWrapper>();
+  ASSERT_EQ(data_wrapper->Init(input_data, OutputData()), SUCCESS);
+  ASSERT_EQ(model.GetDataInputer()->Push(data_wrapper), SUCCESS);
+}
+}  // namespace
+
+TEST_F(UtestModelManagerDavinciModel, run_pipelined_results_in_order) {
+  auto listener = std::make_shared<PipelineListener>();
+  DavinciModel model(0, listener);
+  uint8_t input_mem[kPipelineInputSize] = {0};
+  uint8_t data[kPipelineInputSize] = {0};
+  StartPipelinedModel(model, input_mem);
+
+  // four times the depth, the slots are reused
+  const uint32_t request_num = 8;
+  for (uint32_t i = 0; i < request_num; ++i) {
+    PushRequest(model, i, data, sizeof(data));
+  }
+  ASSERT_TRUE(listener->WaitForResults(request_num));
+  EXPECT_EQ(model.ModelRunStop(), SUCCESS);
+
+  auto results = listener->GetResults();
+  ASSERT_EQ(results.size(), request_num);
+  for (uint32_t i = 0; i < request_num; ++i) {
+    EXPECT_EQ(results[i].first, i);
+    EXPECT_EQ(results[i].second, SUCCESS);
+  }
+  EXPECT_EQ(model.iterator_count_, request_num);
+  EXPECT_TRUE(model.pipeline_slots_.empty());
+}
+
+TEST_F(UtestModelManagerDavinciModel, run_pipelined_failed_request_releases_slot) {
+  auto listener = std::make_shared<PipelineListener>();
+  DavinciModel model(0, listener);
+  uint8_t input_mem[kPipelineInputSize] = {0};
+  uint8_t data[kPipelineInputSize * 2] = {0};
+  StartPipelinedModel(model, input_mem);
+
+  // request 1 is larger than the model input, the requests after it still get slots and complete in order
+  const uint32_t request_num = 6;
+  for (uint32_t i = 0; i < request_num; ++i) {
+    PushRequest(model, i, data, (i == 1) ? sizeof(data) : kPipelineInputSize);
+  }
+  ASSERT_TRUE(listener->WaitForResults(request_num));
+  EXPECT_EQ(model.ModelRunStop(), SUCCESS);
+
+  auto results = listener->GetResults();
+  ASSERT_EQ(results.size(), request_num);
+  for (uint32_t i = 0; i < request_num; ++i) {
+    EXPECT_EQ(results[i].first, i);
+    EXPECT_EQ(results[i].second, (i == 1) ? INTERNAL_ERROR : SUCCESS);
+  }
+  EXPECT_EQ(model.iterator_count_, request_num - 1);
+}
+
+TEST_F(UtestModelManagerDavinciModel, run_pipelined_stop_with_requests_in_flight) {
+  auto listener = std::make_shared<PipelineListener>();
+  listener->hold_first_ = true;
+  DavinciModel model(0, listener);
+  uint8_t input_mem[kPipelineInputSize] = {0};
+  uint8_t data[kPipelineInputSize] = {0};
+  StartPipelinedModel(model, input_mem);
+
+  const uint32_t request_num = 10;
+  for (uint32_t i = 0; i < request_num; ++i) {
+    PushRequest(model, i, data, sizeof(data));
+  }
+  // request 0 is being returned, request 1 is in flight and request 2 waits for a free slot
+  ASSERT_TRUE(listener->WaitForResults(1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  Status stop_ret = FAILED;
+  std::thread stop_thread([&model, &stop_ret]() { stop_ret = model.ModelRunStop(); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  listener->ReleaseFirst();
+  stop_thread.join();
+  EXPECT_EQ(stop_ret, SUCCESS);
+
+  // the requests launched before the stop are all returned, in order, and no others
+  auto results = listener->GetResults();
+  ASSERT_EQ(results.size(), 3);
+  for (uint32_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].first, i);
+    EXPECT_EQ(results[i].second, SUCCESS);
+  }
+  EXPECT_FALSE(model.thread_id_.joinable());
+  EXPECT_FALSE(model.pipeline_thread_.joinable());
+  EXPECT_TRUE(model.pipeline_slots_.empty());
+  EXPECT_EQ(model.pipeline_depth_, 1);
+}
+
+TEST_F(UtestModelManagerDavinciModel, zero_copy_args_index) {
+  DavinciModel model(0, g_label_call_back);
+  uint8_t args[4 * sizeof(uintptr_t)] = {0};
+  uintptr_t virtual_addrs[] = {0x1000, 0x2000};
+
+  ZeroCopyTask default_task("default", args, sizeof(args));
+  EXPECT_EQ(default_task.SetTaskArgsOffset(virtual_addrs[0], 0), SUCCESS);
+  EXPECT_EQ(default_task.SetTaskArgsOffset(virtual_addrs[0], sizeof(uintptr_t)), SUCCESS);
+  default_task.SetOriginalArgs(args, sizeof(args));
+  default_task.SetBatchLabel("Batch_default");
+  model.zero_copy_tasks_.emplace_back(default_task);
+
+  ZeroCopyTask batch_task("batch", args, sizeof(args));
+  EXPECT_EQ(batch_task.SetTaskArgsOffset(virtual_addrs[1], 2 * sizeof(uintptr_t)), SUCCESS);
+  batch_task.SetOriginalArgs(args, sizeof(args));
+  batch_task.SetBatchLabel("Batch_0");
+  model.zero_copy_tasks_.emplace_back(batch_task);
+
+  const auto &args_index = model.GetZeroCopyArgsIndex("Batch_0");
+  EXPECT_EQ(args_index.size(), 2);
+  EXPECT_EQ(args_index.at(virtual_addrs[0]).size(), 2);
+  EXPECT_EQ(args_index.at(virtual_addrs[1]).size(), 1);
+  EXPECT_EQ(args_index.at(virtual_addrs[1])[0].task, &model.zero_copy_tasks_[1]);
+
+  // tasks of other batch labels are not patched
+  const auto &other_index = model.GetZeroCopyArgsIndex("Batch_1");
+  EXPECT_EQ(other_index.size(), 1);
+  EXPECT_EQ(other_index.count(virtual_addrs[1]), 0);
+  EXPECT_EQ(model.zero_copy_args_index_.size(), 2);
+}
+
+TEST_F(UtestModelManagerDavinciModel, distribute_zero_copy_args) {
+  DavinciModel model(0, g_label_call_back);
+  // args of three te kernels, one aicpu kernel and one memcpy addr task are carved from one allocation
+  ModelTaskDef model_task_def;
+  for (int i = 0; i < 4; ++i) {
+    domi::TaskDef *task = model_task_def.add_task();
+    task->set_type(RT_MODEL_TASK_KERNEL);
+    task->mutable_kernel()->set_args_size(2 * sizeof(uintptr_t));
+    auto kernel_type = (i < 3) ? cce::ccKernelType::TE : cce::ccKernelType::AI_CPU;
+    task->mutable_kernel()->mutable_context()->set_kernel_type(static_cast<uint32_t>(kernel_type));
+  }
+  model_task_def.add_task()->set_type(RT_MODEL_TASK_MEMCPY_ADDR_ASYNC);
+  ASSERT_EQ(model.MallocTaskArgsMem(model_task_def), SUCCESS);
+  EXPECT_EQ(model.task_args_mem_size_, 5 * 64);
+
+  std::vector<uint8_t *> args;
+  for (int i = 0; i < 5; ++i) {
+    args.emplace_back(static_cast<uint8_t *>(model.CarveTaskArgs(2 * sizeof(uintptr_t))));
+    ASSERT_NE(args.back(), nullptr);
+  }
+  EXPECT_EQ(args[1], args[0] + 64);
+  EXPECT_EQ(model.CarveTaskArgs(1), nullptr);
+
+  // tasks 0, 2 and 4 are zero copy, saved out of order, task 1 and 3 are not
+  uint8_t own_args[2 * sizeof(uintptr_t)] = {0};
+  for (uint8_t *task_args : {args[4], args[0], args[2], own_args}) {
+    ZeroCopyTask task("task", task_args, 2 * sizeof(uintptr_t));
+    EXPECT_EQ(task.SetTaskArgsOffset(0x1000, sizeof(uintptr_t)), SUCCESS);
+    task.SetOriginalArgs(task_args, 2 * sizeof(uintptr_t));
+    model.zero_copy_tasks_.emplace_back(task);
+  }
+
+  uintptr_t user_addr = 0x3000;
+  for (size_t i = 0; i < 3; ++i) {
+    model.zero_copy_tasks_[i].SetTaskParam(sizeof(uintptr_t), reinterpret_cast<void *>(user_addr));
+  }
+  EXPECT_EQ(model.DistributeZeroCopyArgs(), SUCCESS);
+  // one copy for all carved args
+  EXPECT_EQ(model.zero_copy_args_copy_num_, 1);
+  ASSERT_EQ(model.zero_copy_args_layout_.size(), 4);
+  EXPECT_EQ(model.zero_copy_args_layout_[0].second, 4 * 64);
+  EXPECT_EQ(model.zero_copy_args_layout_[1].second, 0);
+  EXPECT_EQ(model.zero_copy_args_layout_[3].second, SIZE_MAX);
+  EXPECT_EQ(model.zero_copy_args_host_.size(), 5 * 64);
+  auto host_args = model.zero_copy_args_host_.data();
+  for (size_t offset : {0, 2 * 64, 4 * 64}) {
+    EXPECT_EQ(*reinterpret_cast<uintptr_t *>(host_args + offset + sizeof(uintptr_t)), user_addr);
+  }
+  for (const auto &task : model.zero_copy_tasks_) {
+    EXPECT_FALSE(task.IsUpdated());
+  }
+
+  // not updated, nothing to copy
+  EXPECT_EQ(model.DistributeZeroCopyArgs(), SUCCESS);
+  EXPECT_EQ(model.zero_copy_args_copy_num_, 0);
+
+  // the task with its own args is copied separately
+  model.zero_copy_tasks_[1].SetTaskParam(sizeof(uintptr_t), reinterpret_cast<void *>(user_addr));
+  model.zero_copy_tasks_[3].SetTaskParam(sizeof(uintptr_t), reinterpret_cast<void *>(user_addr));
+  EXPECT_EQ(model.DistributeZeroCopyArgs(), SUCCESS);
+  EXPECT_EQ(model.zero_copy_args_copy_num_, 2);
+}
+
+TEST_F(UtestModelManagerDavinciModel, distribute_zero_copy_args_merge_close_ranges) {
+  DavinciModel model(0, g_label_call_back);
+  // three te kernels of 4096 bytes args, and room for one more
+  const size_t args_size = 4096;
+  ModelTaskDef model_task_def;
+  for (int i = 0; i < 4; ++i) {
+    domi::TaskDef *task = model_task_def.add_task();
+    task->set_type(RT_MODEL_TASK_KERNEL);
+    task->mutable_kernel()->set_args_size(args_size);
+    task->mutable_kernel()->mutable_context()->set_kernel_type(static_cast<uint32_t>(cce::ccKernelType::TE));
+  }
+  ASSERT_EQ(model.MallocTaskArgsMem(model_task_def), SUCCESS);
+  std::vector<uint8_t *> args;
+  for (int i = 0; i < 3; ++i) {
+    args.emplace_back(static_cast<uint8_t *>(model.CarveTaskArgs(args_size)));
+    ASSERT_NE(args.back(), nullptr);
+  }
+  for (uint8_t *task_args : args) {
+    ZeroCopyTask task("task", task_args, 2 * sizeof(uintptr_t));
+    EXPECT_EQ(task.SetTaskArgsOffset(0x1000, sizeof(uintptr_t)), SUCCESS);
+    task.SetOriginalArgs(task_args, 2 * sizeof(uintptr_t));
+    model.zero_copy_tasks_.emplace_back(task);
+  }
+
+  // tasks 0 and 2 are a whole args block apart, they are copied separately
+  uintptr_t user_addr = 0x3000;
+  model.zero_copy_tasks_[0].SetTaskParam(sizeof(uintptr_t), reinterpret_cast<void *>(user_addr));
+  model.zero_copy_tasks_[2].SetTaskParam(sizeof(uintptr_t), reinterpret_cast<void *>(user_addr));
+  EXPECT_EQ(model.DistributeZeroCopyArgs(), SUCCESS);
+  EXPECT_EQ(model.zero_copy_args_copy_num_, 2);
+
+  // tasks 0 and 1 are close, they are copied together
+  user_addr = 0x4000;
+  model.zero_copy_tasks_[0].SetTaskParam(sizeof(uintptr_t), reinterpret_cast<void *>(user_addr));
+  model.zero_copy_tasks_[1].SetTaskParam(sizeof(uintptr_t), reinterpret_cast<void *>(user_addr));
+  EXPECT_EQ(model.DistributeZeroCopyArgs(), SUCCESS);
+  EXPECT_EQ(model.zero_copy_args_copy_num_, 1);
+
+  // args carved after the host copy was taken are written by their task, the host copy is taken again
+  ASSERT_NE(model.CarveTaskArgs(args_size), nullptr);
+  EXPECT_EQ(model.DistributeZeroCopyArgs(), SUCCESS);
+  EXPECT_EQ(model.zero_copy_args_host_.size(), 4 * args_size);
+  EXPECT_EQ(model.zero_copy_args_copy_num_, 0);
+}
+
+// kernel task registering its args on the model input for zero copy
+class ZeroCopyKernelTaskStub : public TaskInfo {
+ public:
+  ZeroCopyKernelTaskStub(int64_t op_id, void *input_addr, Status init_ret = SUCCESS)
+      : op_id_(op_id), input_addr_(input_addr), init_ret_(init_ret) {}
+
+  Status Init(const domi::TaskDef &task_def, DavinciModel *davinci_model) override {
+    auto op_desc = std::make_shared<OpDesc>("op_" + std::to_string(op_id_), RELU);
+    op_desc->SetId(op_id_);
+    davinci_model->SetZeroCopyAddr(op_desc, {input_addr_}, args_, args_, sizeof(args_), 0);
+    return init_ret_;
+  }
+
+  Status Distribute() override { return SUCCESS; }
+
+ private:
+  int64_t op_id_;
+  void *input_addr_;
+  Status init_ret_;
+  uint8_t args_[sizeof(void *)] = {0};
+};
+
+TEST_F(UtestModelManagerDavinciModel, init_kernel_tasks_in_parallel) {
+  const int64_t task_num = 1000;
+  uint8_t input_mem[sizeof(void *)] = {0};
+  void *input_addr = input_mem;
+  DavinciModel model(0, g_label_call_back);
+  ZeroCopyOffset &input_offset = model.new_input_outside_addrs_[input_addr];
+  input_offset.addr_count_ = 1;
+  input_offset.outside_addrs_ = {{{input_addr, {}}}};
+  ModelTaskDef model_task_def;
+  for (int64_t i = 0; i < task_num; ++i) {
+    model_task_def.add_task()->set_type(RT_MODEL_TASK_KERNEL);
+    model.task_list_.emplace_back(std::make_shared<ZeroCopyKernelTaskStub>(i, input_addr));
+  }
+  ASSERT_EQ(model.InitTaskInfo(model_task_def), SUCCESS);
+
+  // same tasks in the same order as the serial init, whatever the chunks are scheduled
+  ASSERT_EQ(model.zero_copy_tasks_.size(), task_num);
+  for (int64_t i = 0; i < task_num; ++i) {
+    EXPECT_EQ(model.zero_copy_tasks_[i].GetOpId(), i);
+    EXPECT_EQ(model.zero_copy_tasks_[i].GetTaskArgsOffset().count(reinterpret_cast<uintptr_t>(input_addr)), 1);
+  }
+  EXPECT_EQ(input_offset.outside_addrs_[0][input_addr].size(), task_num);
+}
+
+TEST_F(UtestModelManagerDavinciModel, init_kernel_tasks_in_parallel_failed) {
+  uint8_t input_mem[sizeof(void *)] = {0};
+  void *input_addr = input_mem;
+  DavinciModel model(0, g_label_call_back);
+  ModelTaskDef model_task_def;
+  for (int64_t i = 0; i < 1000; ++i) {
+    model_task_def.add_task()->set_type(RT_MODEL_TASK_KERNEL);
+    Status init_ret = (i == 700) ? PARAM_INVALID : SUCCESS;
+    model.task_list_.emplace_back(std::make_shared<ZeroCopyKernelTaskStub>(i, input_addr, init_ret));
+  }
+  EXPECT_EQ(model.InitTaskInfo(model_task_def), PARAM_INVALID);
+}
 }  // namespace ge
@@ -15,6 +15,9 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <fstream>
+#include <thread>
 
 #include <cce/compiler_stub.h>
 #include "common/debug/log.h"
@@ -441,4 +444,189 @@ TEST_F(UtestModelManagerModelManager, destroy_aicpu_session) {
   manager.DestroyAicpuSession(0);
 }
 
+// test MapFromFile and ReleaseModelData
+TEST_F(UtestModelManagerModelManager, map_model_from_file) {
+  ge::ModelData data;
+  GenUnencryptModelData(data);
+  const std::string model_file = "./ut_map_model_from_file.om";
+  {
+    std::ofstream fs(model_file, std::ios::binary);
+    fs.write(static_cast<const char *>(data.model_data), data.model_len);
+  }
+
+  ge::ModelData mapped_data;
+  EXPECT_EQ(ModelParserBase::MapFromFile(model_file.c_str(), nullptr, 0, mapped_data), SUCCESS);
+  ASSERT_NE(mapped_data.model_data, nullptr);
+  EXPECT_EQ(mapped_data.model_len, data.model_len);
+  EXPECT_EQ(memcmp(mapped_data.model_data, data.model_data, data.model_len), 0);
+
+  uint8_t *model_addr = nullptr;
+  uint32_t model_len = 0;
+  EXPECT_EQ(ModelParserBase::ParseModelContent(mapped_data, model_addr, model_len), SUCCESS);
+  std::shared_ptr<void> holder = ModelParserBase::GetMappedModelHolder(model_addr);
+  EXPECT_NE(holder, nullptr);
+  EXPECT_EQ(ModelParserBase::GetMappedModelHolder(data.model_data), nullptr);
+
+  void *mapped_addr = mapped_data.model_data;
+  ModelParserBase::ReleaseModelData(mapped_data);
+  EXPECT_EQ(mapped_data.model_data, nullptr);
+  EXPECT_EQ(ModelParserBase::GetMappedModelHolder(mapped_addr), nullptr);
+  // still readable through the holder
+  EXPECT_EQ(memcmp(mapped_addr, data.model_data, data.model_len), 0);
+  holder.reset();
+
+  ModelParserBase::ReleaseModelData(data);
+  EXPECT_EQ(data.model_data, nullptr);
+  (void)remove(model_file.c_str());
+}
+
+// test LoadTaskMeta skips the tasks
+TEST_F(UtestModelManagerModelManager, load_task_meta) {
+  domi::ModelTaskDef model_task_def;
+  model_task_def.set_memory_size(1024);
+  model_task_def.set_weight_size(512);
+  model_task_def.set_stream_num(2);
+  model_task_def.add_task()->set_stream_id(1);
+  model_task_def.add_op("op");
+  std::string buffer = model_task_def.SerializeAsString();
+
+  ModelPartition task_partition;
+  task_partition.data = reinterpret_cast<uint8_t *>(&buffer[0]);
+  task_partition.size = buffer.size();
+  domi::ModelTaskDef task_meta;
+  EXPECT_EQ(ModelHelper::LoadTaskMeta(task_partition, task_meta), SUCCESS);
+  EXPECT_EQ(task_meta.memory_size(), 1024);
+  EXPECT_EQ(task_meta.weight_size(), 512);
+  EXPECT_EQ(task_meta.stream_num(), 2);
+  EXPECT_EQ(task_meta.task_size(), 0);
+  EXPECT_EQ(task_meta.op_size(), 0);
+
+  task_partition.size = 0;
+  EXPECT_EQ(ModelHelper::LoadTaskMeta(task_partition, task_meta), SUCCESS);
+  EXPECT_EQ(task_meta.memory_size(), 0);
+}
+
+// test the task partition is decoded when the task def is got first
+TEST_F(UtestModelManagerModelManager, lazy_task_partition) {
+  domi::ModelTaskDef model_task_def;
+  model_task_def.set_stream_num(2);
+  model_task_def.add_task()->set_stream_id(1);
+  std::string buffer = model_task_def.SerializeAsString();
+  ModelPartition task_partition;
+  task_partition.data = reinterpret_cast<uint8_t *>(&buffer[0]);
+  task_partition.size = buffer.size();
+
+  // the holder keeps the partition alive until it is decoded
+  std::shared_ptr<uint8_t> holder(new uint8_t[buffer.size()], std::default_delete<uint8_t[]>());
+  (void)memcpy_s(holder.get(), buffer.size(), buffer.data(), buffer.size());
+  GeModel ge_model;
+  ge_model.SetModelTaskData(holder, holder.get(), buffer.size());
+  holder.reset();
+  EXPECT_TRUE(ge_model.HasModelTaskDef());
+  EXPECT_NE(ge_model.task_data_.holder, nullptr);
+
+  auto task = ge_model.GetModelTaskDefPtr();
+  ASSERT_NE(task, nullptr);
+  EXPECT_EQ(task->stream_num(), 2);
+  ASSERT_EQ(task->task_size(), 1);
+  EXPECT_EQ(task->task(0).stream_id(), 1);
+  // decoded once, the partition is dropped
+  EXPECT_EQ(ge_model.task_data_.holder, nullptr);
+  EXPECT_EQ(ge_model.GetModelTaskDefPtr(), task);
+}
+
+// test a task partition of the caller buffer is decoded by the load, the buffer is not kept
+TEST_F(UtestModelManagerModelManager, load_task_partition_not_mapped) {
+  domi::ModelTaskDef model_task_def;
+  model_task_def.set_stream_num(2);
+  model_task_def.add_task()->set_stream_id(1);
+  std::string buffer = model_task_def.SerializeAsString();
+  ModelPartition task_partition;
+  task_partition.data = reinterpret_cast<uint8_t *>(&buffer[0]);
+  task_partition.size = buffer.size();
+
+  GeModel ge_model;
+  ASSERT_EQ(ModelHelper::LoadTaskPartition(task_partition, ge_model), SUCCESS);
+  EXPECT_EQ(ge_model.task_data_.holder, nullptr);
+  buffer.assign(buffer.size(), '\0');
+  auto task = ge_model.GetModelTaskDefPtr();
+  ASSERT_NE(task, nullptr);
+  EXPECT_EQ(task->stream_num(), 2);
+  ASSERT_EQ(task->task_size(), 1);
+
+  // a broken partition fails the load
+  buffer.assign(4, '\xff');
+  task_partition.data = reinterpret_cast<uint8_t *>(&buffer[0]);
+  task_partition.size = buffer.size();
+  EXPECT_EQ(ModelHelper::LoadTaskPartition(task_partition, ge_model), INTERNAL_ERROR);
+}
+
+// test a broken task partition fails every get
+TEST_F(UtestModelManagerModelManager, lazy_task_partition_broken) {
+  std::shared_ptr<uint8_t> broken(new uint8_t[4], std::default_delete<uint8_t[]>());
+  (void)memset_s(broken.get(), 4, 0xff, 4);
+  GeModel ge_model;
+  ge_model.SetModelTaskData(broken, broken.get(), 4);
+  EXPECT_TRUE(ge_model.HasModelTaskDef());
+  EXPECT_EQ(ge_model.GetModelTaskDefPtr(), nullptr);
+  EXPECT_EQ(ge_model.GetModelTaskDefPtr(), nullptr);
+  EXPECT_TRUE(ge_model.HasModelTaskDef());
+
+  // an empty partition is an empty task def
+  ge_model.SetModelTaskData(broken, broken.get(), 0);
+  auto task = ge_model.GetModelTaskDefPtr();
+  ASSERT_NE(task, nullptr);
+  EXPECT_EQ(task->task_size(), 0);
+}
+
+// test model lookup after InsertModel and DeleteModel
+TEST_F(UtestModelManagerModelManager, model_registry_lookup) {
+  ModelManager manager;
+  std::shared_ptr<DavinciModel> davinci_model = std::make_shared<DavinciModel>(0, UTEST_CALL_BACK_FUN);
+  manager.InsertModel(1, davinci_model);
+  EXPECT_EQ(manager.GetModel(1), davinci_model);
+  EXPECT_EQ(manager.GetHybridModel(1), nullptr);
+  EXPECT_EQ(manager.GetModel(2), nullptr);
+
+  EXPECT_EQ(manager.DeleteModel(1), SUCCESS);
+  EXPECT_EQ(manager.GetModel(1), nullptr);
+  EXPECT_EQ(manager.DeleteModel(1), GE_EXEC_MODEL_ID_INVALID);
+}
+
+TEST_F(UtestModelManagerModelManager, model_registry_lookup_during_publish) {
+  ModelManager manager;
+  std::shared_ptr<DavinciModel> davinci_model = std::make_shared<DavinciModel>(0, UTEST_CALL_BACK_FUN);
+  std::shared_ptr<DavinciModel> other_model = std::make_shared<DavinciModel>(0, UTEST_CALL_BACK_FUN);
+  manager.InsertModel(1, davinci_model);
+
+  // model 1 is always there, model 2 comes and goes while it is looked up
+  std::atomic<bool> stop(false);
+  std::atomic<int> wrong_num(0);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (!stop.load()) {
+        if (manager.GetModel(1) != davinci_model) {
+          ++wrong_num;
+        }
+        auto model = manager.GetModel(2);
+        if ((model != nullptr) && (model != other_model)) {
+          ++wrong_num;
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 200; ++i) {
+    manager.InsertModel(2, other_model);
+    EXPECT_EQ(manager.DeleteModel(2), SUCCESS);
+  }
+  stop = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(wrong_num.load(), 0);
+  EXPECT_EQ(manager.GetModel(2), nullptr);
+  EXPECT_EQ(manager.DeleteModel(1), SUCCESS);
+}
+
 }  // namespace ge
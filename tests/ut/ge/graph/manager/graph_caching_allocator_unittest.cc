@@ -0,0 +1,263 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/manager/graph_caching_allocator.h"
+#include "graph/manager/graph_mem_allocator.h"
+#undef protected
+#undef private
+
+namespace ge {
+namespace {
+const uint32_t kThreadNum = 4;
+const size_t kBlocksPerThread = 64;
+}  // namespace
+
+class UtestGraphCachingAllocator : public testing::Test {
+ protected:
+  void SetUp() {
+    std::vector<rtMemType_t> mem_type{RT_MEMORY_HBM};
+    EXPECT_EQ(MemManager::Instance().Initialize(mem_type), SUCCESS);
+  }
+  void TearDown() { MemManager::Instance().Finalize(); }
+};
+
+TEST_F(UtestGraphCachingAllocator, malloc_free_across_threads) {
+  CachingAllocator allocator(RT_MEMORY_HBM);
+  ASSERT_EQ(allocator.Initialize(), SUCCESS);
+
+  // thread cached sizes and sizes only the bins serve
+  const std::vector<size_t> sizes = {1024, 3000, 64 * 1024, 1024 * 1024, 6 * 1024 * 1024};
+  std::vector<std::vector<uint8_t *>> ptrs(kThreadNum);
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&allocator, &sizes, &ptrs, i]() {
+      for (size_t j = 0; j < kBlocksPerThread; ++j) {
+        ptrs[i].emplace_back(allocator.Malloc(sizes[(i + j) % sizes.size()]));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  // every thread frees the blocks of its neighbour, and mallocs again from its own cache
+  std::vector<Status> results(kThreadNum, SUCCESS);
+  for (uint32_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&allocator, &sizes, &ptrs, &results, i]() {
+      for (auto ptr : ptrs[(i + 1) % kThreadNum]) {
+        if ((ptr == nullptr) || (allocator.Free(ptr) != SUCCESS)) {
+          results[i] = FAILED;
+        }
+      }
+      for (size_t j = 0; j < kBlocksPerThread; ++j) {
+        auto ptr = allocator.Malloc(sizes[j % sizes.size()]);
+        if ((ptr == nullptr) || (allocator.Free(ptr) != SUCCESS)) {
+          results[i] = FAILED;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto result : results) {
+    EXPECT_EQ(result, SUCCESS);
+  }
+
+  CachingAllocatorStats stats;
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.malloc_num, kThreadNum * kBlocksPerThread * 2);
+  EXPECT_EQ(stats.free_num, stats.malloc_num);
+  EXPECT_EQ(stats.in_use_size, 0);
+  EXPECT_EQ(stats.free_size + stats.thread_cached_size, stats.cached_size);
+  allocator.Finalize();
+}
+
+TEST_F(UtestGraphCachingAllocator, malloc_takes_blocks_cached_by_exited_thread) {
+  CachingAllocator allocator(RT_MEMORY_HBM);
+  ASSERT_EQ(allocator.Initialize(), SUCCESS);
+
+  // 8 blocks of 1M use up the whole chunk extended for them, they are all kept in the cache of the thread
+  const size_t block_size = 1024 * 1024;
+  const size_t block_num = 8;
+  std::thread thread([&]() {
+    std::vector<uint8_t *> ptrs;
+    for (size_t i = 0; i < block_num; ++i) {
+      ptrs.emplace_back(allocator.Malloc(block_size));
+    }
+    for (auto ptr : ptrs) {
+      EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+    }
+  });
+  thread.join();
+
+  CachingAllocatorStats stats;
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.extend_num, 1);
+  EXPECT_EQ(stats.thread_cached_size, block_size * block_num);
+  EXPECT_EQ(stats.free_size, 0);
+
+  auto ptr = allocator.Malloc(block_size);
+  EXPECT_NE(ptr, nullptr);
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.extend_num, 1);
+  EXPECT_EQ(stats.thread_cached_size, 0);
+  EXPECT_EQ(stats.in_use_size, block_size);
+
+  EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+  allocator.Finalize();
+}
+
+TEST_F(UtestGraphCachingAllocator, live_thread_returns_cached_blocks_on_request) {
+  CachingAllocator allocator(RT_MEMORY_HBM);
+  ASSERT_EQ(allocator.Initialize(), SUCCESS);
+
+  const size_t block_size = 1024 * 1024;
+  const size_t block_num = 8;
+  std::promise<void> cached;
+  std::promise<void> requested;
+  std::thread thread([&]() {
+    std::vector<uint8_t *> ptrs;
+    for (size_t i = 0; i < block_num; ++i) {
+      ptrs.emplace_back(allocator.Malloc(block_size));
+    }
+    for (auto ptr : ptrs) {
+      EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+    }
+    cached.set_value();
+    requested.get_future().wait();
+    // the next call gives the cached blocks back before it is served
+    EXPECT_EQ(allocator.Free(allocator.Malloc(block_size)), SUCCESS);
+  });
+  cached.get_future().wait();
+
+  // the cache of a live thread is only touched by the thread, the main thread extends
+  auto ptr = allocator.Malloc(block_size);
+  EXPECT_NE(ptr, nullptr);
+  CachingAllocatorStats stats;
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.extend_num, 2);
+  EXPECT_EQ(stats.thread_cached_size, block_size * block_num);
+
+  allocator.RequestFlushStreamCaches();
+  requested.set_value();
+  thread.join();
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.extend_num, 2);
+  EXPECT_EQ(stats.thread_cached_size, block_size);
+  EXPECT_EQ(stats.free_size + stats.thread_cached_size + stats.in_use_size, stats.cached_size);
+
+  EXPECT_EQ(allocator.Free(ptr), SUCCESS);
+  allocator.Finalize();
+}
+
+TEST_F(UtestGraphCachingAllocator, cached_blocks_reused_on_same_stream_only) {
+  CachingAllocator allocator(RT_MEMORY_HBM);
+  ASSERT_EQ(allocator.Initialize(), SUCCESS);
+  auto stream_a = reinterpret_cast<rtStream_t>(0x1);
+  auto stream_b = reinterpret_cast<rtStream_t>(0x2);
+
+  auto ptr_a = allocator.Malloc(1024, nullptr, 0, stream_a);
+  ASSERT_NE(ptr_a, nullptr);
+  EXPECT_EQ(allocator.Free(ptr_a), SUCCESS);
+  // the block may still be in use by the work queued on stream a
+  auto ptr_b = allocator.Malloc(1024, nullptr, 0, stream_b);
+  EXPECT_NE(ptr_b, ptr_a);
+  EXPECT_EQ(allocator.Malloc(1024, nullptr, 0, stream_a), ptr_a);
+
+  CachingAllocatorStats stats;
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.thread_cache_hit_num, 1);
+  EXPECT_EQ(allocator.Free(ptr_a), SUCCESS);
+  EXPECT_EQ(allocator.Free(ptr_b), SUCCESS);
+  allocator.Finalize();
+}
+
+TEST_F(UtestGraphCachingAllocator, stats_of_malloc_and_free) {
+  CachingAllocator allocator(RT_MEMORY_HBM);
+  ASSERT_EQ(allocator.Initialize(), SUCCESS);
+  const size_t small_chunk_size = 512 * 1024;
+  const size_t large_chunk_size = 8 * 1024 * 1024;
+  const size_t large_size = 6 * 1024 * 1024;
+
+  // both miss the empty bins, extend a chunk and split it
+  auto small_ptr = allocator.Malloc(100);
+  auto large_ptr = allocator.Malloc(large_size);
+  ASSERT_NE(small_ptr, nullptr);
+  ASSERT_NE(large_ptr, nullptr);
+  // the small block goes to the thread cache and is served from there
+  EXPECT_EQ(allocator.Free(small_ptr), SUCCESS);
+  EXPECT_EQ(allocator.Malloc(100), small_ptr);
+
+  CachingAllocatorStats stats;
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.malloc_num, 3);
+  EXPECT_EQ(stats.free_num, 1);
+  EXPECT_EQ(stats.thread_cache_hit_num, 1);
+  ASSERT_EQ(stats.bin_stats.size(), kNumBins);
+  EXPECT_EQ(stats.bin_stats[0].hit_num, 0);
+  EXPECT_EQ(stats.bin_stats[0].miss_num, 1);
+  EXPECT_EQ(stats.bin_stats[1].miss_num, 1);
+  EXPECT_EQ(stats.split_num, 2);
+  EXPECT_EQ(stats.merge_num, 0);
+  EXPECT_EQ(stats.extend_num, 2);
+  EXPECT_EQ(stats.extend_fail_num, 0);
+  EXPECT_EQ(stats.cached_size, small_chunk_size + large_chunk_size);
+  EXPECT_EQ(stats.in_use_size, kRoundBlockSize + large_size);
+  EXPECT_EQ(stats.free_size, small_chunk_size - kRoundBlockSize + large_chunk_size - large_size);
+  EXPECT_EQ(stats.largest_free_block_size, large_chunk_size - large_size);
+
+  // the large block merges with the rest of its chunk
+  EXPECT_EQ(allocator.Free(large_ptr), SUCCESS);
+  EXPECT_EQ(allocator.Free(small_ptr), SUCCESS);
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.free_num, 3);
+  EXPECT_EQ(stats.merge_num, 1);
+  EXPECT_EQ(stats.in_use_size, 0);
+  EXPECT_EQ(stats.in_use_peak_size, kRoundBlockSize + large_size);
+  EXPECT_EQ(stats.cached_peak_size, small_chunk_size + large_chunk_size);
+  EXPECT_EQ(stats.thread_cached_size, kRoundBlockSize);
+  EXPECT_EQ(stats.free_size, small_chunk_size - kRoundBlockSize + large_chunk_size);
+  EXPECT_EQ(stats.largest_free_block_size, large_chunk_size);
+  EXPECT_DOUBLE_EQ(stats.fragmentation_ratio,
+                   1.0 - static_cast<double>(large_chunk_size) / static_cast<double>(stats.free_size));
+
+  // finalize gives all chunks back to the device
+  allocator.Finalize();
+  ASSERT_EQ(allocator.GetStats(0, stats), SUCCESS);
+  EXPECT_EQ(stats.cached_size, 0);
+  EXPECT_EQ(stats.free_size, 0);
+  EXPECT_EQ(stats.thread_cached_size, 0);
+}
+
+TEST_F(UtestGraphCachingAllocator, stats_of_invalid_device) {
+  CachingAllocator allocator(RT_MEMORY_HBM);
+  ASSERT_EQ(allocator.Initialize(), SUCCESS);
+  CachingAllocatorStats stats;
+  EXPECT_EQ(allocator.GetStats(kMaxStatsDeviceNum, stats), PARAM_INVALID);
+  allocator.Finalize();
+}
+}  // namespace ge
@@ -0,0 +1,475 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "benchmark_utils.h"
+#include "framework/common/types.h"
+#include "graph/debug/ge_attr_define.h"
+#include "graph/utils/attr_utils.h"
+#include "graph/utils/graph_utils.h"
+
+#define private public
+#define protected public
+#include "graph/partition/dynamic_shape_partition.h"
+#undef private
+#undef protected
+
+// Cluster merging on graphs of alternating known and unknown shape regions and on random graphs, timed against the
+// merging DynamicShapePartitioner had before the union-find, which is replayed here. Both must give the same
+// clusters. The times are test properties, see them with --gtest_output=xml; the 100k nodes case is disabled.
+namespace ge {
+namespace {
+const int kRegionNodeNum = 1000;
+
+NodePtr AddNode(ComputeGraphPtr &graph, const std::string &name, const std::string &type, int in_cnt,
+                bool is_unknown = false) {
+  OpDescPtr op_desc = std::make_shared<OpDesc>(name, type);
+  GeTensorDesc tensor_desc;
+  for (int i = 0; i < in_cnt; ++i) {
+    op_desc->AddInputDesc(tensor_desc);
+  }
+  op_desc->AddOutputDesc(tensor_desc);
+  if (is_unknown) {
+    AttrUtils::SetBool(op_desc, ATTR_NAME_IS_UNKNOWN_SHAPE, true);
+  }
+  return graph->AddNode(op_desc);
+}
+
+// the regions are chains of kRegionNodeNum nodes, known and unknown in turn, the last node of a region also reads
+// the first one
+ComputeGraphPtr BuildAlternatingGraph(int node_num) {
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("alternating_" + std::to_string(node_num));
+  auto tail = AddNode(graph, "data", DATA, 0);
+  NodePtr region_head = nullptr;
+  for (int i = 0; i < node_num; ++i) {
+    bool is_unknown = (i / kRegionNodeNum) % 2 == 1;
+    bool is_region_tail = (i % kRegionNodeNum == kRegionNodeNum - 1);
+    auto node = AddNode(graph, "node_" + std::to_string(i), is_region_tail ? ADD : RELU, is_region_tail ? 2 : 1,
+                        is_unknown);
+    GraphUtils::AddEdge(tail->GetOutDataAnchor(0), node->GetInDataAnchor(0));
+    if (i % kRegionNodeNum == 0) {
+      region_head = node;
+    } else if (is_region_tail) {
+      GraphUtils::AddEdge(region_head->GetOutDataAnchor(0), node->GetInDataAnchor(1));
+    }
+    tail = node;
+  }
+  auto net_output = AddNode(graph, "net_output", NETOUTPUT, 1);
+  GraphUtils::AddEdge(tail->GetOutDataAnchor(0), net_output->GetInDataAnchor(0));
+  return graph;
+}
+
+///
+/// @brief the cluster of DynamicShapePartitioner before the union-find: the links are vectors scanned with
+/// std::find and std::remove, a merge copies the node list, and the partitioner re-maps every merged node
+///
+class LegacyCluster : public std::enable_shared_from_this<LegacyCluster> {
+ public:
+  enum Type { DATA, INPUT_NODE, NETOUTPUT, KNOWN_SHAPE, UNKNOWN_SHAPE };
+  using Ptr = std::shared_ptr<LegacyCluster>;
+
+  LegacyCluster(size_t rank, Type type, const NodePtr &node) : id_(rank), min_(rank), max_(rank), type_(type) {
+    nodes_.push_back(node);
+  }
+
+  void AddInput(const Ptr &in) {
+    if (std::find(in_clusters_.begin(), in_clusters_.end(), in) != in_clusters_.end()) {
+      return;
+    }
+    in_clusters_.push_back(in);
+    if (std::find(in->out_clusters_.begin(), in->out_clusters_.end(), shared_from_this()) == in->out_clusters_.end()) {
+      in->out_clusters_.push_back(shared_from_this());
+    }
+  }
+  void RemoveInput(const Ptr &in) {
+    Erase(in_clusters_, in);
+    Erase(in->out_clusters_, shared_from_this());
+  }
+  void AddOutput(const Ptr &out) {
+    if (std::find(out_clusters_.begin(), out_clusters_.end(), out) != out_clusters_.end()) {
+      return;
+    }
+    out_clusters_.push_back(out);
+    if (std::find(out->in_clusters_.begin(), out->in_clusters_.end(), shared_from_this()) == out->in_clusters_.end()) {
+      out->in_clusters_.push_back(shared_from_this());
+    }
+  }
+  void RemoveOutput(const Ptr &out) {
+    Erase(out_clusters_, out);
+    Erase(out->in_clusters_, shared_from_this());
+  }
+
+  void Merge(const Ptr &other) {
+    nodes_.insert(nodes_.end(), other->nodes_.begin(), other->nodes_.end());
+    Erase(other->in_clusters_, shared_from_this());
+    Erase(other->out_clusters_, shared_from_this());
+    Erase(in_clusters_, other);
+    Erase(out_clusters_, other);
+    auto in_clusters = other->in_clusters_;
+    for (const auto &cluster : in_clusters) {
+      cluster->RemoveOutput(other);
+      cluster->AddOutput(shared_from_this());
+    }
+    auto out_clusters = other->out_clusters_;
+    for (const auto &cluster : out_clusters) {
+      cluster->RemoveInput(other);
+      cluster->AddInput(shared_from_this());
+    }
+    max_ = std::max(max_, other->max_);
+    min_ = std::min(min_, other->min_);
+  }
+
+  bool TryMerge(const Ptr &other) {
+    std::queue<Ptr> forward_reached;
+    forward_reached.push(other);
+    while (!forward_reached.empty()) {
+      auto current_cluster = forward_reached.front();
+      forward_reached.pop();
+      for (const auto &cluster : current_cluster->out_clusters_) {
+        if (cluster->max_ == max_ && current_cluster != other) {
+          return false;
+        } else if (cluster->min_ < max_) {
+          forward_reached.push(cluster);
+        }
+      }
+    }
+    Merge(other);
+    return true;
+  }
+
+  std::vector<Ptr> MergeAllPathFrom(const Ptr &other) {
+    std::vector<Ptr> path_clusters;
+    if (std::find(other->out_clusters_.begin(), other->out_clusters_.end(), shared_from_this()) ==
+        other->out_clusters_.end()) {
+      return path_clusters;
+    }
+    std::queue<Ptr> forward_reached_queue;
+    std::queue<Ptr> backward_reached_queue;
+    std::unordered_set<Ptr> forward_reached_clusters;
+    std::unordered_set<Ptr> backward_reached_clusters;
+    path_clusters.push_back(other);
+    forward_reached_queue.push(other);
+    backward_reached_queue.push(shared_from_this());
+    while (!forward_reached_queue.empty()) {
+      auto current_cluster = forward_reached_queue.front();
+      forward_reached_queue.pop();
+      for (const auto &cluster : current_cluster->out_clusters_) {
+        if (cluster->min_ < max_ && cluster->max_ != max_ && forward_reached_clusters.insert(cluster).second) {
+          forward_reached_queue.push(cluster);
+        }
+      }
+    }
+    while (!backward_reached_queue.empty()) {
+      auto current_cluster = backward_reached_queue.front();
+      backward_reached_queue.pop();
+      for (const auto &cluster : current_cluster->in_clusters_) {
+        if (cluster->max_ > other->min_ && cluster->max_ != other->max_ &&
+            backward_reached_clusters.insert(cluster).second) {
+          backward_reached_queue.push(cluster);
+          if (forward_reached_clusters.count(cluster) != 0) {
+            path_clusters.push_back(cluster);
+          }
+        }
+      }
+    }
+    for (const auto &cluster : path_clusters) {
+      Merge(cluster);
+    }
+    return path_clusters;
+  }
+
+  void Clear() {
+    in_clusters_.clear();
+    out_clusters_.clear();
+  }
+
+  size_t id_;
+  size_t min_;
+  size_t max_;
+  Type type_;
+  std::vector<Ptr> in_clusters_;
+  std::vector<Ptr> out_clusters_;
+  std::vector<NodePtr> nodes_;
+
+ private:
+  static void Erase(std::vector<Ptr> &clusters, const Ptr &cluster) {
+    clusters.erase(std::remove(clusters.begin(), clusters.end(), cluster), clusters.end());
+  }
+};
+
+///
+/// @brief MergeClusters of DynamicShapePartitioner before the union-find, the graphs here have no ref variables
+///
+class LegacyPartitioner {
+ public:
+  LegacyPartitioner(const ComputeGraphPtr &graph, const std::unordered_set<NodePtr> &unknown_shape_nodes)
+      : graph_(graph), unknown_shape_nodes_(unknown_shape_nodes) {}
+
+  ~LegacyPartitioner() {
+    for (auto &it : node_2_cluster_) {
+      it.second->Clear();
+    }
+  }
+
+  void MergeClusters() {
+    InitClusters();
+    MergeClustersUnknownShape();
+    EXPECT_TRUE(TopologicalSortClusters());
+    MergeClustersKnownShape();
+    MergeClustersInputData();
+  }
+
+  std::unordered_map<NodePtr, LegacyCluster::Ptr> node_2_cluster_;
+
+ private:
+  void InitClusters() {
+    size_t rank = 0;
+    for (const auto &node : graph_->GetDirectNode()) {
+      LegacyCluster::Type type = LegacyCluster::KNOWN_SHAPE;
+      bool is_input = ((node->GetType() == CONSTANT) || (node->GetType() == CONSTANTOP)) && node->GetInNodes().empty();
+      if (node->GetType() == DATA) {
+        type = LegacyCluster::DATA;
+      } else if (is_input) {
+        type = LegacyCluster::INPUT_NODE;
+      } else if (node->GetType() == NETOUTPUT) {
+        type = LegacyCluster::NETOUTPUT;
+      } else if (unknown_shape_nodes_.count(node) > 0) {
+        type = LegacyCluster::UNKNOWN_SHAPE;
+      }
+      auto cluster = std::make_shared<LegacyCluster>(rank++, type, node);
+      node_2_cluster_[node] = cluster;
+      if (type == LegacyCluster::UNKNOWN_SHAPE) {
+        ordered_cluster_.push_back(cluster);
+      }
+      for (const auto &parent : node->GetInAllNodes()) {
+        cluster->AddInput(node_2_cluster_[parent]);
+      }
+    }
+  }
+
+  void MergeClustersUnknownShape() {
+    for (const auto &cluster : ordered_cluster_) {
+      auto in_clusters = cluster->in_clusters_;
+      for (const auto &in_cluster : in_clusters) {
+        if (in_cluster->type_ != LegacyCluster::UNKNOWN_SHAPE) {
+          continue;
+        }
+        for (const auto &merged_cluster : cluster->MergeAllPathFrom(in_cluster)) {
+          for (const auto &node : merged_cluster->nodes_) {
+            node_2_cluster_[node] = cluster;
+          }
+        }
+      }
+    }
+  }
+
+  bool TopologicalSortClusters() {
+    ordered_cluster_.clear();
+    std::queue<LegacyCluster::Ptr> ready_clusters;
+    std::unordered_map<LegacyCluster::Ptr, size_t> cluster_pending_count;
+    std::unordered_set<LegacyCluster::Ptr> seen_clusters;
+    for (const auto &node : graph_->GetDirectNode()) {
+      auto &cluster = node_2_cluster_[node];
+      if (!seen_clusters.insert(cluster).second) {
+        continue;
+      }
+      auto pending_count = cluster->in_clusters_.size();
+      if (pending_count == 0) {
+        ready_clusters.push(cluster);
+      } else {
+        cluster_pending_count[cluster] = pending_count;
+      }
+    }
+    size_t rank = 0;
+    while (!ready_clusters.empty()) {
+      auto cluster = ready_clusters.front();
+      ready_clusters.pop();
+      cluster->min_ = rank;
+      cluster->max_ = rank++;
+      if ((cluster->type_ == LegacyCluster::KNOWN_SHAPE) || (cluster->type_ == LegacyCluster::INPUT_NODE)) {
+        ordered_cluster_.push_back(cluster);
+      }
+      for (const auto &out_cluster : cluster->out_clusters_) {
+        if (cluster_pending_count[out_cluster] > 0 && --cluster_pending_count[out_cluster] == 0) {
+          ready_clusters.push(out_cluster);
+        }
+      }
+    }
+    return rank == seen_clusters.size();
+  }
+
+  void MergeClustersKnownShape() {
+    for (const auto &cluster : ordered_cluster_) {
+      auto in_clusters = cluster->in_clusters_;
+      for (const auto &in_cluster : in_clusters) {
+        if (in_cluster->type_ != LegacyCluster::KNOWN_SHAPE) {
+          continue;
+        }
+        if (cluster->TryMerge(in_cluster)) {
+          for (const auto &node : in_cluster->nodes_) {
+            node_2_cluster_[node] = cluster;
+          }
+        }
+      }
+    }
+  }
+
+  void MergeClustersInputData() {
+    LegacyCluster::Ptr cluster_pre = nullptr;
+    for (const auto &cluster : ordered_cluster_) {
+      if (cluster->type_ != LegacyCluster::INPUT_NODE) {
+        continue;
+      }
+      if (cluster_pre != nullptr) {
+        cluster_pre->Merge(cluster);
+      } else {
+        cluster_pre = cluster;
+      }
+      for (const auto &node : cluster->nodes_) {
+        node_2_cluster_[node] = cluster_pre;
+      }
+    }
+  }
+
+  ComputeGraphPtr graph_;
+  const std::unordered_set<NodePtr> &unknown_shape_nodes_;
+  std::vector<LegacyCluster::Ptr> ordered_cluster_;
+};
+
+// every node reads one or two of the previous kRandomWindow nodes, about a third of them has unknown shape
+ComputeGraphPtr BuildRandomGraph(int node_num) {
+  const int kRandomWindow = 16;
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("random_" + std::to_string(node_num));
+  std::vector<NodePtr> nodes = {AddNode(graph, "data", DATA, 0)};
+  uint32_t seed = 7;
+  auto next = [&seed]() {
+    seed = seed * 1103515245U + 12345U;
+    return (seed >> 16) & 0x7fff;
+  };
+  for (int i = 0; i < node_num; ++i) {
+    bool is_unknown = (next() % 3 == 0);
+    int in_cnt = (next() % 2 == 0) ? 1 : 2;
+    auto node = AddNode(graph, "node_" + std::to_string(i), (in_cnt == 2) ? ADD : RELU, in_cnt, is_unknown);
+    for (int in = 0; in < in_cnt; ++in) {
+      int window = std::min(static_cast<int>(nodes.size()), kRandomWindow);
+      auto &src = nodes[nodes.size() - 1 - next() % window];
+      GraphUtils::AddEdge(src->GetOutDataAnchor(0), node->GetInDataAnchor(in));
+    }
+    nodes.emplace_back(node);
+  }
+  auto net_output = AddNode(graph, "net_output", NETOUTPUT, 1);
+  GraphUtils::AddEdge(nodes.back()->GetOutDataAnchor(0), net_output->GetInDataAnchor(0));
+  return graph;
+}
+
+///
+/// @brief merge the clusters of the graph by the legacy merging and by DynamicShapePartitioner, both must put every
+/// node in the cluster of the same id
+/// @return number of clusters
+///
+size_t MergeClusters(ComputeGraphPtr &graph) {
+  DynamicShapePartitioner partitioner(graph);
+  EXPECT_EQ(partitioner.MarkUnknownShapeNodes(), SUCCESS);
+  EXPECT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+
+  LegacyPartitioner legacy_partitioner(graph, partitioner.unknown_shape_nodes_);
+  ut::BenchmarkTimer legacy_timer;
+  legacy_partitioner.MergeClusters();
+  (void)legacy_timer.Record("legacy_merge_clusters");
+
+  ut::BenchmarkTimer timer;
+  EXPECT_EQ(partitioner.InitClusters(), SUCCESS);
+  EXPECT_EQ(partitioner.MergeClusters(), SUCCESS);
+  (void)timer.Record("merge_clusters");
+
+  size_t diff_num = 0;
+  for (const auto &node : graph->GetDirectNode()) {
+    if (partitioner.GetCluster(node)->Id() != legacy_partitioner.node_2_cluster_[node]->id_) {
+      ++diff_num;
+    }
+  }
+  EXPECT_EQ(diff_num, 0);
+  partitioner.PruneUniqueClusters();
+  size_t cluster_num = partitioner.sorted_unique_clusters_.size();
+  partitioner.ClearResource();
+  return cluster_num;
+}
+
+void RunAlternatingGraph(int node_num) {
+  auto graph = BuildAlternatingGraph(node_num);
+  size_t cluster_num = MergeClusters(graph);
+  // one cluster for every region, data and netoutput
+  EXPECT_EQ(cluster_num, static_cast<size_t>((node_num + kRegionNodeNum - 1) / kRegionNodeNum + 2));
+}
+}  // namespace
+
+class UtestDynamicShapePartition : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+// data -> known1 -> unknown1 -> known2 -> unknown2 -> net_output, and unknown1 -> unknown2
+TEST_F(UtestDynamicShapePartition, merge_all_path_between_unknown_shape) {
+  ComputeGraphPtr graph = std::make_shared<ComputeGraph>("merge_all_path");
+  auto data = AddNode(graph, "data", DATA, 0);
+  auto known1 = AddNode(graph, "known1", RELU, 1);
+  auto unknown1 = AddNode(graph, "unknown1", RELU, 1, true);
+  auto known2 = AddNode(graph, "known2", RELU, 1);
+  auto unknown2 = AddNode(graph, "unknown2", ADD, 2, true);
+  auto net_output = AddNode(graph, "net_output", NETOUTPUT, 1);
+  GraphUtils::AddEdge(data->GetOutDataAnchor(0), known1->GetInDataAnchor(0));
+  GraphUtils::AddEdge(known1->GetOutDataAnchor(0), unknown1->GetInDataAnchor(0));
+  GraphUtils::AddEdge(unknown1->GetOutDataAnchor(0), known2->GetInDataAnchor(0));
+  GraphUtils::AddEdge(known2->GetOutDataAnchor(0), unknown2->GetInDataAnchor(0));
+  GraphUtils::AddEdge(unknown1->GetOutDataAnchor(0), unknown2->GetInDataAnchor(1));
+  GraphUtils::AddEdge(unknown2->GetOutDataAnchor(0), net_output->GetInDataAnchor(0));
+
+  DynamicShapePartitioner partitioner(graph);
+  ASSERT_EQ(partitioner.MarkUnknownShapeNodes(), SUCCESS);
+  ASSERT_EQ(graph->TopologicalSorting(), GRAPH_SUCCESS);
+  ASSERT_EQ(partitioner.InitClusters(), SUCCESS);
+  ASSERT_EQ(partitioner.MergeClusters(), SUCCESS);
+  partitioner.PruneUniqueClusters();
+  // known2 is on the path between the unknown shape nodes, so it is merged with them
+  EXPECT_EQ(partitioner.sorted_unique_clusters_.size(), 4);
+  auto cluster = partitioner.GetCluster(unknown2);
+  EXPECT_TRUE(cluster->IsUnknownShape());
+  EXPECT_EQ(partitioner.GetCluster(unknown1), cluster);
+  EXPECT_EQ(partitioner.GetCluster(known2), cluster);
+  EXPECT_EQ(cluster->Nodes().size(), 3);
+  EXPECT_TRUE(partitioner.GetCluster(known1)->IsKnownShape());
+  partitioner.ClearResource();
+}
+
+TEST_F(UtestDynamicShapePartition, alternating_graph_10k) { RunAlternatingGraph(10000); }
+
+TEST_F(UtestDynamicShapePartition, random_graph_same_as_legacy_merge) {
+  auto graph = BuildRandomGraph(2000);
+  EXPECT_GT(MergeClusters(graph), 2);
+}
+
+TEST_F(UtestDynamicShapePartition, DISABLED_alternating_graph_100k) { RunAlternatingGraph(100000); }
+}  // namespace ge
@@ -0,0 +1,202 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <queue>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "benchmark_utils.h"
+#include "framework/common/types.h"
+#include "graph/passes/base_pass.h"
+#include "graph/passes/constant_folding_pass.h"
+#include "graph/passes/dimension_adjust_pass.h"
+#include "graph/passes/identity_pass.h"
+#include "graph/passes/reshape_remove_pass.h"
+#include "graph_builder_utils.h"
+
+// GEPass on synthetic graphs. The traversal cases time GEPass against the hash set traversal it had before the
+// dense node ids, both on the same graph. The 1M node graphs take minutes and are disabled.
+namespace ge {
+namespace {
+// every column of one layer has 4 nodes: Relu -> Identity -> Reshape -> Add, the Add joins the column on the right
+const int kNodesPerColumn = 4;
+const int kColumnNum = 64;
+
+ComputeGraphPtr BuildSyntheticGraph(int node_num) {
+  ut::GraphBuilder builder("synthetic_" + std::to_string(node_num));
+  std::vector<NodePtr> tails;
+  for (int col = 0; col < kColumnNum; ++col) {
+    tails.emplace_back(builder.AddNode("data_" + std::to_string(col), DATA, 1, 1));
+  }
+
+  int layer_num = node_num / (kColumnNum * kNodesPerColumn) + 1;
+  for (int layer = 0; layer < layer_num; ++layer) {
+    std::vector<NodePtr> adds;
+    for (int col = 0; col < kColumnNum; ++col) {
+      std::string suffix = std::to_string(layer) + "_" + std::to_string(col);
+      auto relu = builder.AddNode("relu_" + suffix, RELU, 1, 1);
+      auto identity = builder.AddNode("identity_" + suffix, IDENTITY, 1, 1);
+      auto reshape = builder.AddNode("reshape_" + suffix, RESHAPE, 1, 1);
+      auto add = builder.AddNode("add_" + suffix, ADD, 2, 1);
+      builder.AddDataEdge(tails[col], 0, relu, 0);
+      builder.AddDataEdge(relu, 0, identity, 0);
+      builder.AddDataEdge(identity, 0, reshape, 0);
+      builder.AddDataEdge(reshape, 0, add, 0);
+      adds.emplace_back(add);
+    }
+    for (int col = 0; col < kColumnNum; ++col) {
+      builder.AddDataEdge(tails[(col + 1) % kColumnNum], 0, adds[col], 1);
+    }
+    tails.swap(adds);
+  }
+  return builder.GetGraph();
+}
+
+class CountPass : public BaseNodePass {
+ public:
+  Status Run(NodePtr &node) override {
+    ++run_times_;
+    return SUCCESS;
+  }
+  size_t run_times_ = 0;
+};
+
+///
+/// @brief the traversal of GEPass before dense node ids: seen nodes in a hash set, and every in node of a node
+/// rescanned for each of its in edges
+///
+size_t RunLegacyTraversal(const ComputeGraphPtr &graph, BaseNodePass &pass) {
+  std::queue<NodePtr> nodes_to_pass;
+  std::unordered_set<Node *> nodes_seen;
+  std::unordered_set<NodePtr> nodes_deleted;
+  for (auto &node : graph->GetDirectNode()) {
+    if (node->GetInNodes().empty()) {
+      nodes_to_pass.push(node);
+      nodes_seen.insert(node.get());
+    }
+  }
+  size_t visited = 0;
+  while (!nodes_to_pass.empty()) {
+    auto node = nodes_to_pass.front();
+    nodes_to_pass.pop();
+    if (nodes_deleted.count(node) > 0) {
+      continue;
+    }
+    ++visited;
+    (void)pass.Run(node);
+    for (auto &out_node : node->GetOutNodes()) {
+      if (out_node->IsAllInNodesSeen(nodes_seen) && nodes_seen.insert(out_node.get()).second) {
+        nodes_to_pass.push(out_node);
+      }
+    }
+  }
+  return visited;
+}
+
+void RunTraversal(int node_num) {
+  auto graph = BuildSyntheticGraph(node_num);
+  size_t node_size = graph->GetDirectNodesSize();
+
+  CountPass legacy_pass;
+  ut::BenchmarkTimer legacy_timer;
+  EXPECT_EQ(RunLegacyTraversal(graph, legacy_pass), node_size);
+  int64_t legacy_us = legacy_timer.Record("legacy_traversal");
+
+  CountPass count_pass;
+  NamesToPass names_to_passes;
+  names_to_passes.emplace_back("CountPass", &count_pass);
+  GEPass ge_pass(graph);
+  ut::BenchmarkTimer timer;
+  EXPECT_EQ(ge_pass.Run(names_to_passes), SUCCESS);
+  int64_t cost_us = timer.Record("ge_pass_traversal");
+
+  EXPECT_EQ(count_pass.run_times_, node_size);
+  EXPECT_EQ(legacy_pass.run_times_, node_size);
+  GELOGI("GEPass traversal of %zu nodes: %ld us, legacy traversal %ld us", node_size, cost_us, legacy_us);
+}
+
+void RunPipeline(int node_num) {
+  auto graph = BuildSyntheticGraph(node_num);
+  size_t nodes_before = graph->GetDirectNodesSize();
+
+  IdentityPass identity_pass(false);
+  ReshapeRemovePass reshape_remove_pass;
+  DimensionAdjustPass dimension_adjust_pass;
+  ConstantFoldingPass constant_folding_pass;
+  NamesToPass names_to_passes;
+  names_to_passes.emplace_back("IdentityPass", &identity_pass);
+  names_to_passes.emplace_back("ReshapeRemovePass", &reshape_remove_pass);
+  names_to_passes.emplace_back("DimensionAdjustPass", &dimension_adjust_pass);
+  names_to_passes.emplace_back("ConstantFoldingPass", &constant_folding_pass);
+
+  GEPass ge_pass(graph);
+  ut::BenchmarkTimer timer;
+  EXPECT_EQ(ge_pass.Run(names_to_passes), SUCCESS);
+  (void)timer.Record("pipeline");
+
+  // the identity and reshape of every column are removed
+  size_t nodes_after = graph->GetDirectNodesSize();
+  EXPECT_EQ(nodes_before - nodes_after, (nodes_before - kColumnNum) / kNodesPerColumn * 2);
+}
+
+// the parallel mode only applies to lists of node-local passes, the identity removal stage is one
+void RunIdentityRemoval(int node_num, bool parallel) {
+  auto graph = BuildSyntheticGraph(node_num);
+  size_t nodes_before = graph->GetDirectNodesSize();
+
+  IdentityPass identity_pass(false);
+  NamesToPass names_to_passes;
+  names_to_passes.emplace_back("IdentityPass", &identity_pass);
+  GEPass ge_pass(graph);
+  ge_pass.SetParallel(parallel);
+  ut::BenchmarkTimer timer;
+  EXPECT_EQ(ge_pass.Run(names_to_passes), SUCCESS);
+  (void)timer.Record(parallel ? "identity_removal_parallel" : "identity_removal_serial");
+
+  size_t nodes_after = graph->GetDirectNodesSize();
+  EXPECT_EQ(nodes_before - nodes_after, (nodes_before - kColumnNum) / kNodesPerColumn);
+}
+}  // namespace
+
+class UtestGraphPassesBaseBenchmark : public testing::Test {
+ protected:
+  void SetUp() {}
+  void TearDown() {}
+};
+
+TEST_F(UtestGraphPassesBaseBenchmark, traversal_10k) { RunTraversal(10000); }
+
+TEST_F(UtestGraphPassesBaseBenchmark, traversal_100k) { RunTraversal(100000); }
+
+TEST_F(UtestGraphPassesBaseBenchmark, pipeline_10k) { RunPipeline(10000); }
+
+TEST_F(UtestGraphPassesBaseBenchmark, identity_removal_10k) {
+  RunIdentityRemoval(10000, false);
+  RunIdentityRemoval(10000, true);
+}
+
+TEST_F(UtestGraphPassesBaseBenchmark, DISABLED_traversal_1m) { RunTraversal(1000000); }
+
+TEST_F(UtestGraphPassesBaseBenchmark, DISABLED_pipeline_1m) { RunPipeline(1000000); }
+
+TEST_F(UtestGraphPassesBaseBenchmark, DISABLED_identity_removal_1m) {
+  RunIdentityRemoval(1000000, false);
+  RunIdentityRemoval(1000000, true);
+}
+}  // namespace ge
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <set>
@@ -67,6 +68,22 @@ class UtestTestPass : public BaseNodePass {
         names_to_add_repass_.erase(iter);
       }
     }
+    iter = names_to_attr_changed_.find(node->GetName());
+    if (iter != names_to_attr_changed_.end()) {
+      for (const auto &node_name : iter->second) {
+        RecordAttrChanged(node->GetOwnerComputeGraph()->FindNode(node_name));
+      }
+      names_to_attr_changed_.erase(iter);
+    }
+    // the control edges are added through GraphUtils only, without recording them
+    iter = names_to_add_ctrl_in_.find(node->GetName());
+    if (iter != names_to_add_ctrl_in_.end()) {
+      for (const auto &node_name : iter->second) {
+        auto src_node = node->GetOwnerComputeGraph()->FindNode(node_name);
+        GraphUtils::AddEdge(src_node->GetOutControlAnchor(), node->GetInControlAnchor());
+      }
+      names_to_add_ctrl_in_.erase(iter);
+    }
     return SUCCESS;
   }
   void clear() { iter_nodes_.clear(); }
@@ -78,12 +95,20 @@ class UtestTestPass : public BaseNodePass {
   void AddDelNodeName(const std::string &iter_node, const std::string &del_node) {
     names_to_add_del_[iter_node].insert(del_node);
   }
+  void AddAttrChangedNodeName(const std::string &iter_node, const std::string &changed_node) {
+    names_to_attr_changed_[iter_node].insert(changed_node);
+  }
+  void AddCtrlInNodeName(const std::string &iter_node, const std::string &src_node) {
+    names_to_add_ctrl_in_[iter_node].insert(src_node);
+  }
   unsigned int GetRunTimes() { return run_times_; }
 
  private:
   std::vector<NodePtr> iter_nodes_;
   std::map<std::string, std::unordered_set<std::string>> names_to_add_del_;
   std::map<std::string, std::unordered_set<std::string>> names_to_add_repass_;
+  std::map<std::string, std::unordered_set<std::string>> names_to_attr_changed_;
+  std::map<std::string, std::unordered_set<std::string>> names_to_add_ctrl_in_;
   bool dead_loop_;
   unsigned int run_times_;
 };
@@ -93,6 +118,101 @@ class TestDelPass : public BaseNodePass {
   Status Run(NodePtr &node) override { return SUCCESS; }
 };
 
+class UtestNodeLocalPass : public BaseNodePass {
+ public:
+  explicit UtestNodeLocalPass(const std::string &type_to_del) : type_to_del_(type_to_del) {}
+
+  Status Run(NodePtr &node) override {
+    ++run_times_;
+    if (node->GetType() != type_to_del_) {
+      return SUCCESS;
+    }
+    return IsolateAndDeleteNode(node, {0});
+  }
+  bool IsNodeLocal() const override { return true; }
+  Status Analyze(const NodePtr &node, NodeCommit &commit) override {
+    ++analyze_times_;
+    if (node->GetType() == type_to_del_) {
+      commit = [this, node]() {
+        ++commit_times_;
+        NodePtr node_to_del = node;
+        return IsolateAndDeleteNode(node_to_del, {0});
+      };
+    }
+    return SUCCESS;
+  }
+
+  std::atomic<uint32_t> analyze_times_{0};
+  uint32_t run_times_ = 0;
+  uint32_t commit_times_ = 0;
+
+ private:
+  std::string type_to_del_;
+};
+
+// the commit on one node deletes another node of the same wave
+class UtestSiblingDelPass : public BaseNodePass {
+ public:
+  Status Run(NodePtr &node) override {
+    ++run_times_;
+    return SUCCESS;
+  }
+  bool IsNodeLocal() const override { return true; }
+  Status Analyze(const NodePtr &node, NodeCommit &commit) override {
+    auto iter = names_to_del_.find(node->GetName());
+    if (iter != names_to_del_.end()) {
+      std::string name_to_del = iter->second;
+      commit = [this, node, name_to_del]() {
+        committed_.push_back(node->GetName());
+        NodePtr node_to_del = node->GetOwnerComputeGraph()->FindNode(name_to_del);
+        if (node_to_del == nullptr) {
+          return SUCCESS;
+        }
+        return IsolateAndDeleteNode(node_to_del, {0});
+      };
+    }
+    return SUCCESS;
+  }
+
+  std::map<std::string, std::string> names_to_del_;
+  std::vector<std::string> committed_;
+  uint32_t run_times_ = 0;
+};
+
+// removes an in edge of sum1 from a node not seen yet, without recording the change
+class UtestUnrecordedEdgePass : public BaseNodePass {
+ public:
+  Status Run(NodePtr &node) override {
+    visited_.insert(node->GetName());
+    if (node->GetName() == "data1") {
+      auto addn1 = node->GetOwnerComputeGraph()->FindNode("addn1");
+      for (const auto &peer : addn1->GetOutDataAnchor(0)->GetPeerInDataAnchors()) {
+        GraphUtils::RemoveEdge(addn1->GetOutDataAnchor(0), peer);
+      }
+    }
+    return SUCCESS;
+  }
+  std::set<std::string> visited_;
+};
+
+// records the pass and the node of every run, the default analysis of a node-local pass commits a run
+class UtestOrderPass : public BaseNodePass {
+ public:
+  UtestOrderPass(const std::string &name, bool node_local, std::vector<std::string> &order)
+      : name_(name), node_local_(node_local), order_(order) {}
+
+  Status Run(NodePtr &node) override {
+    order_.push_back(name_ + ":" + node->GetName());
+    return SUCCESS;
+  }
+  bool IsNodeLocal() const override { return node_local_; }
+
+ private:
+  std::string name_;
+  bool node_local_;
+  std::vector<std::string> &order_;
+};
+
 class UTESTGraphPassesBasePass : public testing::Test {
  protected:
   UTESTGraphPassesBasePass() {
@@ -329,6 +449,60 @@ TEST_F(UTESTGraphPassesBasePass, re_pass_before_multi_times) {
   EXPECT_EQ(test_pass.GetIterNodes().at(3)->GetName(), "reshape1");
 }
 
+TEST_F(UTESTGraphPassesBasePass, re_pass_only_stale_passes) {
+  NamesToPass names_to_pass;
+  auto test_pass1 = UtestTestPass();
+  auto test_pass2 = UtestTestPass();
+  names_to_pass.push_back(std::make_pair("test1", &test_pass1));
+  names_to_pass.push_back(std::make_pair("test2", &test_pass2));
+
+  // test2 runs on add1 after test1 changed it, only test1 has to see add1 again
+  test_pass1.AddRePassNodeName("add1", "add1");
+
+  auto graph = BuildGraph1();
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  EXPECT_EQ(test_pass1.GetIterNodes().size(), 5);
+  EXPECT_EQ(test_pass1.GetIterNodes().at(4)->GetName(), "add1");
+  EXPECT_EQ(test_pass2.GetIterNodes().size(), 4);
+}
+
+TEST_F(UTESTGraphPassesBasePass, re_pass_all_passes_after_neighbour_attr_changed) {
+  NamesToPass names_to_pass;
+  auto test_pass1 = UtestTestPass();
+  auto test_pass2 = UtestTestPass();
+  names_to_pass.push_back(std::make_pair("test1", &test_pass1));
+  names_to_pass.push_back(std::make_pair("test2", &test_pass2));
+
+  // test2 has seen add1 after its change, but the attributes of reshape1 read by it change later
+  test_pass1.AddRePassNodeName("add1", "add1");
+  test_pass1.AddAttrChangedNodeName("reshape1", "reshape1");
+
+  auto graph = BuildGraph1();
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  EXPECT_EQ(test_pass1.GetIterNodes().size(), 6);
+  EXPECT_EQ(test_pass2.GetIterNodes().size(), 5);
+  EXPECT_EQ(test_pass2.GetIterNodes().at(4)->GetName(), "add1");
+}
+
+TEST_F(UTESTGraphPassesBasePass, re_pass_after_unrecorded_edge_added) {
+  NamesToPass names_to_pass;
+  auto test_pass = UtestTestPass();
+  names_to_pass.push_back(std::make_pair("test", &test_pass));
+
+  test_pass.AddCtrlInNodeName("reshape1", "data1");
+
+  auto graph = BuildGraph1();
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  EXPECT_EQ(test_pass.GetIterNodes().size(), 6);
+  std::set<std::string> re_passed;
+  re_passed.insert(test_pass.GetIterNodes().at(4)->GetName());
+  re_passed.insert(test_pass.GetIterNodes().at(5)->GetName());
+  EXPECT_EQ(re_passed, std::set<std::string>({"reshape1", "data1"}));
+}
+
 TEST_F(UTESTGraphPassesBasePass, del_after) {
   NamesToPass names_to_pass;
   auto test_pass = UtestTestPass();
@@ -353,7 +527,8 @@ TEST_F(UTESTGraphPassesBasePass, del_after_multiple) {
   auto graph = BuildGraph2();
   auto ge_pass = GEPass(graph);
   EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
-  EXPECT_EQ(test_pass.GetIterNodes().size(), 6);
+  // add1 lost its out edges without a record and is passed again
+  EXPECT_EQ(test_pass.GetIterNodes().size(), 7);
 }
 
 TEST_F(UTESTGraphPassesBasePass, del_after_break_link) {
@@ -384,7 +559,8 @@ TEST_F(UTESTGraphPassesBasePass, del_self_and_after) {
   auto graph = BuildGraph2();
   auto ge_pass = GEPass(graph);
   EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
-  EXPECT_EQ(test_pass.GetIterNodes().size(), 4);
+  // shape1 is linked to reshape1 and sum1 by the isolation without a record, it is passed again and reaches them
+  EXPECT_EQ(test_pass.GetIterNodes().size(), 7);
 }
 
 TEST_F(UTESTGraphPassesBasePass, del_before) {
@@ -398,7 +574,8 @@ TEST_F(UTESTGraphPassesBasePass, del_before) {
   auto graph = BuildGraph2();
   auto ge_pass = GEPass(graph);
   EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
-  EXPECT_EQ(test_pass.GetIterNodes().size(), 8);
+  // reshape1 and sum1 are relinked to the in nodes of the deleted nodes, they and their new in nodes are passed again
+  EXPECT_EQ(test_pass.GetIterNodes().size(), 13);
 }
 
 TEST_F(UTESTGraphPassesBasePass, re_pass_and_del) {
@@ -412,7 +589,8 @@ TEST_F(UTESTGraphPassesBasePass, re_pass_and_del) {
   auto graph = BuildGraph2();
   auto ge_pass = GEPass(graph);
   EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
-  EXPECT_EQ(test_pass.GetIterNodes().size(), 7);
+  // reshape1 lost its out edge to sum1 without a record and is passed again
+  EXPECT_EQ(test_pass.GetIterNodes().size(), 8);
 }
 
 TEST_F(UTESTGraphPassesBasePass, dead_loop) {
@@ -438,4 +616,116 @@ TEST_F(UTESTGraphPassesBasePass, while_loop) {
   auto ge_pass = GEPass(graph);
   EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
 }
+TEST_F(UTESTGraphPassesBasePass, parallel_data_graph) {
+  auto graph = BuildGraph2();
+  auto ge_pass = GEPass(graph);
+  ge_pass.SetParallel(true);
+  EXPECT_EQ(ge_pass.Run(names_to_pass_), SUCCESS);
+  auto *pass = dynamic_cast<UtestTestPass *>(names_to_pass_[0].second);
+
+  EXPECT_EQ(pass->GetIterNodes().size(), 8);
+  std::vector<std::unordered_set<std::string>> layers;
+  layers.push_back({"data1", "const1", "const2"});
+  layers.push_back({"shape1"});
+  layers.push_back({"add1", "addn1"});
+  layers.push_back({"reshape1"});
+  layers.push_back({"sum1"});
+  CheckIterOrder(pass, layers);
+}
+
+TEST_F(UTESTGraphPassesBasePass, parallel_node_local_commit) {
+  NamesToPass names_to_pass;
+  UtestNodeLocalPass del_pass(RESHAPE);
+  names_to_pass.push_back(std::make_pair("del", &del_pass));
+
+  auto graph = BuildGraph2();
+  auto ge_pass = GEPass(graph);
+  ge_pass.SetParallel(true);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  EXPECT_EQ(graph->FindNode("reshape1"), nullptr);
+  EXPECT_EQ(del_pass.commit_times_, 1);
+  EXPECT_EQ(del_pass.run_times_, 0);
+  auto sum1 = graph->FindNode("sum1");
+  ASSERT_NE(sum1, nullptr);
+  EXPECT_EQ(sum1->GetInDataNodes().at(0)->GetName(), "add1");
+}
+
+TEST_F(UTESTGraphPassesBasePass, parallel_node_local_commit_del_sibling) {
+  NamesToPass names_to_pass;
+  UtestSiblingDelPass del_pass;
+  // add1 and addn1 are in the same wave, whichever commits first deletes the other
+  del_pass.names_to_del_["add1"] = "addn1";
+  del_pass.names_to_del_["addn1"] = "add1";
+  names_to_pass.push_back(std::make_pair("del", &del_pass));
+
+  auto graph = BuildGraph2();
+  auto ge_pass = GEPass(graph);
+  ge_pass.SetParallel(true);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  EXPECT_EQ(del_pass.run_times_, 0);
+  // only the node that survived has committed
+  bool add1_kept = graph->FindNode("add1") != nullptr;
+  bool addn1_kept = graph->FindNode("addn1") != nullptr;
+  ASSERT_NE(add1_kept, addn1_kept);
+  ASSERT_FALSE(del_pass.committed_.empty());
+  for (const auto &name : del_pass.committed_) {
+    EXPECT_EQ(name, add1_kept ? "add1" : "addn1");
+  }
+}
+
+TEST_F(UTESTGraphPassesBasePass, parallel_run_del_sibling) {
+  NamesToPass names_to_pass;
+  auto test_pass = UtestTestPass();
+  names_to_pass.push_back(std::make_pair("test", &test_pass));
+  test_pass.AddDelNodeName("add1", "addn1");
+  test_pass.AddDelNodeName("addn1", "add1");
+
+  auto graph = BuildGraph2();
+  auto ge_pass = GEPass(graph);
+  ge_pass.SetParallel(true);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  size_t sibling_runs = 0;
+  for (const auto &node : test_pass.GetIterNodes()) {
+    if (node->GetName() == "add1" || node->GetName() == "addn1") {
+      ++sibling_runs;
+    }
+  }
+  EXPECT_EQ(sibling_runs, 1);
+}
+
+TEST_F(UTESTGraphPassesBasePass, parallel_keeps_node_order_with_non_local_pass) {
+  std::vector<std::string> serial_order;
+  UtestOrderPass serial_local("local", true, serial_order);
+  UtestOrderPass serial_other("other", false, serial_order);
+  NamesToPass serial_passes = {{"local", &serial_local}, {"other", &serial_other}};
+  auto serial_graph = BuildGraph2();
+  auto serial = GEPass(serial_graph);
+  EXPECT_EQ(serial.Run(serial_passes), SUCCESS);
+
+  std::vector<std::string> parallel_order;
+  UtestOrderPass parallel_local("local", true, parallel_order);
+  UtestOrderPass parallel_other("other", false, parallel_order);
+  NamesToPass parallel_passes = {{"local", &parallel_local}, {"other", &parallel_other}};
+  auto parallel_graph = BuildGraph2();
+  auto parallel = GEPass(parallel_graph);
+  parallel.SetParallel(true);
+  EXPECT_EQ(parallel.Run(parallel_passes), SUCCESS);
+
+  // a pass that is not node-local keeps every pass running node by node
+  EXPECT_EQ(parallel_order, serial_order);
+  ASSERT_GE(serial_order.size(), 2);
+  EXPECT_EQ(serial_order[0].substr(0, 6), "local:");
+  EXPECT_EQ(serial_order[1].substr(0, 6), "other:");
+}
+
+TEST_F(UTESTGraphPassesBasePass, unrecorded_in_edge_removal_not_block_node) {
+  UtestUnrecordedEdgePass pass;
+  NamesToPass names_to_pass = {{"unrecorded", &pass}};
+  auto graph = BuildGraph2();
+  auto ge_pass = GEPass(graph);
+  EXPECT_EQ(ge_pass.Run(names_to_pass), SUCCESS);
+  // sum1 only waits for reshape1 after the edge from addn1 is gone
+  EXPECT_EQ(pass.visited_.count("sum1"), 1);
+  EXPECT_EQ(pass.visited_.size(), 8);
+}
 }  // namespace ge
@@ -16,6 +16,9 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+#include <string>
+
 #define protected public
 #define private public
 #include "graph/passes/identity_pass.h"
@@ -198,4 +201,66 @@ TEST_F(UtestIdentityPass, norm_after_switch) {
   auto switch1 = graph->FindNode("switch1");
   EXPECT_EQ(switch1->GetOutNodes().size(), 1);
   EXPECT_EQ(switch1->GetOutDataNodes().at(0)->GetName(), "addn1");
-}
\ No newline at end of file
+}
+
+///  var_i -> identity_i -> relu_i -> out_i, and var_i -> switch_i -> kept_i -c-> relu_i, for `chain_num` chains.
+///  The switch identities have control outputs and are kept, the others are removed.
+static ComputeGraphPtr BuildChainsGraph(int chain_num) {
+  ge::ut::GraphBuilder builder("chains");
+  for (int i = 0; i < chain_num; ++i) {
+    std::string index = std::to_string(i);
+    auto var = builder.AddNode("var" + index, "Variable", 0, 1);
+    auto identity = builder.AddNode("identity" + index, "Identity", 1, 1);
+    auto relu = builder.AddNode("relu" + index, "Relu", 1, 1);
+    auto out = builder.AddNode("out" + index, "Identity", 1, 1);
+    auto switch_node = builder.AddNode("switch" + index, "Switch", 2, 2);
+    auto kept = builder.AddNode("kept" + index, "Identity", 1, 1);
+    builder.AddDataEdge(var, 0, identity, 0);
+    builder.AddDataEdge(identity, 0, relu, 0);
+    builder.AddDataEdge(relu, 0, out, 0);
+    builder.AddDataEdge(var, 0, switch_node, 0);
+    builder.AddDataEdge(switch_node, 0, kept, 0);
+    builder.AddControlEdge(kept, relu);
+  }
+  return builder.GetGraph();
+}
+
+static std::set<std::string> DumpEdges(const ComputeGraphPtr &graph) {
+  std::set<std::string> edges;
+  for (const auto &node : graph->GetDirectNode()) {
+    edges.insert(node->GetName());
+    for (const auto &out_anchor : node->GetAllOutDataAnchors()) {
+      for (const auto &peer : out_anchor->GetPeerInDataAnchors()) {
+        edges.insert(node->GetName() + ":" + std::to_string(out_anchor->GetIdx()) + "->" +
+                     peer->GetOwnerNode()->GetName() + ":" + std::to_string(peer->GetIdx()));
+      }
+    }
+    for (const auto &peer : node->GetOutControlNodes()) {
+      edges.insert(node->GetName() + "-c->" + peer->GetName());
+    }
+  }
+  return edges;
+}
+
+TEST_F(UtestIdentityPass, parallel_same_graph_as_serial) {
+  // enough nodes in a wave to analyze them in several tasks
+  const int chain_num = 512;
+  auto serial_graph = BuildChainsGraph(chain_num);
+  auto parallel_graph = BuildChainsGraph(chain_num);
+  IdentityPass serial_pass(false);
+  IdentityPass parallel_pass(false);
+  ge::NamesToPass serial_passes = {{"IdentityPass", &serial_pass}};
+  ge::NamesToPass parallel_passes = {{"IdentityPass", &parallel_pass}};
+
+  ge::GEPass serial(serial_graph);
+  EXPECT_EQ(serial.Run(serial_passes), SUCCESS);
+  ge::GEPass parallel(parallel_graph);
+  parallel.SetParallel(true);
+  EXPECT_EQ(parallel.Run(parallel_passes), SUCCESS);
+
+  EXPECT_EQ(DumpEdges(serial_graph), DumpEdges(parallel_graph));
+  EXPECT_EQ(serial_graph->GetDirectNode().size(), static_cast<size_t>(chain_num * 4));
+  EXPECT_EQ(serial_graph->FindNode("identity0"), nullptr);
+  EXPECT_EQ(serial_graph->FindNode("out0"), nullptr);
+  EXPECT_NE(serial_graph->FindNode("kept0"), nullptr);
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "framework/common/types.h"
+#include "graph/passes/graph_builder_utils.h"
+#include "hybrid/executor/node_done_manager.h"
+
+namespace ge {
+namespace hybrid {
+namespace {
+const size_t kWaiterNum = 8;
+}  // namespace
+
+class UtestNodeDoneManager : public testing::Test {
+ protected:
+  void SetUp() {
+    ut::GraphBuilder builder("node_done");
+    observed_ = builder.AddNode("observed", RELU, 1, 1);
+    unregistered_ = builder.AddNode("unregistered", RELU, 1, 1);
+    graph_ = builder.GetGraph();
+    manager_.Init({observed_});
+  }
+  void TearDown() {}
+
+  ComputeGraphPtr graph_;
+  NodePtr observed_;
+  NodePtr unregistered_;
+  NodeDoneManager manager_;
+};
+
+TEST_F(UtestNodeDoneManager, await_released_node) {
+  std::vector<std::future<bool>> results;
+  for (size_t i = 0; i < kWaiterNum; ++i) {
+    results.emplace_back(std::async(std::launch::async, [this]() { return manager_.Await(observed_); }));
+  }
+  manager_.NodeDone(observed_);
+  for (auto &result : results) {
+    EXPECT_TRUE(result.get());
+  }
+  // done already, no wait
+  EXPECT_TRUE(manager_.Await(observed_));
+}
+
+TEST_F(UtestNodeDoneManager, await_unregistered_node) {
+  auto result = std::async(std::launch::async, [this]() { return manager_.Await(unregistered_); });
+  manager_.NodeDone(unregistered_);
+  EXPECT_TRUE(result.get());
+  EXPECT_TRUE(manager_.Await(unregistered_));
+}
+
+TEST_F(UtestNodeDoneManager, destroy_cancels_waiters) {
+  std::vector<std::future<bool>> results;
+  for (size_t i = 0; i < kWaiterNum; ++i) {
+    auto &node = (i % 2 == 0) ? observed_ : unregistered_;
+    results.emplace_back(std::async(std::launch::async, [this, &node]() { return manager_.Await(node); }));
+  }
+  manager_.Destroy();
+  for (auto &result : results) {
+    EXPECT_FALSE(result.get());
+  }
+  EXPECT_FALSE(manager_.Await(observed_));
+  // done after destroyed has no effect
+  manager_.NodeDone(observed_);
+  EXPECT_FALSE(manager_.Await(observed_));
+}
+
+TEST_F(UtestNodeDoneManager, released_node_stays_released_after_destroy) {
+  manager_.NodeDone(observed_);
+  manager_.Destroy();
+  EXPECT_FALSE(manager_.Await(unregistered_));
+}
+}  // namespace hybrid
+}  // namespace ge
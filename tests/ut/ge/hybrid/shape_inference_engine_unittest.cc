@@ -0,0 +1,148 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "framework/common/types.h"
+#include "graph/operator.h"
+#include "graph/passes/graph_builder_utils.h"
+#include "graph/utils/op_desc_utils.h"
+
+#define protected public
+#define private public
+#include "hybrid/executor/hybrid_execution_context.h"
+#include "hybrid/executor/worker/shape_inference_engine.h"
+#include "hybrid/model/node_item.h"
+#undef protected
+#undef private
+
+namespace ge {
+namespace hybrid {
+namespace {
+int g_infer_num = 0;
+
+// output shape is the input shape
+graphStatus InferShapeStub(Operator &op) {
+  ++g_infer_num;
+  auto op_desc = OpDescUtils::GetOpDescFromOperator(op);
+  op_desc->MutableOutputDesc(0)->SetShape(op_desc->GetInputDesc(0).GetShape());
+  op_desc->MutableOutputDesc(0)->SetOriginShape(op_desc->GetInputDesc(0).GetOriginShape());
+  return GRAPH_SUCCESS;
+}
+}  // namespace
+
+class UtestShapeInferenceEngine : public testing::Test {
+ protected:
+  void SetUp() {
+    g_infer_num = 0;
+    ut::GraphBuilder builder("infer_shape_cache");
+    auto node = builder.AddNode("relu", RELU, 1, 1, FORMAT_ND, DT_FLOAT, {-1});
+    node->GetOpDesc()->AddInferFunc(InferShapeStub);
+    graph_ = builder.GetGraph();
+    node_item_.reset(new NodeItem(node));
+    ASSERT_EQ(node_item_->Init(), SUCCESS);
+    ASSERT_NE(node_item_->infer_shape_cache, nullptr);
+    engine_.reset(new ShapeInferenceEngine(&execution_context_, nullptr));
+  }
+  void TearDown() {}
+
+  void SetInputShape(const std::vector<int64_t> &dims) {
+    auto input_desc = node_item_->op_desc->MutableInputDesc(0);
+    input_desc->SetShape(GeShape(dims));
+    input_desc->SetOriginShape(GeShape(dims));
+  }
+
+  std::vector<int64_t> GetOutputShape() const {
+    return node_item_->op_desc->MutableOutputDesc(0)->GetShape().GetDims();
+  }
+
+  void ExpectStats(uint64_t expected_hit_num, uint64_t expected_miss_num) const {
+    EXPECT_EQ(node_item_->infer_shape_cache->hit_num.load(), expected_hit_num);
+    EXPECT_EQ(node_item_->infer_shape_cache->miss_num.load(), expected_miss_num);
+  }
+
+  ComputeGraphPtr graph_;
+  std::unique_ptr<NodeItem> node_item_;
+  GraphExecutionContext execution_context_;
+  std::unique_ptr<ShapeInferenceEngine> engine_;
+};
+
+TEST_F(UtestShapeInferenceEngine, cache_hit_on_same_shape) {
+  SetInputShape({4});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  EXPECT_EQ(g_infer_num, 1);
+  ExpectStats(0, 1);
+  EXPECT_EQ(GetOutputShape(), std::vector<int64_t>({4}));
+
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  EXPECT_EQ(g_infer_num, 1);
+  ExpectStats(1, 1);
+  EXPECT_EQ(GetOutputShape(), std::vector<int64_t>({4}));
+}
+
+TEST_F(UtestShapeInferenceEngine, cache_miss_on_shape_change) {
+  SetInputShape({4});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  SetInputShape({8});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  EXPECT_EQ(g_infer_num, 2);
+  ExpectStats(0, 2);
+  EXPECT_EQ(GetOutputShape(), std::vector<int64_t>({8}));
+
+  // same rank, other dims
+  SetInputShape({2, 2});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  EXPECT_EQ(g_infer_num, 3);
+  ExpectStats(0, 3);
+  EXPECT_EQ(GetOutputShape(), std::vector<int64_t>({2, 2}));
+
+  // the cached result of the first shape is restored into the output desc
+  SetInputShape({4});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  EXPECT_EQ(g_infer_num, 3);
+  ExpectStats(1, 3);
+  EXPECT_EQ(GetOutputShape(), std::vector<int64_t>({4}));
+}
+
+TEST_F(UtestShapeInferenceEngine, least_recently_used_entry_evicted) {
+  const int64_t max_entries = 8;
+  for (int64_t dim = 1; dim <= max_entries; ++dim) {
+    SetInputShape({dim});
+    ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  }
+  // touch the first entry, the second becomes the least recently used
+  SetInputShape({1});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  ExpectStats(1, max_entries);
+
+  SetInputShape({max_entries + 1});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  EXPECT_EQ(node_item_->infer_shape_cache->entries.size(), max_entries);
+  ExpectStats(1, max_entries + 1);
+
+  SetInputShape({1});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  ExpectStats(2, max_entries + 1);
+  SetInputShape({2});
+  ASSERT_EQ(engine_->InferShapeWithCache(*node_item_), SUCCESS);
+  ExpectStats(2, max_entries + 2);
+  EXPECT_EQ(GetOutputShape(), std::vector<int64_t>({2}));
+}
+}  // namespace hybrid
+}  // namespace ge
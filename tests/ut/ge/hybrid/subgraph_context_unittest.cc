@@ -0,0 +1,143 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "framework/common/types.h"
+#include "graph/passes/graph_builder_utils.h"
+#include "graph/utils/graph_utils.h"
+
+#define protected public
+#define private public
+#include "hybrid/executor/subgraph_context.h"
+#include "hybrid/model/graph_item.h"
+#include "hybrid/model/hybrid_model_builder.h"
+#include "hybrid/model/node_item.h"
+#undef protected
+#undef private
+
+namespace ge {
+namespace hybrid {
+namespace {
+uint8_t kTensorData[4][64];
+
+TensorValue MakeTensor(int index, std::weak_ptr<TensorBuffer> &weak_buffer) {
+  std::shared_ptr<TensorBuffer> buffer = TensorBuffer::Create(kTensorData[index], sizeof(kTensorData[index]));
+  weak_buffer = buffer;
+  return TensorValue(buffer);
+}
+}  // namespace
+
+class UtestSubgraphContext : public testing::Test {
+ protected:
+  ///
+  /// a -> b -> net_output
+  ///   \-> c -/
+  ///
+  void SetUp() {
+    ut::GraphBuilder builder("memory_plan");
+    auto a = builder.AddNode("a", RELU, 1, 1);
+    auto b = builder.AddNode("b", RELU, 1, 1);
+    auto c = builder.AddNode("c", RELU, 1, 1);
+    auto net_output = builder.AddNode("net_output", NETOUTPUT, 2, 0);
+    builder.AddDataEdge(a, 0, b, 0);
+    builder.AddDataEdge(a, 0, c, 0);
+    builder.AddDataEdge(b, 0, net_output, 0);
+    builder.AddDataEdge(c, 0, net_output, 1);
+    graph_ = builder.GetGraph();
+
+    a_.reset(new NodeItem(a));
+    b_.reset(new NodeItem(b));
+    c_.reset(new NodeItem(c));
+    net_output_.reset(new NodeItem(net_output));
+    a_->input_start = 0;
+    a_->output_start = 0;
+    b_->input_start = 1;
+    b_->output_start = 1;
+    c_->input_start = 2;
+    c_->output_start = 2;
+    net_output_->input_start = 3;
+    a_->outputs = {{std::make_pair(0U, b_.get()), std::make_pair(0U, c_.get())}};
+    b_->outputs = {{std::make_pair(0U, net_output_.get())}};
+    c_->outputs = {{std::make_pair(1U, net_output_.get())}};
+
+    graph_item_.node_items_ = {a_.get(), b_.get(), c_.get()};
+    graph_item_.output_node_ = net_output_.get();
+    graph_item_.total_inputs_ = 5;
+    graph_item_.total_outputs_ = 3;
+  }
+  void TearDown() {}
+
+  ComputeGraphPtr graph_;
+  std::unique_ptr<NodeItem> a_;
+  std::unique_ptr<NodeItem> b_;
+  std::unique_ptr<NodeItem> c_;
+  std::unique_ptr<NodeItem> net_output_;
+  GraphItem graph_item_;
+};
+
+TEST_F(UtestSubgraphContext, build_memory_plan) {
+  ASSERT_EQ(HybridModelBuilder::BuildMemoryPlan(graph_item_), SUCCESS);
+  EXPECT_EQ(a_->output_use_counts, std::vector<int>({2}));
+  // read by NetOutput
+  EXPECT_EQ(b_->output_use_counts, std::vector<int>({kOutputKeptAlive}));
+  EXPECT_EQ(c_->output_use_counts, std::vector<int>({kOutputKeptAlive}));
+  EXPECT_EQ(b_->input_srcs[0], std::make_pair(static_cast<const NodeItem *>(a_.get()), 0));
+  EXPECT_EQ(c_->input_srcs[0], std::make_pair(static_cast<const NodeItem *>(a_.get()), 0));
+}
+
+TEST_F(UtestSubgraphContext, build_launch_dependencies) {
+  // c is also launched after b, and NetOutput is never launched
+  ASSERT_EQ(GraphUtils::AddEdge(b_->node->GetOutControlAnchor(), c_->node->GetInControlAnchor()), GRAPH_SUCCESS);
+  graph_item_.node_items_.emplace_back(net_output_.get());
+  ASSERT_EQ(HybridModelBuilder::BuildLaunchDependencies(graph_item_), SUCCESS);
+  EXPECT_EQ(a_->launch_successors, std::vector<int>({1, 2}));
+  EXPECT_EQ(b_->launch_successors, std::vector<int>({2}));
+  EXPECT_TRUE(c_->launch_successors.empty());
+  EXPECT_EQ(a_->num_launch_predecessors, 0);
+  EXPECT_EQ(b_->num_launch_predecessors, 1);
+  EXPECT_EQ(c_->num_launch_predecessors, 2);
+  EXPECT_EQ(net_output_->num_launch_predecessors, 0);
+}
+
+TEST_F(UtestSubgraphContext, output_released_after_last_consumer) {
+  ASSERT_EQ(HybridModelBuilder::BuildMemoryPlan(graph_item_), SUCCESS);
+  SubgraphContext context(&graph_item_);
+  ASSERT_EQ(context.Init(), SUCCESS);
+
+  std::weak_ptr<TensorBuffer> a_buffer;
+  std::weak_ptr<TensorBuffer> b_buffer;
+  ASSERT_EQ(context.SetOutput(*a_, 0, MakeTensor(0, a_buffer)), SUCCESS);
+  ASSERT_EQ(context.SetOutput(*b_, 0, MakeTensor(1, b_buffer)), SUCCESS);
+  EXPECT_FALSE(a_buffer.expired());
+
+  // c is not done with it yet
+  context.OnInputReleased(*b_, 0);
+  EXPECT_FALSE(a_buffer.expired());
+  context.OnInputReleased(*c_, 0);
+  EXPECT_TRUE(a_buffer.expired());
+  // released once only
+  context.OnInputReleased(*c_, 0);
+  EXPECT_EQ(context.output_use_counts_[0].load(), 0);
+
+  // outputs of the subgraph stay until the context is gone
+  context.OnInputReleased(*net_output_, 0);
+  EXPECT_FALSE(b_buffer.expired());
+}
+}  // namespace hybrid
+}  // namespace ge
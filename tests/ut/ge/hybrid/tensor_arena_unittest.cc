@@ -0,0 +1,137 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#define protected public
+#define private public
+#include "graph/manager/graph_mem_allocator.h"
+#include "hybrid/common/npu_memory_allocator.h"
+#include "hybrid/common/tensor_arena.h"
+#include "hybrid/common/tensor_value.h"
+#undef protected
+#undef private
+
+namespace ge {
+namespace hybrid {
+namespace {
+const size_t kBufferSize = 1024 * 1024;
+const size_t kLiveBufferNum = 4;
+const size_t kRoundNum = 3;
+
+///
+/// @brief one step allocating kRoundNum rounds of kLiveBufferNum buffers, each round is released before the next
+///
+std::set<void *> RunStep(const std::shared_ptr<TensorArena> &arena, NpuMemoryAllocator *allocator) {
+  std::set<void *> addrs;
+  for (size_t round = 0; round < kRoundNum; ++round) {
+    std::vector<std::shared_ptr<TensorBuffer>> buffers;
+    for (size_t i = 0; i < kLiveBufferNum; ++i) {
+      auto buffer = TensorBuffer::CreateShared(arena, allocator, kBufferSize);
+      EXPECT_NE(buffer, nullptr);
+      if (buffer != nullptr) {
+        addrs.insert(buffer->GetData());
+        buffers.emplace_back(buffer);
+      }
+    }
+  }
+  return addrs;
+}
+}  // namespace
+
+class UtestTensorArena : public testing::Test {
+ protected:
+  void SetUp() {
+    std::vector<rtMemType_t> mem_type{RT_MEMORY_HBM};
+    EXPECT_EQ(MemManager::Instance().Initialize(mem_type), SUCCESS);
+    allocator_ = NpuMemoryAllocator::GetAllocator(0);
+    ASSERT_NE(allocator_, nullptr);
+    arena_ = std::make_shared<TensorArena>(allocator_);
+  }
+  void TearDown() {
+    arena_.reset();
+    MemManager::Instance().Finalize();
+  }
+
+  NpuMemoryAllocator *allocator_ = nullptr;
+  std::shared_ptr<TensorArena> arena_;
+};
+
+TEST_F(UtestTensorArena, slab_sized_from_peak_live_bytes) {
+  // no slab in the first step, the buffers are allocated separately but counted
+  (void)RunStep(arena_, allocator_);
+  EXPECT_EQ(arena_->GetPeakSize(), kBufferSize * kLiveBufferNum);
+  EXPECT_EQ(arena_->Reset(), SUCCESS);
+  EXPECT_EQ(arena_->GetSlabSize(), kBufferSize * kLiveBufferNum);
+
+  // released buffers are reused in the step, all rounds fit in the slab
+  auto addrs = RunStep(arena_, allocator_);
+  EXPECT_EQ(addrs.size(), kLiveBufferNum);
+  EXPECT_EQ(arena_->live_size_.load(), 0);
+  EXPECT_EQ(arena_->Reset(), SUCCESS);
+  EXPECT_EQ(arena_->GetSlabSize(), kBufferSize * kLiveBufferNum);
+
+  // the same slab is recycled for the next step
+  EXPECT_EQ(RunStep(arena_, allocator_), addrs);
+}
+
+TEST_F(UtestTensorArena, reset_with_live_tensor) {
+  (void)RunStep(arena_, allocator_);
+  EXPECT_EQ(arena_->Reset(), SUCCESS);
+  auto kept = TensorBuffer::CreateShared(arena_, allocator_, kBufferSize);
+  ASSERT_NE(kept, nullptr);
+  ASSERT_NE(kept->arena_block_.slab, nullptr);
+  auto old_slab = kept->arena_block_.slab;
+
+  // the tensor outlives its step, it keeps the old slab and the arena goes on with a new one
+  EXPECT_EQ(arena_->Reset(), SUCCESS);
+  EXPECT_NE(arena_->slab_, nullptr);
+  EXPECT_NE(arena_->slab_, old_slab);
+  auto buffer = TensorBuffer::CreateShared(arena_, allocator_, kBufferSize);
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_EQ(buffer->arena_block_.slab, arena_->slab_);
+  EXPECT_NE(buffer->GetData(), kept->GetData());
+
+  // the old slab is freed with the last tensor in it
+  std::weak_ptr<TensorArena::Slab> weak_slab = old_slab;
+  old_slab.reset();
+  kept.reset();
+  EXPECT_TRUE(weak_slab.expired());
+  buffer.reset();
+  EXPECT_EQ(arena_->live_size_.load(), 0);
+}
+
+TEST_F(UtestTensorArena, requests_not_for_arena) {
+  EXPECT_EQ(arena_->Reset(), SUCCESS);
+  (void)RunStep(arena_, allocator_);
+  EXPECT_EQ(arena_->Reset(), SUCCESS);
+  ASSERT_GT(arena_->GetSlabSize(), 0);
+
+  auto large = TensorBuffer::CreateShared(arena_, allocator_, kBufferSize + 1);
+  ASSERT_NE(large, nullptr);
+  EXPECT_EQ(large->arena_, nullptr);
+  AllocationAttr host_attr(0, nullptr, HOST_DDR);
+  auto host = TensorBuffer::CreateShared(arena_, allocator_, 1024, &host_attr);
+  ASSERT_NE(host, nullptr);
+  EXPECT_EQ(host->arena_, nullptr);
+  EXPECT_EQ(arena_->live_size_.load(), 0);
+}
+}  // namespace hybrid
+}  // namespace ge
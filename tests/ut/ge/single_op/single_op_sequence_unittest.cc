@@ -0,0 +1,235 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "runtime/rt.h"
+
+#define protected public
+#define private public
+#include "single_op/single_op.h"
+#include "single_op/single_op_sequence.h"
+#include "single_op/stream_resource.h"
+#include "single_op/task/op_task.h"
+#undef private
+#undef protected
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+
+class UtestSingleOpSequence : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+namespace {
+void InitOp(SingleOp &op, StreamResource &resource, size_t input_num) {
+  op.input_sizes_.assign(input_num, 64);
+  op.output_sizes_ = {64};
+  op.args_.resize(input_num + 1);
+  op.arg_table_.resize(input_num + 1);
+  op.stream_resource_ = &resource;
+}
+
+// not an arg of the op, such as a workspace, it is never patched
+const uintptr_t kWorkspaceAddr = 0x5a5a;
+
+///
+/// @brief add a TBE task to op, its kernel args are the inputs and outputs of op followed by a workspace, and
+/// arg_table_ of op points into them
+///
+TbeOpTask *AddTbeTask(SingleOp &op) {
+  size_t arg_num = op.args_.size() + 1;
+  std::unique_ptr<uint8_t[]> args(new uint8_t[arg_num * sizeof(uintptr_t)]());
+  auto tbe_task = new TbeOpTask();
+  tbe_task->SetKernelArgs(std::move(args), arg_num * sizeof(uintptr_t), 1, nullptr);
+  auto task_args = reinterpret_cast<uintptr_t *>(tbe_task->args_.get());
+  for (size_t i = 0; i < op.args_.size(); ++i) {
+    op.arg_table_[i].emplace_back(&task_args[i]);
+  }
+  task_args[op.args_.size()] = kWorkspaceAddr;
+  op.tasks_.emplace_back(tbe_task);
+  return tbe_task;
+}
+
+uintptr_t GetTaskArg(const std::vector<uint8_t> &task_args, size_t index) {
+  return reinterpret_cast<const uintptr_t *>(task_args.data())[index];
+}
+}  // namespace
+
+TEST_F(UtestSingleOpSequence, test_capture_and_replay) {
+  StreamResource resource(1);
+  SingleOp relu(&resource.stream_mu_, nullptr);
+  SingleOp add(&resource.stream_mu_, nullptr);
+  InitOp(relu, resource, 1);
+  InitOp(add, resource, 2);
+
+  SingleOpSequence *sequence = nullptr;
+  ASSERT_EQ(resource.EndCapture({}, {}, &sequence), PARAM_INVALID);
+  ASSERT_EQ(resource.BeginCapture(), SUCCESS);
+  ASSERT_EQ(resource.BeginCapture(), PARAM_INVALID);
+
+  // input -> relu -> tmp, (tmp, weight) -> add -> output
+  uint8_t input[64];
+  uint8_t tmp[64];
+  uint8_t weight[64];
+  uint8_t output[64];
+  vector<DataBuffer> inputs = {DataBuffer(input, sizeof(input), false)};
+  vector<DataBuffer> outputs = {DataBuffer(output, sizeof(output), false)};
+  ASSERT_EQ(relu.ExecuteAsync(inputs, {DataBuffer(tmp, sizeof(tmp), false)}), SUCCESS);
+  ASSERT_EQ(add.ExecuteAsync({DataBuffer(tmp, sizeof(tmp), false), DataBuffer(weight, sizeof(weight), false)}, outputs),
+            SUCCESS);
+  ASSERT_EQ(resource.EndCapture(inputs, outputs, &sequence), SUCCESS);
+  ASSERT_NE(sequence, nullptr);
+  EXPECT_EQ(sequence->GetStepNum(), 2);
+  EXPECT_EQ(sequence->GetIntermediateNum(), 1);
+  EXPECT_EQ(resource.GetCapturingSequence(), nullptr);
+
+  // executions after the capture are not recorded
+  ASSERT_EQ(relu.ExecuteAsync(inputs, {DataBuffer(tmp, sizeof(tmp), false)}), SUCCESS);
+  EXPECT_EQ(sequence->GetStepNum(), 2);
+
+  auto &relu_step = sequence->steps_[0];
+  auto &add_step = sequence->steps_[1];
+  void *intermediate = sequence->intermediate_buffers_[0];
+  EXPECT_EQ(relu_step.outputs[0].data, intermediate);
+  EXPECT_EQ(add_step.inputs[0].data, intermediate);
+  EXPECT_EQ(add_step.inputs[1].data, weight);
+
+  uint8_t new_input[64];
+  uint8_t new_output[64];
+  vector<DataBuffer> new_outputs = {DataBuffer(new_output, sizeof(new_output), false)};
+  ASSERT_EQ(sequence->ExecuteAsync({DataBuffer(new_input, sizeof(new_input), false)}, new_outputs), SUCCESS);
+  EXPECT_EQ(relu_step.inputs[0].data, new_input);
+  EXPECT_EQ(relu_step.outputs[0].data, intermediate);
+  EXPECT_EQ(add_step.outputs[0].data, new_output);
+  EXPECT_EQ(add_step.io_addrs[2], reinterpret_cast<uintptr_t>(new_output));
+
+  EXPECT_EQ(sequence->ExecuteAsync({}, new_outputs), PARAM_INVALID);
+  EXPECT_EQ(sequence->ExecuteAsync({DataBuffer(new_input, 1, false)}, new_outputs), PARAM_INVALID);
+}
+
+TEST_F(UtestSingleOpSequence, test_end_capture_without_op) {
+  StreamResource resource(1);
+  ASSERT_EQ(resource.BeginCapture(), SUCCESS);
+  SingleOpSequence *sequence = nullptr;
+  EXPECT_EQ(resource.EndCapture({}, {}, &sequence), PARAM_INVALID);
+  EXPECT_EQ(resource.GetCapturingSequence(), nullptr);
+}
+
+TEST_F(UtestSingleOpSequence, test_replay_patches_external_args_of_tbe_tasks) {
+  StreamResource resource(1);
+  SingleOp relu(&resource.stream_mu_, nullptr);
+  SingleOp add(&resource.stream_mu_, nullptr);
+  InitOp(relu, resource, 1);
+  InitOp(add, resource, 2);
+  AddTbeTask(relu);
+  // two tasks of add read the same args
+  auto add_task = AddTbeTask(add);
+  AddTbeTask(add);
+
+  // input -> relu -> tmp, (tmp, weight) -> add -> output
+  uint8_t input[64];
+  uint8_t tmp[64];
+  uint8_t weight[64];
+  uint8_t output[64];
+  vector<DataBuffer> inputs = {DataBuffer(input, sizeof(input), false)};
+  vector<DataBuffer> outputs = {DataBuffer(output, sizeof(output), false)};
+  ASSERT_EQ(resource.BeginCapture(), SUCCESS);
+  ASSERT_EQ(relu.ExecuteAsync(inputs, {DataBuffer(tmp, sizeof(tmp), false)}), SUCCESS);
+  ASSERT_EQ(add.ExecuteAsync({DataBuffer(tmp, sizeof(tmp), false), DataBuffer(weight, sizeof(weight), false)}, outputs),
+            SUCCESS);
+  SingleOpSequence *sequence = nullptr;
+  ASSERT_EQ(resource.EndCapture(inputs, outputs, &sequence), SUCCESS);
+  ASSERT_NE(sequence, nullptr);
+
+  auto &relu_step = sequence->steps_[0];
+  auto &add_step = sequence->steps_[1];
+  ASSERT_EQ(relu_step.task_args.size(), 1);
+  ASSERT_EQ(add_step.task_args.size(), 2);
+  auto intermediate = reinterpret_cast<uintptr_t>(sequence->intermediate_buffers_[0]);
+  // the input of relu and the output of add are external, in both tasks of add
+  ASSERT_EQ(relu_step.arg_patches.size(), 1);
+  EXPECT_EQ(relu_step.arg_patches[0].arg_index, 0);
+  EXPECT_EQ(relu_step.arg_patches[0].offset, 0);
+  ASSERT_EQ(add_step.arg_patches.size(), 2);
+  for (size_t i = 0; i < add_step.arg_patches.size(); ++i) {
+    EXPECT_EQ(add_step.arg_patches[i].task_index, i);
+    EXPECT_EQ(add_step.arg_patches[i].arg_index, 2);
+    EXPECT_EQ(add_step.arg_patches[i].offset, 2 * sizeof(uintptr_t));
+  }
+
+  uint8_t new_input[64];
+  uint8_t new_output[64];
+  ASSERT_EQ(sequence->ExecuteAsync({DataBuffer(new_input, sizeof(new_input), false)},
+                                   {DataBuffer(new_output, sizeof(new_output), false)}),
+            SUCCESS);
+  EXPECT_EQ(GetTaskArg(relu_step.task_args[0], 0), reinterpret_cast<uintptr_t>(new_input));
+  EXPECT_EQ(GetTaskArg(relu_step.task_args[0], 1), intermediate);
+  EXPECT_EQ(GetTaskArg(relu_step.task_args[0], 2), kWorkspaceAddr);
+  for (const auto &task_args : add_step.task_args) {
+    EXPECT_EQ(GetTaskArg(task_args, 0), intermediate);
+    EXPECT_EQ(GetTaskArg(task_args, 1), reinterpret_cast<uintptr_t>(weight));
+    EXPECT_EQ(GetTaskArg(task_args, 2), reinterpret_cast<uintptr_t>(new_output));
+    EXPECT_EQ(GetTaskArg(task_args, 3), kWorkspaceAddr);
+  }
+  // the replay launches copies, the args of the task keep what the last execution of the op set
+  auto args_of_task = reinterpret_cast<const uintptr_t *>(add_task->GetArgs());
+  EXPECT_EQ(args_of_task[0], reinterpret_cast<uintptr_t>(tmp));
+  EXPECT_EQ(args_of_task[2], reinterpret_cast<uintptr_t>(output));
+}
+
+TEST_F(UtestSingleOpSequence, test_intermediates_from_memory_pool) {
+  StreamResource resource(1);
+  SingleOp relu(&resource.stream_mu_, nullptr);
+  SingleOp add(&resource.stream_mu_, nullptr);
+  InitOp(relu, resource, 1);
+  InitOp(add, resource, 2);
+
+  uint8_t input[64];
+  uint8_t tmp[64];
+  uint8_t weight[64];
+  uint8_t output[64];
+  vector<DataBuffer> inputs = {DataBuffer(input, sizeof(input), false)};
+  vector<DataBuffer> outputs = {DataBuffer(output, sizeof(output), false)};
+  ASSERT_EQ(resource.BeginCapture(), SUCCESS);
+  ASSERT_EQ(relu.ExecuteAsync(inputs, {DataBuffer(tmp, sizeof(tmp), false)}), SUCCESS);
+  ASSERT_EQ(add.ExecuteAsync({DataBuffer(tmp, sizeof(tmp), false), DataBuffer(weight, sizeof(weight), false)}, outputs),
+            SUCCESS);
+  SingleOpSequence *sequence = nullptr;
+  ASSERT_EQ(resource.EndCapture(inputs, outputs, &sequence), SUCCESS);
+  ASSERT_NE(sequence, nullptr);
+
+  // the intermediate buffer is a block of the stream
+  auto stats = resource.GetMemoryStats();
+  EXPECT_EQ(stats.malloc_num, 1);
+  EXPECT_GT(stats.in_use_size, 0);
+  EXPECT_EQ(stats.cached_size, stats.in_use_size);
+
+  EXPECT_EQ(resource.DestroySequence(sequence), SUCCESS);
+  stats = resource.GetMemoryStats();
+  EXPECT_EQ(stats.free_num, 1);
+  EXPECT_EQ(stats.in_use_size, 0);
+  EXPECT_EQ(resource.DestroySequence(sequence), PARAM_INVALID);
+
+  // given back to runtime by trimming
+  resource.TrimMemory(0);
+  EXPECT_EQ(resource.GetMemoryStats().cached_size, 0);
+}
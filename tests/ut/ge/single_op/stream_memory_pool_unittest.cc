@@ -0,0 +1,152 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "single_op/stream_memory_pool.h"
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+
+class UtestStreamMemoryPool : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestStreamMemoryPool, test_block_size) {
+  EXPECT_EQ(StreamMemoryPool::GetBlockSize(0), 512);
+  EXPECT_EQ(StreamMemoryPool::GetBlockSize(512), 512);
+  EXPECT_EQ(StreamMemoryPool::GetBlockSize(513), 1024);
+  EXPECT_EQ(StreamMemoryPool::GetBlockSize(1000 * 1000), 1024 * 1024);
+  EXPECT_EQ(StreamMemoryPool::GetBlockSize(2 * 1024 * 1024 + 1), 4 * 1024 * 1024);
+  EXPECT_EQ(StreamMemoryPool::GetBlockSize(5 * 1024 * 1024), 6 * 1024 * 1024);
+}
+
+TEST_F(UtestStreamMemoryPool, test_reuse_free_block) {
+  StreamMemoryPool pool;
+  uint8_t *block = pool.Malloc("test", 1000);
+  ASSERT_NE(block, nullptr);
+  ASSERT_EQ(pool.Free(block), SUCCESS);
+  ASSERT_EQ(pool.Free(block), PARAM_INVALID);
+
+  // 1000 and 600 bytes are in the same size class, 300 bytes is less than half of it
+  EXPECT_EQ(pool.Malloc("test", 600), block);
+  uint8_t *small_block = pool.Malloc("test", 300);
+  ASSERT_NE(small_block, nullptr);
+  EXPECT_NE(small_block, block);
+
+  const auto &stats = pool.GetStats();
+  EXPECT_EQ(stats.malloc_num, 3);
+  EXPECT_EQ(stats.reuse_num, 1);
+  EXPECT_EQ(stats.cached_size, 1024 + 512);
+  EXPECT_EQ(stats.in_use_size, 1024 + 512);
+  EXPECT_EQ(stats.in_use_peak_size, 1024 + 512);
+}
+
+TEST_F(UtestStreamMemoryPool, test_trim_to_high_water_mark) {
+  StreamMemoryPool pool;
+  vector<uint8_t *> blocks;
+  for (size_t size : {512, 1024, 4096, 8192}) {
+    blocks.emplace_back(pool.Malloc("test", size));
+    ASSERT_NE(blocks.back(), nullptr);
+  }
+  for (auto block : blocks) {
+    ASSERT_EQ(pool.Free(block), SUCCESS);
+  }
+  EXPECT_EQ(pool.GetStats().cached_size, 512 + 1024 + 4096 + 8192);
+  EXPECT_EQ(pool.GetStats().in_use_size, 0);
+
+  // the largest free blocks are released first
+  pool.Trim(2048);
+  EXPECT_EQ(pool.GetStats().cached_size, 512 + 1024);
+  EXPECT_EQ(pool.GetStats().release_num, 2);
+
+  // the mark is kept for later frees
+  uint8_t *block = pool.Malloc("test", 8192);
+  ASSERT_NE(block, nullptr);
+  EXPECT_EQ(pool.GetStats().cached_size, 512 + 1024 + 8192);
+  ASSERT_EQ(pool.Free(block), SUCCESS);
+  EXPECT_EQ(pool.GetStats().cached_size, 512 + 1024);
+
+  pool.Trim(0);
+  EXPECT_EQ(pool.GetStats().cached_size, 0);
+}
+
+TEST_F(UtestStreamMemoryPool, test_sync_stream_before_release) {
+  StreamMemoryPool pool;
+  vector<uint8_t *> blocks;
+  for (size_t size : {512, 1024, 4096}) {
+    blocks.emplace_back(pool.Malloc("test", size));
+    ASSERT_NE(blocks.back(), nullptr);
+  }
+
+  // no free block to release, the stream is not synchronized
+  pool.Trim(0);
+  EXPECT_EQ(pool.GetStats().sync_num, 0);
+
+  // the launches the blocks were freed after may still be running, they are released after a synchronization
+  ASSERT_EQ(pool.Free(blocks[2]), SUCCESS);
+  ASSERT_EQ(pool.Free(blocks[1]), SUCCESS);
+  pool.Trim(512 + 1024);
+  EXPECT_EQ(pool.GetStats().sync_num, 1);
+  EXPECT_EQ(pool.GetStats().release_num, 1);
+  // freed before the last synchronization, no need to synchronize again
+  pool.Trim(512);
+  EXPECT_EQ(pool.GetStats().sync_num, 1);
+  EXPECT_EQ(pool.GetStats().release_num, 2);
+
+  // trimming on free synchronizes as well
+  ASSERT_EQ(pool.Free(blocks[0]), SUCCESS);
+  EXPECT_EQ(pool.GetStats().cached_size, 512);
+  EXPECT_EQ(pool.GetStats().sync_num, 1);
+  uint8_t *block = pool.Malloc("test", 2048);
+  ASSERT_NE(block, nullptr);
+  ASSERT_EQ(pool.Free(block), SUCCESS);
+  EXPECT_EQ(pool.GetStats().sync_num, 2);
+  EXPECT_EQ(pool.GetStats().release_num, 3);
+  EXPECT_EQ(pool.GetStats().cached_size, 512);
+}
+
+TEST_F(UtestStreamMemoryPool, test_no_sync_on_free_while_in_use_above_mark) {
+  StreamMemoryPool pool;
+  pool.Trim(1024);
+  vector<uint8_t *> blocks;
+  for (int i = 0; i < 8; ++i) {
+    blocks.emplace_back(pool.Malloc("test", 1024));
+    ASSERT_NE(blocks.back(), nullptr);
+  }
+
+  // the blocks in use alone are above the mark, freeing does not synchronize the stream
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(pool.Free(blocks[i]), SUCCESS);
+    EXPECT_EQ(pool.GetStats().sync_num, 0);
+    EXPECT_EQ(pool.GetStats().release_num, 0);
+  }
+  EXPECT_EQ(pool.GetStats().cached_size, 8 * 1024);
+
+  // in use drops to the mark, the free blocks are released after one synchronization
+  ASSERT_EQ(pool.Free(blocks[6]), SUCCESS);
+  EXPECT_EQ(pool.GetStats().sync_num, 1);
+  EXPECT_EQ(pool.GetStats().release_num, 7);
+  EXPECT_EQ(pool.GetStats().cached_size, 1024);
+  ASSERT_EQ(pool.Free(blocks[7]), SUCCESS);
+  EXPECT_EQ(pool.GetStats().sync_num, 1);
+  EXPECT_EQ(pool.GetStats().cached_size, 1024);
+}
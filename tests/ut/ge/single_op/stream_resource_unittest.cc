@@ -56,26 +56,24 @@ TEST_F(UtestStreamResource, test_malloc_memory) {
   ASSERT_NE(res.MallocMemory(100), nullptr);
 }
 
-TEST_F(UtestStreamResource, test_do_malloc_memory) {
-  size_t max_allocated = 0;
-  vector<uint8_t *> allocated;
+TEST_F(UtestStreamResource, test_malloc_shared_memory) {
+  StreamResource res(1);
 
-  uint8_t *ret = StreamResource::DoMallocMemory(100, max_allocated, allocated);
-  ASSERT_EQ(allocated.size(), 1);
-  ASSERT_NE(allocated.back(), nullptr);
-  ASSERT_EQ(max_allocated, 100);
+  uint8_t *memory = res.MallocMemory("test", 100);
+  ASSERT_NE(memory, nullptr);
+  ASSERT_EQ(res.MallocMemory("test", 50), memory);
+  ASSERT_EQ(res.MallocMemory("test", 100), memory);
+  ASSERT_EQ(res.max_memory_size_, 100);
 
-  StreamResource::DoMallocMemory(50, max_allocated, allocated);
-  StreamResource::DoMallocMemory(99, max_allocated, allocated);
-  StreamResource::DoMallocMemory(100, max_allocated, allocated);
-  ASSERT_EQ(allocated.size(), 1);
-  ASSERT_EQ(max_allocated, 100);
-
-  StreamResource::DoMallocMemory(101, max_allocated, allocated);
-  ASSERT_EQ(allocated.size(), 2);
-  ASSERT_EQ(max_allocated, 101);
-
-  for (auto res : allocated) {
-      rtFree(res);
-  }
+  uint8_t *larger_memory = res.MallocMemory("test", 101);
+  ASSERT_NE(larger_memory, nullptr);
+  ASSERT_NE(larger_memory, memory);
+  ASSERT_EQ(res.max_memory_size_, 101);
+  // the shared memory is never freed to the pool, so workspaces do not overlap it
+  uint8_t *workspace = res.MallocWorkspace("test", 100);
+  ASSERT_NE(workspace, memory);
+  ASSERT_NE(workspace, larger_memory);
+  ASSERT_EQ(res.FreeWorkspace(workspace), SUCCESS);
+  ASSERT_EQ(res.MallocWorkspace("test", 100), workspace);
+  ASSERT_EQ(res.GetMemoryStats().malloc_num, 4);
 }
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "single_op/task/tiling_cache.h"
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+
+class UtestTilingCache : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+TEST_F(UtestTilingCache, test_find_and_insert) {
+  TilingCache cache(2);
+  ASSERT_EQ(cache.Find("a"), nullptr);
+  auto *tiling_info = cache.Insert("a");
+  ASSERT_NE(tiling_info, nullptr);
+  tiling_info->block_dim = 8;
+  tiling_info->workspace_sizes = {32, 64};
+  tiling_info->tiling_data = "tiling";
+
+  auto *cached = cache.Find("a");
+  ASSERT_EQ(cached, tiling_info);
+  EXPECT_EQ(cached->block_dim, 8);
+  EXPECT_EQ(cached->workspace_sizes.size(), 2);
+  EXPECT_EQ(cached->tiling_data, "tiling");
+  EXPECT_EQ(cache.HitCount(), 1);
+  EXPECT_EQ(cache.MissCount(), 1);
+}
+
+TEST_F(UtestTilingCache, test_evict_least_recently_used) {
+  TilingCache cache(2);
+  int buffer_a = 0;
+  auto *tiling_info = cache.Insert("a");
+  tiling_info->tiling_buffer = &buffer_a;
+  tiling_info->is_uploaded = true;
+  cache.Insert("b")->block_dim = 2;
+  // "a" becomes the most recently used, so "b" is evicted
+  ASSERT_NE(cache.Find("a"), nullptr);
+  auto *reused = cache.Insert("c");
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_EQ(cache.EvictCount(), 1);
+  EXPECT_EQ(cache.Find("b"), nullptr);
+  EXPECT_NE(cache.Find("a"), nullptr);
+  EXPECT_EQ(cache.Find("c"), reused);
+  EXPECT_EQ(reused->block_dim, 0);
+  EXPECT_FALSE(reused->is_uploaded);
+
+  // the device buffer of an evicted entry is kept for the new one
+  cache.Insert("d");
+  EXPECT_EQ(cache.Find("a"), nullptr);
+  auto *entry_d = cache.Find("d");
+  ASSERT_NE(entry_d, nullptr);
+  EXPECT_EQ(entry_d->tiling_buffer, &buffer_a);
+  EXPECT_FALSE(entry_d->is_uploaded);
+
+  size_t entry_num = 0;
+  cache.ForEach([&entry_num](TilingInfo &) { ++entry_num; });
+  EXPECT_EQ(entry_num, 2);
+}
+
+TEST_F(UtestTilingCache, test_zero_capacity) {
+  TilingCache cache(0);
+  EXPECT_EQ(cache.Insert("a"), nullptr);
+  EXPECT_EQ(cache.Find("a"), nullptr);
+  EXPECT_EQ(cache.Size(), 0);
+}
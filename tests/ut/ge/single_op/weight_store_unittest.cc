@@ -0,0 +1,116 @@
+/**
+ * Copyright 2019-2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#define protected public
+#define private public
+#include "single_op/weight_store.h"
+#undef private
+#undef protected
+
+using namespace std;
+using namespace testing;
+using namespace ge;
+
+class UtestWeightStore : public testing::Test {
+ protected:
+  void SetUp() {}
+
+  void TearDown() {}
+};
+
+namespace {
+std::string ToHex(const WeightStore::Fingerprint &fingerprint) {
+  const char kHexDigits[] = "0123456789abcdef";
+  std::string hex;
+  for (auto byte : fingerprint) {
+    hex += kHexDigits[byte >> 4];
+    hex += kHexDigits[byte & 0xf];
+  }
+  return hex;
+}
+
+std::string GetFingerprintHex(const std::string &data) {
+  return ToHex(WeightStore::GetFingerprint(reinterpret_cast<const uint8_t *>(data.data()), data.size()));
+}
+}  // namespace
+
+TEST_F(UtestWeightStore, test_fingerprint) {
+  EXPECT_EQ(GetFingerprintHex(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(GetFingerprintHex("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  // the padding takes another block
+  EXPECT_EQ(GetFingerprintHex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  // a whole block followed by the padding block
+  EXPECT_EQ(GetFingerprintHex(std::string(64, 'a')),
+            "ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb");
+}
+
+TEST_F(UtestWeightStore, test_share_same_weights) {
+  WeightStore store;
+  vector<uint8_t> weights(64, 0);
+  vector<uint8_t> other_weights(64, 1);
+  uint8_t *device_weights = nullptr;
+  uint8_t *shared_weights = nullptr;
+  uint8_t *other_device_weights = nullptr;
+  ASSERT_EQ(store.Acquire("test", 128, weights.data(), weights.size(), &device_weights), SUCCESS);
+  ASSERT_EQ(store.Acquire("test", 128, weights.data(), weights.size(), &shared_weights), SUCCESS);
+  ASSERT_EQ(store.Acquire("test", 128, other_weights.data(), other_weights.size(), &other_device_weights), SUCCESS);
+  EXPECT_EQ(shared_weights, device_weights);
+  EXPECT_NE(other_device_weights, device_weights);
+
+  auto stats = store.GetStats();
+  EXPECT_EQ(stats.entry_num, 2);
+  EXPECT_EQ(stats.ref_num, 3);
+  EXPECT_EQ(stats.device_size, 256);
+  EXPECT_EQ(stats.saved_size, 128);
+
+  // weights of another memory size are not shared
+  uint8_t *larger_weights = nullptr;
+  ASSERT_EQ(store.Acquire("test", 256, weights.data(), weights.size(), &larger_weights), SUCCESS);
+  EXPECT_NE(larger_weights, device_weights);
+  EXPECT_EQ(store.Acquire("test", 32, weights.data(), weights.size(), &larger_weights), PARAM_INVALID);
+
+  store.Release(device_weights);
+  EXPECT_EQ(store.GetStats().entry_num, 3);
+  store.Release(shared_weights);
+  store.Release(other_device_weights);
+  EXPECT_EQ(store.GetStats().entry_num, 1);
+  EXPECT_EQ(store.GetStats().ref_num, 1);
+}
+
+TEST_F(UtestWeightStore, test_share_by_fingerprint) {
+  WeightStore store;
+  // the device copy read back by the runtime stub is all zeros, the weights are shared without reading it
+  vector<uint8_t> weights(64, 1);
+  uint8_t *device_weights = nullptr;
+  ASSERT_EQ(store.Acquire("test", 128, weights.data(), weights.size(), &device_weights), SUCCESS);
+  ASSERT_EQ(store.GetStats().entry_num, 1);
+  EXPECT_EQ(store.entries_.begin()->first, WeightStore::GetFingerprint(weights.data(), weights.size()));
+
+  uint8_t *shared_weights = nullptr;
+  ASSERT_EQ(store.Acquire("test", 128, weights.data(), weights.size(), &shared_weights), SUCCESS);
+  EXPECT_EQ(shared_weights, device_weights);
+  auto stats = store.GetStats();
+  EXPECT_EQ(stats.entry_num, 1);
+  EXPECT_EQ(stats.ref_num, 2);
+
+  store.Release(device_weights);
+  store.Release(shared_weights);
+  EXPECT_EQ(store.GetStats().entry_num, 0);
+}